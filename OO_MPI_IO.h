@@ -1,6 +1,18 @@
-/* OO_MPI_IO.h (Version 2) declares C++ templates that use MPI_IO:
+/* OO_MPI_IO.h (Version 3) declares C++ templates that use MPI_IO:
  *  - ParallelReader to read data from a binary file in parallel.
  *  - ParallelWriter to write data to a binary file in parallel.
+ *  - ParallelUpdater to update scattered data in a binary file in parallel.
+ *  - ParallelArrayReader to read a PE's tile of an N-dimensional array.
+ *  - ParallelArrayWriter to write a PE's tile of an N-dimensional array.
+ *  - TiledArray to access an out-of-core matrix through a tile cache.
+ *  - EpochReader to read a file's blocks in a shuffled order, epoch by epoch.
+ *  - CompressedWriter/CompressedReader to write/read block-compressed files.
+ *  - RangeScanReader to read just the Items within a range of values.
+ *  - SortedLookup to look up batches of keys in a sorted file.
+ *  - BloomFilter to test keys for membership in a file without reading it.
+ *  - RecordWriter/RecordReader to write/read files of variable-length records.
+ *  - ParallelTextReader/ParallelTextWriter to read/write text files of values.
+ *  - Philox4x32 to generate random data that is the same for any number of PEs.
  *
  * The template allows you to pass a type-parameter indicating
  *   the type of the data in the file.
@@ -17,6 +29,103 @@
  *     Also adds method ParallelReader::getChunkPlus(int extras) for 
  *      reading a chunk plus extras items from the next PE's chunk
  *      (useful for search problems where the target spans chunk boundaries).
+ *   Version 3, Fall 2026, adds
+ *     - ParallelArrayReader and ParallelArrayWriter, which use
+ *        MPI subarray file views to read/write block-decomposed
+ *        N-dimensional arrays (with optional ghost layers).
+ *     - TiledArray, an out-of-core 2-D array with an LRU tile cache,
+ *        prefetching, write-back and hit/miss/bandwidth counters.
+ *     - ParallelReader::readItems(indices), to gather arbitrary Items
+ *        with a single coalesced, indexed read.
+ *     - ParallelUpdater, to overwrite scattered Items in place, with a
+ *        policy for resolving conflicting writes.
+ *     - EpochReader, which reads fixed-size blocks in a seeded, 
+ *        per-epoch random order, with asynchronous prefetching.
+ *     - an optional 256-byte file header (ParallelWriter::enableHeader())
+ *        recording the Item type and count, byte order, array shape
+ *        and user metadata; the readers detect and check it.
+ *     - setByteOrder(), to read/write files in the other byte order
+ *        (or MPI's external32 representation), converting each window
+ *        of Items as it is transferred with swapBytes(), which uses
+ *        AVX2/SSSE3 shuffles when available.
+ *     - ParallelReader<Stored, Delivered> and 
+ *        ParallelWriter<Stored, Supplied>, which convert values
+ *        (e.g., double to float) a window at a time as they are
+ *        transferred, using AVX/AVX2 kernels when available.
+ *     - CompressedWriter and CompressedReader, for a container of
+ *        independently compressed blocks (LZ, optionally byte-shuffled)
+ *        with a footer index, so PEs can decompress blocks in parallel.
+ *     - numeric codecs for compressed containers (frame of reference,
+ *        delta and XOR-float encodings, bit-packed), and per-block
+ *        min/max in the index, so min/max queries need not decode.
+ *     - CRC32C block checksums in a '.crc' sidecar file
+ *        (ParallelWriter::enableChecksums()), which
+ *        ParallelReader::verifyChecksums() checks as it reads,
+ *        using the SSE 4.2 crc32 instruction when available.
+ *     - zone maps (per-block min/max and count, in a '.zmap' sidecar
+ *        written by ParallelWriter::enableZoneMap() or buildZoneMap()),
+ *        and RangeScanReader, which uses one to read only the blocks
+ *        that might hold values in a range, balanced among the PEs.
+ *     - SortedLookup, which answers batches of lower-bound and
+ *        exact-match queries on a sorted file using an in-memory
+ *        index of every K-th key, routing each key to the PE that
+ *        owns its block, which reads its blocks in one indexed read.
+ *     - BloomFilter, a blocked (64-byte, cache-line-sized) Bloom filter
+ *        that buildBloomFilter() builds from a file in parallel (merging
+ *        the PEs' filters with a bitwise-OR reduction) and saves in a
+ *        '.bloom' sidecar; batches of keys are tested with AVX2 probes
+ *        (when available) before any file I/O.
+ *     - record files of length-prefixed, variable-length records,
+ *        with a sync marker at least every 'syncInterval' bytes, so that
+ *        RecordReader can snap an even split of the bytes to record
+ *        starts; an optional '.idx' sidecar of offsets replaces the
+ *        marker search and allows reads of records by number, and
+ *        records are returned as views into the read buffer.
+ *     - ParallelTextReader, which splits a text file (of one value
+ *        per line, with an optional count line) by bytes, moves each
+ *        split to the start of a line, and parses its lines with
+ *        from_chars() (C++17) or the C library, so text files need
+ *        not be converted to binary serially before a run.
+ *     - ParallelTextWriter, which formats each PE's Items (with
+ *        to_chars() or the C library) and writes them after those of
+ *        the lower-id PEs, matching a serial write byte for byte;
+ *        likewise, in MPI mode, ParallelWriter now places each chunk
+ *        after those of the lower-id PEs, whatever their sizes.
+ *     - ParallelWriter::beginChunk(), writePart() and endChunk(),
+ *        to write a chunk a part at a time (in bounded memory), and
+ *        Philox4x32, a counter-based random number generator, which
+ *        genTextAndBinaryFiles/genData uses to generate data sets in
+ *        parallel; getChunkStartStopValues() now handles counts 
+ *        of 2^32 or more.
+ *     - I/O statistics (compiled in with -DOO_MPI_IO_STATS): each
+ *        reader and writer counts the calls, bytes and wall time of
+ *        its opens, size queries, reads, writes, truncations and
+ *        closes (getStats()), and reduceStats() summarizes them over
+ *        the PEs (least, greatest, mean and each PE's bandwidth).
+ *     - event tracing (compiled in with -DOO_MPI_IO_TRACE): each
+ *        MPI-IO operation, and each phase of ParallelReader and 
+ *        ParallelWriter, is recorded in its thread's ring buffer,
+ *        and saveTrace() merges every thread's events into one
+ *        Chrome-trace JSON file, for viewing as a timeline.
+ *     - I/O tuning profiles: each reader and writer uses the profile
+ *        of its file's file system (collective or independent I/O,
+ *        MPI-IO hints, and the window size), which autotune() finds
+ *        by probing the file system and saves, by mount point.
+ *     - ParallelReader::reduce(op), to reduce a chunk in cache-sized
+ *        windows (never holding all of it) and combine the results 
+ *        over the PEs, with sum, min, max, moments (mean, variance)
+ *        and histogram ops, plus makeAssociativeOp() for others.
+ *     - transformFile(reader, writer, function), to write a function
+ *        of each Item of a file to another file through a ring of 
+ *        blocks, so reading, transforming and writing overlap, 
+ *        built on non-blocking parts (beginChunk(), startPart(), 
+ *        finishPart() and endChunk()) of ParallelReader and 
+ *        ParallelWriter.
+ *     - parallelSort(inFileName, outFileName, mpiType), to sort a file
+ *        of numbers with a distributed sample sort (radixSort() for 
+ *        each process's Items, MPI_Alltoallv() to exchange them), 
+ *        using run files and a k-way merge if it does not fit in 
+ *        memory.
  *
  * Note: OO_MPI_IO uses 'PEs' (processing elements) as a synonym
  *        for threads or processes.
@@ -34,73 +143,280 @@
 #include <string>                    // C++ string 
 #include <cmath>                     // ceil()
 #include <vector>                    // C++ vector
+#include <climits>                   // INT_MAX
+#include <cstdint>                   // uint64_t
+#include <cstddef>                   // offsetof()
+#include <cstring>                   // memcmp(), memcpy()
+#include <algorithm>                 // min(), max()
+#include <list>                      // C++ list
+#include <unordered_map>             // C++ unordered_map
+#include <type_traits>               // is_same, is_integral, ...
 
 /********************************************************************
- * OO_MPI_IO_Base is a base class for C++ templates that use
- *  MPI_IO to read/write binary data from/to files in parallel.
+ * OO_MPI_IO_Header is the (optional) fixed-size header of a
+ *  self-describing binary file: it records what the file contains
+ *  and where its data begins, so that readers need not infer 
+ *  the Item count from the file's size (or trust the ItemType).
  *
- * Its subclasses are ParallelReader and ParallelWriter.
+ * A file with a header consists of the 256-byte header,
+ *  followed by numItems Items of itemSize bytes each.
+ * The header's fields are stored in the writer's byte order;
+ *  byteOrderMark (0x01020304 as written) reveals what that order was.
  ********************************************************************/
 
-template<class ItemType> 
-class OO_MPI_IO_Base {
-public:
-  OO_MPI_IO_Base(const std::string& fileName, 
-                   int openMode, MPI_Datatype mpiType,
-                   int id, int numPEs);
-  virtual ~OO_MPI_IO_Base();
- 
-  int getID() const                { return myID; }
-  int getNumPEs() const            { return myNumPEs; }
-  long getItemSize() const         { return myItemSize; }
-  std::string getFileName() const  { return myFileName; }
-  MPI_File& getFileHandle()        { return myFileHandle; }
-  MPI_Datatype getMPIType() const  { return myMPIType; }
-  long getNumItemsInFile() const   { return myNumItemsInFile; }
-  long getChunkSize() const        { return myChunkSize; }
-  long getFirstItemOffset() const  { return myFirstItemOffset; }
-  long getFirstByteOffset() const  { return myFirstByteOffset; }
-  long getFileSize() const         { return myFileSize; }
+const char     OO_MPI_IO_MAGIC[8] = {'O','O','M','P','I','I','O','\0'};
+const uint32_t OO_MPI_IO_BYTE_ORDER_MARK = 0x01020304;
+const int      OO_MPI_IO_HEADER_SIZE = 256;
+const int      OO_MPI_IO_MAX_DIMS = 8;
+const int      OO_MPI_IO_USER_DATA_SIZE = 152;
 
-  void close()                     { MPI_File_close(&myFileHandle); }
+struct OO_MPI_IO_Header {
+  char     magic[8];                          // OO_MPI_IO_MAGIC
+  uint32_t version;                           // header format (1)
+  uint32_t headerSize;                        // OO_MPI_IO_HEADER_SIZE
+  uint32_t typeCode;                          // an OO_MPI_IO_TypeCode
+  uint32_t itemSize;                          // sizeof(ItemType)
+  uint32_t byteOrderMark;                     // OO_MPI_IO_BYTE_ORDER_MARK
+  uint32_t numDims;                           // 0 (unspecified) .. 8
+  uint64_t numItems;                          // Items in the file
+  uint64_t dims[OO_MPI_IO_MAX_DIMS];          // array shape, if numDims > 0
+  char     userData[OO_MPI_IO_USER_DATA_SIZE];// caller's metadata ('\0'-padded)
+};
 
-protected:
-  void setID(int newID);
-  void setNumPEs(int newNumPEs);
+static_assert(sizeof(OO_MPI_IO_Header) == OO_MPI_IO_HEADER_SIZE,
+              "OO_MPI_IO_Header must be exactly 256 bytes");
 
-  void setNumItemsInFile(long numItemsInFile) {
-        myNumItemsInFile = numItemsInFile;
-  }
-  void setFileSize(MPI_Offset fileSize) {
-        myFileSize = fileSize;
-  }
-  void setChunkSize(long chunkSize) {
-        myChunkSize = chunkSize;
-  }
-  void setFirstItemOffset(long firstItemOffset) {
-        myFirstItemOffset = firstItemOffset; 
-  }
-  void setFirstByteOffset(long firstByteOffset) {
-        myFirstByteOffset = firstByteOffset;
-  }
+/* Codes identifying the type of the Items in a file.
+ * (Types are identified by kind and size, not by C++ name,
+ *  so that e.g. a long written on one platform can be read 
+ *  as a long long on another.)
+ */
+enum OO_MPI_IO_TypeCode {
+  OO_MPI_IO_OTHER = 0,                // a struct, etc.: check size only
+  OO_MPI_IO_CHAR = 1,
+  OO_MPI_IO_INT8, OO_MPI_IO_UINT8,
+  OO_MPI_IO_INT16, OO_MPI_IO_UINT16,
+  OO_MPI_IO_INT32, OO_MPI_IO_UINT32,
+  OO_MPI_IO_INT64, OO_MPI_IO_UINT64,
+  OO_MPI_IO_FLOAT32, OO_MPI_IO_FLOAT64,
+  OO_MPI_IO_BOOL
+};
 
-private:
-  int          myID;                  // thread id or MPI rank
-  int          myNumPEs;              // num threads or MPI processes
-  int          myItemSize;            // size of 1 Item
-  std::string  myFileName;            // file being opened
-  MPI_Datatype myMPIType;             // the MPI equiv of ItemType
-  MPI_File     myFileHandle;          // MPI handle for file 
-  bool         myFinalizeFlag;        // true iff MPI_Init not called
+/* Utility to find the OO_MPI_IO_TypeCode of ItemType
+ * Return: the code of the arithmetic type that matches ItemType,
+ *          or OO_MPI_IO_OTHER.
+ */
+template <class ItemType>
+OO_MPI_IO_TypeCode getTypeCode() {
+   if (std::is_same<ItemType, char>::value) return OO_MPI_IO_CHAR;
+   if (std::is_same<ItemType, bool>::value) return OO_MPI_IO_BOOL;
+   if (std::is_floating_point<ItemType>::value) {
+      switch (sizeof(ItemType)) {
+        case 4: return OO_MPI_IO_FLOAT32;
+        case 8: return OO_MPI_IO_FLOAT64;
+      }
+   } else if (std::is_integral<ItemType>::value) {
+      bool isSigned = std::is_signed<ItemType>::value;
+      switch (sizeof(ItemType)) {
+        case 1: return isSigned ? OO_MPI_IO_INT8  : OO_MPI_IO_UINT8;
+        case 2: return isSigned ? OO_MPI_IO_INT16 : OO_MPI_IO_UINT16;
+        case 4: return isSigned ? OO_MPI_IO_INT32 : OO_MPI_IO_UINT32;
+        case 8: return isSigned ? OO_MPI_IO_INT64 : OO_MPI_IO_UINT64;
+      }
+   }
+   return OO_MPI_IO_OTHER;
+}
 
-  // these attributes are unknown until read or write is called
-  long         myNumItemsInFile;      // total Items to be read
-  MPI_Offset   myFileSize;            // size of file in bytes
-  long         myChunkSize;           // size of my chunk to read
-  long         myFirstItemOffset;     // offset of my chunk (Item #)
-  long         myFirstByteOffset;     // offset of my chunk (byte #)
+/********************************************************************
+ * Byte-order conversion: a file written on a host whose byte order
+ *  differs from ours (e.g., on a big-endian machine, or in MPI's 
+ *  big-endian 'external32' representation) can be read or written
+ *  by reversing the bytes of each Item as it passes through memory.
+ *
+ * swapBytes() does so in place, using AVX2 or SSSE3 byte shuffles
+ *  when the compiler targets them (e.g., with -march=native)
+ *  and a portable scalar loop otherwise.
+ ********************************************************************/
+
+#if defined(__AVX__)
+#include <immintrin.h>               // _mm256_shuffle_epi8(), ...
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>               // _mm_shuffle_epi8(), _mm_crc32_u64()
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>               // _mm_shuffle_epi8(), ...
+#endif
+
+/* How the bytes of each Item in a file are ordered */
+enum ByteOrder {
+  NATIVE_ORDER,              // this host's byte order (no conversion)
+  LITTLE_ENDIAN_ORDER,       // least-significant byte first (x86, ARM)
+  BIG_ENDIAN_ORDER,          // most-significant byte first
+  EXTERNAL32_ORDER           // MPI's portable representation (big-endian)
 };
 
+/* Items are converted this many bytes at a time, so that each window
+ *  can be swapped while the next one is being read or written.
+ */
+const long OO_MPI_IO_SWAP_WINDOW = 1L << 22;
+
+/* Utility to find this host's byte order
+ * Return: LITTLE_ENDIAN_ORDER or BIG_ENDIAN_ORDER.
+ */
+ByteOrder getHostByteOrder() {
+   const uint32_t one = 1;
+   unsigned char firstByte = 0;
+   memcpy(&firstByte, &one, 1);
+   return (firstByte == 1) ? LITTLE_ENDIAN_ORDER : BIG_ENDIAN_ORDER;
+}
+
+/* Utility to reverse the bytes of each of a sequence of Items
+ *  (the scalar version, for any host)
+ * @param: data, the address of the first Item
+ * @param: count, the number of Items
+ * @param: itemSize, the size of each Item in bytes.
+ * Precondition: itemSize is 1, 2, 4 or 8.
+ * Postcondition: the bytes of each Item have been reversed.
+ */
+void swapBytesScalar(void* data, unsigned long count, int itemSize) {
+   unsigned char* bytes = (unsigned char*) data;
+   if (itemSize == 2) {
+      for (unsigned long i = 0; i < count; ++i, bytes += 2) {
+         uint16_t x;
+         memcpy(&x, bytes, 2);
+         x = (uint16_t)((x >> 8) | (x << 8));
+         memcpy(bytes, &x, 2);
+      }
+   } else if (itemSize == 4) {
+      for (unsigned long i = 0; i < count; ++i, bytes += 4) {
+         uint32_t x;
+         memcpy(&x, bytes, 4);
+         x = (x >> 24) | ((x >> 8) & 0x0000FF00u) 
+              | ((x << 8) & 0x00FF0000u) | (x << 24);
+         memcpy(bytes, &x, 4);
+      }
+   } else if (itemSize == 8) {
+      for (unsigned long i = 0; i < count; ++i, bytes += 8) {
+         uint64_t x;
+         memcpy(&x, bytes, 8);
+         x = ((x & 0x00000000FFFFFFFFull) << 32) | (x >> 32);
+         x = ((x & 0x0000FFFF0000FFFFull) << 16) 
+              | ((x >> 16) & 0x0000FFFF0000FFFFull);
+         x = ((x & 0x00FF00FF00FF00FFull) << 8)
+              | ((x >> 8) & 0x00FF00FF00FF00FFull);
+         memcpy(bytes, &x, 8);
+      }
+   }
+}
+
+/* Utility to reverse the bytes of each of a sequence of Items
+ *  (vectorized when the target supports it)
+ * @param: data, the address of the first Item
+ * @param: count, the number of Items
+ * @param: itemSize, the size of each Item in bytes.
+ * Precondition: itemSize is 1, 2, 4 or 8.
+ * Postcondition: the bytes of each Item have been reversed.
+ */
+void swapBytes(void* data, unsigned long count, int itemSize) {
+   if (itemSize != 2 && itemSize != 4 && itemSize != 8) {
+      return;                                     // nothing to reverse
+   }
+   unsigned char* bytes = (unsigned char*) data;
+   unsigned long numBytes = count * itemSize;
+   unsigned long done = 0;
+#if defined(__SSSE3__)
+   // shuffle control: byte j of each 16-byte lane comes from the byte
+   //  at the mirror-image position within j's Item
+   unsigned char control[32];
+   for (int j = 0; j < 32; ++j) {
+      int lanePos = j % 16;
+      control[j] = (lanePos / itemSize) * itemSize 
+                    + (itemSize - 1 - lanePos % itemSize);
+   }
+#endif
+#if defined(__AVX2__)
+   const __m256i control32 = _mm256_loadu_si256((const __m256i*) control);
+   for ( ; done + 64 <= numBytes; done += 64) {     // 2 vectors per trip
+      __m256i x0 = _mm256_loadu_si256((const __m256i*)(bytes + done));
+      __m256i x1 = _mm256_loadu_si256((const __m256i*)(bytes + done + 32));
+      _mm256_storeu_si256((__m256i*)(bytes + done), 
+                           _mm256_shuffle_epi8(x0, control32));
+      _mm256_storeu_si256((__m256i*)(bytes + done + 32), 
+                           _mm256_shuffle_epi8(x1, control32));
+   }
+#endif
+#if defined(__SSSE3__)
+   const __m128i control16 = _mm_loadu_si128((const __m128i*) control);
+   for ( ; done + 16 <= numBytes; done += 16) {
+      __m128i x = _mm_loadu_si128((const __m128i*)(bytes + done));
+      _mm_storeu_si128((__m128i*)(bytes + done), 
+                        _mm_shuffle_epi8(x, control16));
+   }
+#endif
+   swapBytesScalar(bytes + done, (numBytes - done) / itemSize, itemSize);
+}
+
+/********************************************************************
+ * Numeric conversion: a ParallelReader<Stored, Delivered> converts
+ *  the Stored values of a file to the Delivered type (and a 
+ *  ParallelWriter<Stored, Supplied> converts Supplied values to the
+ *  Stored type) a window at a time, as they are transferred, so 
+ *  that a full-size vector of the other type is never needed.
+ *
+ * convertNumbers() converts as if by static_cast; the overloads for
+ *  the common double <-> float and int32 -> int64 conversions use
+ *  AVX/AVX2 instructions when the compiler targets them.
+ ********************************************************************/
+
+/* Utility to convert a sequence of numbers from one type to another
+ * @param: in, the address of the first From value
+ * @param: out, the address of the first To value
+ * @param: count, the number of values.
+ * Postcondition: out[i] == static_cast<To>(in[i]), for 0 <= i < count.
+ */
+template <class From, class To>
+void convertNumbers(const From* in, To* out, unsigned long count) {
+   for (unsigned long i = 0; i < count; ++i) {
+      out[i] = static_cast<To>(in[i]);
+   }
+}
+
+void convertNumbers(const double* in, float* out, unsigned long count) {
+   unsigned long i = 0;
+#if defined(__AVX__)
+   for ( ; i + 4 <= count; i += 4) {
+      _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+   }
+#endif
+   for ( ; i < count; ++i) {
+      out[i] = (float) in[i];
+   }
+}
+
+void convertNumbers(const float* in, double* out, unsigned long count) {
+   unsigned long i = 0;
+#if defined(__AVX__)
+   for ( ; i + 4 <= count; i += 4) {
+      _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+   }
+#endif
+   for ( ; i < count; ++i) {
+      out[i] = in[i];
+   }
+}
+
+void convertNumbers(const int32_t* in, int64_t* out, unsigned long count) {
+   unsigned long i = 0;
+#if defined(__AVX2__)
+   for ( ; i + 4 <= count; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+      _mm256_storeu_si256((__m256i*)(out + i), _mm256_cvtepi32_epi64(x));
+   }
+#endif
+   for ( ; i < count; ++i) {
+      out[i] = in[i];
+   }
+}
+
 /* Utility to check the return-values of MPI-IO function calls
  * @param: result, an int
  * Precondition:  result is the return-value from the last MPI-IO call.
@@ -122,446 +438,9136 @@ void checkResult(int result) {
   }
 }
 
-/* OO_MPI_IO_BASE constructor
- * @param: fileName, a string
- * @param: openMode, an int
- * @param: mpiType, an MPI_Datatype value
- * @param: id, an int
- * @param: numPEs, an int
- * Precondition: fileName is the name of a file containing
- *                binary-format values of type ItemType
- *           &&  openMode is a valid MPI file-opening mode
- *           &&  mpiType is the MPI equivalent of ItemType
- *           &&  id is a thread id or MPI process rank
- *           &&  numPEs is the number of threads or processes.
- * Postcondition: if MPI_Init() has not already been called 
- *                 then MPI_Init_thread() has been called
- *           &&   the file has been opened 1for parallel IO
- *                 as specified by openMode
- *           &&   each instance variable have been initialized
- *                 as appropriate for this PE.
- * Note: It would be cleaner to pass mpiType as a template parameter
- *         but doing so produces errors (at least for OpenMPI and clang),
- *         so this is a hack-ey workaround.
+/********************************************************************
+ * Event tracing: when OO_MPI_IO_TRACE is defined (with 
+ *  -DOO_MPI_IO_TRACE, or before this file is included), each MPI-IO
+ *  operation of a reader or writer (see the timed...() functions
+ *  below), and each phase of ParallelReader and ParallelWriter
+ *  (readChunk(), writePart(), ...), is recorded as an event with its
+ *  start and end times, in a ring buffer belonging to the thread 
+ *  that performed it; saveTrace() merges the events of every thread
+ *  of every process into one Chrome-trace JSON file, which trace
+ *  viewers (e.g., chrome://tracing or Perfetto) show as a timeline
+ *  with a row per process and thread.
+ *
+ * A thread is the only writer of its buffer, so recording an event
+ *  needs no lock (only a thread's first event takes one, to register
+ *  its buffer). When OO_MPI_IO_TRACE is not defined, nothing is
+ *  recorded, and the recording code is not compiled in.
+ ********************************************************************/
+
+#include <atomic>                    // atomic
+#include <mutex>                     // mutex, lock_guard
+#include <cstdio>                    // snprintf()
+
+#if defined(OO_MPI_IO_TRACE)
+const bool OO_MPI_IO_TRACE_ENABLED = true;
+#else
+const bool OO_MPI_IO_TRACE_ENABLED = false;
+#endif
+
+/* Each thread keeps (at most) its most recent this-many events */
+const long OO_MPI_IO_TRACE_EVENTS = 1L << 16;
+
+/* One traced operation or phase */
+struct OO_MPI_IO_TraceEvent {
+  const char* name;                   // e.g. "read" (a string literal)
+  const char* category;               // "io" or "phase"
+  double      start;                  // MPI_Wtime() at its start
+  double      end;                    // MPI_Wtime() at its end
+  uint64_t    bytes;                  // bytes transferred (if any)
+};
+
+/* OO_MPI_IO_TraceBuffer is a thread's ring of its latest events.
  */
-template <class ItemType>
-OO_MPI_IO_Base<ItemType>::
-OO_MPI_IO_Base(const std::string& fileName, int openMode, MPI_Datatype mpiType,
-                int id, int numPEs) {
-   myFileName = fileName;
-   myMPIType = mpiType;
-   myItemSize = sizeof(ItemType);
-   if (id >= 0) { 
-      myID = id; 
-   } else { 
-      fprintf(stderr, "\nOO_MPI_IO_Base(): id must be non-negative\n\n");
-      exit(1);
-   } 
-   if (numPEs > 0) { 
-      myNumPEs = numPEs;
-   } else { 
-      fprintf(stderr, "\nOO_MPI_IO_Base(): numPEs must be positive\n\n");
-      exit(1);
-   } 
+class OO_MPI_IO_TraceBuffer {
+public:
+  OO_MPI_IO_TraceBuffer(int thread, long capacity = OO_MPI_IO_TRACE_EVENTS)
+   : myEvents(capacity), myNumAdded(0), myThread(thread) { }
 
-   // set other attributes to defaults for now
-   myNumItemsInFile = 0;
-   myFileSize = 0;
-   myChunkSize = 0;
-   myFirstItemOffset = 0;
-   myFirstByteOffset = 0;
-   myFinalizeFlag = false;
+  void add(const char* name, const char* category, double start, 
+            double end, uint64_t bytes) {
+        uint64_t n = myNumAdded.load(std::memory_order_relaxed);
+        OO_MPI_IO_TraceEvent& event = myEvents[n % myEvents.size()];
+        event.name = name;
+        event.category = category;
+        event.start = start;
+        event.end = end;
+        event.bytes = bytes;
+        myNumAdded.store(n + 1, std::memory_order_release);
+  }
+  int getThread() const           { return myThread; }
+  long getCapacity() const        { return myEvents.size(); }
+  uint64_t getNumAdded() const    { return myNumAdded.load(); }
+  long getNumEvents() const       { return std::min<uint64_t>(getNumAdded(),
+                                                       myEvents.size()); }
+  uint64_t getNumDropped() const  { return getNumAdded() - getNumEvents(); }
+  /* the i-th oldest event that is still held (0 <= i < getNumEvents()) */
+  const OO_MPI_IO_TraceEvent& getEvent(long i) const {
+        return myEvents[ (getNumDropped() + i) % myEvents.size() ];
+  }
+  void clear()                    { myNumAdded.store(0); }
 
-   // for OpenMP: the main thread needs to call MPI_Init_thread()
-   int mpiInitFlag = 0;
-   MPI_Initialized(&mpiInitFlag);                    // was MPI_Init() called?
-   if (!mpiInitFlag) {                               // if no: assume OpenMP;
-      //pthread_barrier_t barrier;                   //  if using Pthreads,
-      //pthread_barrier_init(&barrier, NULL, numPEs);//   uncomment these lines
-                                                     //   and the 2 below
-      if (id == 0) {                                 //  if main thread:
-        int modeProvided = 0;                        //   call MPI_Init_thread()
-        int initResult = MPI_Init_thread(0, 0,       //   so any thread can make
-                                MPI_THREAD_MULTIPLE, //   MPI calls
-                                &modeProvided);     
-        checkResult(initResult);
-        myFinalizeFlag = true;                       // set flag for destructor
-      }
-                                                     // make threads wait 'til
-      #pragma omp barrier                            //  MPI_Init_thread done
-                                                     //  or MPI_File_open may fail
-      //pthread_barrier_wait(&barrier);              // replace omp barrier with
-      //pthread_barrier_destroy(&barrier);           //  these to use Pthreads
+private:
+  std::vector<OO_MPI_IO_TraceEvent> myEvents;   // the ring
+  std::atomic<uint64_t>             myNumAdded; // events ever added
+  int                               myThread;   // order of registration
+};
+
+/* Utilities to access this process's trace buffers
+ * Return: all of them (in order of registration), or its mutex.
+ * Note: The buffers are never deleted, so that the events of
+ *        threads that have exited can still be saved.
+ */
+std::vector<OO_MPI_IO_TraceBuffer*>& getTraceBuffers() {
+   static std::vector<OO_MPI_IO_TraceBuffer*> buffers;
+   return buffers;
+}
+
+std::mutex& getTraceMutex() {
+   static std::mutex traceMutex;
+   return traceMutex;
+}
+
+/* Utility to find the calling thread's trace buffer
+ * Return: the buffer (which is registered on the thread's first call).
+ */
+OO_MPI_IO_TraceBuffer* getMyTraceBuffer() {
+   static thread_local OO_MPI_IO_TraceBuffer* myBuffer = NULL;
+   if (myBuffer == NULL) {
+      std::lock_guard<std::mutex> lock( getTraceMutex() );
+      std::vector<OO_MPI_IO_TraceBuffer*>& buffers = getTraceBuffers();
+      myBuffer = new OO_MPI_IO_TraceBuffer(buffers.size());
+      buffers.push_back(myBuffer);
    }
+   return myBuffer;
+}
 
-   int openResult = MPI_File_open( MPI_COMM_WORLD,    // communicator
-                                    fileName.c_str(), // name of file
-                                    openMode,         // mode parameter
-                                    MPI_INFO_NULL,    // skip this
-                                    &myFileHandle );  // MPI handle
-   checkResult(openResult);
+/* Utility to discard this process's trace events (e.g., before
+ *  the part of a run that is to be traced)
+ * Precondition: no other thread is recording events.
+ * Postcondition: each of this process's trace buffers is empty.
+ */
+void clearTrace() {
+   std::lock_guard<std::mutex> lock( getTraceMutex() );
+   std::vector<OO_MPI_IO_TraceBuffer*>& buffers = getTraceBuffers();
+   for (unsigned long b = 0; b < buffers.size(); ++b) {
+      buffers[b]->clear();
+   }
 }
 
-/* parameter-checking setter methods for id, numPEs
+/* OO_MPI_IO_TraceSpan records a phase (from its construction to
+ *  the end of its scope) in the calling thread's trace buffer.
+ * (It is empty unless OO_MPI_IO_TRACE is defined.)
  */
-template <class ItemType>
-void OO_MPI_IO_Base<ItemType>::setID(int newID) {
-   if (newID < 0) {
-      fprintf(stderr, "\nOO_MPI_IO_Base::setID(): bad id (%d)\n\n", newID);
-      exit(1);
+class OO_MPI_IO_TraceSpan {
+public:
+#if defined(OO_MPI_IO_TRACE)
+  OO_MPI_IO_TraceSpan(const char* name) : myName(name) { 
+        myStart = MPI_Wtime();
+  }
+  ~OO_MPI_IO_TraceSpan() {
+        getMyTraceBuffer()->add(myName, "phase", myStart, MPI_Wtime(), 0);
+  }
+
+private:
+  const char* myName;                 // a string literal
+  double      myStart;                // MPI_Wtime() at the start
+#else
+  OO_MPI_IO_TraceSpan(const char*) { }
+#endif
+};
+
+/* Utility to format one Chrome-trace event
+ * @param: out, the string to append the event to
+ * @param: event, the event
+ * @param: process, the rank of the process that recorded it
+ * @param: thread, the thread that recorded it
+ * @param: zero, the (local) MPI_Wtime() that is time 0 in the trace.
+ */
+void formatTraceEvent(std::string& out, const OO_MPI_IO_TraceEvent& event,
+                       int process, int thread, double zero) {
+   char text[256];
+   snprintf(text, sizeof(text), "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+             "\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+             "\"args\":{\"bytes\":%llu}},\n", event.name, event.category,
+             process, thread, (event.start - zero) * 1e6,
+             (event.end - event.start) * 1e6, 
+             (unsigned long long) event.bytes);
+   out += text;
+}
+
+/* Utility to write every PE's trace events to a Chrome-trace file
+ * @param: fileName, the name of the (JSON) file.
+ * Precondition: every MPI process calls this, from one thread,
+ *                after its threads have finished their I/O
+ *                (e.g., just before MPI_Finalize()).
+ * Postcondition: fileName holds the events in each trace buffer of
+ *                 each process, as complete ("X") events whose pid is
+ *                 the process's rank and whose tid is the thread's
+ *                 buffer, plus the names of the processes and threads
+ *                 (with the number of events each thread dropped).
+ *             && the buffers are empty.
+ * Note: Each process's times are shifted so that all the processes
+ *        leave a barrier at the same time (as MPI_Wtime() need not be
+ *        synchronized), and then so that the first event is at 0.
+ *       This is a collective call (MPI_Barrier(), MPI_Allreduce(),
+ *        MPI_Exscan(), MPI_File_open()).
+ */
+void saveTrace(const std::string& fileName) {
+   int rank = 0, numProcs = 1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Barrier(MPI_COMM_WORLD);
+   double myZero = MPI_Wtime();
+   std::lock_guard<std::mutex> lock( getTraceMutex() );
+   std::vector<OO_MPI_IO_TraceBuffer*>& buffers = getTraceBuffers();
+
+   // find the earliest event (relative to the barrier)
+   double myFirst = 0, first = 0;
+   for (unsigned long b = 0; b < buffers.size(); ++b) {
+      if (buffers[b]->getNumEvents() > 0) {
+         myFirst = std::min(myFirst, buffers[b]->getEvent(0).start - myZero);
+      }
    }
-   myID = newID;
+   MPI_Allreduce(&myFirst, &first, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+   double zero = myZero + first;
+
+   // format my events (each ends with ",\n", except the last one's)
+   std::string text = (rank == 0) ? "{\"traceEvents\":[\n" : "";
+   char line[256];
+   snprintf(line, sizeof(line), "{\"name\":\"process_name\",\"ph\":\"M\","
+             "\"pid\":%d,\"args\":{\"name\":\"process %d\"}},\n", rank, rank);
+   text += line;
+   for (unsigned long b = 0; b < buffers.size(); ++b) {
+      const OO_MPI_IO_TraceBuffer& buffer = *buffers[b];
+      snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\","
+                "\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\","
+                "\"dropped\":%llu}},\n", rank, buffer.getThread(),
+                buffer.getThread(), (unsigned long long) buffer.getNumDropped());
+      text += line;
+      for (long i = 0; i < buffer.getNumEvents(); ++i) {
+         formatTraceEvent(text, buffer.getEvent(i), rank, 
+                           buffer.getThread(), zero);
+      }
+      buffers[b]->clear();
+   }
+   if (rank == numProcs - 1) {
+      text.resize(text.size() - 2);                 // the last ",\n"
+      text += "\n],\"displayTimeUnit\":\"ms\"}\n";
+   }
+
+   // write them after those of the lower ranks
+   uint64_t myBytes = text.size(), before = 0;
+   MPI_Exscan(&myBytes, &before, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+   if (rank == 0) before = 0;
+   MPI_File fh;
+   int result = MPI_File_open(MPI_COMM_WORLD, fileName.c_str(),
+                               MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                               MPI_INFO_NULL, &fh);
+   checkResult(result);
+   MPI_File_set_size(fh, 0);                                  // truncate
+   MPI_Status status;
+   for (uint64_t done = 0; done < myBytes; done += INT_MAX) {
+      int count = std::min<uint64_t>(INT_MAX, myBytes - done);
+      result = MPI_File_write_at(fh, before + done, text.data() + done, 
+                                  count, MPI_CHAR, &status);
+      checkResult(result);
+   }
+   MPI_File_close(&fh);
+}
+
+/********************************************************************
+ * I/O statistics: when OO_MPI_IO_STATS is defined (with 
+ *  -DOO_MPI_IO_STATS, or before this file is included), each reader
+ *  and writer counts the calls, bytes and wall time of the MPI-IO
+ *  operations it performs (on its file and its sidecar files),
+ *  by kind of operation, and OO_MPI_IO_Base::reduceStats() 
+ *  summarizes them over the PEs.
+ *
+ * The timed...() functions below wrap the MPI-IO calls;
+ *  when OO_MPI_IO_STATS is not defined, the counters are not stored
+ *  and the wrappers just make the calls, so the statistics cost nothing.
+ ********************************************************************/
+
+#if defined(OO_MPI_IO_STATS)
+const bool OO_MPI_IO_STATS_ENABLED = true;
+#else
+const bool OO_MPI_IO_STATS_ENABLED = false;
+#endif
+
+/* The kinds of MPI-IO operations that are counted */
+enum OO_MPI_IO_Operation {
+  OPEN_OP,                   // MPI_File_open()
+  SIZE_OP,                   // MPI_File_get_size()
+  READ_OP,                   // MPI_File_read...() (and waits for them)
+  WRITE_OP,                  // MPI_File_write...() (and waits for them)
+  TRUNCATE_OP,               // MPI_File_set_size()
+  CLOSE_OP                   // MPI_File_close()
+};
+
+const int OO_MPI_IO_NUM_OPERATIONS = 6;
+
+/* Their names, in traces */
+const char* const OO_MPI_IO_OPERATION_NAMES[OO_MPI_IO_NUM_OPERATIONS] = 
+               { "open", "size", "read", "write", "truncate", "close" };
+
+/* The counters of one kind of operation */
+struct OO_MPI_IO_OpStats {
+  uint64_t calls;                     // operations begun
+  uint64_t bytes;                     // bytes asked to read or write
+  double   seconds;                   // wall time spent in them
+};
+
+/* A PE's counters, indexed by OO_MPI_IO_Operation */
+struct OO_MPI_IO_Stats {
+  OO_MPI_IO_OpStats ops[OO_MPI_IO_NUM_OPERATIONS];
+};
+
+/* The counters of one kind of operation, summarized over the PEs */
+struct OO_MPI_IO_OpSummary {
+  double minCalls, maxCalls, meanCalls;           // per PE
+  double minBytes, maxBytes, meanBytes;           // per PE
+  double minSeconds, maxSeconds, meanSeconds;     // per PE
+  double aggregateBandwidth;          // all PEs' bytes / maxSeconds
+  std::vector<double> bandwidths;     // each PE's bytes / seconds, by id
+};
+
+/* OO_MPI_IO_Timer adds an operation to a PE's counters (and to
+ *  the thread's trace) when it goes out of scope, i.e., after 
+ *  the call it times. 
+ * (It is empty unless OO_MPI_IO_STATS or OO_MPI_IO_TRACE is defined.)
+ */
+class OO_MPI_IO_Timer {
+public:
+#if defined(OO_MPI_IO_STATS) || defined(OO_MPI_IO_TRACE)
+  OO_MPI_IO_Timer(OO_MPI_IO_Stats* stats, OO_MPI_IO_Operation op, 
+                   int count = 0, MPI_Datatype type = MPI_BYTE, 
+                   uint64_t calls = 1) 
+   : myStats(stats), myOp(op), myCalls(calls), myBytes(0) {
+        if (count > 0) {
+           int typeSize = 0;
+           MPI_Type_size(type, &typeSize);
+           myBytes = (uint64_t) count * typeSize;
+        }
+        myStart = MPI_Wtime();
+  }
+  ~OO_MPI_IO_Timer() {
+        double end = MPI_Wtime();
+        if (myStats != NULL) {
+           OO_MPI_IO_OpStats& counters = myStats->ops[myOp];
+           counters.calls += myCalls;
+           counters.bytes += myBytes;
+           counters.seconds += end - myStart;
+        }
+#if defined(OO_MPI_IO_TRACE)
+        const char* name = (myCalls > 0) ? OO_MPI_IO_OPERATION_NAMES[myOp] 
+                                         : "wait";
+        getMyTraceBuffer()->add(name, "io", myStart, end, myBytes);
+#endif
+  }
+
+private:
+  OO_MPI_IO_Stats*    myStats;        // the counters (or NULL)
+  OO_MPI_IO_Operation myOp;           // the kind of operation
+  uint64_t            myCalls;        // 1, or 0 for a wait
+  uint64_t            myBytes;        // bytes transferred
+  double              myStart;        // MPI_Wtime() at the start
+#else
+  OO_MPI_IO_Timer(OO_MPI_IO_Stats*, OO_MPI_IO_Operation, 
+                   int = 0, MPI_Datatype = MPI_BYTE, uint64_t = 1) { }
+#endif
+};
+
+/* Utilities to make (and count) MPI-IO calls
+ * @param: stats, the counters of the calling PE (or NULL, to not count)
+ * @param: the remaining parameters are those of the MPI-IO function.
+ * Return: the result of the MPI-IO function.
+ * Note: A nonblocking read or write is counted when it is begun;
+ *        the time spent waiting for it is added by timedWait()
+ *        or timedWaitall().
+ */
+int timedOpen(OO_MPI_IO_Stats* stats, MPI_Comm comm, const char* fileName,
+               int openMode, MPI_Info info, MPI_File* fh) {
+   OO_MPI_IO_Timer timer(stats, OPEN_OP);
+   return MPI_File_open(comm, fileName, openMode, info, fh);
+}
+
+int timedClose(OO_MPI_IO_Stats* stats, MPI_File* fh) {
+   OO_MPI_IO_Timer timer(stats, CLOSE_OP);
+   return MPI_File_close(fh);
+}
+
+int timedGetSize(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset* size) {
+   OO_MPI_IO_Timer timer(stats, SIZE_OP);
+   return MPI_File_get_size(fh, size);
+}
+
+int timedSetSize(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset size) {
+   OO_MPI_IO_Timer timer(stats, TRUNCATE_OP);
+   return MPI_File_set_size(fh, size);
+}
+
+int timedReadAt(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset offset,
+                 void* buffer, int count, MPI_Datatype type, 
+                 MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, READ_OP, count, type);
+   return MPI_File_read_at(fh, offset, buffer, count, type, status);
+}
+
+int timedRead(OO_MPI_IO_Stats* stats, MPI_File fh, void* buffer, 
+               int count, MPI_Datatype type, MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, READ_OP, count, type);
+   return MPI_File_read(fh, buffer, count, type, status);
+}
+
+int timedReadAll(OO_MPI_IO_Stats* stats, MPI_File fh, void* buffer, 
+                  int count, MPI_Datatype type, MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, READ_OP, count, type);
+   return MPI_File_read_all(fh, buffer, count, type, status);
+}
+
+int timedReadAtAll(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset offset,
+                    void* buffer, int count, MPI_Datatype type, 
+                    MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, READ_OP, count, type);
+   return MPI_File_read_at_all(fh, offset, buffer, count, type, status);
+}
+
+int timedIreadAt(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset offset,
+                  void* buffer, int count, MPI_Datatype type, 
+                  MPI_Request* request) {
+   OO_MPI_IO_Timer timer(stats, READ_OP, count, type);
+   return MPI_File_iread_at(fh, offset, buffer, count, type, request);
+}
+
+int timedWriteAt(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset offset,
+                  const void* buffer, int count, MPI_Datatype type, 
+                  MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, WRITE_OP, count, type);
+   return MPI_File_write_at(fh, offset, buffer, count, type, status);
+}
+
+int timedWrite(OO_MPI_IO_Stats* stats, MPI_File fh, const void* buffer, 
+                int count, MPI_Datatype type, MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, WRITE_OP, count, type);
+   return MPI_File_write(fh, buffer, count, type, status);
+}
+
+int timedWriteAll(OO_MPI_IO_Stats* stats, MPI_File fh, const void* buffer, 
+                   int count, MPI_Datatype type, MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, WRITE_OP, count, type);
+   return MPI_File_write_all(fh, buffer, count, type, status);
+}
+
+int timedWriteAtAll(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset offset,
+                     const void* buffer, int count, MPI_Datatype type, 
+                     MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, WRITE_OP, count, type);
+   return MPI_File_write_at_all(fh, offset, buffer, count, type, status);
+}
+
+int timedIwriteAt(OO_MPI_IO_Stats* stats, MPI_File fh, MPI_Offset offset,
+                   const void* buffer, int count, MPI_Datatype type, 
+                   MPI_Request* request) {
+   OO_MPI_IO_Timer timer(stats, WRITE_OP, count, type);
+   return MPI_File_iwrite_at(fh, offset, buffer, count, type, request);
+}
+
+int timedWait(OO_MPI_IO_Stats* stats, OO_MPI_IO_Operation op, 
+               MPI_Request* request, MPI_Status* status) {
+   OO_MPI_IO_Timer timer(stats, op, 0, MPI_BYTE, 0);
+   return MPI_Wait(request, status);
+}
+
+int timedWaitall(OO_MPI_IO_Stats* stats, OO_MPI_IO_Operation op, 
+                  int count, MPI_Request* requests, MPI_Status* statuses) {
+   OO_MPI_IO_Timer timer(stats, op, 0, MPI_BYTE, 0);
+   return MPI_Waitall(count, requests, statuses);
+}
+
+/********************************************************************
+ * I/O tuning profiles: the parameters that suit a file system best
+ *  (collective vs. independent reads and writes, the MPI-IO hints 
+ *  for the number of aggregators, the collective buffer size and 
+ *  the alignment, and the window size) can be recorded in a profile,
+ *  kept in a small text file (see getProfilesFileName()) that has
+ *  one line per mount point, e.g.:
+ *
+ *  /scratch collective=1 aggregators=8 bufferBytes=16777216 ...
+ *
+ * Each reader and writer uses the profile of the file system its
+ *  file is on (if there is one), so a profile that autotune() (or
+ *  tools/autotune) finds by probing a file system, and saves, tunes
+ *  the later programs that use it. Without a profile, readers and
+ *  writers work as they always have.
+ ********************************************************************/
+
+#include <cstdlib>                   // getenv(), realpath(), free()
+
+/* The parameters of a profile (0 or false: the default) */
+struct OO_MPI_IO_Profile {
+  bool collective;          // collective readChunk() and writeChunk()?
+  long aggregators;         // the "cb_nodes" hint
+  long bufferBytes;         // the "cb_buffer_size" hint
+  long alignment;           // the "striping_unit" hint
+  long windowBytes;         // the most bytes per read or write call
+};
+
+const int OO_MPI_IO_PROFILE_LINE = 1024;     // max chars per profile line
+
+bool operator==(const OO_MPI_IO_Profile& left, 
+                 const OO_MPI_IO_Profile& right) {
+   return left.collective == right.collective && 
+           left.aggregators == right.aggregators &&
+           left.bufferBytes == right.bufferBytes && 
+           left.alignment == right.alignment &&
+           left.windowBytes == right.windowBytes;
+}
+
+/* Utility to find the file that holds the profiles
+ * Return: the value of the OO_MPI_IO_PROFILES environment variable,
+ *          if it is set; otherwise $HOME/.oo_mpi_io_profiles
+ *          (or ./.oo_mpi_io_profiles, if HOME is not set).
+ */
+std::string getProfilesFileName() {
+   const char* name = getenv("OO_MPI_IO_PROFILES");
+   if (name != NULL && name[0] != '\0') {
+      return name;
+   }
+   const char* home = getenv("HOME");
+   return std::string( (home != NULL) ? home : "." ) + "/.oo_mpi_io_profiles";
+}
+
+/* Utility to find the mount point of the file system a file is on
+ * @param: fileName, the name of a file (which need not exist yet).
+ * Return: the longest mount point in /proc/mounts that contains
+ *          the file's directory (or "/" if there is no such table).
+ */
+std::string getMountPoint(const std::string& fileName) {
+   size_t slash = fileName.find_last_of('/');
+   std::string directory = (slash == std::string::npos) ? "." 
+                          : fileName.substr(0, std::max<size_t>(slash, 1));
+   char* resolved = realpath(directory.c_str(), NULL);
+   std::string path = (resolved != NULL) ? resolved : directory;
+   free(resolved);
+
+   std::string best = "/";
+   FILE* mounts = fopen("/proc/mounts", "r");
+   if (mounts == NULL) {
+      return best;
+   }
+   char line[OO_MPI_IO_PROFILE_LINE], mountPoint[OO_MPI_IO_PROFILE_LINE];
+   while (fgets(line, sizeof(line), mounts) != NULL) {
+      if (sscanf(line, "%*s %1023s", mountPoint) != 1) continue;
+      size_t length = strlen(mountPoint);
+      bool contains = path.compare(0, length, mountPoint) == 0 &&
+                       (path.size() == length || path[length] == '/');
+      if (contains && length > best.size()) {
+         best = mountPoint;
+      }
+   }
+   fclose(mounts);
+   return best;
+}
+
+/* Utilities to convert a profile to and from a line of the profiles file
+ * @param: line, a line of the file
+ * @param: mountPoint, the mount point the profile is for
+ * @param: profile, the profile.
+ * Return (parseProfile()): true, with mountPoint and profile set, 
+ *          iff line is not blank or a comment (one that begins with '#');
+ *          parameters it does not name are 0 (and unknown ones are ignored).
+ * Return (formatProfile()): the line (ending with a newline).
+ */
+bool parseProfile(const char* line, std::string& mountPoint, 
+                   OO_MPI_IO_Profile& profile) {
+   char word[OO_MPI_IO_PROFILE_LINE];
+   int used = 0;
+   if (sscanf(line, "%1023s%n", word, &used) != 1 || word[0] == '#') {
+      return false;
+   }
+   mountPoint = word;
+   profile = OO_MPI_IO_Profile();
+   char key[64];
+   long long value = 0;
+   for (line += used; 
+         sscanf(line, " %63[^= \t\n]=%lld%n", key, &value, &used) == 2; 
+         line += used) {
+      if (strcmp(key, "collective") == 0)       profile.collective = (value != 0);
+      else if (strcmp(key, "aggregators") == 0) profile.aggregators = value;
+      else if (strcmp(key, "bufferBytes") == 0) profile.bufferBytes = value;
+      else if (strcmp(key, "alignment") == 0)   profile.alignment = value;
+      else if (strcmp(key, "windowBytes") == 0) profile.windowBytes = value;
+   }
+   return true;
+}
+
+std::string formatProfile(const std::string& mountPoint, 
+                           const OO_MPI_IO_Profile& profile) {
+   char line[OO_MPI_IO_PROFILE_LINE];
+   snprintf(line, sizeof(line), "%s collective=%d aggregators=%ld"
+             " bufferBytes=%ld alignment=%ld windowBytes=%ld\n", 
+             mountPoint.c_str(), (int) profile.collective, profile.aggregators,
+             profile.bufferBytes, profile.alignment, profile.windowBytes);
+   return line;
+}
+
+/* A process's profiles (by mount point), read from the profiles file
+ *  when first needed (and guarded by getProfileMutex()).
+ */
+struct OO_MPI_IO_ProfileTable {
+  bool loaded;                                    // file read yet?
+  std::unordered_map<std::string, OO_MPI_IO_Profile> profiles;
+};
+
+OO_MPI_IO_ProfileTable& getProfileTable() {
+   static OO_MPI_IO_ProfileTable table = OO_MPI_IO_ProfileTable();
+   return table;
+}
+
+std::mutex& getProfileMutex() {
+   static std::mutex mutex;
+   return mutex;
+}
+
+/* Utility to read the profiles file (if there is one) into a table
+ * Precondition: the caller holds getProfileMutex().
+ */
+void loadProfiles(OO_MPI_IO_ProfileTable& table) {
+   table.loaded = true;
+   FILE* in = fopen(getProfilesFileName().c_str(), "r");
+   if (in == NULL) {
+      return;                                     // no profiles
+   }
+   char line[OO_MPI_IO_PROFILE_LINE];
+   std::string mountPoint;
+   OO_MPI_IO_Profile profile;
+   while (fgets(line, sizeof(line), in) != NULL) {
+      if ( parseProfile(line, mountPoint, profile) ) {
+         table.profiles[mountPoint] = profile;
+      }
+   }
+   fclose(in);
+}
+
+/* Utility to find the profile of the file system a file is on
+ * @param: fileName, the name of a file.
+ * Return: the profile of getMountPoint(fileName), from the profiles
+ *          file or setProfileFor(), or else the default profile.
+ * Note: The profiles file is read once per process (or once after
+ *        each clearProfiles()); when it has no profiles, the mount
+ *        table is not read either.
+ */
+OO_MPI_IO_Profile getProfileFor(const std::string& fileName) {
+   std::lock_guard<std::mutex> lock( getProfileMutex() );
+   OO_MPI_IO_ProfileTable& table = getProfileTable();
+   if ( !table.loaded ) {
+      loadProfiles(table);
+   }
+   if ( table.profiles.empty() ) {
+      return OO_MPI_IO_Profile();
+   }
+   auto found = table.profiles.find( getMountPoint(fileName) );
+   return (found != table.profiles.end()) ? found->second 
+                                          : OO_MPI_IO_Profile();
+}
+
+/* Utility to have this process use a profile for a file system
+ * @param: fileName, the name of a file on the file system
+ * @param: profile, the profile.
+ * Postcondition: getProfileFor() returns profile for files on the same
+ *                 file system (until clearProfiles()); the profiles
+ *                 file is unchanged (see saveProfile()).
+ */
+void setProfileFor(const std::string& fileName, 
+                    const OO_MPI_IO_Profile& profile) {
+   std::lock_guard<std::mutex> lock( getProfileMutex() );
+   OO_MPI_IO_ProfileTable& table = getProfileTable();
+   if ( !table.loaded ) {
+      loadProfiles(table);
+   }
+   table.profiles[ getMountPoint(fileName) ] = profile;
+}
+
+/* Utility to forget this process's profiles
+ * Postcondition: the next getProfileFor() reads the profiles file again.
+ */
+void clearProfiles() {
+   std::lock_guard<std::mutex> lock( getProfileMutex() );
+   OO_MPI_IO_ProfileTable& table = getProfileTable();
+   table.loaded = false;
+   table.profiles.clear();
+}
+
+/* Utility to save a profile in the profiles file
+ * @param: mountPoint, a mount point (see getMountPoint())
+ * @param: profile, its profile.
+ * Postcondition: the profiles file's line for mountPoint (if any)
+ *                 has been replaced by one for profile, and its 
+ *                 other lines are unchanged.
+ * Note: The new file is written beside the old one and renamed over
+ *        it, so readers never see a partial file. 
+ *       This is not a collective call: one process should make it.
+ */
+void saveProfile(const std::string& mountPoint, 
+                  const OO_MPI_IO_Profile& profile) {
+   std::string fileName = getProfilesFileName();
+   std::string text = "# OO_MPI_IO tuning profiles:"
+                       " <mount point> <parameter>=<value> ...\n";
+   FILE* in = fopen(fileName.c_str(), "r");
+   if (in != NULL) {
+      text.clear();
+      char line[OO_MPI_IO_PROFILE_LINE];
+      std::string oldMountPoint;
+      OO_MPI_IO_Profile oldProfile;
+      while (fgets(line, sizeof(line), in) != NULL) {
+         if ( !parseProfile(line, oldMountPoint, oldProfile) ||
+               oldMountPoint != mountPoint ) {
+            text += line;
+         }
+      }
+      fclose(in);
+   }
+   text += formatProfile(mountPoint, profile);
+
+   std::string tempName = fileName + ".tmp";
+   FILE* out = fopen(tempName.c_str(), "w");
+   bool ok = (out != NULL);
+   if (ok) {
+      ok = fputs(text.c_str(), out) >= 0;
+      ok = (fclose(out) == 0) && ok;
+   }
+   if ( !ok || rename(tempName.c_str(), fileName.c_str()) != 0 ) {
+      fprintf(stderr, "\nsaveProfile(): cannot write '%s'\n\n", 
+                      fileName.c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+}
+
+/* Utility to make the MPI-IO hints of a profile
+ * @param: profile, a profile.
+ * Return: an MPI_Info holding the profile's (non-0) hints,
+ *          or MPI_INFO_NULL if it has none.
+ * Postcondition: the caller must free the MPI_Info (if it is not 
+ *                 MPI_INFO_NULL), after using it to open a file.
+ */
+MPI_Info makeProfileInfo(const OO_MPI_IO_Profile& profile) {
+   const char* keys[3] = { "cb_nodes", "cb_buffer_size", "striping_unit" };
+   long values[3] = { profile.aggregators, profile.bufferBytes, 
+                      profile.alignment };
+   MPI_Info info = MPI_INFO_NULL;
+   for (int k = 0; k < 3; ++k) {
+      if (values[k] <= 0) continue;
+      if (info == MPI_INFO_NULL) {
+         MPI_Info_create(&info);
+      }
+      char value[32];
+      snprintf(value, sizeof(value), "%ld", values[k]);
+      MPI_Info_set(info, keys[k], value);
+   }
+   return info;
+}
+
+/********************************************************************
+ * Integrity checking: a ParallelWriter can record a CRC32C checksum
+ *  of each fixed-size block of a file's Items in a sidecar file
+ *  (the file's name plus ".crc"), which a ParallelReader can then
+ *  use to verify each block as it is read.
+ *
+ * crc32c() uses the SSE 4.2 crc32 instruction when the compiler
+ *  targets it (e.g., with -march=native) and a portable slice-by-8
+ *  table lookup otherwise.
+ ********************************************************************/
+
+const uint32_t OO_MPI_IO_CRC32C_POLY = 0x82F63B78;  // reversed Castagnoli
+const long     OO_MPI_IO_CRC_BLOCK_SIZE = 1L << 20; // default block bytes
+const char     OO_MPI_IO_CRC_MAGIC[8] = {'O','O','M','P','I','C','R','C'};
+
+/* The beginning of a sidecar file; one uint32_t CRC per block follows.
+ */
+struct OO_MPI_IO_CrcPrologue {
+  char     magic[8];                  // OO_MPI_IO_CRC_MAGIC
+  uint32_t version;                   // sidecar format (1)
+  uint32_t byteOrderMark;             // OO_MPI_IO_BYTE_ORDER_MARK
+  uint64_t blockBytes;                // bytes per block (the last may be short)
+  uint64_t dataOffset;                // where the blocks begin in the file
+  uint64_t dataBytes;                 // bytes of Items the blocks cover
+};
+
+/* utility to build the 8 slice-by-8 lookup tables
+ * Return: a vector whose [k*256 + b] entry is the CRC contribution of
+ *          byte value b followed by k zero bytes.
+ */
+std::vector<uint32_t> makeCrc32cTables() {
+   std::vector<uint32_t> table(8 * 256);
+   for (uint32_t b = 0; b < 256; ++b) {
+      uint32_t crc = b;
+      for (int bit = 0; bit < 8; ++bit) {
+         crc = (crc & 1) ? (crc >> 1) ^ OO_MPI_IO_CRC32C_POLY : crc >> 1;
+      }
+      table[b] = crc;
+   }
+   for (int k = 1; k < 8; ++k) {
+      for (int b = 0; b < 256; ++b) {
+         uint32_t previous = table[(k-1) * 256 + b];
+         table[k * 256 + b] = (previous >> 8) ^ table[previous & 0xFF];
+      }
+   }
+   return table;
+}
+
+/* Utility to compute a CRC32C checksum (the portable version)
+ * @param: data, the address of the bytes
+ * @param: numBytes, the number of bytes
+ * @param: crc, the checksum of the preceding bytes (default 0).
+ * Return: the CRC32C of the preceding bytes followed by these.
+ */
+uint32_t crc32cScalar(const void* data, unsigned long numBytes,
+                       uint32_t crc = 0) {
+   static const std::vector<uint32_t> table = makeCrc32cTables();
+   const uint32_t* t = table.data();
+   const unsigned char* bytes = (const unsigned char*) data;
+   crc = ~crc;
+   if (getHostByteOrder() == LITTLE_ENDIAN_ORDER) {
+      for ( ; numBytes >= 8; numBytes -= 8, bytes += 8) {
+         uint32_t low, high;
+         memcpy(&low, bytes, 4);
+         memcpy(&high, bytes + 4, 4);
+         low ^= crc;
+         crc = t[7*256 + (low & 0xFF)] ^ t[6*256 + ((low >> 8) & 0xFF)]
+             ^ t[5*256 + ((low >> 16) & 0xFF)] ^ t[4*256 + (low >> 24)]
+             ^ t[3*256 + (high & 0xFF)] ^ t[2*256 + ((high >> 8) & 0xFF)]
+             ^ t[1*256 + ((high >> 16) & 0xFF)] ^ t[high >> 24];
+      }
+   }
+   for ( ; numBytes > 0; --numBytes, ++bytes) {
+      crc = t[(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+   }
+   return ~crc;
+}
+
+/* Utility to compute a CRC32C checksum, 8 bytes per crc32 
+ *  instruction when SSE 4.2 is available
+ * (see crc32cScalar() for the parameters).
+ */
+uint32_t crc32c(const void* data, unsigned long numBytes, uint32_t crc = 0) {
+#if defined(__SSE4_2__)
+   const unsigned char* bytes = (const unsigned char*) data;
+   uint64_t crc64 = (uint32_t) ~crc;
+   for ( ; numBytes >= 8; numBytes -= 8, bytes += 8) {
+      uint64_t word;
+      memcpy(&word, bytes, 8);
+      crc64 = _mm_crc32_u64(crc64, word);
+   }
+   uint32_t crc32 = (uint32_t) crc64;
+   for ( ; numBytes > 0; --numBytes, ++bytes) {
+      crc32 = _mm_crc32_u8(crc32, *bytes);
+   }
+   return ~crc32;
+#else
+   return crc32cScalar(data, numBytes, crc);
+#endif
+}
+
+/* utility to multiply a vector by a 32x32 matrix over GF(2)
+ */
+uint32_t gf2MatrixTimes(const uint32_t* matrix, uint32_t vector) {
+   uint32_t sum = 0;
+   for ( ; vector != 0; vector >>= 1, ++matrix) {
+      if (vector & 1) sum ^= *matrix;
+   }
+   return sum;
+}
+
+/* utility to square a 32x32 matrix over GF(2)
+ */
+void gf2MatrixSquare(uint32_t* square, const uint32_t* matrix) {
+   for (int n = 0; n < 32; ++n) {
+      square[n] = gf2MatrixTimes(matrix, matrix[n]);
+   }
+}
+
+/* Utility to combine the checksums of two adjacent byte sequences
+ * @param: crc1, the CRC32C of the first sequence
+ * @param: crc2, the CRC32C of the second sequence
+ * @param: length2, the length of the second sequence.
+ * Return: the CRC32C of the first sequence followed by the second
+ *          (computed in O(log length2) time, without the bytes).
+ */
+uint32_t crc32cCombine(uint32_t crc1, uint32_t crc2, uint64_t length2) {
+   if (length2 == 0) {
+      return crc1;
+   }
+   uint32_t even[32], odd[32];          // operators for 2^k zero bits
+   odd[0] = OO_MPI_IO_CRC32C_POLY;      //  (odd: one zero bit)
+   for (int n = 1; n < 32; ++n) {
+      odd[n] = 1u << (n - 1);
+   }
+   gf2MatrixSquare(even, odd);          // two zero bits
+   gf2MatrixSquare(odd, even);          // four zero bits
+   do {                                 // apply length2 zero bytes to crc1
+      gf2MatrixSquare(even, odd);
+      if (length2 & 1) crc1 = gf2MatrixTimes(even, crc1);
+      length2 >>= 1;
+      if (length2 == 0) break;
+      gf2MatrixSquare(odd, even);
+      if (length2 & 1) crc1 = gf2MatrixTimes(odd, crc1);
+      length2 >>= 1;
+   } while (length2 != 0);
+   return crc1 ^ crc2;
+}
+
+/* Accumulates the CRC32Cs of the blocks a contiguous byte range 
+ *  overlaps, as the range's bytes are passed to add() in order.
+ *  Each piece is (block number, CRC32C, length) of the part of
+ *  a block within the range.
+ */
+class OO_MPI_IO_CrcAccumulator {
+public:
+  OO_MPI_IO_CrcAccumulator()    { begin(0, OO_MPI_IO_CRC_BLOCK_SIZE); }
+  void begin(uint64_t firstByte, long blockBytes);
+  void add(const void* bytes, unsigned long numBytes);
+  void finish();
+
+  long getNumPieces() const                { return myBlocks.size(); }
+  uint64_t getBlock(long piece) const      { return myBlocks[piece]; }
+  uint32_t getCrc(long piece) const        { return myCrcs[piece]; }
+  uint64_t getLength(long piece) const     { return myLengths[piece]; }
+private:
+  long                  myBlockBytes;      // bytes per block
+  uint64_t              myNextByte;        // the next byte to be added
+  uint32_t              myCrc;             // CRC of the current piece
+  uint64_t              myLength;          // length of the current piece
+  std::vector<uint64_t> myBlocks;          // finished pieces
+  std::vector<uint32_t> myCrcs;
+  std::vector<uint64_t> myLengths;
+};
+
+/* method to start accumulating
+ * @param: firstByte, the (data-relative) offset of the range's first byte
+ * @param: blockBytes, the number of bytes per block.
+ * Postcondition: there are no pieces.
+ */
+void OO_MPI_IO_CrcAccumulator::begin(uint64_t firstByte, long blockBytes) {
+   myBlockBytes = blockBytes;
+   myNextByte = firstByte;
+   myCrc = 0;
+   myLength = 0;
+   myBlocks.clear();
+   myCrcs.clear();
+   myLengths.clear();
+}
+
+/* method to add the range's next bytes
+ * @param: bytes, the address of the bytes
+ * @param: numBytes, the number of bytes.
+ * Postcondition: each block they complete has become a piece.
+ */
+void OO_MPI_IO_CrcAccumulator::add(const void* bytes, unsigned long numBytes) {
+   const unsigned char* next = (const unsigned char*) bytes;
+   while (numBytes > 0) {
+      unsigned long room = myBlockBytes - myNextByte % myBlockBytes;
+      unsigned long length = std::min(room, numBytes);
+      myCrc = crc32c(next, length, myCrc);
+      myLength += length;
+      myNextByte += length;
+      next += length;
+      numBytes -= length;
+      if (length == room) {
+         finish();
+      }
+   }
+}
+
+/* method to end the current piece (if it is not empty)
+ * Postcondition: the bytes added since the last piece are a piece.
+ */
+void OO_MPI_IO_CrcAccumulator::finish() {
+   if (myLength > 0) {
+      myBlocks.push_back( (myNextByte - 1) / myBlockBytes );
+      myCrcs.push_back(myCrc);
+      myLengths.push_back(myLength);
+   }
+   myCrc = 0;
+   myLength = 0;
+}
+
+/* Utility to find the name of a file's checksum sidecar
+ */
+std::string getCrcFileName(const std::string& fileName) {
+   return fileName + ".crc";
+}
+
+/********************************************************************
+ * Zone maps: a ParallelWriter (or buildZoneMap()) can record the 
+ *  least and greatest value, and the number of values that are 
+ *  not NaN, of each fixed-size block (zone) of a file's Items in 
+ *  a sidecar file (the file's name plus ".zmap"), so that 
+ *  a RangeScanReader can skip the blocks that cannot hold values
+ *  in the range it is looking for.
+ ********************************************************************/
+
+const long OO_MPI_IO_ZONE_ITEMS = 1L << 16;        // default Items per block
+const char OO_MPI_IO_ZONE_MAGIC[8] = {'O','O','M','P','I','Z','M','P'};
+
+/* The beginning of a zone map; one OO_MPI_IO_ZoneEntry per block follows.
+ *  (The zone map is in the byte order of its writer,
+ *   which need not be that of the file's Items.)
+ */
+struct OO_MPI_IO_ZonePrologue {
+  char     magic[8];                  // OO_MPI_IO_ZONE_MAGIC
+  uint32_t version;                   // zone map format (1)
+  uint32_t byteOrderMark;             // OO_MPI_IO_BYTE_ORDER_MARK
+  uint32_t typeCode;                  // an OO_MPI_IO_TypeCode
+  uint32_t itemSize;                  // sizeof(ItemType)
+  uint64_t blockItems;                // Items per block (the last may be short)
+  uint64_t dataOffset;                // where the blocks begin in the file
+  uint64_t numItems;                  // Items the blocks cover
+};
+
+struct OO_MPI_IO_ZoneEntry {
+  uint64_t minimum;                   // the bytes of the block's least Item
+  uint64_t maximum;                   //  and of its greatest Item
+  uint64_t count;                     // the number of its Items that are
+};                                    //  not NaN (0: min/max are unset)
+
+/* utility to find the least and greatest of some arithmetic Items
+ *  (see findMinMax())
+ */
+template <class ItemType>
+bool findMinMax(const ItemType* items, unsigned long numItems,
+                 ItemType& least, ItemType& greatest, std::true_type) {
+   unsigned long i = 0;
+   while (i + 1 < numItems && items[i] != items[i]) {     // skip NaNs
+      ++i;
+   }
+   if (i >= numItems) return false;
+   least = greatest = items[i];
+   for ( ; i < numItems; ++i) {
+      if (items[i] < least) least = items[i];
+      if (greatest < items[i]) greatest = items[i];
+   }
+   return true;
+}
+
+/* utility for Items that have no order
+ */
+template <class ItemType>
+bool findMinMax(const ItemType* items, unsigned long numItems,
+                 ItemType& least, ItemType& greatest, std::false_type) {
+   return false;
+}
+
+/* Utility to find the least and greatest of a sequence of Items
+ * @param: items, the address of the Items
+ * @param: numItems, the number of Items
+ * @param: least, greatest, ItemType variables.
+ * Return: true, with least and greatest set (ignoring NaNs, unless all
+ *          are NaNs), if numItems > 0 and ItemType is arithmetic;
+ *          false otherwise.
+ */
+template <class ItemType>
+bool findMinMax(const ItemType* items, unsigned long numItems,
+                 ItemType& least, ItemType& greatest) {
+   return findMinMax(items, numItems, least, greatest,
+                      std::is_arithmetic<ItemType>());
+}
+
+/* utility to count the NaNs in a sequence of floating point Items
+ */
+template <class ItemType>
+unsigned long countNaNs(const ItemType* items, unsigned long numItems, 
+                         std::true_type) {
+   unsigned long numNaNs = 0;
+   for (unsigned long i = 0; i < numItems; ++i) {
+      numNaNs += (items[i] != items[i]);
+   }
+   return numNaNs;
+}
+
+/* utility for Items that cannot be NaN
+ */
+template <class ItemType>
+unsigned long countNaNs(const ItemType* items, unsigned long numItems, 
+                         std::false_type) {
+   return 0;
+}
+
+/* Utility to merge a (part of a) block's zone into another's
+ * @param: entry, an OO_MPI_IO_ZoneEntry
+ * @param: minimum, maximum, the bytes of the part's least and greatest Items
+ * @param: count, the number of the part's Items that are not NaN.
+ * Postcondition: entry describes its Items plus the part's.
+ */
+template <class ItemType>
+void mergeZone(OO_MPI_IO_ZoneEntry& entry, uint64_t minimum, 
+                uint64_t maximum, uint64_t count) {
+   if (count == 0) {
+      return;
+   }
+   if (entry.count > 0) {
+      ItemType values[4], least, greatest;
+      memcpy(&values[0], &entry.minimum, sizeof(ItemType));
+      memcpy(&values[1], &entry.maximum, sizeof(ItemType));
+      memcpy(&values[2], &minimum, sizeof(ItemType));
+      memcpy(&values[3], &maximum, sizeof(ItemType));
+      findMinMax(values, 4, least, greatest);
+      memcpy(&minimum, &least, sizeof(ItemType));
+      memcpy(&maximum, &greatest, sizeof(ItemType));
+   }
+   entry.minimum = minimum;
+   entry.maximum = maximum;
+   entry.count += count;
+}
+
+/* Accumulates the zones of the blocks a contiguous range of Items
+ *  overlaps, as the range's Items are passed to add() in order.
+ *  Each piece is the (block number, least Item, greatest Item, count)
+ *  of the part of a block within the range, stored as 4 uint64_t 
+ *  values (the Items as their bytes) so that they can be gathered.
+ */
+template <class ItemType>
+class OO_MPI_IO_ZoneAccumulator {
+public:
+  OO_MPI_IO_ZoneAccumulator()    { begin(0, OO_MPI_IO_ZONE_ITEMS); }
+  void begin(uint64_t firstItem, long blockItems);
+  void add(const ItemType* items, unsigned long numItems);
+
+  long getBlockItems() const                    { return myBlockItems; }
+  long getNumPieces() const                     { return myPieces.size() / 4; }
+  const std::vector<uint64_t>& getPieces() const { return myPieces; }
+private:
+  long                  myBlockItems;      // Items per block
+  uint64_t              myNextItem;        // the next Item to be added
+  std::vector<uint64_t> myPieces;          // 4 values per piece
+};
+
+/* method to start accumulating
+ * @param: firstItem, the number of the range's first Item
+ * @param: blockItems, the number of Items per block.
+ * Postcondition: there are no pieces.
+ */
+template <class ItemType>
+void OO_MPI_IO_ZoneAccumulator<ItemType>::begin(uint64_t firstItem, 
+                                                 long blockItems) {
+   myBlockItems = blockItems;
+   myNextItem = firstItem;
+   myPieces.clear();
+}
+
+/* method to add the range's next Items
+ * @param: items, the address of the Items (in the host's byte order)
+ * @param: numItems, the number of Items.
+ * Postcondition: the pieces describe every Item added so far
+ *                 (one piece per block, even if a block's Items 
+ *                  were added by several calls).
+ */
+template <class ItemType>
+void OO_MPI_IO_ZoneAccumulator<ItemType>::add(const ItemType* items, 
+                                               unsigned long numItems) {
+   while (numItems > 0) {
+      uint64_t block = myNextItem / myBlockItems;
+      unsigned long room = myBlockItems - myNextItem % myBlockItems;
+      unsigned long length = std::min(room, numItems);
+      ItemType least, greatest;
+      uint64_t minimum = 0, maximum = 0, count = 0;
+      if ( findMinMax(items, length, least, greatest) ) {
+         memcpy(&minimum, &least, sizeof(ItemType));
+         memcpy(&maximum, &greatest, sizeof(ItemType));
+         count = length - countNaNs(items, length, 
+                                     std::is_floating_point<ItemType>());
+      }
+      bool sameBlock = !myPieces.empty() && 
+                        myPieces[myPieces.size() - 4] == block;
+      if ( !sameBlock ) {
+         myPieces.push_back(block);
+         myPieces.push_back(0);
+         myPieces.push_back(0);
+         myPieces.push_back(0);
+      }
+      OO_MPI_IO_ZoneEntry entry;
+      memcpy(&entry, &myPieces[myPieces.size() - 3], sizeof(entry));
+      mergeZone<ItemType>(entry, minimum, maximum, count);
+      memcpy(&myPieces[myPieces.size() - 3], &entry, sizeof(entry));
+      myNextItem += length;
+      items += length;
+      numItems -= length;
+   }
+}
+
+/* Utility to find the name of a file's zone map
+ */
+std::string getZoneMapFileName(const std::string& fileName) {
+   return fileName + ".zmap";
+}
+
+/* Utility to gather every process's pieces (of a sidecar) to process 0
+ * @param: mine, this process's values.
+ * Return: on process 0, every process's values, in order of rank;
+ *          on other processes, an empty vector.
+ * Note: This is a collective call (MPI_Gatherv()).
+ */
+std::vector<uint64_t> gatherPieces(const std::vector<uint64_t>& mine) {
+   int worldSize = 1, worldRank = 0, myCount = mine.size();
+   MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+   MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+   std::vector<int> counts(worldSize), displacements(worldSize, 0);
+   MPI_Gather(&myCount, 1, MPI_INT, counts.data(), 1, MPI_INT, 
+              0, MPI_COMM_WORLD);
+   for (int pe = 1; pe < worldSize; ++pe) {
+      displacements[pe] = displacements[pe-1] + counts[pe-1];
+   }
+   std::vector<uint64_t> all;
+   if (worldRank == 0) {
+      all.resize(displacements.back() + counts.back());
+   }
+   MPI_Gatherv(mine.data(), myCount, MPI_UINT64_T, all.data(), counts.data(),
+               displacements.data(), MPI_UINT64_T, 0, MPI_COMM_WORLD);
+   return all;
+}
+
+/* Utility to write a file's zone map
+ * @param: fileName, the name of the file
+ * @param: zones, this PE's pieces of the file's zones
+ * @param: dataOffset, where the file's Items begin
+ * @param: numItems, the number of Items in the file
+ * @param: stats, the I/O counters of the writer (or NULL).
+ * Precondition: zones holds the pieces for this PE's range of Items
+ *                (the ranges of all PEs cover the file).
+ * Postcondition: process 0 has merged every PE's pieces (including
+ *                 those of blocks that span PEs' ranges) and written
+ *                 them to getZoneMapFileName(fileName).
+ * Note: This is a collective call (MPI_Gatherv()).
+ */
+template <class ItemType>
+void saveZoneMap(const std::string& fileName, 
+                  const OO_MPI_IO_ZoneAccumulator<ItemType>& zones,
+                  uint64_t dataOffset, uint64_t numItems,
+                  OO_MPI_IO_Stats* stats = NULL) {
+   std::vector<uint64_t> all = gatherPieces( zones.getPieces() );
+   int worldRank = 0;
+   MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+   if (worldRank != 0) {
+      return;
+   }
+
+   uint64_t blockItems = zones.getBlockItems();
+   uint64_t numBlocks = (numItems + blockItems - 1) / blockItems;
+   std::vector<OO_MPI_IO_ZoneEntry> entries(numBlocks);
+   memset(entries.data(), 0, numBlocks * sizeof(OO_MPI_IO_ZoneEntry));
+   for (unsigned long i = 0; i < all.size(); i += 4) {
+      mergeZone<ItemType>(entries[ all[i] ], all[i+1], all[i+2], all[i+3]);
+   }
+   OO_MPI_IO_ZonePrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   memcpy(prologue.magic, OO_MPI_IO_ZONE_MAGIC, sizeof(prologue.magic));
+   prologue.version = 1;
+   prologue.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   prologue.typeCode = getTypeCode<ItemType>();
+   prologue.itemSize = sizeof(ItemType);
+   prologue.blockItems = blockItems;
+   prologue.dataOffset = dataOffset;
+   prologue.numItems = numItems;
+
+   MPI_File zoneFile;
+   std::string zoneFileName = getZoneMapFileName(fileName);
+   int result = timedOpen(stats, MPI_COMM_SELF, zoneFileName.c_str(),
+                                  MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                  MPI_INFO_NULL, &zoneFile);
+   checkResult(result);
+   timedSetSize(stats, zoneFile, 0);
+   MPI_Status status;
+   result = timedWriteAt(stats, zoneFile, 0, &prologue, sizeof(prologue),
+                                 MPI_BYTE, &status);
+   checkResult(result);
+   result = timedWriteAt(stats, zoneFile, sizeof(prologue), entries.data(), 
+                                 numBlocks * 3, MPI_UINT64_T, &status);
+   checkResult(result);
+   timedClose(stats, &zoneFile);
+}
+
+/********************************************************************
+ * OO_MPI_IO_Base is a base class for C++ templates that use
+ *  MPI_IO to read/write binary data from/to files in parallel.
+ *
+ * Its subclasses are ParallelReader and ParallelWriter.
+ ********************************************************************/
+
+template<class ItemType> 
+class OO_MPI_IO_Base {
+public:
+  OO_MPI_IO_Base(const std::string& fileName, 
+                   int openMode, MPI_Datatype mpiType,
+                   int id, int numPEs);
+  virtual ~OO_MPI_IO_Base();
+ 
+  int getID() const                { return myID; }
+  int getNumPEs() const            { return myNumPEs; }
+  long getItemSize() const         { return myItemSize; }
+  std::string getFileName() const  { return myFileName; }
+  MPI_File& getFileHandle()        { return myFileHandle; }
+  MPI_Datatype getMPIType() const  { return myMPIType; }
+  bool isCollective() const        { return myCollectiveFlag; }
+  long getNumItemsInFile() const   { return myNumItemsInFile; }
+  long getChunkSize() const        { return myChunkSize; }
+  long getFirstItemOffset() const  { return myFirstItemOffset; }
+  long getFirstByteOffset() const  { return myFirstByteOffset; }
+  long getFileSize() const         { return myFileSize; }
+  long getDataOffset() const       { return myDataOffset; }
+  bool hasHeader() const           { return myHeaderFlag; }
+  const OO_MPI_IO_Header& getHeader() const { return myHeader; }
+  std::vector<uint64_t> getDims() const;
+  std::string getUserData() const;
+  ByteOrder getByteOrder() const   { return myByteOrder; }
+  bool needsByteSwap() const       { return mySwapFlag; }
+  void setByteOrder(ByteOrder order);
+  const OO_MPI_IO_Stats& getStats() const;
+  void resetStats();
+  std::vector<OO_MPI_IO_OpSummary> reduceStats() const;
+  const OO_MPI_IO_Profile& getProfile() const { return myProfile; }
+
+  void close()             { timedClose(getStatsRecorder(), &myFileHandle); }
+
+protected:
+  void setID(int newID);
+  void setNumPEs(int newNumPEs);
+
+  void setNumItemsInFile(long numItemsInFile) {
+        myNumItemsInFile = numItemsInFile;
+  }
+  void setFileSize(MPI_Offset fileSize) {
+        myFileSize = fileSize;
+  }
+  void setChunkSize(long chunkSize) {
+        myChunkSize = chunkSize;
+  }
+  void setFirstItemOffset(long firstItemOffset) {
+        myFirstItemOffset = firstItemOffset; 
+  }
+  void setFirstByteOffset(long firstByteOffset) {
+        myFirstByteOffset = firstByteOffset;
+  }
+  void setDataOffset(long dataOffset) {
+        myDataOffset = dataOffset;
+  }
+  void loadHeader();
+  void setHeader(long numItems, const std::vector<uint64_t>& dims,
+                  const std::string& userData);
+  void convertItems(ItemType* items, unsigned long count) {
+        if (mySwapFlag) swapBytes(items, count, myItemSize);
+  }
+  void readRanges(const std::vector<uint64_t>& rangeStarts,
+                   const std::vector<int>& rangeLengths, ItemType* buffer);
+  OO_MPI_IO_Stats* getStatsRecorder();
+  bool usesCollectiveIO() const {
+        return myProfile.collective && myCollectiveFlag;
+  }
+  unsigned long getWindowItems() const;
+  unsigned long getPieceItems() const;
+  long countPieces(unsigned long count, bool collective) const;
+
+private:
+  int          myID;                  // thread id or MPI rank
+  int          myNumPEs;              // num threads or MPI processes
+  int          myItemSize;            // size of 1 Item
+  std::string  myFileName;            // file being opened
+  MPI_Datatype myMPIType;             // the MPI equiv of ItemType
+  MPI_File     myFileHandle;          // MPI handle for file 
+  bool         myFinalizeFlag;        // true iff MPI_Init not called
+  bool         myCollectiveFlag;      // true iff PEs == MPI processes
+
+  // these attributes are unknown until read or write is called
+  long         myNumItemsInFile;      // total Items to be read
+  MPI_Offset   myFileSize;            // size of file in bytes
+  long         myChunkSize;           // size of my chunk to read
+  long         myFirstItemOffset;     // offset of my chunk (Item #)
+  long         myFirstByteOffset;     // offset of my chunk (byte #)
+  long         myDataOffset;          // offset of the Items (byte #)
+  bool         myHeaderFlag;          // true iff the file has a header
+  OO_MPI_IO_Header myHeader;          // the header (if myHeaderFlag)
+  ByteOrder    myByteOrder;           // byte order of the file's Items
+  bool         mySwapFlag;            // true iff it is not the host's
+  OO_MPI_IO_Profile myProfile;        // my file system's tuning profile
+#if defined(OO_MPI_IO_STATS)
+  OO_MPI_IO_Stats myStats;            // my I/O counters
+#endif
+};
+
+/* OO_MPI_IO_BASE constructor
+ * @param: fileName, a string
+ * @param: openMode, an int
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType
+ *           &&  openMode is a valid MPI file-opening mode
+ *           &&  mpiType is the MPI equivalent of ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
+ * Postcondition: if MPI_Init() has not already been called 
+ *                 then MPI_Init_thread() has been called
+ *           &&   the file has been opened 1for parallel IO
+ *                 as specified by openMode
+ *           &&   each instance variable have been initialized
+ *                 as appropriate for this PE
+ *           &&   getProfile() is the profile of the file's file system
+ *                 (see getProfileFor()), whose hints the file was
+ *                 opened with
+ *           &&   isCollective() is true iff each PE is an MPI process.
+ * Note: It would be cleaner to pass mpiType as a template parameter
+ *         but doing so produces errors (at least for OpenMPI and clang),
+ *         so this is a hack-ey workaround.
+ */
+template <class ItemType>
+OO_MPI_IO_Base<ItemType>::
+OO_MPI_IO_Base(const std::string& fileName, int openMode, MPI_Datatype mpiType,
+                int id, int numPEs) {
+   myFileName = fileName;
+   myMPIType = mpiType;
+   myItemSize = sizeof(ItemType);
+   if (id >= 0) { 
+      myID = id; 
+   } else { 
+      fprintf(stderr, "\nOO_MPI_IO_Base(): id must be non-negative\n\n");
+      exit(1);
+   } 
+   if (numPEs > 0) { 
+      myNumPEs = numPEs;
+   } else { 
+      fprintf(stderr, "\nOO_MPI_IO_Base(): numPEs must be positive\n\n");
+      exit(1);
+   } 
+
+   // set other attributes to defaults for now
+   myNumItemsInFile = 0;
+   myFileSize = 0;
+   myChunkSize = 0;
+   myFirstItemOffset = 0;
+   myFirstByteOffset = 0;
+   myDataOffset = 0;
+   myHeaderFlag = false;
+   memset(&myHeader, 0, sizeof(myHeader));
+   myByteOrder = NATIVE_ORDER;
+   mySwapFlag = false;
+   myFinalizeFlag = false;
+   myCollectiveFlag = false;
+   resetStats();
+
+   // for OpenMP: the main thread needs to call MPI_Init_thread()
+   int mpiInitFlag = 0;
+   MPI_Initialized(&mpiInitFlag);                    // was MPI_Init() called?
+   if (!mpiInitFlag) {                               // if no: assume OpenMP;
+      //pthread_barrier_t barrier;                   //  if using Pthreads,
+      //pthread_barrier_init(&barrier, NULL, numPEs);//   uncomment these lines
+                                                     //   and the 2 below
+      if (id == 0) {                                 //  if main thread:
+        int modeProvided = 0;                        //   call MPI_Init_thread()
+        int initResult = MPI_Init_thread(0, 0,       //   so any thread can make
+                                MPI_THREAD_MULTIPLE, //   MPI calls
+                                &modeProvided);     
+        checkResult(initResult);
+        myFinalizeFlag = true;                       // set flag for destructor
+      }
+                                                     // make threads wait 'til
+      #pragma omp barrier                            //  MPI_Init_thread done
+                                                     //  or MPI_File_open may fail
+      //pthread_barrier_wait(&barrier);              // replace omp barrier with
+      //pthread_barrier_destroy(&barrier);           //  these to use Pthreads
+   }
+
+   myProfile = getProfileFor(fileName);
+   MPI_Info info = makeProfileInfo(myProfile);
+   int openResult = timedOpen( getStatsRecorder(),    // my counters
+                                MPI_COMM_WORLD,        // communicator
+                                fileName.c_str(),      // name of file
+                                openMode,              // mode parameter
+                                info,                  // hints (if tuned)
+                                &myFileHandle );       // MPI handle
+   checkResult(openResult);
+   if (info != MPI_INFO_NULL) {
+      MPI_Info_free(&info);
+   }
+
+   // collective MPI-IO calls are only safe if each PE is an MPI process
+   //  (in OpenMP mode, the threads of a process share MPI_COMM_WORLD)
+   int worldSize = 0, worldRank = 0;
+   MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+   MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+   myCollectiveFlag = (worldSize == myNumPEs && worldRank == myID);
+}
+
+/* parameter-checking setter methods for id, numPEs
+ */
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::setID(int newID) {
+   if (newID < 0) {
+      fprintf(stderr, "\nOO_MPI_IO_Base::setID(): bad id (%d)\n\n", newID);
+      exit(1);
+   }
+   myID = newID;
+}
+
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::setNumPEs(int newNumPEs) {
+   if (newNumPEs < 0) {
+      fprintf(stderr, "\nOO_MPI_IO_Base::setNumPEs(): bad numPEs (%d)\n\n",
+                     newNumPEs);
+      exit(1);
+   }
+   myNumPEs = newNumPEs;
+}
+
+/* accessors for a header's array dimensions and user metadata
+ * Return: the dimensions (empty if unspecified or no header),
+ *          or the user metadata (empty if none or no header).
+ */
+template <class ItemType>
+std::vector<uint64_t> OO_MPI_IO_Base<ItemType>::getDims() const {
+   return std::vector<uint64_t>(myHeader.dims, 
+                                 myHeader.dims + myHeader.numDims);
+}
+
+template <class ItemType>
+std::string OO_MPI_IO_Base<ItemType>::getUserData() const {
+   return std::string(myHeader.userData, 
+                       strnlen(myHeader.userData, OO_MPI_IO_USER_DATA_SIZE));
+}
+
+/* method to set the byte order of the file's Items
+ * @param: order, a ByteOrder.
+ * Precondition: ItemType is an arithmetic type of at most 8 bytes,
+ *                or order is the host's byte order
+ *                (EXTERNAL32_ORDER is treated as BIG_ENDIAN_ORDER,
+ *                 which is what it is for such types).
+ * Postcondition: getByteOrder() == order
+ *            &&  needsByteSwap() is true iff order differs from
+ *                 the host's byte order (and Items are over 1 byte),
+ *                 in which case Items are converted as they are
+ *                 read or written.
+ */
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::setByteOrder(ByteOrder order) {
+   ByteOrder fileOrder = (order == EXTERNAL32_ORDER) ? BIG_ENDIAN_ORDER 
+                                                     : order;
+   bool swap = (fileOrder != NATIVE_ORDER && 
+                 fileOrder != getHostByteOrder() && myItemSize > 1);
+   if (swap && ( !std::is_arithmetic<ItemType>::value || myItemSize > 8 )) {
+      fprintf(stderr, "\nOO_MPI_IO_Base::setByteOrder(): only arithmetic"
+                      " Items of 2, 4 or 8 bytes can be converted\n\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myByteOrder = order;
+   mySwapFlag = swap;
+}
+
+/* accessors for my I/O counters
+ * Return: the calls, bytes and seconds of each kind of operation
+ *          (indexed by OO_MPI_IO_Operation) since construction
+ *          or the last resetStats(); all 0 unless OO_MPI_IO_STATS
+ *          is defined.
+ */
+template <class ItemType>
+const OO_MPI_IO_Stats& OO_MPI_IO_Base<ItemType>::getStats() const {
+#if defined(OO_MPI_IO_STATS)
+   return myStats;
+#else
+   static const OO_MPI_IO_Stats noStats = OO_MPI_IO_Stats();
+   return noStats;
+#endif
+}
+
+template <class ItemType>
+OO_MPI_IO_Stats* OO_MPI_IO_Base<ItemType>::getStatsRecorder() {
+#if defined(OO_MPI_IO_STATS)
+   return &myStats;
+#else
+   return NULL;
+#endif
+}
+
+/* method to zero my I/O counters
+ * Postcondition: every counter in getStats() is 0.
+ */
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::resetStats() {
+#if defined(OO_MPI_IO_STATS)
+   memset(&myStats, 0, sizeof(myStats));
+#endif
+}
+
+/* method to summarize the PEs' I/O counters
+ * Return: for each kind of operation (indexed by OO_MPI_IO_Operation),
+ *          the least, greatest and mean calls, bytes and seconds 
+ *          of any PE, the bandwidth of each PE (in bytes/second, 
+ *          0 if it spent no time), and the aggregate bandwidth 
+ *          (all the bytes over the greatest time).
+ * Note: In MPI mode, this is a collective call (MPI_Allreduce(),
+ *        MPI_Allgather()); in OpenMP mode a PE cannot see the counters
+ *        of the other threads, so each summarizes just its own.
+ */
+template <class ItemType>
+std::vector<OO_MPI_IO_OpSummary> OO_MPI_IO_Base<ItemType>::reduceStats() const {
+   const int N = 3 * OO_MPI_IO_NUM_OPERATIONS;
+   const OO_MPI_IO_Stats& stats = getStats();
+   double mine[N];
+   for (int op = 0; op < OO_MPI_IO_NUM_OPERATIONS; ++op) {
+      mine[3*op] = stats.ops[op].calls;
+      mine[3*op+1] = stats.ops[op].bytes;
+      mine[3*op+2] = stats.ops[op].seconds;
+   }
+   int numPEs = 1;
+   std::vector<double> least(mine, mine + N), greatest(mine, mine + N),
+                        sums(mine, mine + N), all(mine, mine + N);
+   if (myCollectiveFlag) {
+      numPEs = myNumPEs;
+      MPI_Allreduce(mine, least.data(), N, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+      MPI_Allreduce(mine, greatest.data(), N, MPI_DOUBLE, MPI_MAX, 
+                     MPI_COMM_WORLD);
+      MPI_Allreduce(mine, sums.data(), N, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      all.resize(N * numPEs);
+      MPI_Allgather(mine, N, MPI_DOUBLE, all.data(), N, MPI_DOUBLE, 
+                     MPI_COMM_WORLD);
+   }
+
+   std::vector<OO_MPI_IO_OpSummary> summaries(OO_MPI_IO_NUM_OPERATIONS);
+   for (int op = 0; op < OO_MPI_IO_NUM_OPERATIONS; ++op) {
+      OO_MPI_IO_OpSummary& summary = summaries[op];
+      summary.minCalls = least[3*op];
+      summary.maxCalls = greatest[3*op];
+      summary.meanCalls = sums[3*op] / numPEs;
+      summary.minBytes = least[3*op+1];
+      summary.maxBytes = greatest[3*op+1];
+      summary.meanBytes = sums[3*op+1] / numPEs;
+      summary.minSeconds = least[3*op+2];
+      summary.maxSeconds = greatest[3*op+2];
+      summary.meanSeconds = sums[3*op+2] / numPEs;
+      summary.aggregateBandwidth = (summary.maxSeconds > 0) ? 
+                                    sums[3*op+1] / summary.maxSeconds : 0;
+      for (int pe = 0; pe < numPEs; ++pe) {
+         double seconds = all[N*pe + 3*op+2];
+         summary.bandwidths.push_back( (seconds > 0) ? 
+                                        all[N*pe + 3*op+1] / seconds : 0 );
+      }
+   }
+   return summaries;
+}
+
+/* utilities for the window size of my profile
+ * Return (getWindowItems()): the Items per window of the reads and
+ *          writes that convert or check Items as they go (at least 1;
+ *          OO_MPI_IO_SWAP_WINDOW bytes' worth unless my profile sets it)
+ * Return (getPieceItems()): the most Items per call of the reads and
+ *          writes that do not (INT_MAX unless my profile sets it).
+ */
+template <class ItemType>
+unsigned long OO_MPI_IO_Base<ItemType>::getWindowItems() const {
+   long windowBytes = (myProfile.windowBytes > 0) ? myProfile.windowBytes
+                                                  : OO_MPI_IO_SWAP_WINDOW;
+   return std::max(1L, windowBytes / myItemSize);
+}
+
+template <class ItemType>
+unsigned long OO_MPI_IO_Base<ItemType>::getPieceItems() const {
+   if (myProfile.windowBytes <= 0) {
+      return INT_MAX;
+   }
+   return std::min<long>(INT_MAX, 
+                          std::max(1L, myProfile.windowBytes / myItemSize));
+}
+
+/* method to count the calls that read or write a range in pieces
+ * @param: count, the number of Items in the range
+ * @param: collective, true iff the calls are collective.
+ * Return: the number of getPieceItems()-Item pieces in the range 
+ *          (at least 1), or, if collective, the greatest such number
+ *          of any process, as each must make the same number of calls.
+ * Note: If collective, this is a collective call (MPI_Allreduce()).
+ */
+template <class ItemType>
+long OO_MPI_IO_Base<ItemType>::countPieces(unsigned long count, 
+                                            bool collective) const {
+   unsigned long pieceItems = getPieceItems();
+   long myPieces = std::max(1UL, (count + pieceItems - 1) / pieceItems);
+   long pieces = myPieces;
+   if (collective) {
+      MPI_Allreduce(&myPieces, &pieces, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+   }
+   return pieces;
+}
+
+/* method to look for (and validate) a header at the start of the file
+ * Precondition: the file has been opened for input
+ *            && (in MPI mode) every process calls this method.
+ * Postcondition: if the file begins with an OO_MPI_IO_Header:
+ *                  hasHeader() is true, getHeader() returns it,
+ *                  getDataOffset() == OO_MPI_IO_HEADER_SIZE, and
+ *                  the file's Item count and size have been set
+ *                  from it (so no size query is needed);
+ *                otherwise, hasHeader() is false 
+ *                  and getDataOffset() == 0.
+ *             && if the header was written in the other byte order,
+ *                  its fields have been converted and setByteOrder()
+ *                  has been called, so that the Items will be too
+ *             && if the header's type or Item size does not match
+ *                  ItemType, an error has been reported and
+ *                  the program has been terminated.
+ * Note: In MPI mode, process 0 reads the header and broadcasts it;
+ *        in OpenMP mode each thread reads it.
+ */
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::loadHeader() {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   OO_MPI_IO_Header header;
+   memset(&header, 0, sizeof(header));
+   if ( !myCollectiveFlag || myID == 0 ) {
+      MPI_Status status;
+      int readResult = timedReadAt(stats, myFileHandle, 0, &header, 
+                                           sizeof(header), MPI_BYTE, &status);
+      checkResult(readResult);
+      int bytesRead = 0;
+      MPI_Get_count(&status, MPI_BYTE, &bytesRead);
+      if (bytesRead < (int)sizeof(header)) {
+         memset(&header, 0, sizeof(header));           // too small
+      }
+   }
+   if (myCollectiveFlag) {
+      MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   if (memcmp(header.magic, OO_MPI_IO_MAGIC, sizeof(header.magic)) != 0) {
+      myHeaderFlag = false;
+      myDataOffset = 0;
+      return;
+   }
+
+   // a reversed mark means the file was written in the other byte order
+   uint32_t reversedMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   swapBytes(&reversedMark, 1, 4);
+   bool foreignOrder = (header.byteOrderMark == reversedMark);
+   if (foreignOrder) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&header);
+      swapBytes(bytes + offsetof(OO_MPI_IO_Header, version), 
+                 6, 4);                           // version .. numDims
+      swapBytes(bytes + offsetof(OO_MPI_IO_Header, numItems), 
+                 1 + OO_MPI_IO_MAX_DIMS, 8);      // numItems, dims
+   } else if (header.byteOrderMark != OO_MPI_IO_BYTE_ORDER_MARK) {
+      fprintf(stderr, "\nOO_MPI_IO: '%s' has a corrupt header\n\n",
+                      myFileName.c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   OO_MPI_IO_TypeCode myCode = getTypeCode<ItemType>();
+   if (header.itemSize != (uint32_t)myItemSize ||
+        (header.typeCode != OO_MPI_IO_OTHER && myCode != OO_MPI_IO_OTHER &&
+         header.typeCode != (uint32_t)myCode)) {
+      fprintf(stderr, "\nOO_MPI_IO: '%s' contains Items of type code %u"
+                      " (%u bytes), not type code %d (%d bytes)\n\n",
+                      myFileName.c_str(), header.typeCode, header.itemSize,
+                      myCode, myItemSize);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   if (header.numDims > (uint32_t)OO_MPI_IO_MAX_DIMS) {
+      header.numDims = OO_MPI_IO_MAX_DIMS;
+   }
+
+   if (foreignOrder) {
+      setByteOrder(getHostByteOrder() == LITTLE_ENDIAN_ORDER ? BIG_ENDIAN_ORDER
+                                                            : LITTLE_ENDIAN_ORDER);
+   }
+
+   myHeader = header;
+   myHeaderFlag = true;
+   myDataOffset = header.headerSize;
+   myNumItemsInFile = header.numItems;
+   myFileSize = myDataOffset + header.numItems * myItemSize;
+}
+
+/* method to fill in the header to be written to a file
+ * @param: numItems, a long
+ * @param: dims, a vector of uint64_t values
+ * @param: userData, a string
+ * Precondition: numItems is the number of Items in the file
+ *           &&  dims is empty or the array's shape (at most 8 dims)
+ *           &&  userData is at most 151 chars.
+ * Postcondition: getHeader() describes a file of numItems ItemType
+ *                 values with shape dims and metadata userData
+ *            &&  hasHeader() is true
+ *            &&  getDataOffset() == OO_MPI_IO_HEADER_SIZE.
+ */
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::setHeader(long numItems,
+                                          const std::vector<uint64_t>& dims,
+                                          const std::string& userData) {
+   if (dims.size() > (unsigned)OO_MPI_IO_MAX_DIMS ||
+        userData.size() >= (unsigned)OO_MPI_IO_USER_DATA_SIZE) {
+      fprintf(stderr, "\nOO_MPI_IO_Base::setHeader(): at most %d dims"
+                      " and %d chars of user data\n\n",
+                      OO_MPI_IO_MAX_DIMS, OO_MPI_IO_USER_DATA_SIZE - 1);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   memset(&myHeader, 0, sizeof(myHeader));
+   memcpy(myHeader.magic, OO_MPI_IO_MAGIC, sizeof(myHeader.magic));
+   myHeader.version = 1;
+   myHeader.headerSize = OO_MPI_IO_HEADER_SIZE;
+   myHeader.typeCode = getTypeCode<ItemType>();
+   myHeader.itemSize = myItemSize;
+   myHeader.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   myHeader.numDims = dims.size();
+   myHeader.numItems = numItems;
+   for (unsigned d = 0; d < dims.size(); ++d) {
+      myHeader.dims[d] = dims[d];
+   }
+   memcpy(myHeader.userData, userData.data(), userData.size());
+   myHeaderFlag = true;
+   myDataOffset = OO_MPI_IO_HEADER_SIZE;
+}
+
+/* method to read several ranges of Items with a single read
+ * @param: rangeStarts, a vector of Item numbers
+ * @param: rangeLengths, a vector of Item counts
+ * @param: buffer, the address of a buffer.
+ * Precondition: rangeStarts is sorted, and the ranges do not overlap
+ *           &&  rangeStarts.size() == rangeLengths.size()
+ *           &&  buffer has room for the sum of rangeLengths Items.
+ * Postcondition: buffer holds the Items of each range in turn,
+ *                 in the host's byte order.
+ *
+ * The ranges are described as one (hindexed) file type, so that all
+ *  of them are read by a single read through a file view.
+ *
+ * Note: In MPI mode this is a collective call (MPI_File_read_all),
+ *        so every process must call it (possibly with no ranges).
+ */
+template <class ItemType>
+void OO_MPI_IO_Base<ItemType>::readRanges(const std::vector<uint64_t>& rangeStarts,
+                                           const std::vector<int>& rangeLengths,
+                                           ItemType* buffer) {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   // describe the ranges as one file type (using the smaller 
+   //  hindexed_block type when all ranges have the same length)
+   int numRanges = rangeStarts.size();
+   std::vector<MPI_Aint> byteOffsets(numRanges);
+   unsigned long itemsToRead = 0;
+   bool sameLengths = true;
+   for (int r = 0; r < numRanges; ++r) {
+      byteOffsets[r] = rangeStarts[r] * myItemSize;
+      itemsToRead += rangeLengths[r];
+      sameLengths = sameLengths && rangeLengths[r] == rangeLengths[0];
+   }
+   MPI_Datatype fileType;
+   if (sameLengths && numRanges > 0) {
+      MPI_Type_create_hindexed_block(numRanges, rangeLengths[0], 
+                                      byteOffsets.data(), myMPIType, &fileType);
+   } else {
+      MPI_Type_create_hindexed(numRanges, rangeLengths.data(), 
+                                byteOffsets.data(), myMPIType, &fileType);
+   }
+   MPI_Type_commit(&fileType);
+
+   MPI_Status status;
+   int readResult = MPI_File_set_view(myFileHandle, myDataOffset,
+                                       myMPIType, fileType, 
+                                       "native", MPI_INFO_NULL);
+   checkResult(readResult);
+   unsigned long itemsRead = 0;
+   unsigned long totalItems = itemsToRead;
+   // handle very large requests where itemsToRead > INT_MAX
+   while (itemsToRead > INT_MAX) {
+      readResult = timedRead(stats, myFileHandle, buffer + itemsRead, INT_MAX,
+                                     myMPIType, &status);
+      checkResult(readResult);
+      itemsRead += INT_MAX;
+      itemsToRead -= INT_MAX;
+   }
+   if (myCollectiveFlag) {
+      readResult = timedReadAll(stats, myFileHandle, buffer + itemsRead, 
+                                        itemsToRead, myMPIType, &status);
+   } else {
+      readResult = timedRead(stats, myFileHandle, buffer + itemsRead, 
+                                     itemsToRead, myMPIType, &status);
+   }
+   checkResult(readResult);
+   // restore the default (byte-stream) view for any later calls
+   MPI_File_set_view(myFileHandle, 0, MPI_BYTE, MPI_BYTE, "native", 
+                      MPI_INFO_NULL);
+   MPI_Type_free(&fileType);
+
+   convertItems(buffer, totalItems);
+}
+
+/* OO_MPI_IO_BASE destructor cleans up at object's end-of-life
+ * Postcondition: the shared file has been closed 
+ *             && if we called MPI_Init_thread(),
+ *                  we have called MPI_Finalize().
+ */
+template <class ItemType>
+OO_MPI_IO_Base<ItemType>::~OO_MPI_IO_Base() {
+   if (myFinalizeFlag &&                   // if MPI_Init() was not called 
+        myID == 0) {                       //  and we are the main thread,
+         MPI_Finalize();                   //  then we need to finalize
+   }
+ }
+
+/* Calculate the start and stop values for this PE's 
+ *  contiguous chunk of a set of loop-iterations, 0..REPS-1,
+ *  so that PEs' chunk-sizes are equal (or nearly so).
+ *
+ * @param: id, an int containing this PE's id (thread id or MPI rank)
+ * @param: numPEs, an int containing the number of PEs
+ * @param: REPS, a const long containing the for loop's iteration total
+ * Precondition: id == this thread's id or MPI process's rank
+ *            && numPEs == the number of threads or MPI processes
+ *            && REPS == the total number of 0-based loop iterations needed
+ *            && numPEs <= REPS 
+ * @param: start, a long reference through which the 
+ *          starting value of this PE's chunk should be returned
+ * @param: stop, a long reference through which the
+ *          stopping value of this PE's chunk should be returned
+ * Postcondition: start == this PE's first iteration value 
+ *             && stop == this PE's last iteration value + 1.
+ */
+void getChunkStartStopValues(int id, int numPEs, const long REPS,
+                              long& start, long& stop)
+{
+   // check precondition before proceeding
+   if (numPEs > REPS) {
+      if (id == 0) {
+         printf("\n*** Number of PEs (%d) exceeds REPS (%ld)\n",
+                 numPEs, REPS);
+         printf("*** Please run using PEs less than or equal to %ld\n\n", REPS);
+      }
+      MPI_Finalize();
+      exit(1);
+   }
+
+   // compute the chunk size that works in many cases
+   long chunkSize1 = (REPS + numPEs - 1) / numPEs;        // ceil(REPS/numPEs)
+   long begin = id * chunkSize1;
+   long end = begin + chunkSize1;
+   // see if there are any leftover iterations
+   long remainder = REPS % numPEs;
+   // If remainder == 0, chunkSize1 = chunk-size for all PEs;
+   // If remainder != 0, chunkSize1 = chunk-size for p_0..p_remainder-1
+   //   but for PEs p_remainder..p_numPEs-1
+   //   recompute begin and end using a smaller-by-1 chunk size, chunkSize2.
+   if (remainder > 0 && id >= remainder) {
+     long chunkSize2 = chunkSize1 - 1;
+     long remainderBase = remainder * chunkSize1;
+     long peOffset = (id-remainder) * chunkSize2;
+     begin = remainderBase + peOffset;
+     end = begin + chunkSize2;
+   } 
+   // pass back this PE's begin and end values via start and stop
+   start = begin;
+   stop = end;
+} 
+
+/********************************************************************
+ * Streaming reductions: ParallelReader::reduce() reads a PE's chunk
+ *  a (cache-sized) window at a time and passes each window to an op,
+ *  so a sum, extreme, moments or histogram of a file never needs 
+ *  more memory than a window, then combines the PEs' results.
+ *
+ * An op is a class with:
+ *     typedef ... Result;                         // what it computes
+ *     Result identity() const;                    // for no Items
+ *     void accumulate(Result& result, const Item* items, 
+ *                      unsigned long count) const;   // adds Items
+ *     Result combine(const Result& left, const Result& right) const;
+ *  where combine() is associative, identity() is its identity, and
+ *  Result is trivially copyable or a std::vector of such values
+ *  (so that processes can exchange them).
+ * SumOp, MinOp, MaxOp, MomentsOp and HistogramOp are provided;
+ *  makeAssociativeOp() makes an op from an associative function.
+ *
+ * The kernels keep OO_MPI_IO_LANES independent partial results, 
+ *  so that the compiler can vectorize them (as IEEE addition is not
+ *  associative, it cannot reorder a single running sum).
+ * Min and max ignore NaNs (which fail every comparison), as do 
+ *  histograms; sums and moments of Items that include a NaN are NaN.
+ ********************************************************************/
+
+#include <limits>                    // numeric_limits
+
+const long OO_MPI_IO_REDUCE_WINDOW = 1L << 18;   // default window bytes
+const int  OO_MPI_IO_LANES = 8;                  // partial results per kernel
+
+/* Utilities (kernels) to reduce a window of Items
+ * @param: items, the address of the first Item
+ * @param: count, the number of Items
+ * @param: initial (minItems(), maxItems()), the result for no Items.
+ * Return: the sum, least or greatest of the Items.
+ */
+template <class Item, class Sum>
+Sum sumItems(const Item* items, unsigned long count) {
+   Sum lanes[OO_MPI_IO_LANES] = {};
+   unsigned long i = 0;
+   for ( ; i + OO_MPI_IO_LANES <= count; i += OO_MPI_IO_LANES) {
+      for (int lane = 0; lane < OO_MPI_IO_LANES; ++lane) {
+         lanes[lane] += items[i + lane];
+      }
+   }
+   Sum sum = 0;
+   for ( ; i < count; ++i) {
+      sum += items[i];
+   }
+   for (int lane = 0; lane < OO_MPI_IO_LANES; ++lane) {
+      sum += lanes[lane];
+   }
+   return sum;
+}
+
+template <class Item>
+Item minItems(const Item* items, unsigned long count, Item initial) {
+   Item lanes[OO_MPI_IO_LANES];
+   std::fill(lanes, lanes + OO_MPI_IO_LANES, initial);
+   unsigned long i = 0;
+   for ( ; i + OO_MPI_IO_LANES <= count; i += OO_MPI_IO_LANES) {
+      for (int lane = 0; lane < OO_MPI_IO_LANES; ++lane) {
+         lanes[lane] = (items[i + lane] < lanes[lane]) ? items[i + lane] 
+                                                       : lanes[lane];
+      }
+   }
+   for ( ; i < count; ++i) {
+      lanes[0] = (items[i] < lanes[0]) ? items[i] : lanes[0];
+   }
+   for (int lane = 1; lane < OO_MPI_IO_LANES; ++lane) {
+      lanes[0] = (lanes[lane] < lanes[0]) ? lanes[lane] : lanes[0];
+   }
+   return lanes[0];
+}
+
+template <class Item>
+Item maxItems(const Item* items, unsigned long count, Item initial) {
+   Item lanes[OO_MPI_IO_LANES];
+   std::fill(lanes, lanes + OO_MPI_IO_LANES, initial);
+   unsigned long i = 0;
+   for ( ; i + OO_MPI_IO_LANES <= count; i += OO_MPI_IO_LANES) {
+      for (int lane = 0; lane < OO_MPI_IO_LANES; ++lane) {
+         lanes[lane] = (lanes[lane] < items[i + lane]) ? items[i + lane] 
+                                                       : lanes[lane];
+      }
+   }
+   for ( ; i < count; ++i) {
+      lanes[0] = (lanes[0] < items[i]) ? items[i] : lanes[0];
+   }
+   for (int lane = 1; lane < OO_MPI_IO_LANES; ++lane) {
+      lanes[0] = (lanes[0] < lanes[lane]) ? lanes[lane] : lanes[0];
+   }
+   return lanes[0];
+}
+
+/* SumOp adds Items (integers as long long, others as double) */
+template <class Item>
+class SumOp {
+public:
+  typedef typename std::conditional<std::is_integral<Item>::value, 
+                                     long long, double>::type Result;
+  Result identity() const { return 0; }
+  void accumulate(Result& result, const Item* items, 
+                   unsigned long count) const {
+        result += sumItems<Item, Result>(items, count);
+  }
+  Result combine(const Result& left, const Result& right) const {
+        return left + right;
+  }
+};
+
+/* MinOp and MaxOp find the least and greatest Items 
+ *  (for no Items: infinity and -infinity, or the type's extremes)
+ */
+template <class Item>
+class MinOp {
+public:
+  typedef Item Result;
+  Result identity() const {
+        return std::numeric_limits<Item>::has_infinity 
+                ? std::numeric_limits<Item>::infinity()
+                : std::numeric_limits<Item>::max();
+  }
+  void accumulate(Result& result, const Item* items, 
+                   unsigned long count) const {
+        result = minItems(items, count, result);
+  }
+  Result combine(const Result& left, const Result& right) const {
+        return (right < left) ? right : left;
+  }
+};
+
+template <class Item>
+class MaxOp {
+public:
+  typedef Item Result;
+  Result identity() const {
+        return std::numeric_limits<Item>::has_infinity 
+                ? -std::numeric_limits<Item>::infinity()
+                : std::numeric_limits<Item>::lowest();
+  }
+  void accumulate(Result& result, const Item* items, 
+                   unsigned long count) const {
+        result = maxItems(items, count, result);
+  }
+  Result combine(const Result& left, const Result& right) const {
+        return (left < right) ? right : left;
+  }
+};
+
+/* The count, mean and sum of squared deviations from the mean
+ *  of some Items (see MomentsOp)
+ */
+struct OO_MPI_IO_Moments {
+  uint64_t count;
+  double   mean;
+  double   m2;                             // sum of (Item - mean)^2
+
+  double getVariance() const        { return (count > 0) ? m2 / count : 0; }
+  double getSampleVariance() const  { return (count > 1) ? m2 / (count-1) : 0; }
+};
+
+/* Utility to merge the moments of two sets of Items
+ * Return: the moments of their union (Chan et al.'s pairwise update,
+ *          which generalizes Welford's to sets of any size).
+ */
+OO_MPI_IO_Moments mergeMoments(const OO_MPI_IO_Moments& left, 
+                                const OO_MPI_IO_Moments& right) {
+   if (left.count == 0) return right;
+   if (right.count == 0) return left;
+   OO_MPI_IO_Moments merged;
+   merged.count = left.count + right.count;
+   double delta = right.mean - left.mean;
+   double rightShare = (double) right.count / merged.count;
+   merged.mean = left.mean + delta * rightShare;
+   merged.m2 = left.m2 + right.m2 + delta * delta * left.count * rightShare;
+   return merged;
+}
+
+/* MomentsOp finds the count, mean and variance of Items: each window's
+ *  moments are computed in two passes (while it is in cache), then
+ *  merged with the running moments by mergeMoments()
+ */
+template <class Item>
+class MomentsOp {
+public:
+  typedef OO_MPI_IO_Moments Result;
+  Result identity() const { return OO_MPI_IO_Moments(); }
+  void accumulate(Result& result, const Item* items, 
+                   unsigned long count) const {
+        if (count == 0) return;
+        OO_MPI_IO_Moments window;
+        window.count = count;
+        window.mean = sumItems<Item, double>(items, count) / count;
+        double lanes[OO_MPI_IO_LANES] = {};
+        unsigned long i = 0;
+        for ( ; i + OO_MPI_IO_LANES <= count; i += OO_MPI_IO_LANES) {
+           for (int lane = 0; lane < OO_MPI_IO_LANES; ++lane) {
+              double deviation = items[i + lane] - window.mean;
+              lanes[lane] += deviation * deviation;
+           }
+        }
+        window.m2 = 0;
+        for ( ; i < count; ++i) {
+           window.m2 += (items[i] - window.mean) * (items[i] - window.mean);
+        }
+        for (int lane = 0; lane < OO_MPI_IO_LANES; ++lane) {
+           window.m2 += lanes[lane];
+        }
+        result = mergeMoments(result, window);
+  }
+  Result combine(const Result& left, const Result& right) const {
+        return mergeMoments(left, right);
+  }
+};
+
+/* HistogramOp counts Items in numBins equal bins from low to high:
+ *  result[0] counts the Items below low, result[b] (1 <= b <= numBins)
+ *  those in bin b-1, and result[numBins+1] those at or above high.
+ */
+template <class Item>
+class HistogramOp {
+public:
+  typedef std::vector<uint64_t> Result;
+  HistogramOp(double low, double high, int numBins);
+  double getLow() const        { return myLow; }
+  double getHigh() const       { return myHigh; }
+  int getNumBins() const       { return myNumBins; }
+  Result identity() const      { return Result(myNumBins + 2, 0); }
+  void accumulate(Result& result, const Item* items, 
+                   unsigned long count) const;
+  Result combine(const Result& left, const Result& right) const;
+
+private:
+  double myLow, myHigh;        // the range of the bins
+  int    myNumBins;            // how many bins it is cut into
+  double myScale;              // bins per unit
+};
+
+/* HistogramOp constructor
+ * @param: low, high, the range of the bins
+ * @param: numBins, an int.
+ * Precondition: low < high && numBins > 0.
+ */
+template <class Item>
+HistogramOp<Item>::HistogramOp(double low, double high, int numBins) {
+   if ( !(low < high) || numBins <= 0 ) {
+      fprintf(stderr, "\nHistogramOp(): need low < high and numBins > 0\n\n");
+      exit(1);
+   }
+   myLow = low;
+   myHigh = high;
+   myNumBins = numBins;
+   myScale = numBins / (high - low);
+}
+
+template <class Item>
+void HistogramOp<Item>::accumulate(Result& result, const Item* items, 
+                                    unsigned long count) const {
+   uint64_t* counts = result.data();
+   for (unsigned long i = 0; i < count; ++i) {
+      double value = items[i];
+      if (value >= myLow && value < myHigh) {
+         long bin = (long)((value - myLow) * myScale);
+         ++counts[1 + std::min(bin, (long) myNumBins - 1)];   // (rounding)
+      } else if (value < myLow) {
+         ++counts[0];
+      } else if (value >= myHigh) {
+         ++counts[myNumBins + 1];
+      }                                                      // (NaN: neither)
+   }
+}
+
+template <class Item>
+std::vector<uint64_t> HistogramOp<Item>::combine(const Result& left, 
+                                                  const Result& right) const {
+   Result sum(left);
+   for (unsigned long b = 0; b < sum.size(); ++b) {
+      sum[b] += right[b];
+   }
+   return sum;
+}
+
+/* AssociativeOp combines Items with a user's associative function
+ *  (e.g., bitwise OR, a product or a gcd), one Item at a time
+ */
+template <class Item, class Combine>
+class AssociativeOp {
+public:
+  typedef Item Result;
+  AssociativeOp(const Item& identity, Combine combine)
+   : myIdentity(identity), myCombine(combine) { }
+  Result identity() const { return myIdentity; }
+  void accumulate(Result& result, const Item* items, 
+                   unsigned long count) const {
+        for (unsigned long i = 0; i < count; ++i) {
+           result = myCombine(result, items[i]);
+        }
+  }
+  Result combine(const Result& left, const Result& right) const {
+        return myCombine(left, right);
+  }
+
+private:
+  Item    myIdentity;          // combine(identity, x) == x
+  Combine myCombine;           // an associative function of 2 Items
+};
+
+/* Utility to make an AssociativeOp
+ * @param: identity, the function's identity
+ * @param: combine, an associative function (e.g., a lambda) of 2 Items.
+ * Return: the op.
+ */
+template <class Item, class Combine>
+AssociativeOp<Item, Combine> makeAssociativeOp(const Item& identity,
+                                                Combine combine) {
+   return AssociativeOp<Item, Combine>(identity, combine);
+}
+
+/* Utilities to gather every process's result, in order of rank
+ * @param: mine, this process's result.
+ * Return: a vector of the results.
+ * Note: These are collective calls (MPI_Allgather(), MPI_Allgatherv()).
+ */
+template <class Result>
+std::vector<Result> allgatherResult(const Result& mine) {
+   static_assert(std::is_trivially_copyable<Result>::value,
+                  "an op's Result must be trivially copyable");
+   int numProcs = 1;
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   std::vector<Result> all(numProcs);
+   MPI_Allgather(&mine, sizeof(Result), MPI_BYTE, all.data(), 
+                  sizeof(Result), MPI_BYTE, MPI_COMM_WORLD);
+   return all;
+}
+
+template <class Value>
+std::vector< std::vector<Value> > allgatherResult(const std::vector<Value>& mine) {
+   static_assert(std::is_trivially_copyable<Value>::value,
+                  "an op's Result must be a vector of trivially copyable values");
+   int numProcs = 1;
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   int myBytes = mine.size() * sizeof(Value);
+   std::vector<int> bytes(numProcs), offsets(numProcs, 0);
+   MPI_Allgather(&myBytes, 1, MPI_INT, bytes.data(), 1, MPI_INT, 
+                  MPI_COMM_WORLD);
+   for (int p = 1; p < numProcs; ++p) {
+      offsets[p] = offsets[p-1] + bytes[p-1];
+   }
+   std::vector<char> buffer(offsets[numProcs-1] + bytes[numProcs-1]);
+   MPI_Allgatherv(mine.data(), myBytes, MPI_BYTE, buffer.data(), 
+                   bytes.data(), offsets.data(), MPI_BYTE, MPI_COMM_WORLD);
+   std::vector< std::vector<Value> > all(numProcs);
+   for (int p = 0; p < numProcs; ++p) {
+      all[p].resize(bytes[p] / sizeof(Value));
+      memcpy(all[p].data(), buffer.data() + offsets[p], bytes[p]);
+   }
+   return all;
+}
+
+/* Utilities to combine the PEs' results of an op
+ * @param: op, the op
+ * @param: mine, this PE's result
+ * @param: id, numPEs (combineOverThreads()), this thread's id, and 
+ *          the number of threads.
+ * Return: the PEs' results combined, in order of id (the same for 
+ *          every PE).
+ * Precondition (combineOverProcesses()): every MPI process calls it.
+ * Precondition (combineOverThreads()): every thread of the team calls
+ *                it (or there is only this thread, whose result it 
+ *                then returns).
+ * Note: combineOverThreads() shares the threads' results through a
+ *        static vector (one per Op type), between OpenMP barriers.
+ */
+template <class Op>
+typename Op::Result combineOverProcesses(const Op& op, 
+                                          const typename Op::Result& mine) {
+   auto all = allgatherResult(mine);
+   typename Op::Result result = all[0];
+   for (unsigned long p = 1; p < all.size(); ++p) {
+      result = op.combine(result, all[p]);
+   }
+   return result;
+}
+
+template <class Op>
+typename Op::Result combineOverThreads(const Op& op, 
+                                        const typename Op::Result& mine,
+                                        int id, int numPEs) {
+   static std::vector<typename Op::Result> results;
+   #pragma omp single
+   results.assign(numPEs, op.identity());             // (then a barrier)
+   results[id] = mine;
+   #pragma omp barrier
+   typename Op::Result result = results[0];
+   for (int pe = 1; pe < numPEs; ++pe) {
+      result = op.combine(result, results[pe]);
+   }
+   #pragma omp barrier                                // (before any reuse)
+   return result;
+}
+
+/*******************************************************************
+ * The ParallelReader template provides an abstraction to hide the
+ *  details of MPI-IO parallel input.
+ *
+ * ItemType is the type of the values stored in the file; 
+ *  DeliveredType (by default, ItemType) is the type of the values
+ *  it returns, e.g., ParallelReader<double, float> reads doubles
+ *  and returns floats, converting them as they are read.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType, class DeliveredType = ItemType> 
+class ParallelReader : public OO_MPI_IO_Base<ItemType> {
+public:
+  ParallelReader(const std::string& fileName, MPI_Datatype mpiType,
+                  int id, int numPEs);
+  std::vector<DeliveredType> readChunk();
+  std::vector<DeliveredType> readChunkPlus(unsigned numExtras);
+  std::vector<DeliveredType> readItems(const std::vector<uint64_t>& indices);
+  template <class Op>
+  typename Op::Result reduce(const Op& op, unsigned long windowItems = 0);
+  long beginChunk();
+  void startPart(ItemType* buffer, unsigned long count, MPI_Request* request);
+  void finishPart(ItemType* buffer, unsigned long count, MPI_Request* request);
+  void endChunk();
+  void verifyChecksums(bool abortOnFailure = true);
+
+  unsigned long getGapThreshold() const        { return myGapThreshold; }
+  void setGapThreshold(unsigned long numItems) { myGapThreshold = numItems; }
+  bool isVerifying() const                     { return myCrcBlockBytes > 0; }
+  const std::vector<uint64_t>& getCorruptBlocks() const 
+                                               { return myCorruptBlocks; }
+private:
+  void setFileInfo();
+  void readRange(MPI_Offset byteOffset, DeliveredType* items, 
+                  unsigned long count, bool collective);
+  void readBytes(MPI_Offset byteOffset, unsigned long numBytes);
+  void beginChecking(uint64_t firstByte);
+  void finishChecking(uint64_t endByte);
+  void checkBlocks();
+
+  unsigned long myGapThreshold;   // max gap (in Items) readItems() merges
+  MPI_Offset    myNextPartOffset; // where startPart() reads next
+  long          myCrcBlockBytes;  // bytes per checksummed block (0: none)
+  bool          myAbortOnFailure; // abort when a block fails its check?
+  std::vector<uint32_t> myBlockCrcs;       // each block's CRC32C
+  std::vector<uint64_t> myCorruptBlocks;   // blocks that failed
+  OO_MPI_IO_CrcAccumulator myCrcs;         // CRCs of the blocks being read
+};
+
+/* ParallelReader constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType
+ *           &&  mpiType is the MPI_Datatype that corresonds to ItemType
+ *               (e.g., MPI_DOUBLE for double)
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes
+ *           &&  an ItemType can be converted to a DeliveredType.
+ * Postcondition: the file has been opened for parallel input
+ *           &&  each instance variable have been initialized
+ *                as appropriate for this PE using the file's info
+ *                (including its header, if it has one)
+ *           &&  getGapThreshold() == 16
+ *           &&  !isVerifying().
+ * Note: In MPI mode, every process must construct its ParallelReader
+ *        (as MPI_File_open() and the header broadcast are collective).
+ */
+template <class ItemType, class DeliveredType>
+ParallelReader<ItemType, DeliveredType>::
+ParallelReader(const std::string& fileName, MPI_Datatype mpiType,
+                int id, int numPEs)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, id, numPEs)
+{
+   myGapThreshold = 16;          // reading a few unwanted Items is cheaper
+                                 //  than a separate access for each range
+   myCrcBlockBytes = 0;
+   myAbortOnFailure = true;
+   myNextPartOffset = 0;
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+}
+
+/* method to verify the blocks of the file against their checksums
+ * @param: abortOnFailure, a bool (default true).
+ * Precondition: the file was written by a ParallelWriter after a call
+ *                to enableChecksums(), so it has a checksum sidecar.
+ * Postcondition: isVerifying() is true, and readChunk() and 
+ *                 readChunkPlus() check each block they read as it
+ *                 arrives, reporting the failing block, its bytes and
+ *                 the PE to stderr, and either aborting the program
+ *                 (if abortOnFailure) or adding the block's number to 
+ *                 getCorruptBlocks().
+ * Note: Blocks at the ends of a chunk are read in full (at most
+ *        one extra block's bytes at each end) so they can be checked.
+ *       In MPI mode, every process must call this method 
+ *        (as process 0 reads the sidecar and broadcasts it).
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::verifyChecksums(bool abortOnFailure) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   setFileInfo();
+   std::string crcFileName = 
+                 getCrcFileName( OO_MPI_IO_Base<ItemType>::getFileName() );
+   bool collective = OO_MPI_IO_Base<ItemType>::isCollective();
+   bool readsFile = !collective || OO_MPI_IO_Base<ItemType>::getID() == 0;
+
+   OO_MPI_IO_CrcPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   MPI_File crcFile;
+   int openResult = MPI_SUCCESS;
+   if (readsFile) {
+      openResult = timedOpen(stats, MPI_COMM_SELF, crcFileName.c_str(),
+                                     MPI_MODE_RDONLY, MPI_INFO_NULL, &crcFile);
+      if (openResult == MPI_SUCCESS) {
+         MPI_Status status;
+         int readResult = timedReadAt(stats, crcFile, 0, &prologue, 
+                                              sizeof(prologue), MPI_BYTE, &status);
+         checkResult(readResult);
+      }
+   }
+   if (collective) {
+      MPI_Bcast(&prologue, sizeof(prologue), MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   uint32_t reversedMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   swapBytes(&reversedMark, 1, 4);
+   bool foreignOrder = (prologue.byteOrderMark == reversedMark);
+   if (foreignOrder) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&prologue);
+      swapBytes(bytes + offsetof(OO_MPI_IO_CrcPrologue, version), 2, 4);
+      swapBytes(bytes + offsetof(OO_MPI_IO_CrcPrologue, blockBytes), 3, 8);
+   }
+   uint64_t dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   uint64_t dataBytes = OO_MPI_IO_Base<ItemType>::getNumItemsInFile() 
+                         * OO_MPI_IO_Base<ItemType>::getItemSize();
+   if (memcmp(prologue.magic, OO_MPI_IO_CRC_MAGIC, 8) != 0 ||
+        prologue.byteOrderMark != OO_MPI_IO_BYTE_ORDER_MARK ||
+        prologue.blockBytes == 0 || prologue.dataOffset != dataOffset ||
+        prologue.dataBytes != dataBytes) {
+      fprintf(stderr, "\nParallelReader::verifyChecksums(): '%s' is missing"
+                      " or does not match '%s'\n\n", crcFileName.c_str(),
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   uint64_t numBlocks = (dataBytes + prologue.blockBytes - 1) 
+                         / prologue.blockBytes;
+   myBlockCrcs.resize(numBlocks);
+   if (readsFile) {
+      MPI_Status status;
+      int readResult = timedReadAt(stats, crcFile, sizeof(prologue), 
+                                           myBlockCrcs.data(), numBlocks,
+                                           MPI_UINT32_T, &status);
+      checkResult(readResult);
+      timedClose(stats, &crcFile);
+   }
+   if (collective) {
+      MPI_Bcast(myBlockCrcs.data(), numBlocks, MPI_UINT32_T, 0, MPI_COMM_WORLD);
+   }
+   if (foreignOrder) {
+      swapBytes(myBlockCrcs.data(), numBlocks, 4);
+   }
+   myCrcBlockBytes = prologue.blockBytes;
+   myAbortOnFailure = abortOnFailure;
+   myCorruptBlocks.clear();
+}
+
+/* utility to set the file's size and number of Items
+ * Postcondition: getFileSize() and getNumItemsInFile() have been set:
+ *                 from the file's header, if it has one
+ *                 (see OO_MPI_IO_Base::loadHeader()), 
+ *                 or else from the size of the file.
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::setFileInfo() {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if ( OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      return;                         // loadHeader() has done the work
+   }
+   // Note: We could compute the following attributes in the constructor, 
+   //  but do them here for symmetry with ParallelWriter
+   MPI_Offset fileSize;
+   timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+   OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+   // Note: EOF char seems inconsistent on different platforms;
+   //  if char tests fail and off-by-one, uncomment the next 3 lines 
+//   if (std::is_same<ItemType, char>::value) {         // if ItemType is char
+//      --fileSize;                                     // ignore EOF char
+//   }
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile( fileSize / OO_MPI_IO_Base<ItemType>::getItemSize() );
+}
+
+/* utility to read a contiguous range of Items
+ * @param: byteOffset, an MPI_Offset
+ * @param: items, the address of a buffer
+ * @param: count, an unsigned long
+ * @param: collective, a bool.
+ * Precondition: items has room for count DeliveredType values
+ *           &&  the file holds count Items starting at byteOffset
+ *           &&  if collective, every process makes this call
+ *                (with the same conversion and checking).
+ * Postcondition: items[0..count-1] contain those Items,
+ *                 converted to the host's byte order and 
+ *                 to DeliveredType if need be.
+ * Note: Items that need no conversion or checking are read at most
+ *        getPieceItems() at a time, collectively if collective.
+ *       Conversion is done a window at a time, while the next
+ *        window is being read, instead of in a second pass.
+ *       (If DeliveredType differs from ItemType, each window is read
+ *        into a small staging buffer, so memory use and traffic are
+ *        those of the DeliveredType values.)
+ *       Likewise, if isVerifying(), each window's blocks are 
+ *        checksummed while the next window is being read.
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::readRange(MPI_Offset byteOffset, 
+                                                         DeliveredType* items, 
+                                                         unsigned long count,
+                                                         bool collective) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   MPI_Datatype mpiType = OO_MPI_IO_Base<ItemType>::getMPIType();
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   const bool sameType = std::is_same<ItemType, DeliveredType>::value;
+   MPI_Status status;
+   int readResult = 0;
+   if ( sameType && !OO_MPI_IO_Base<ItemType>::needsByteSwap() && 
+         !isVerifying() ) {
+      // read the Items a piece (of at most INT_MAX) at a time
+      unsigned long pieceItems = OO_MPI_IO_Base<ItemType>::getPieceItems();
+      long numPieces = OO_MPI_IO_Base<ItemType>::countPieces(count, collective);
+      for (long piece = 0; piece < numPieces; ++piece) {
+         unsigned long first = std::min(count, piece * pieceItems);
+         int length = std::min(pieceItems, count - first);
+         if (collective) {
+            readResult = timedReadAtAll(stats, fh, byteOffset + first * itemSize,
+                                                items + first, length, mpiType, 
+                                                &status);
+         } else {
+            readResult = timedReadAt(stats, fh, byteOffset + first * itemSize,
+                                             items + first, length, mpiType, 
+                                             &status);
+         }
+         checkResult(readResult);
+      }
+      return;
+   }
+
+   if (count == 0) {
+      return;
+   }
+   uint64_t firstByte = byteOffset - OO_MPI_IO_Base<ItemType>::getDataOffset();
+   if ( isVerifying() ) {
+      beginChecking(firstByte);
+   }
+   unsigned long windowSize = OO_MPI_IO_Base<ItemType>::getWindowItems();
+   std::vector<ItemType> staging[2];
+   if ( !sameType ) {
+      staging[0].resize( std::min(windowSize, count) );
+      staging[1].resize( staging[0].size() );
+   }
+   // where the window starting at Item start is read to
+   auto windowBuffer = [&](unsigned long start, int which) -> ItemType* {
+      return sameType ? reinterpret_cast<ItemType*>(items + start) 
+                      : staging[which].data();
+   };
+   unsigned long start = 0;
+   unsigned long length = std::min(windowSize, count);
+   int which = 0;
+   MPI_Request request;
+   readResult = timedIreadAt(stats, fh, byteOffset, windowBuffer(0, which), 
+                                     length, mpiType, &request);
+   checkResult(readResult);
+   while (length > 0) {
+      timedWait(stats, READ_OP, &request, &status);
+      ItemType* window = windowBuffer(start, which);
+      unsigned long nextStart = start + length;
+      unsigned long nextLength = std::min(windowSize, count - nextStart);
+      if (nextLength > 0) {                      // start the next window...
+         readResult = timedIreadAt(stats, fh, byteOffset + nextStart * itemSize,
+                                           windowBuffer(nextStart, 1 - which), 
+                                           nextLength, mpiType, &request);
+         checkResult(readResult);
+      }
+      if ( isVerifying() ) {                     // ...check this one
+         myCrcs.add(window, length * itemSize);
+      }
+      OO_MPI_IO_Base<ItemType>::convertItems(window, length);
+      if ( !sameType ) {                         // ...and convert this one
+         convertNumbers(window, items + start, length);
+      }
+      start = nextStart;
+      length = nextLength;
+      which = 1 - which;
+   }
+   if ( isVerifying() ) {
+      finishChecking(firstByte + count * itemSize);
+   }
+}
+
+/* utilities to begin and finish checksumming a range of the file
+ * @param: firstByte, endByte, the offsets (from the first Item) of
+ *          the range's first byte and of the byte after it.
+ * Precondition: isVerifying() 
+ *           &&  (finishChecking()) beginChecking(firstByte) has been
+ *                called, and the range's bytes have been added to myCrcs.
+ * Postcondition: (beginChecking()) the bytes from the start of 
+ *                 firstByte's block to firstByte have been added to 
+ *                 myCrcs, and (finishChecking()) those from endByte to 
+ *                 the end of its block, and the blocks have been checked.
+ * Note: The blocks at either end are checked whole, so their other 
+ *        bytes are read too (just to checksum them).
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::beginChecking(uint64_t firstByte) {
+   uint64_t dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   uint64_t blockStart = firstByte - firstByte % myCrcBlockBytes;
+   myCrcs.begin(blockStart, myCrcBlockBytes);
+   readBytes(dataOffset + blockStart, firstByte - blockStart);
+}
+
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::finishChecking(uint64_t endByte) {
+   uint64_t dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   uint64_t dataBytes = OO_MPI_IO_Base<ItemType>::getNumItemsInFile() 
+                         * OO_MPI_IO_Base<ItemType>::getItemSize();
+   uint64_t blockEnd = std::min(dataBytes, endByte + (myCrcBlockBytes 
+                                 - endByte % myCrcBlockBytes) % myCrcBlockBytes);
+   readBytes(dataOffset + endByte, blockEnd - endByte);
+   myCrcs.finish();
+   checkBlocks();
+}
+
+/* utility to read bytes (just to checksum them)
+ * @param: byteOffset, an MPI_Offset
+ * @param: numBytes, an unsigned long (less than a block).
+ * Postcondition: the numBytes bytes at byteOffset have been added to myCrcs.
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::readBytes(MPI_Offset byteOffset, 
+                                                         unsigned long numBytes) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (numBytes == 0) {
+      return;
+   }
+   std::vector<unsigned char> bytes(numBytes);
+   MPI_Status status;
+   int readResult = timedReadAt(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(),
+                                        byteOffset, bytes.data(), numBytes,
+                                        MPI_BYTE, &status);
+   checkResult(readResult);
+   myCrcs.add(bytes.data(), numBytes);
+}
+
+/* utility to compare the CRCs of the blocks just read with the sidecar's
+ * Postcondition: each block whose CRC differs has been reported
+ *                 (and the program aborted, or the block's number 
+ *                  added to getCorruptBlocks()).
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::checkBlocks() {
+   for (long p = 0; p < myCrcs.getNumPieces(); ++p) {
+      uint64_t block = myCrcs.getBlock(p);
+      if (myCrcs.getCrc(p) == myBlockCrcs[block]) {
+         continue;
+      }
+      uint64_t firstByte = OO_MPI_IO_Base<ItemType>::getDataOffset() 
+                            + block * myCrcBlockBytes;
+      fprintf(stderr, "\nParallelReader: PE %d: block %llu (bytes %llu..%llu)"
+                      " of '%s' fails its CRC32C check\n\n",
+                      OO_MPI_IO_Base<ItemType>::getID(),
+                      (unsigned long long) block,
+                      (unsigned long long) firstByte,
+                      (unsigned long long)(firstByte + myCrcs.getLength(p) - 1),
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+      if (myAbortOnFailure) {
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      myCorruptBlocks.push_back(block);
+   }
+}
+
+/* method to read a chunk from the file (in its entirety).
+ * Return: a vector containing the values of this PE's chunk
+ *          (converted to DeliveredType, if need be).
+ * Note: vector was chosen as the return-type because it
+ *        uses contiguous memory and provides a move-constructor.
+ *       If the file system's profile has collective set (see 
+ *        OO_MPI_IO_Profile), then in MPI mode this (like readChunkPlus())
+ *        is a collective call (MPI_File_read_at_all()).
+ */
+template <class ItemType, class DeliveredType>
+std::vector<DeliveredType> 
+ParallelReader<ItemType, DeliveredType>::readChunk() {
+   OO_MPI_IO_TraceSpan span("readChunk");
+   setFileInfo();
+
+   long start = 0, stop = 0;
+   getChunkStartStopValues(OO_MPI_IO_Base<ItemType>::getID(), 
+                           OO_MPI_IO_Base<ItemType>::getNumPEs(),
+                           OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
+                           start, stop);
+   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(
+                              OO_MPI_IO_Base<ItemType>::getDataOffset() +
+                              start * OO_MPI_IO_Base<ItemType>::getItemSize());
+
+   std::vector<DeliveredType> v( OO_MPI_IO_Base<ItemType>::getChunkSize() );
+   readRange(OO_MPI_IO_Base<ItemType>::getFirstByteOffset(), 
+              v.data(), v.size(), OO_MPI_IO_Base<ItemType>::usesCollectiveIO());
+
+   return v;
+}
+
+/* method to read a chunk from the file (in its entirety)
+ *  plus a few items from the next PE's chunk.
+ *  This version of the method is useful for search problems where
+ *  the sought-after value straddles the boundary between two chunks.
+ * @param: numExtras, an unsigned.
+ * Precondition: numExtras is the number of additional Items to be read
+ *                beyond the end of this PE's chunk.
+ * Return: a vector containing the values of this PE's chunk
+ *          plus numExtras values of the next PE's chunk
+ *          for all PEs except the last one.
+ *
+ * Note: Giving numExtras a default parameter value would let us eliminate
+ *        the other readChunk() method and adhere to the DRY principle,
+ *        but defining each separately lets us more clearly explain
+ *        the difference between the two versions.
+ */
+template <class ItemType, class DeliveredType>
+std::vector<DeliveredType>
+ParallelReader<ItemType, DeliveredType>::readChunkPlus(unsigned numExtras) {
+   OO_MPI_IO_TraceSpan span("readChunkPlus");
+   setFileInfo();
+
+   long numItemsInFile = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   long start = 0, stop = 0;
+   int id = OO_MPI_IO_Base<ItemType>::getID();
+   int numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+   getChunkStartStopValues(id, numPEs, numItemsInFile, start, stop);
+   if (id < numPEs-1) {
+      stop += numExtras;
+   }
+   if (stop > numItemsInFile ) {
+      stop = numItemsInFile;
+   }
+   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(
+                              OO_MPI_IO_Base<ItemType>::getDataOffset() +
+                              start * OO_MPI_IO_Base<ItemType>::getItemSize());
+
+   std::vector<DeliveredType> v( OO_MPI_IO_Base<ItemType>::getChunkSize() );
+   readRange(OO_MPI_IO_Base<ItemType>::getFirstByteOffset(), 
+              v.data(), v.size(), OO_MPI_IO_Base<ItemType>::usesCollectiveIO());
+
+   return v;
+}
+
+/* method to read an arbitrary set of Items from the file
+ * @param: indices, a vector of Item numbers.
+ * Precondition: each value in indices is less than getNumItemsInFile()
+ *                (the indices need not be sorted or unique).
+ * Return: a vector v whose i-th value is Item number indices[i].
+ *
+ * The indices are sorted and de-duplicated, then indices that are
+ *  within getGapThreshold() Items of one another are merged into 
+ *  ranges, so that all the ranges can be read with a single 
+ *  (indexed file view) read (see OO_MPI_IO_Base::readRanges());
+ *  the Items in the gaps are discarded.
+ *
+ * Note: In MPI mode this is a collective call (MPI_File_read_all),
+ *        so every process must call it (possibly with no indices).
+ */
+template <class ItemType, class DeliveredType>
+std::vector<DeliveredType>
+ParallelReader<ItemType, DeliveredType>::readItems(const std::vector<uint64_t>& indices) {
+   OO_MPI_IO_TraceSpan span("readItems");
+   setFileInfo();
+
+   std::vector<uint64_t> sorted(indices);
+   std::sort(sorted.begin(), sorted.end());
+   sorted.erase( std::unique(sorted.begin(), sorted.end()), sorted.end() );
+   if ( !sorted.empty() && 
+         sorted.back() >= (uint64_t)OO_MPI_IO_Base<ItemType>::getNumItemsInFile() ) {
+      fprintf(stderr, "\nParallelReader::readItems(): index %llu is beyond"
+                      " the end of '%s'\n\n", 
+                      (unsigned long long)sorted.back(),
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   // coalesce nearby indices into ranges
+   std::vector<uint64_t> rangeStarts;
+   std::vector<int> rangeLengths;
+   for (unsigned long i = 0; i < sorted.size(); ++i) {
+      if ( !rangeStarts.empty() && 
+            sorted[i] - (rangeStarts.back() + rangeLengths.back()) 
+              <= myGapThreshold &&
+            sorted[i] - rangeStarts.back() < INT_MAX ) {
+         rangeLengths.back() = sorted[i] - rangeStarts.back() + 1;
+      } else {
+         rangeStarts.push_back(sorted[i]);
+         rangeLengths.push_back(1);
+      }
+   }
+
+   std::vector<long> bufferOffsets(rangeStarts.size() + 1, 0);
+   for (unsigned long r = 0; r < rangeStarts.size(); ++r) {
+      bufferOffsets[r+1] = bufferOffsets[r] + rangeLengths[r];
+   }
+   std::vector<ItemType> buffer( bufferOffsets.back() );
+   OO_MPI_IO_Base<ItemType>::readRanges(rangeStarts, rangeLengths, 
+                                         buffer.data());
+
+   // return the Items in the caller's order
+   std::vector<DeliveredType> v( indices.size() );
+   for (unsigned long i = 0; i < indices.size(); ++i) {
+      int r = std::upper_bound(rangeStarts.begin(), rangeStarts.end(), 
+                                indices[i]) - rangeStarts.begin() - 1;
+      v[i] = static_cast<DeliveredType>(
+                buffer[ bufferOffsets[r] + (indices[i] - rangeStarts[r]) ] );
+   }
+   return v;
+}
+
+/* method to reduce this PE's chunk of the file, without reading
+ *  it into memory all at once
+ * @param: op, an op (e.g., SumOp<DeliveredType>(), see "Streaming
+ *          reductions" above)
+ * @param: windowItems, an unsigned long (default 0).
+ * Precondition: op's accumulate() takes DeliveredType Items.
+ * Return: op's result for the Items of every PE's chunk (i.e., of the
+ *          whole file), combined in order of id, so every PE gets
+ *          the same result.
+ * Note: The chunk is read windowItems Items at a time (by default, 
+ *        OO_MPI_IO_REDUCE_WINDOW bytes' worth, so a window stays in
+ *        cache while op accumulates it) into a buffer that is reused,
+ *        so memory use does not grow with the size of the file.
+ *       If isVerifying(), windows are whole checksummed blocks.
+ *       In MPI mode this is a collective call (the results are
+ *        combined with MPI_Allgather()); in OpenMP mode every thread
+ *        of the team must call it (the results are combined between
+ *        barriers).
+ */
+template <class ItemType, class DeliveredType>
+template <class Op>
+typename Op::Result
+ParallelReader<ItemType, DeliveredType>::reduce(const Op& op, 
+                                                 unsigned long windowItems) {
+   OO_MPI_IO_TraceSpan span("reduce");
+   setFileInfo();
+
+   long start = 0, stop = 0;
+   int id = OO_MPI_IO_Base<ItemType>::getID();
+   int numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   getChunkStartStopValues(id, numPEs, 
+                           OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
+                           start, stop);
+   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(
+                              OO_MPI_IO_Base<ItemType>::getDataOffset() +
+                              start * itemSize);
+
+   if (windowItems == 0) {
+      windowItems = std::max(1UL, OO_MPI_IO_REDUCE_WINDOW / sizeof(DeliveredType));
+   }
+   if ( isVerifying() ) {                     // (so blocks are read once)
+      unsigned long blockItems = std::max(1L, myCrcBlockBytes / itemSize);
+      windowItems = (windowItems + blockItems - 1) / blockItems * blockItems;
+   }
+   std::vector<DeliveredType> window( std::min(windowItems, 
+                                               (unsigned long)(stop - start)) );
+   typename Op::Result result = op.identity();
+   // windows end at multiples of windowItems (block boundaries)
+   for (long first = start; first < stop; ) {
+      long last = std::min(stop, (first / (long) windowItems + 1) 
+                                  * (long) windowItems);
+      readRange(OO_MPI_IO_Base<ItemType>::getDataOffset() + first * itemSize,
+                 window.data(), last - first, false);
+      op.accumulate(result, window.data(), last - first);
+      first = last;
+   }
+
+   if ( OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      return combineOverProcesses(op, result);
+   } else if (numPEs > 1) {
+      return combineOverThreads(op, result, id, numPEs);
+   }
+   return result;
+}
+
+/* method to begin reading this PE's chunk in parts, each read 
+ *  without blocking, so that the caller can work on one part while 
+ *  the next is being read (see transformFile())
+ * Return: the number of Items in this PE's chunk (as for readChunk()).
+ * Postcondition: getChunkSize() and getFirstItemOffset() are set,
+ *                 as readChunk() sets them
+ *            &&  startPart() will read the chunk's first Items.
+ */
+template <class ItemType, class DeliveredType>
+long ParallelReader<ItemType, DeliveredType>::beginChunk() {
+   OO_MPI_IO_TraceSpan span("beginChunk");
+   setFileInfo();
+
+   long start = 0, stop = 0;
+   getChunkStartStopValues(OO_MPI_IO_Base<ItemType>::getID(), 
+                           OO_MPI_IO_Base<ItemType>::getNumPEs(),
+                           OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
+                           start, stop);
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(
+                              OO_MPI_IO_Base<ItemType>::getDataOffset() +
+                              start * itemSize);
+   myNextPartOffset = OO_MPI_IO_Base<ItemType>::getFirstByteOffset();
+   if ( isVerifying() && stop > start ) {
+      beginChecking(start * itemSize);
+   }
+   return stop - start;
+}
+
+/* method to start reading the next part of this PE's chunk
+ * @param: buffer, the address of a buffer
+ * @param: count, an unsigned long
+ * @param: request, the address of an MPI_Request.
+ * Precondition: beginChunk() has been called
+ *           &&  buffer has room for count (<= INT_MAX) Items
+ *           &&  the chunk has at least count Items left to start.
+ * Postcondition: the read of those Items (in the file's format) into
+ *                 buffer has been started, and *request is its request.
+ * Note: Parts are started, and then finished, in order.
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::startPart(ItemType* buffer, 
+                                                         unsigned long count,
+                                                         MPI_Request* request) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   int readResult = timedIreadAt(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(),
+                                         myNextPartOffset, buffer, count, 
+                                         OO_MPI_IO_Base<ItemType>::getMPIType(),
+                                         request);
+   checkResult(readResult);
+   myNextPartOffset += count * OO_MPI_IO_Base<ItemType>::getItemSize();
+}
+
+/* method to finish reading the next part of this PE's chunk
+ * @param: buffer, count, request, as passed to startPart().
+ * Precondition: startPart(buffer, count, request) started the oldest
+ *                part that has not been finished.
+ * Postcondition: buffer[0..count-1] contain the part's Items, in the 
+ *                 host's byte order (and, if isVerifying(), they have
+ *                 been checksummed).
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::finishPart(ItemType* buffer, 
+                                                          unsigned long count,
+                                                          MPI_Request* request) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_Status status;
+   timedWait(stats, READ_OP, request, &status);
+   if ( isVerifying() ) {
+      myCrcs.add(buffer, count * OO_MPI_IO_Base<ItemType>::getItemSize());
+   }
+   OO_MPI_IO_Base<ItemType>::convertItems(buffer, count);
+}
+
+/* method to finish reading this PE's chunk in parts
+ * Precondition: every part of the chunk has been finished.
+ * Postcondition: if isVerifying(), the chunk's blocks have been checked
+ *                 (see verifyChecksums()).
+ */
+template <class ItemType, class DeliveredType>
+void ParallelReader<ItemType, DeliveredType>::endChunk() {
+   OO_MPI_IO_TraceSpan span("endChunk");
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   long start = OO_MPI_IO_Base<ItemType>::getFirstItemOffset();
+   long chunkSize = OO_MPI_IO_Base<ItemType>::getChunkSize();
+   if ( isVerifying() && chunkSize > 0 ) {
+      finishChecking((start + chunkSize) * itemSize);
+   }
+}
+
+/*******************************************************************
+ * The RangeScanReader template provides an abstraction to hide the
+ *  details of reading just the Items of a file that are within a
+ *  range of values, using the file's zone map (see enableZoneMap()
+ *  and buildZoneMap()) to skip the blocks that hold no such Items.
+ *
+ * The blocks that might hold such Items are divided evenly among 
+ *  the PEs, so the PEs' shares of a scan are balanced no matter 
+ *  where in the file those blocks are.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType> 
+class RangeScanReader : public OO_MPI_IO_Base<ItemType> {
+public:
+  RangeScanReader(const std::string& fileName, MPI_Datatype mpiType,
+                   int id, int numPEs);
+  std::vector<ItemType> scanRange(const ItemType& low, const ItemType& high);
+
+  long getNumBlocks() const                { return myCounts.size(); }
+  long getBlockItems() const               { return myBlockItems; }
+  ItemType getBlockMin(long block) const   { return myMinimums[block]; }
+  ItemType getBlockMax(long block) const   { return myMaximums[block]; }
+  uint64_t getBlockCount(long block) const { return myCounts[block]; }
+  long getNumBlocksMatched() const         { return myNumBlocksMatched; }
+  long getNumBlocksRead() const            { return myNumBlocksRead; }
+  long getNumItemsRead() const             { return myNumItemsRead; }
+private:
+  void loadZoneMap();
+
+  long                  myBlockItems;       // Items per block
+  std::vector<ItemType> myMinimums;         // each block's least Item,
+  std::vector<ItemType> myMaximums;         //  its greatest Item,
+  std::vector<uint64_t> myCounts;           //  and how many are not NaN
+  long                  myNumBlocksMatched; // last scan: blocks (all PEs)
+  long                  myNumBlocksRead;    //  blocks this PE read
+  long                  myNumItemsRead;     //  Items this PE read
+};
+
+/* RangeScanReader constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType,
+ *                which has a zone map
+ *           &&  ItemType is an arithmetic type of at most 8 bytes
+ *           &&  mpiType is the MPI_Datatype that corresonds to ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
+ * Postcondition: the file has been opened for parallel input
+ *           &&  its header (if any) and zone map have been loaded
+ *           &&  getNumBlocksMatched() == getNumBlocksRead() == 0.
+ * Note: In MPI mode, every process must construct its RangeScanReader
+ *        (as process 0 reads the header and zone map and broadcasts them).
+ */
+template <class ItemType>
+RangeScanReader<ItemType>::
+RangeScanReader(const std::string& fileName, MPI_Datatype mpiType,
+                 int id, int numPEs)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, id, numPEs)
+{
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if ( !std::is_arithmetic<ItemType>::value || sizeof(ItemType) > 8 ) {
+      fprintf(stderr, "\nRangeScanReader(): only arithmetic Items"
+                      " of at most 8 bytes have zones\n\n");
+      exit(1);
+   }
+   myNumBlocksMatched = myNumBlocksRead = myNumItemsRead = 0;
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+   if ( !OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      MPI_Offset fileSize;
+      timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+      OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+      OO_MPI_IO_Base<ItemType>::setNumItemsInFile(fileSize / sizeof(ItemType));
+   }
+   loadZoneMap();
+}
+
+/* utility to load the file's zone map
+ * Postcondition: myBlockItems, myMinimums, myMaximums and myCounts
+ *                 describe the file's blocks (in the host's byte order),
+ *                 or, if the zone map is missing or does not match
+ *                 the file, an error has been reported and
+ *                 the program has been terminated.
+ */
+template <class ItemType>
+void RangeScanReader<ItemType>::loadZoneMap() {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   std::string zoneFileName = 
+                 getZoneMapFileName( OO_MPI_IO_Base<ItemType>::getFileName() );
+   bool collective = OO_MPI_IO_Base<ItemType>::isCollective();
+   bool readsFile = !collective || OO_MPI_IO_Base<ItemType>::getID() == 0;
+
+   OO_MPI_IO_ZonePrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   MPI_File zoneFile;
+   int openResult = MPI_SUCCESS;
+   if (readsFile) {
+      openResult = timedOpen(stats, MPI_COMM_SELF, zoneFileName.c_str(),
+                                     MPI_MODE_RDONLY, MPI_INFO_NULL, &zoneFile);
+      if (openResult == MPI_SUCCESS) {
+         MPI_Status status;
+         int readResult = timedReadAt(stats, zoneFile, 0, &prologue, 
+                                              sizeof(prologue), MPI_BYTE, &status);
+         checkResult(readResult);
+      }
+   }
+   if (collective) {
+      MPI_Bcast(&prologue, sizeof(prologue), MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   uint32_t reversedMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   swapBytes(&reversedMark, 1, 4);
+   bool foreignOrder = (prologue.byteOrderMark == reversedMark);
+   if (foreignOrder) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&prologue);
+      swapBytes(bytes + offsetof(OO_MPI_IO_ZonePrologue, version), 
+                 4, 4);                           // version .. itemSize
+      swapBytes(bytes + offsetof(OO_MPI_IO_ZonePrologue, blockItems), 
+                 3, 8);                           // blockItems .. numItems
+   }
+   uint64_t numItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   if (memcmp(prologue.magic, OO_MPI_IO_ZONE_MAGIC, 8) != 0 ||
+        prologue.byteOrderMark != OO_MPI_IO_BYTE_ORDER_MARK ||
+        prologue.itemSize != sizeof(ItemType) || prologue.blockItems == 0 ||
+        prologue.typeCode != (uint32_t) getTypeCode<ItemType>() ||
+        prologue.dataOffset != (uint64_t) 
+                                OO_MPI_IO_Base<ItemType>::getDataOffset() ||
+        prologue.numItems != numItems) {
+      fprintf(stderr, "\nRangeScanReader: '%s' is missing"
+                      " or does not match '%s'\n\n", zoneFileName.c_str(),
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   uint64_t numBlocks = (numItems + prologue.blockItems - 1) 
+                         / prologue.blockItems;
+   std::vector<OO_MPI_IO_ZoneEntry> entries(numBlocks);
+   if (readsFile) {
+      MPI_Status status;
+      int readResult = timedReadAt(stats, zoneFile, sizeof(prologue), 
+                                           entries.data(), numBlocks * 3,
+                                           MPI_UINT64_T, &status);
+      checkResult(readResult);
+      timedClose(stats, &zoneFile);
+   }
+   if (collective) {
+      MPI_Bcast(entries.data(), numBlocks * 3, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+   }
+   myBlockItems = prologue.blockItems;
+   myMinimums.resize(numBlocks);
+   myMaximums.resize(numBlocks);
+   myCounts.resize(numBlocks);
+   for (uint64_t b = 0; b < numBlocks; ++b) {
+      if (foreignOrder) {
+         swapBytes(&entries[b].minimum, 1, sizeof(ItemType));
+         swapBytes(&entries[b].maximum, 1, sizeof(ItemType));
+         swapBytes(&entries[b].count, 1, 8);
+      }
+      memcpy(&myMinimums[b], &entries[b].minimum, sizeof(ItemType));
+      memcpy(&myMaximums[b], &entries[b].maximum, sizeof(ItemType));
+      myCounts[b] = entries[b].count;
+   }
+}
+
+/* method to read the Items of the file that are in a range of values
+ * @param: low, high, ItemType values.
+ * Return: this PE's share of the Items x of the file such that
+ *          low <= x && x <= high, in file order 
+ *          (concatenating the PEs' shares in order of id gives 
+ *           all such Items, in file order).
+ * Postcondition: getNumBlocksMatched() is the number of blocks whose
+ *                 zones overlap [low, high], which are the only blocks
+ *                 read; they were divided among the PEs by Item count
+ *            &&  getNumBlocksRead() and getNumItemsRead() are the 
+ *                 numbers of blocks and Items this PE read.
+ * Note: Each run of adjacent blocks is read (a window at a time) with
+ *        non-blocking reads, all of which are in flight at once.
+ *       Every PE finds the same matching blocks from the zone map,
+ *        so no communication is needed.
+ */
+template <class ItemType>
+std::vector<ItemType> RangeScanReader<ItemType>::scanRange(const ItemType& low,
+                                                            const ItemType& high) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   uint64_t numItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   std::vector<uint64_t> matched;
+   uint64_t totalItems = 0;
+   for (unsigned long b = 0; b < myCounts.size(); ++b) {
+      if (myCounts[b] > 0 && myMinimums[b] <= high && low <= myMaximums[b]) {
+         matched.push_back(b);
+         totalItems += std::min<uint64_t>(myBlockItems, numItems - b * myBlockItems);
+      }
+   }
+   myNumBlocksMatched = matched.size();
+
+   // my blocks: those that begin in my share of the matched Items
+   uint64_t id = OO_MPI_IO_Base<ItemType>::getID();
+   uint64_t numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+   uint64_t myFirst = totalItems * id / numPEs;
+   uint64_t myStop = totalItems * (id + 1) / numPEs;
+   std::vector<uint64_t> runStarts, runLengths;   // in Items
+   uint64_t before = 0, count = 0;
+   myNumBlocksRead = 0;
+   for (unsigned long m = 0; m < matched.size(); ++m) {
+      uint64_t first = matched[m] * myBlockItems;
+      uint64_t length = std::min<uint64_t>(myBlockItems, numItems - first);
+      if (before >= myFirst && before < myStop) {
+         if ( !runStarts.empty() && 
+               runStarts.back() + runLengths.back() == first ) {
+            runLengths.back() += length;
+         } else {
+            runStarts.push_back(first);
+            runLengths.push_back(length);
+         }
+         count += length;
+         ++myNumBlocksRead;
+      }
+      before += length;
+   }
+   myNumItemsRead = count;
+
+   std::vector<ItemType> v(count);
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   MPI_Datatype mpiType = OO_MPI_IO_Base<ItemType>::getMPIType();
+   long itemSize = sizeof(ItemType);
+   uint64_t windowSize = OO_MPI_IO_Base<ItemType>::getWindowItems();
+   uint64_t dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   std::vector<MPI_Request> requests;
+   ItemType* next = v.data();
+   for (unsigned long r = 0; r < runStarts.size(); ++r) {
+      for (uint64_t done = 0; done < runLengths[r]; done += windowSize) {
+         uint64_t length = std::min(windowSize, runLengths[r] - done);
+         MPI_Request request;
+         int readResult = timedIreadAt(stats, fh, dataOffset + 
+                                               (runStarts[r] + done) * itemSize,
+                                               next, length, mpiType, &request);
+         checkResult(readResult);
+         requests.push_back(request);
+         next += length;
+      }
+   }
+   timedWaitall(stats, READ_OP, requests.size(), requests.data(),
+                 MPI_STATUSES_IGNORE);
+   OO_MPI_IO_Base<ItemType>::convertItems(v.data(), count);
+
+   // keep the Items in the range (in place)
+   unsigned long kept = 0;
+   for (unsigned long i = 0; i < count; ++i) {
+      if (low <= v[i] && v[i] <= high) {
+         v[kept++] = v[i];
+      }
+   }
+   v.resize(kept);
+   return v;
+}
+
+/* Utility to build the zone map of an existing file
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: blockItems, a long (default OO_MPI_IO_ZONE_ITEMS).
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType
+ *                (with or without a header, in either byte order)
+ *           &&  ItemType is an arithmetic type of at most 8 bytes
+ *           &&  blockItems > 0.
+ * Postcondition: each PE has read its chunk of the file and found
+ *                 the zones of its blocks, and process 0 has written
+ *                 the file's zone map, getZoneMapFileName(fileName).
+ * Note: This is a collective call (see saveZoneMap()).
+ */
+template <class ItemType>
+void buildZoneMap(const std::string& fileName, MPI_Datatype mpiType,
+                   int id, int numPEs, long blockItems = OO_MPI_IO_ZONE_ITEMS) {
+   if (blockItems <= 0 || !std::is_arithmetic<ItemType>::value || 
+        sizeof(ItemType) > 8) {
+      fprintf(stderr, "\nbuildZoneMap(): bad blockItems (%ld), or Items"
+                      " that are not arithmetic (of at most 8 bytes)\n\n",
+                      blockItems);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   ParallelReader<ItemType> reader(fileName, mpiType, id, numPEs);
+   std::vector<ItemType> chunk = reader.readChunk();
+   OO_MPI_IO_ZoneAccumulator<ItemType> zones;
+   zones.begin(reader.getFirstItemOffset(), blockItems);
+   zones.add(chunk.data(), chunk.size());
+   reader.close();
+   saveZoneMap(fileName, zones, reader.getDataOffset(), 
+                reader.getNumItemsInFile());
+}
+
+/*******************************************************************
+ * The SortedLookup template provides an abstraction to hide the
+ *  details of looking up batches of keys in a file of sorted Items
+ *  (exact matches and lower bounds), without reading the whole file.
+ *
+ * Its constructor builds a fence index (every K-th Item) that every
+ *  PE holds; the fences split the file into blocks of K Items, so
+ *  a key's fences name the one block that can resolve it. In MPI
+ *  mode, each key is routed to the PE that owns its block, which
+ *  reads all the blocks its keys need with one coalesced read,
+ *  so no block is read by more than one PE per batch.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+const long OO_MPI_IO_FENCE_INTERVAL = 4096;  // default Items per fence
+
+template<class ItemType> 
+class SortedLookup : public OO_MPI_IO_Base<ItemType> {
+public:
+  SortedLookup(const std::string& fileName, MPI_Datatype mpiType,
+                int id, int numPEs, 
+                long fenceInterval = OO_MPI_IO_FENCE_INTERVAL);
+  std::vector<uint64_t> lowerBound(const std::vector<ItemType>& keys);
+  std::vector<int64_t> find(const std::vector<ItemType>& keys);
+
+  long getFenceInterval() const                 { return myFenceInterval; }
+  const std::vector<ItemType>& getFences() const { return myFences; }
+  long getNumBlocksRead() const                 { return myNumBlocksRead; }
+private:
+  void loadFences();
+  std::vector<uint64_t> lookUp(const std::vector<ItemType>& keys);
+  std::vector<uint64_t> resolve(const std::vector<ItemType>& keys);
+  long findBlock(const ItemType& key) const;
+  int getOwner(long block) const;
+
+  long                  myFenceInterval;   // Items per block (K)
+  std::vector<ItemType> myFences;          // Items 0, K, 2K, ...
+  long                  myNumBlocksRead;   // by the last batch
+};
+
+/* SortedLookup constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: fenceInterval, a long (default OO_MPI_IO_FENCE_INTERVAL).
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType,
+ *                in ascending order (by operator<)
+ *           &&  mpiType is the MPI_Datatype that corresonds to ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes
+ *           &&  fenceInterval > 0.
+ * Postcondition: the file has been opened for parallel input
+ *           &&  getFences() holds every fenceInterval-th Item
+ *                of the file (starting with the first).
+ * Note: In MPI mode, every process must construct its SortedLookup
+ *        (as each process reads its share of the fences, and
+ *         then they all gather all of them).
+ */
+template <class ItemType>
+SortedLookup<ItemType>::
+SortedLookup(const std::string& fileName, MPI_Datatype mpiType,
+              int id, int numPEs, long fenceInterval)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, id, numPEs)
+{
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (fenceInterval <= 0) {
+      fprintf(stderr, "\nSortedLookup(): bad fenceInterval (%ld)\n\n",
+                      fenceInterval);
+      exit(1);
+   }
+   myFenceInterval = fenceInterval;
+   myNumBlocksRead = 0;
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+   if ( !OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      MPI_Offset fileSize;
+      timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+      OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+      OO_MPI_IO_Base<ItemType>::setNumItemsInFile(fileSize / sizeof(ItemType));
+   }
+   loadFences();
+}
+
+/* utility to read the fences
+ * Postcondition: myFences holds Items 0, K, 2K, ... of the file.
+ * Note: In MPI mode, each process reads (with one strided read) 
+ *        an equal share of the fences, then all gather them;
+ *        in OpenMP mode, each thread reads them all.
+ */
+template <class ItemType>
+void SortedLookup<ItemType>::loadFences() {
+   long numItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   long numFences = (numItems + myFenceInterval - 1) / myFenceInterval;
+   bool collective = OO_MPI_IO_Base<ItemType>::isCollective();
+   long id = OO_MPI_IO_Base<ItemType>::getID();
+   long numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+   long first = collective ? numFences * id / numPEs : 0;
+   long stop = collective ? numFences * (id + 1) / numPEs : numFences;
+   std::vector<uint64_t> starts;
+   for (long f = first; f < stop; ++f) {
+      starts.push_back(f * myFenceInterval);
+   }
+   std::vector<int> lengths(starts.size(), 1);
+   myFences.resize(numFences);
+   OO_MPI_IO_Base<ItemType>::readRanges(starts, lengths, 
+                                         myFences.data() + first);
+   if ( !collective ) {
+      return;
+   }
+   std::vector<int> counts(numPEs), displacements(numPEs);
+   for (long pe = 0; pe < numPEs; ++pe) {
+      displacements[pe] = numFences * pe / numPEs * sizeof(ItemType);
+      counts[pe] = numFences * (pe + 1) / numPEs * sizeof(ItemType) 
+                    - displacements[pe];
+   }
+   MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, myFences.data(), 
+                  counts.data(), displacements.data(), MPI_BYTE, 
+                  MPI_COMM_WORLD);
+}
+
+/* utility to find the block that can resolve a key
+ * Return: the number of the last block whose fence is less than key
+ *          (-1 if there is none, i.e., key <= Item 0).
+ */
+template <class ItemType>
+long SortedLookup<ItemType>::findBlock(const ItemType& key) const {
+   return std::lower_bound(myFences.begin(), myFences.end(), key) 
+           - myFences.begin() - 1;
+}
+
+/* utility to find the PE that owns a block (blocks are split 
+ *  evenly among the PEs, in order)
+ */
+template <class ItemType>
+int SortedLookup<ItemType>::getOwner(long block) const {
+   return block * OO_MPI_IO_Base<ItemType>::getNumPEs() / myFences.size();
+}
+
+/* method to find the lower bound of each of a batch of keys
+ * @param: keys, a vector of ItemType values (in any order).
+ * Return: a vector whose i-th value is the number of the first Item
+ *          of the file that is not less than keys[i]
+ *          (getNumItemsInFile() if there is none).
+ * Note: In MPI mode this is a collective call, so every process must
+ *        call it (possibly with no keys).
+ */
+template <class ItemType>
+std::vector<uint64_t> 
+SortedLookup<ItemType>::lowerBound(const std::vector<ItemType>& keys) {
+   std::vector<uint64_t> v = lookUp(keys);
+   for (unsigned long i = 0; i < v.size(); ++i) {
+      v[i] >>= 1;
+   }
+   return v;
+}
+
+/* method to find each of a batch of keys
+ * @param: keys, a vector of ItemType values (in any order).
+ * Return: a vector whose i-th value is the number of the first Item
+ *          of the file that equals keys[i] (-1 if there is none).
+ * Note: In MPI mode this is a collective call, so every process must
+ *        call it (possibly with no keys).
+ */
+template <class ItemType>
+std::vector<int64_t> 
+SortedLookup<ItemType>::find(const std::vector<ItemType>& keys) {
+   std::vector<uint64_t> codes = lookUp(keys);
+   std::vector<int64_t> v( codes.size() );
+   for (unsigned long i = 0; i < v.size(); ++i) {
+      v[i] = (codes[i] & 1) ? (int64_t)(codes[i] >> 1) : -1;
+   }
+   return v;
+}
+
+/* utility to look up a batch of keys
+ * @param: keys, a vector of ItemType values.
+ * Return: a vector whose i-th value is 2 * (the lower bound of keys[i])
+ *          + (1 if that Item equals keys[i], 0 otherwise).
+ *
+ * A key that is at most Item 0 is resolved from the fences alone.
+ *  The others are sent (in MPI mode) to the owners of their blocks,
+ *  resolved there, and the answers sent back.
+ *  (A key equal to a fence still needs its block, as equal Items
+ *   may precede the fence.)
+ */
+template <class ItemType>
+std::vector<uint64_t> 
+SortedLookup<ItemType>::lookUp(const std::vector<ItemType>& keys) {
+   long numFences = myFences.size();
+   std::vector<uint64_t> codes( keys.size() );
+   // sort the keys (which sorts them by block), so that their blocks
+   //  can be found by walking the fences, and each later pass is 
+   //  sequential
+   std::vector< std::pair<ItemType, long> > sorted( keys.size() );
+   for (unsigned long i = 0; i < keys.size(); ++i) {
+      sorted[i] = std::make_pair(keys[i], (long) i);
+   }
+   std::sort(sorted.begin(), sorted.end());
+   std::vector<long> pending, blocks;            // (positions in keys)
+   std::vector<ItemType> pendingKeys;
+   long block = -1;
+   for (unsigned long k = 0; k < sorted.size(); ++k) {
+      const ItemType& key = sorted[k].first;
+      while (block + 1 < numFences && myFences[block+1] < key) {
+         ++block;
+      }
+      if (block < 0) {                                  // Item 0, or none
+         codes[ sorted[k].second ] = 
+                       (numFences > 0 && !(key < myFences[0])) ? 1 : 0;
+      } else {
+         pending.push_back( sorted[k].second );
+         blocks.push_back(block);
+         pendingKeys.push_back(key);
+      }
+   }
+
+   std::vector<uint64_t> answers;
+   if ( !OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      answers = resolve(pendingKeys);
+   } else {
+      // send each key to its block's owner (they are sorted by block)
+      int numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+      std::vector<int> sendCounts(numPEs, 0), recvCounts(numPEs, 0);
+      for (unsigned long k = 0; k < pending.size(); ++k) {
+         ++sendCounts[ getOwner(blocks[k]) ];
+      }
+      MPI_Alltoall(sendCounts.data(), 1, MPI_INT, 
+                    recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+      std::vector<int> sendDispls(numPEs, 0), recvDispls(numPEs, 0);
+      for (int p = 1; p < numPEs; ++p) {
+         sendDispls[p] = sendDispls[p-1] + sendCounts[p-1];
+         recvDispls[p] = recvDispls[p-1] + recvCounts[p-1];
+      }
+      long numReceived = recvDispls[numPEs-1] + recvCounts[numPEs-1];
+      int itemSize = sizeof(ItemType);
+      std::vector<int> sendBytes(numPEs), sendByteDispls(numPEs),
+                       recvBytes(numPEs), recvByteDispls(numPEs);
+      for (int p = 0; p < numPEs; ++p) {
+         sendBytes[p] = sendCounts[p] * itemSize;
+         sendByteDispls[p] = sendDispls[p] * itemSize;
+         recvBytes[p] = recvCounts[p] * itemSize;
+         recvByteDispls[p] = recvDispls[p] * itemSize;
+      }
+      std::vector<ItemType> inKeys(numReceived);
+      MPI_Alltoallv(pendingKeys.data(), sendBytes.data(), sendByteDispls.data(),
+                     MPI_BYTE, inKeys.data(), recvBytes.data(), 
+                     recvByteDispls.data(), MPI_BYTE, MPI_COMM_WORLD);
+      std::vector<uint64_t> inAnswers = resolve(inKeys);
+      // ...and send the answers back the way the keys came
+      answers.resize( pending.size() );
+      MPI_Alltoallv(inAnswers.data(), recvCounts.data(), recvDispls.data(),
+                     MPI_UINT64_T, answers.data(), sendCounts.data(),
+                     sendDispls.data(), MPI_UINT64_T, MPI_COMM_WORLD);
+   }
+   for (unsigned long k = 0; k < pending.size(); ++k) {
+      codes[ pending[k] ] = answers[k];
+   }
+   return codes;
+}
+
+/* utility to resolve keys by reading their blocks
+ * @param: keys, a vector of ItemType values, each of which is greater
+ *          than its block's fence (and at most the next fence),
+ *          in one or more ascending runs (one per sending PE).
+ * Return: a vector of codes (see lookUp()) for keys.
+ * Postcondition: getNumBlocksRead() is the number of blocks read.
+ * Note: In MPI mode this is a collective call (see readRanges()).
+ */
+template <class ItemType>
+std::vector<uint64_t> 
+SortedLookup<ItemType>::resolve(const std::vector<ItemType>& keys) {
+   uint64_t numItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   long numFences = myFences.size();
+   std::vector<long> blocks( keys.size() ), needed;
+   for (unsigned long i = 0; i < keys.size(); ++i) {
+      if (i == 0 || keys[i] < keys[i-1]) {           // a new run
+         blocks[i] = findBlock(keys[i]);
+      } else {                                       // walk the fences
+         blocks[i] = blocks[i-1];
+         while (blocks[i] + 1 < numFences && myFences[blocks[i]+1] < keys[i]) {
+            ++blocks[i];
+         }
+      }
+      needed.push_back(blocks[i]);
+   }
+   std::sort(needed.begin(), needed.end());
+   needed.erase( std::unique(needed.begin(), needed.end()), needed.end() );
+   myNumBlocksRead = needed.size();
+
+   // coalesce adjacent blocks into ranges
+   std::vector<uint64_t> rangeStarts;
+   std::vector<int> rangeLengths;
+   std::vector<long> blockOffsets;                 // where each is in buffer
+   long bufferSize = 0;
+   for (unsigned long n = 0; n < needed.size(); ++n) {
+      uint64_t first = needed[n] * myFenceInterval;
+      int length = std::min<uint64_t>(myFenceInterval, numItems - first);
+      if ( !rangeStarts.empty() && 
+            rangeStarts.back() + rangeLengths.back() == first &&
+            (long) rangeLengths.back() + length < INT_MAX ) {
+         rangeLengths.back() += length;
+      } else {
+         rangeStarts.push_back(first);
+         rangeLengths.push_back(length);
+      }
+      blockOffsets.push_back(bufferSize);
+      bufferSize += length;
+   }
+   std::vector<ItemType> buffer(bufferSize);
+   OO_MPI_IO_Base<ItemType>::readRanges(rangeStarts, rangeLengths, 
+                                         buffer.data());
+
+   std::vector<uint64_t> codes( keys.size() );
+   for (unsigned long i = 0; i < keys.size(); ++i) {
+      long n = std::lower_bound(needed.begin(), needed.end(), blocks[i]) 
+                - needed.begin();
+      uint64_t first = blocks[i] * myFenceInterval;
+      long length = std::min<uint64_t>(myFenceInterval, numItems - first);
+      const ItemType* begin = buffer.data() + blockOffsets[n];
+      const ItemType* bound = std::lower_bound(begin, begin + length, keys[i]);
+      bool found = (bound < begin + length) ? !(keys[i] < *bound)
+                    : (blocks[i] + 1 < numFences &&
+                        !(keys[i] < myFences[blocks[i] + 1]));
+      codes[i] = (first + (bound - begin)) * 2 + (found ? 1 : 0);
+   }
+   return codes;
+}
+
+/********************************************************************
+ * Bloom filters: a BloomFilter answers "might this key be in the 
+ *  file?" without reading the file: "no" is always right, and "yes"
+ *  is wrong for about 1% of absent keys (at 10 bits per key).
+ *
+ * The filter is blocked: each key sets (and a probe tests) 8 bits of
+ *  one 64-byte (cache-line-sized) block, one bit in each of its 
+ *  8 words, so a probe touches one cache line. buildBloomFilter()
+ *  builds one from a file in parallel and saves it in a sidecar
+ *  file (the file's name plus ".bloom").
+ ********************************************************************/
+
+const double   OO_MPI_IO_BLOOM_BITS_PER_KEY = 10;  // default filter size
+const long     OO_MPI_IO_BLOOM_BLOCK_WORDS = 8;    // 64 bytes per block
+const char     OO_MPI_IO_BLOOM_MAGIC[8] = {'O','O','M','P','I','B','L','M'};
+const uint32_t OO_MPI_IO_BLOOM_SALTS[8] = {        // one per word of a block
+                 0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+
+/* The beginning of a Bloom filter sidecar; the blocks' words follow.
+ *  (The sidecar is in the byte order of its writer.)
+ */
+struct OO_MPI_IO_BloomPrologue {
+  char     magic[8];                  // OO_MPI_IO_BLOOM_MAGIC
+  uint32_t version;                   // Bloom filter format (1)
+  uint32_t byteOrderMark;             // OO_MPI_IO_BYTE_ORDER_MARK
+  uint32_t typeCode;                  // an OO_MPI_IO_TypeCode
+  uint32_t itemSize;                  // sizeof(ItemType)
+  uint64_t numBlocks;                 // 64-byte blocks
+  uint64_t numKeys;                   // keys inserted
+};
+
+/* Utility to find the name of a file's Bloom filter
+ */
+std::string getBloomFileName(const std::string& fileName) {
+   return fileName + ".bloom";
+}
+
+/* the sidecars of a data file, for removeSidecars() */
+const int OO_MPI_IO_CRC_SIDECAR = 1;          // getCrcFileName()
+const int OO_MPI_IO_ZONE_MAP_SIDECAR = 2;     // getZoneMapFileName()
+const int OO_MPI_IO_BLOOM_SIDECAR = 4;        // getBloomFileName()
+const int OO_MPI_IO_ALL_SIDECARS = 7;
+
+/* Utility to remove a data file's sidecars
+ * @param: fileName, the name of a data file
+ * @param: which, the sidecars to remove (OO_MPI_IO_CRC_SIDECAR | ...).
+ * Postcondition: those of the chosen sidecars that existed are gone.
+ * Note: A sidecar describes the Items it was made from, so any
+ *        write that changes the Items without remaking it must remove it
+ *        (or readers would trust it, and skip or reject good Items).
+ *       This is not a collective call.
+ */
+void removeSidecars(const std::string& fileName, 
+                     int which = OO_MPI_IO_ALL_SIDECARS) {
+   if (which & OO_MPI_IO_CRC_SIDECAR) {
+      MPI_File_delete(getCrcFileName(fileName).c_str(), MPI_INFO_NULL);
+   }
+   if (which & OO_MPI_IO_ZONE_MAP_SIDECAR) {
+      MPI_File_delete(getZoneMapFileName(fileName).c_str(), MPI_INFO_NULL);
+   }
+   if (which & OO_MPI_IO_BLOOM_SIDECAR) {
+      MPI_File_delete(getBloomFileName(fileName).c_str(), MPI_INFO_NULL);
+   }
+}
+
+/* Utility to find the 64-bit hash of a key for a Bloom filter
+ * @param: key, an arithmetic value of at most 8 bytes.
+ * Return: a mix of key's value (not its bytes, so that it is 
+ *          the same on hosts of either byte order).
+ * Note: 0.0 and -0.0 are equal, so they have the same hash.
+ */
+template <class ItemType>
+uint64_t hashKey(ItemType key) {
+   if (key == 0) key = 0;
+   uint64_t x = 0;
+   if (sizeof(ItemType) == 1) {
+      uint8_t bits;  memcpy(&bits, &key, 1);  x = bits;
+   } else if (sizeof(ItemType) == 2) {
+      uint16_t bits; memcpy(&bits, &key, 2);  x = bits;
+   } else if (sizeof(ItemType) == 4) {
+      uint32_t bits; memcpy(&bits, &key, 4);  x = bits;
+   } else {
+      memcpy(&x, &key, 8);
+   }
+   x ^= x >> 33;                                  // MurmurHash3's finalizer
+   x *= 0xff51afd7ed558ccdULL;
+   x ^= x >> 33;
+   x *= 0xc4ceb9fe1a85ec53ULL;
+   x ^= x >> 33;
+   return x;
+}
+
+template <class ItemType>
+class BloomFilter {
+public:
+  BloomFilter(uint64_t numKeys, double bitsPerKey = OO_MPI_IO_BLOOM_BITS_PER_KEY);
+  BloomFilter(const std::string& fileName, int id, int numPEs);
+  void insert(const ItemType* keys, unsigned long numKeys);
+  void insert(const std::vector<ItemType>& keys) 
+                                        { insert(keys.data(), keys.size()); }
+  bool mayContain(const ItemType& key) const    { return probe(hashKey(key)); }
+  std::vector<char> mayContain(const std::vector<ItemType>& keys) const;
+  void mergeAll();
+  void save(const std::string& fileName) const;
+
+  uint64_t getNumBlocks() const                  { return myNumBlocks; }
+  uint64_t getNumBits() const                    { return myNumBlocks * 512; }
+  uint64_t getNumKeys() const                    { return myNumKeys; }
+  const std::vector<uint64_t>& getWords() const  { return myWords; }
+  const OO_MPI_IO_Stats& getStats() const;
+  void resetStats();
+private:
+  uint64_t getFirstWord(uint64_t hash) const      // of the key's block
+            { return ((hash >> 32) * myNumBlocks >> 32) 
+                      * OO_MPI_IO_BLOOM_BLOCK_WORDS; }
+  bool probe(uint64_t hash) const;
+  OO_MPI_IO_Stats* getStatsRecorder() const;
+
+  uint64_t              myNumBlocks;       // 64-byte blocks
+  uint64_t              myNumKeys;         // keys inserted
+  std::vector<uint64_t> myWords;           // 8 per block
+#if defined(OO_MPI_IO_STATS)
+  mutable OO_MPI_IO_Stats myStats;         // my sidecar's I/O counters
+#endif
+};
+
+/* BloomFilter constructor (for an empty filter)
+ * @param: numKeys, the number of keys the filter is to hold
+ * @param: bitsPerKey, a double (default OO_MPI_IO_BLOOM_BITS_PER_KEY).
+ * Precondition: ItemType is an arithmetic type of at most 8 bytes
+ *           &&  bitsPerKey > 0.
+ * Postcondition: the filter has enough 64-byte blocks for 
+ *                 numKeys * bitsPerKey bits (and at least one)
+ *           &&  it holds no keys.
+ */
+template <class ItemType>
+BloomFilter<ItemType>::BloomFilter(uint64_t numKeys, double bitsPerKey) {
+   if ( !std::is_arithmetic<ItemType>::value || sizeof(ItemType) > 8 ) {
+      fprintf(stderr, "\nBloomFilter(): only arithmetic keys"
+                      " of at most 8 bytes can be hashed\n\n");
+      exit(1);
+   }
+   double numBlocks = ceil(numKeys * bitsPerKey / 512);
+   if ( !(bitsPerKey > 0) || numBlocks >= 4294967296.0 ) {
+      fprintf(stderr, "\nBloomFilter(): bad size (%llu keys, %g bits"
+                      " per key)\n\n", (unsigned long long)numKeys, bitsPerKey);
+      exit(1);
+   }
+   myNumBlocks = std::max(1.0, numBlocks);
+   myNumKeys = 0;
+   myWords.assign(myNumBlocks * OO_MPI_IO_BLOOM_BLOCK_WORDS, 0);
+   resetStats();
+}
+
+/* BloomFilter constructor (to load a file's filter)
+ * @param: fileName, the name of a file
+ * @param: id, an int
+ * @param: numPEs, an int.
+ * Precondition: buildBloomFilter() (or save()) wrote the filter
+ *                of ItemType keys to getBloomFileName(fileName)
+ *           &&  MPI has been initialized
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
+ * Postcondition: the filter is the one in the sidecar (in the host's
+ *                 byte order), or, if the sidecar is missing or does
+ *                 not hold a filter of ItemType keys, an error has been
+ *                 reported and the program has been terminated.
+ * Note: In MPI mode (each PE is a process), every process must construct
+ *        its BloomFilter, as process 0 reads the sidecar and broadcasts it;
+ *       in OpenMP mode, each thread that constructs one reads the sidecar.
+ */
+template <class ItemType>
+BloomFilter<ItemType>::BloomFilter(const std::string& fileName, 
+                                    int id, int numPEs) {
+   resetStats();
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   int worldSize = 0, worldRank = 0;
+   MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+   MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+   bool collective = (worldSize == numPEs && worldRank == id);
+   bool readsFile = !collective || id == 0;
+   std::string bloomFileName = getBloomFileName(fileName);
+
+   OO_MPI_IO_BloomPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   MPI_File bloomFile;
+   if (readsFile) {
+      int openResult = timedOpen(stats, MPI_COMM_SELF, bloomFileName.c_str(),
+                                  MPI_MODE_RDONLY, MPI_INFO_NULL, &bloomFile);
+      if (openResult == MPI_SUCCESS) {
+         MPI_Status status;
+         int readResult = timedReadAt(stats, bloomFile, 0, &prologue, 
+                                       sizeof(prologue), MPI_BYTE, &status);
+         checkResult(readResult);
+      }
+   }
+   if (collective) {
+      MPI_Bcast(&prologue, sizeof(prologue), MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   uint32_t reversedMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   swapBytes(&reversedMark, 1, 4);
+   bool foreignOrder = (prologue.byteOrderMark == reversedMark);
+   if (foreignOrder) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&prologue);
+      swapBytes(bytes + offsetof(OO_MPI_IO_BloomPrologue, version), 
+                 4, 4);                           // version .. itemSize
+      swapBytes(bytes + offsetof(OO_MPI_IO_BloomPrologue, numBlocks), 
+                 2, 8);                           // numBlocks, numKeys
+   }
+   if (memcmp(prologue.magic, OO_MPI_IO_BLOOM_MAGIC, 8) != 0 ||
+        prologue.byteOrderMark != OO_MPI_IO_BYTE_ORDER_MARK ||
+        prologue.itemSize != sizeof(ItemType) || prologue.numBlocks == 0 ||
+        prologue.typeCode != (uint32_t) getTypeCode<ItemType>()) {
+      fprintf(stderr, "\nBloomFilter: '%s' is missing or does not"
+                      " hold a filter of these keys\n\n", bloomFileName.c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myNumBlocks = prologue.numBlocks;
+   myNumKeys = prologue.numKeys;
+   myWords.resize(myNumBlocks * OO_MPI_IO_BLOOM_BLOCK_WORDS);
+   for (uint64_t done = 0; done < myWords.size(); done += INT_MAX) {
+      int count = std::min<uint64_t>(INT_MAX, myWords.size() - done);
+      if (readsFile) {
+         MPI_Status status;
+         int readResult = timedReadAt(stats, bloomFile, 
+                                       sizeof(prologue) + done * 8, 
+                                       &myWords[done], count,
+                                       MPI_UINT64_T, &status);
+         checkResult(readResult);
+      }
+      if (collective) {
+         MPI_Bcast(&myWords[done], count, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+      }
+   }
+   if (readsFile) {
+      timedClose(stats, &bloomFile);
+   }
+   if (foreignOrder) {
+      swapBytes(myWords.data(), myWords.size(), 8);
+   }
+}
+
+/* accessors for my I/O counters
+ * Return: the calls, bytes and seconds of each kind of operation
+ *          on my sidecar (loading it, or save()) since construction
+ *          or the last resetStats(); all 0 unless OO_MPI_IO_STATS
+ *          is defined.
+ */
+template <class ItemType>
+const OO_MPI_IO_Stats& BloomFilter<ItemType>::getStats() const {
+#if defined(OO_MPI_IO_STATS)
+   return myStats;
+#else
+   static const OO_MPI_IO_Stats noStats = OO_MPI_IO_Stats();
+   return noStats;
+#endif
+}
+
+template <class ItemType>
+OO_MPI_IO_Stats* BloomFilter<ItemType>::getStatsRecorder() const {
+#if defined(OO_MPI_IO_STATS)
+   return &myStats;
+#else
+   return NULL;
+#endif
+}
+
+/* method to zero my I/O counters
+ * Postcondition: every counter in getStats() is 0.
+ */
+template <class ItemType>
+void BloomFilter<ItemType>::resetStats() {
+#if defined(OO_MPI_IO_STATS)
+   memset(&myStats, 0, sizeof(myStats));
+#endif
+}
+
+/* method to insert keys into the filter
+ * @param: keys, the address of the keys
+ * @param: numKeys, the number of keys.
+ * Postcondition: mayContain(k) is true for each of the keys k
+ *           &&  getNumKeys() has grown by numKeys.
+ */
+template <class ItemType>
+void BloomFilter<ItemType>::insert(const ItemType* keys, unsigned long numKeys) {
+   const unsigned long GROUP = 16;               // (see mayContain())
+   uint64_t hashes[GROUP];
+   for (unsigned long first = 0; first < numKeys; first += GROUP) {
+      unsigned long length = std::min(GROUP, numKeys - first);
+      for (unsigned long i = 0; i < length; ++i) {
+         hashes[i] = hashKey(keys[first + i]);
+#if defined(__GNUC__)
+         __builtin_prefetch( &myWords[ getFirstWord(hashes[i]) ], 1 );
+#endif
+      }
+      for (unsigned long i = 0; i < length; ++i) {
+         uint64_t* block = &myWords[ getFirstWord(hashes[i]) ];
+         for (int w = 0; w < OO_MPI_IO_BLOOM_BLOCK_WORDS; ++w) {
+            block[w] |= 1ULL << ((uint32_t(hashes[i]) * OO_MPI_IO_BLOOM_SALTS[w]) 
+                                  >> 26);
+         }
+      }
+   }
+   myNumKeys += numKeys;
+}
+
+/* utility to test a key's bits
+ * @param: hash, the key's hashKey().
+ * Return: true iff all 8 of the key's bits are set.
+ * Note: With AVX2, the 8 bit positions are found with one 
+ *        vector multiply, and tested with two 256-bit tests.
+ */
+template <class ItemType>
+bool BloomFilter<ItemType>::probe(uint64_t hash) const {
+   const uint64_t* block = &myWords[ getFirstWord(hash) ];
+#if defined(__AVX2__)
+   const __m256i salts = _mm256_loadu_si256((const __m256i*) OO_MPI_IO_BLOOM_SALTS);
+   __m256i shifts = _mm256_srli_epi32( _mm256_mullo_epi32(
+                                        _mm256_set1_epi32(uint32_t(hash)), salts),
+                                        26 );
+   const __m256i ones = _mm256_set1_epi64x(1);
+   __m256i lowMask = _mm256_sllv_epi64(ones, 
+                        _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts)));
+   __m256i highMask = _mm256_sllv_epi64(ones, 
+                        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)));
+   return _mm256_testc_si256(_mm256_loadu_si256((const __m256i*) block), 
+                              lowMask) &&
+          _mm256_testc_si256(_mm256_loadu_si256((const __m256i*) (block + 4)), 
+                              highMask);
+#else
+   for (int w = 0; w < OO_MPI_IO_BLOOM_BLOCK_WORDS; ++w) {
+      uint64_t bit = 1ULL << ((uint32_t(hash) * OO_MPI_IO_BLOOM_SALTS[w]) >> 26);
+      if ((block[w] & bit) == 0) {
+         return false;
+      }
+   }
+   return true;
+#endif
+}
+
+/* method to test a batch of keys
+ * @param: keys, a vector of ItemType values.
+ * Return: a vector whose i-th value is 1 if keys[i] may have been 
+ *          inserted, and 0 if it certainly was not.
+ * Note: Keys are hashed a group at a time, and their blocks prefetched,
+ *        so that the group's (likely) cache misses overlap.
+ */
+template <class ItemType>
+std::vector<char> 
+BloomFilter<ItemType>::mayContain(const std::vector<ItemType>& keys) const {
+   const unsigned long GROUP = 16;
+   uint64_t hashes[GROUP];
+   std::vector<char> answers( keys.size() );
+   for (unsigned long first = 0; first < keys.size(); first += GROUP) {
+      unsigned long length = std::min(GROUP, keys.size() - first);
+      for (unsigned long i = 0; i < length; ++i) {
+         hashes[i] = hashKey(keys[first + i]);
+#if defined(__GNUC__)
+         __builtin_prefetch( &myWords[ getFirstWord(hashes[i]) ] );
+#endif
+      }
+      for (unsigned long i = 0; i < length; ++i) {
+         answers[first + i] = probe(hashes[i]);
+      }
+   }
+   return answers;
+}
+
+/* method to merge every process's filter
+ * Precondition: every process's filter has the same number of blocks.
+ * Postcondition: each process's filter holds the keys inserted into
+ *                 any process's filter (the bitwise OR of the filters)
+ *           &&  getNumKeys() is the total of their keys.
+ * Note: This is a collective call (MPI_Allreduce() with MPI_BOR),
+ *        so it is for MPI mode; OpenMP threads can instead insert
+ *        into a shared filter, a thread at a time.
+ */
+template <class ItemType>
+void BloomFilter<ItemType>::mergeAll() {
+   for (uint64_t done = 0; done < myWords.size(); done += INT_MAX) {
+      int count = std::min<uint64_t>(INT_MAX, myWords.size() - done);
+      MPI_Allreduce(MPI_IN_PLACE, &myWords[done], count, MPI_UINT64_T, 
+                    MPI_BOR, MPI_COMM_WORLD);
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &myNumKeys, 1, MPI_UINT64_T, MPI_SUM,
+                 MPI_COMM_WORLD);
+}
+
+/* method to save the filter as a file's Bloom filter
+ * @param: fileName, the name of the (data) file.
+ * Postcondition: the filter has been written to getBloomFileName(fileName).
+ * Note: Just one PE should call this.
+ */
+template <class ItemType>
+void BloomFilter<ItemType>::save(const std::string& fileName) const {
+   OO_MPI_IO_BloomPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   memcpy(prologue.magic, OO_MPI_IO_BLOOM_MAGIC, sizeof(prologue.magic));
+   prologue.version = 1;
+   prologue.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   prologue.typeCode = getTypeCode<ItemType>();
+   prologue.itemSize = sizeof(ItemType);
+   prologue.numBlocks = myNumBlocks;
+   prologue.numKeys = myNumKeys;
+
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   MPI_File bloomFile;
+   int result = timedOpen(stats, MPI_COMM_SELF, 
+                           getBloomFileName(fileName).c_str(),
+                           MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                           MPI_INFO_NULL, &bloomFile);
+   checkResult(result);
+   timedSetSize(stats, bloomFile, 0);
+   MPI_Status status;
+   result = timedWriteAt(stats, bloomFile, 0, &prologue, sizeof(prologue),
+                          MPI_BYTE, &status);
+   checkResult(result);
+   for (uint64_t done = 0; done < myWords.size(); done += INT_MAX) {
+      int count = std::min<uint64_t>(INT_MAX, myWords.size() - done);
+      result = timedWriteAt(stats, bloomFile, sizeof(prologue) + done * 8, 
+                             &myWords[done], count, MPI_UINT64_T, &status);
+      checkResult(result);
+   }
+   timedClose(stats, &bloomFile);
+}
+
+/* Utility to build the Bloom filter of an existing file
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: bitsPerKey, a double (default OO_MPI_IO_BLOOM_BITS_PER_KEY).
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType
+ *                (with or without a header, in either byte order)
+ *           &&  ItemType is an arithmetic type of at most 8 bytes
+ *           &&  bitsPerKey > 0.
+ * Postcondition: each PE has read its chunk of the file and inserted
+ *                 its Items into a filter sized for all of the file's
+ *                 Items, the filters have been merged, and process 0
+ *                 has written the result to getBloomFileName(fileName).
+ * Return: (on every PE) the file's filter.
+ * Note: This is a collective call (see mergeAll()).
+ */
+template <class ItemType>
+BloomFilter<ItemType> buildBloomFilter(const std::string& fileName, 
+                                        MPI_Datatype mpiType, int id, int numPEs,
+                                        double bitsPerKey = 
+                                                 OO_MPI_IO_BLOOM_BITS_PER_KEY) {
+   ParallelReader<ItemType> reader(fileName, mpiType, id, numPEs);
+   std::vector<ItemType> chunk = reader.readChunk();
+   BloomFilter<ItemType> filter(reader.getNumItemsInFile(), bitsPerKey);
+   filter.insert(chunk);
+   reader.close();
+   filter.mergeAll();
+   if (id == 0) {
+      filter.save(fileName);
+   }
+   return filter;
+}
+
+/*******************************************************************
+ * The ParallelWriter template provides an abstraction to hide the
+ *  details of MPI-IO parallel output.
+ *
+ * ItemType is the type of the values stored in the file;
+ *  SuppliedType (by default, ItemType) is the type of the values
+ *  passed to it, e.g., ParallelWriter<int64_t, int32_t> is given
+ *  int32_t values and stores them as int64_t values.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType, class SuppliedType = ItemType> 
+class ParallelWriter : public OO_MPI_IO_Base<ItemType> {
+public:
+  ParallelWriter(const std::string& fileName, MPI_Datatype mpiType,
+                  int id, int numPEs); 
+  void writeChunk(const std::vector<SuppliedType>& v);
+  void beginChunk(long chunkSize);
+  void writePart(const std::vector<SuppliedType>& part);
+  void startPart(ItemType* buffer, unsigned long count, MPI_Request* request);
+  void finishPart(MPI_Request* request);
+  void endChunk();
+  void enableHeader(const std::vector<uint64_t>& dims 
+                                          = std::vector<uint64_t>(),
+                     const std::string& userData = "");
+  void enableChecksums(long blockBytes = OO_MPI_IO_CRC_BLOCK_SIZE);
+  void enableZoneMap(long blockItems = OO_MPI_IO_ZONE_ITEMS);
+private:
+  void writeNextPart(const SuppliedType* items, unsigned long count,
+                      bool collective);
+  void writeRange(MPI_Offset byteOffset, const SuppliedType* items, 
+                   unsigned long count, bool collective);
+  void writeChecksums(long dataBytes);
+
+  bool                  myHeaderRequested;  // write a header?
+  std::vector<uint64_t> myHeaderDims;       //  with these dimensions
+  std::string           myHeaderUserData;   //  and this metadata
+  long                  myCrcBlockBytes;    // checksum blocks (0: none)
+  OO_MPI_IO_CrcAccumulator myCrcs;          // CRCs of my chunk's blocks
+  long                  myZoneItems;        // zone map blocks (0: none)
+  OO_MPI_IO_ZoneAccumulator<ItemType> myZones; // my chunk's blocks' zones
+  long                  myItemsLeft;        // of my chunk, to be written
+                                            //  (-1: no chunk begun)
+};
+
+/* ParallelWriter constructor
+ * @param: fileName, a string
+ * @param: id, an int
+ * @param: numPEs, an int
+ * Precondition: fileName is the name of an output file 
+ *                to which binary-format values 
+ *                of type ItemType are to be written.
+ *             && mpiType is the MPI equivalent of ItemType
+ *                 (e.g., MPI_DOUBLE for double)
+ *             && id is a thread id or MPI process rank
+ *             && numPEs is the number of threads or MPI processes
+ *             && a SuppliedType can be converted to an ItemType.
+ * Postcondition: the file has been opened for parallel output
+ *             &&  each instance variable have been initialized
+ *                  as appropriate for this PE using id, numPEs,
+ *                  and size info from the file.
+ */
+template <class ItemType, class SuppliedType>
+ParallelWriter<ItemType, SuppliedType>::
+ParallelWriter(const std::string& fileName, MPI_Datatype mpiType,
+                int id, int numPEs)
+: OO_MPI_IO_Base<ItemType>(fileName,
+                            MPI_MODE_WRONLY | MPI_MODE_CREATE,  
+                            mpiType, id, numPEs)
+{
+   myHeaderRequested = false;          // by default, write raw Items
+   myCrcBlockBytes = 0;                //  with no checksums
+   myZoneItems = 0;                    //  and no zone map
+   myItemsLeft = -1;
+}
+
+/* method to have writeChunk() begin the file with an OO_MPI_IO_Header
+ * @param: dims, a vector of uint64_t values (default: empty)
+ * @param: userData, a string (default: empty)
+ * Precondition: dims is empty or the shape of the array being written
+ *                (at most 8 dimensions)
+ *           &&  userData is at most 151 chars of metadata.
+ * Postcondition: subsequent calls to writeChunk() will write a header 
+ *                 recording ItemType, the Item count, the host's byte
+ *                 order, dims and userData, followed by the Items.
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::enableHeader(const std::vector<uint64_t>& dims,
+                                             const std::string& userData) {
+   myHeaderRequested = true;
+   myHeaderDims = dims;
+   myHeaderUserData = userData;
+}
+
+/* method to have writeChunk() record a checksum of each block
+ * @param: blockBytes, a long (default OO_MPI_IO_CRC_BLOCK_SIZE).
+ * Precondition: blockBytes > 0.
+ * Postcondition: subsequent calls to writeChunk() will compute the
+ *                 CRC32C of each blockBytes bytes of Items (as they
+ *                 are written) and store them in a sidecar file,
+ *                 named getCrcFileName(getFileName()).
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::enableChecksums(long blockBytes) {
+   if (blockBytes <= 0) {
+      fprintf(stderr, "\nParallelWriter::enableChecksums(): bad blockBytes"
+                      " (%ld)\n\n", blockBytes);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myCrcBlockBytes = blockBytes;
+}
+
+/* method to have writeChunk() record the zone (min/max) of each block
+ * @param: blockItems, a long (default OO_MPI_IO_ZONE_ITEMS).
+ * Precondition: blockItems > 0
+ *           &&  ItemType is an arithmetic type of at most 8 bytes.
+ * Postcondition: subsequent calls to writeChunk() will find the least
+ *                 and greatest value (and the number of values that
+ *                 are not NaN) of each blockItems Items as they are 
+ *                 written, and store them in a zone map,
+ *                 named getZoneMapFileName(getFileName()).
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::enableZoneMap(long blockItems) {
+   if (blockItems <= 0) {
+      fprintf(stderr, "\nParallelWriter::enableZoneMap(): bad blockItems"
+                      " (%ld)\n\n", blockItems);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   if ( !std::is_arithmetic<ItemType>::value || sizeof(ItemType) > 8 ) {
+      fprintf(stderr, "\nParallelWriter::enableZoneMap(): only arithmetic"
+                      " Items of at most 8 bytes have zones\n\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myZoneItems = blockItems;
+}
+
+
+/* method to write this PE's chunk to the file
+ * @param: v, a vector of Items.
+ * Precondition: v contains the Items to be output to a file.
+ * Postcondition: v's values have been written to the file
+ *         at the appropriate offsets for this PE
+ *         (in MPI mode, after the chunks of the lower-id PEs, 
+ *          whatever their sizes; otherwise, at this PE's share
+ *          of an even split of the Items)
+ *         (after a header, if enableHeader() has been called)
+ *     &&  the file's checksum sidecar has been written if 
+ *          enableChecksums() has been called (or else removed, 
+ *          since it would no longer match)
+ *     &&  likewise for its zone map and enableZoneMap()
+ *     &&  its Bloom filter (if any) has been removed.
+ * Note: If the file system's profile has collective set (see 
+ *        OO_MPI_IO_Profile), the Items are written collectively
+ *        (MPI_File_write_at_all()) in MPI mode.
+ *       It would be cleaner to pass mpiType as a template parameter
+ *         but doing so produces errors (at least for OpenMPI and clang),
+ *         so this is a hack-ey workaround.
+ *       Could instead pass it as a parameter to the constructor...
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::
+writeChunk(const std::vector<SuppliedType>& v) {
+   beginChunk(v.size());
+   writeNextPart(v.data(), v.size(), 
+                  OO_MPI_IO_Base<ItemType>::usesCollectiveIO());
+   endChunk();
+}
+
+/* method to begin writing this PE's chunk to the file in parts,
+ *  so that the whole chunk need never be in memory at once
+ * @param: chunkSize, a long.
+ * Precondition: chunkSize is the number of Items in this PE's chunk.
+ * Postcondition: the file has been truncated (and its header written,
+ *                 if enableHeader() has been called)
+ *            &&  getFirstItemOffset() is where this PE's chunk begins
+ *                 (placed as writeChunk() places it)
+ *            &&  writePart() will write the chunk's first Items.
+ * Note: This is a collective call (MPI_Allreduce()), so every process
+ *        must call it.
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::beginChunk(long chunkSize) {
+   OO_MPI_IO_TraceSpan span("beginChunk");
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   timedSetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), 0); // truncate
+
+   OO_MPI_IO_Base<ItemType>::setChunkSize(chunkSize);
+   myItemsLeft = chunkSize;
+   
+   long totalItems;
+   MPI_Allreduce(&chunkSize, &totalItems, 1,   // find total #
+                   MPI_LONG, MPI_SUM, MPI_COMM_WORLD);  //  of Items
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile(totalItems);
+   int itemSize = sizeof(ItemType);
+   long totalBytes = totalItems * itemSize;
+   if (myHeaderRequested) {
+      OO_MPI_IO_Base<ItemType>::setHeader(totalItems, myHeaderDims, 
+                                           myHeaderUserData);
+      if (OO_MPI_IO_Base<ItemType>::getID() == 0) {
+         // the header is stored in the same byte order as the Items
+         OO_MPI_IO_Header header = OO_MPI_IO_Base<ItemType>::getHeader();
+         if ( OO_MPI_IO_Base<ItemType>::needsByteSwap() ) {
+            unsigned char* bytes = reinterpret_cast<unsigned char*>(&header);
+            swapBytes(bytes + offsetof(OO_MPI_IO_Header, version), 6, 4);
+            swapBytes(bytes + offsetof(OO_MPI_IO_Header, numItems), 
+                       1 + OO_MPI_IO_MAX_DIMS, 8);
+         }
+         MPI_Status status;
+         int writeResult = timedWriteAt(stats, 
+                                OO_MPI_IO_Base<ItemType>::getFileHandle(), 0,
+                                &header, OO_MPI_IO_HEADER_SIZE, MPI_BYTE, 
+                                &status);
+         checkResult(writeResult);
+      }
+   }
+   long dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   OO_MPI_IO_Base<ItemType>::setFileSize(dataOffset + totalBytes); 
+   long start = 0, stop = 0;
+   if ( OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      // place my chunk after those of lower-id PEs (of any sizes)
+      MPI_Exscan(&chunkSize, &start, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+      if (OO_MPI_IO_Base<ItemType>::getID() == 0) start = 0;
+   } else {
+      getChunkStartStopValues(OO_MPI_IO_Base<ItemType>::getID(), 
+                              OO_MPI_IO_Base<ItemType>::getNumPEs(),
+                              OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
+                              start, stop);
+   }
+
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(dataOffset + start * itemSize);
+   if (myCrcBlockBytes > 0) {
+      myCrcs.begin(start * itemSize, myCrcBlockBytes);
+   }
+   if (myZoneItems > 0) {
+      myZones.begin(start, myZoneItems);
+   }
+}
+
+/* method to write the next part of this PE's chunk
+ * @param: part, a vector of Items.
+ * Precondition: beginChunk() has been called
+ *           &&  part holds the Items that follow those already written
+ *           &&  they are no more than the chunk has left.
+ * Postcondition: part's values have been written to the file
+ *                 (and added to its checksums and zones, if any).
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::
+writePart(const std::vector<SuppliedType>& part) {
+   writeNextPart(part.data(), part.size(), false);
+}
+
+/* utility to write the next part of this PE's chunk
+ * @param: items, the address of the part's first value
+ * @param: count, an unsigned long
+ * @param: collective, a bool.
+ * Precondition: as for writePart() (and see writeRange()).
+ * Postcondition: as for writePart().
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::
+writeNextPart(const SuppliedType* items, unsigned long count, bool collective) {
+   OO_MPI_IO_TraceSpan span("writePart");
+   if ( myItemsLeft < (long) count ) {
+      fprintf(stderr, "\nParallelWriter::writePart(): %lu Items, but %ld"
+                      " left in the chunk\n\n", count, myItemsLeft);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   long written = OO_MPI_IO_Base<ItemType>::getChunkSize() - myItemsLeft;
+   writeRange(OO_MPI_IO_Base<ItemType>::getFirstByteOffset() 
+               + written * OO_MPI_IO_Base<ItemType>::getItemSize(), 
+               items, count, collective);
+   myItemsLeft -= count;
+}
+
+/* method to start writing the next part of this PE's chunk, 
+ *  without blocking (see transformFile())
+ * @param: buffer, the address of the part's first Item
+ * @param: count, an unsigned long
+ * @param: request, the address of an MPI_Request.
+ * Precondition: beginChunk() has been called
+ *           &&  buffer holds the count (<= INT_MAX) Items that follow
+ *                those already written (no more than the chunk has left).
+ * Postcondition: their write has been started (and they have been added
+ *                 to the file's checksums and zones, if any), and 
+ *                 *request is its request.
+ * Note: If the Items need converting to the file's byte order, they
+ *        are converted in place, so buffer must not be used again 
+ *        (or changed) until finishPart(request) has been called.
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::startPart(ItemType* buffer,
+                                                        unsigned long count,
+                                                        MPI_Request* request) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if ( myItemsLeft < (long) count ) {
+      fprintf(stderr, "\nParallelWriter::startPart(): %lu Items, but %ld"
+                      " left in the chunk\n\n", count, myItemsLeft);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   long written = OO_MPI_IO_Base<ItemType>::getChunkSize() - myItemsLeft;
+   if (myZoneItems > 0) {
+      myZones.add(buffer, count);
+   }
+   OO_MPI_IO_Base<ItemType>::convertItems(buffer, count);
+   int writeResult = timedIwriteAt(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(),
+                                   OO_MPI_IO_Base<ItemType>::getFirstByteOffset()
+                                    + written * itemSize, buffer, count, 
+                                   OO_MPI_IO_Base<ItemType>::getMPIType(), 
+                                   request);
+   checkResult(writeResult);
+   if (myCrcBlockBytes > 0) {
+      myCrcs.add(buffer, count * itemSize);
+   }
+   myItemsLeft -= count;
+}
+
+/* method to finish writing a part of this PE's chunk
+ * @param: request, the address of an MPI_Request.
+ * Precondition: request is MPI_REQUEST_NULL or was set by startPart().
+ * Postcondition: that part has been written, and its buffer may be reused.
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::finishPart(MPI_Request* request) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_Status status;
+   timedWait(stats, WRITE_OP, request, &status);
+}
+
+/* method to finish writing this PE's chunk
+ * Precondition: beginChunk() has been called
+ *           &&  writePart() has written all of the chunk.
+ * Postcondition: the file's sidecars have been written or removed 
+ *                 (as writeChunk() says).
+ * Note: This is a collective call (e.g., writeChecksums()), so every 
+ *        process must call it.
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::endChunk() {
+   OO_MPI_IO_TraceSpan span("endChunk");
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (myItemsLeft != 0) {
+      fprintf(stderr, "\nParallelWriter::endChunk(): %ld Items of the chunk"
+                      " were not written\n\n", myItemsLeft);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myItemsLeft = -1;
+   long totalItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   long totalBytes = totalItems * OO_MPI_IO_Base<ItemType>::getItemSize();
+   long dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   std::string fileName = OO_MPI_IO_Base<ItemType>::getFileName();
+   int staleSidecars = OO_MPI_IO_BLOOM_SIDECAR;
+   if (myCrcBlockBytes > 0) {
+      myCrcs.finish();
+      writeChecksums(totalBytes);
+   } else {
+      staleSidecars |= OO_MPI_IO_CRC_SIDECAR;
+   }
+   if (myZoneItems > 0) {
+      saveZoneMap(fileName, myZones, dataOffset, totalItems, stats);
+   } else {
+      staleSidecars |= OO_MPI_IO_ZONE_MAP_SIDECAR;
+   }
+   if (OO_MPI_IO_Base<ItemType>::getID() == 0) {
+      removeSidecars(fileName, staleSidecars);             // if there are any
+   }
+}
+
+/* utility to write the checksum sidecar
+ * @param: dataBytes, the number of bytes of Items in the file.
+ * Precondition: myCrcs holds the CRCs of this PE's chunk's (parts of) blocks.
+ * Postcondition: process 0 has combined every PE's CRCs (merging the
+ *                 parts of blocks that span PEs' chunks) and written 
+ *                 them to the sidecar.
+ * Note: This is a collective call (see gatherPieces()).
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::writeChecksums(long dataBytes) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   // gather each PE's (block, CRC, length) pieces, in order of id
+   std::vector<uint64_t> mine;
+   for (long p = 0; p < myCrcs.getNumPieces(); ++p) {
+      mine.push_back( myCrcs.getBlock(p) );
+      mine.push_back( myCrcs.getCrc(p) );
+      mine.push_back( myCrcs.getLength(p) );
+   }
+   std::vector<uint64_t> all = gatherPieces(mine);
+   if (OO_MPI_IO_Base<ItemType>::getID() != 0) {
+      return;
+   }
+
+   uint64_t numBlocks = (dataBytes + myCrcBlockBytes - 1) / myCrcBlockBytes;
+   std::vector<uint32_t> crcs(numBlocks, 0);
+   std::vector<uint64_t> lengths(numBlocks, 0);
+   for (unsigned long i = 0; i < all.size(); i += 3) {
+      uint64_t block = all[i];
+      crcs[block] = crc32cCombine(crcs[block], all[i+1], all[i+2]);
+      lengths[block] += all[i+2];
+   }
+   OO_MPI_IO_CrcPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   memcpy(prologue.magic, OO_MPI_IO_CRC_MAGIC, sizeof(prologue.magic));
+   prologue.version = 1;
+   prologue.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   prologue.blockBytes = myCrcBlockBytes;
+   prologue.dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   prologue.dataBytes = dataBytes;
+
+   MPI_File crcFile;
+   std::string crcFileName = 
+                 getCrcFileName( OO_MPI_IO_Base<ItemType>::getFileName() );
+   int result = timedOpen(stats, MPI_COMM_SELF, crcFileName.c_str(),
+                                  MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                  MPI_INFO_NULL, &crcFile);
+   checkResult(result);
+   timedSetSize(stats, crcFile, 0);
+   MPI_Status status;
+   result = timedWriteAt(stats, crcFile, 0, &prologue, sizeof(prologue),
+                                 MPI_BYTE, &status);
+   checkResult(result);
+   result = timedWriteAt(stats, crcFile, sizeof(prologue), crcs.data(), 
+                                 numBlocks, MPI_UINT32_T, &status);
+   checkResult(result);
+   timedClose(stats, &crcFile);
+}
+
+/* utility to write a contiguous range of Items
+ * @param: byteOffset, an MPI_Offset
+ * @param: items, the address of the first value
+ * @param: count, an unsigned long
+ * @param: collective, a bool.
+ * Precondition: if collective, every process makes this call
+ *                (with the same conversion, checksums and zones).
+ * Postcondition: items[0..count-1] have been written to the file
+ *                 starting at byteOffset, converted to ItemType and
+ *                 the file's byte order if need be (items is unchanged).
+ * Note: Items that need no conversion, checksums or zones are written
+ *        at most getPieceItems() at a time, collectively if collective.
+ *       Conversion is done a window at a time, in a staging buffer,
+ *        while the previous window is being written; likewise, 
+ *        checksums and zones are computed while their window 
+ *        is being written (zones before any byte swap).
+ */
+template <class ItemType, class SuppliedType>
+void ParallelWriter<ItemType, SuppliedType>::writeRange(MPI_Offset byteOffset, 
+                                                         const SuppliedType* items,
+                                                         unsigned long count,
+                                                         bool collective) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   MPI_Datatype mpiType = OO_MPI_IO_Base<ItemType>::getMPIType();
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   const bool sameType = std::is_same<ItemType, SuppliedType>::value;
+   MPI_Status status;
+   int writeResult = 0;
+   bool staged = !sameType || OO_MPI_IO_Base<ItemType>::needsByteSwap();
+   if ( !staged && myCrcBlockBytes == 0 && myZoneItems == 0 ) {
+      // write the Items a piece (of at most INT_MAX) at a time
+      unsigned long pieceItems = OO_MPI_IO_Base<ItemType>::getPieceItems();
+      long numPieces = OO_MPI_IO_Base<ItemType>::countPieces(count, collective);
+      for (long piece = 0; piece < numPieces; ++piece) {
+         unsigned long first = std::min(count, piece * pieceItems);
+         int length = std::min(pieceItems, count - first);
+         if (collective) {
+            writeResult = timedWriteAtAll(stats, fh, 
+                                                  byteOffset + first * itemSize,
+                                                  items + first, length, 
+                                                  mpiType, &status);
+         } else {
+            writeResult = timedWriteAt(stats, fh, byteOffset + first * itemSize,
+                                               items + first, length, mpiType, 
+                                               &status);
+         }
+         checkResult(writeResult);
+      }
+      return;
+   }
+
+   unsigned long windowSize = OO_MPI_IO_Base<ItemType>::getWindowItems();
+   std::vector<ItemType> staging[2];
+   MPI_Request request = MPI_REQUEST_NULL;
+   int which = 0;
+   for (unsigned long start = 0; start < count; start += windowSize) {
+      unsigned long length = std::min(windowSize, count - start);
+      // fill one buffer while the other one's write is in progress
+      const ItemType* window = reinterpret_cast<const ItemType*>(items + start);
+      if (staged) {
+         staging[which].resize(length);
+         convertNumbers(items + start, staging[which].data(), length);
+         window = staging[which].data();
+      }
+      if (myZoneItems > 0) {
+         myZones.add(window, length);
+      }
+      if (staged) {
+         OO_MPI_IO_Base<ItemType>::convertItems(staging[which].data(), length);
+      }
+      timedWait(stats, WRITE_OP, &request, &status);
+      writeResult = timedIwriteAt(stats, fh, byteOffset + start * itemSize,
+                                          window, length, mpiType, &request);
+      checkResult(writeResult);
+      if (myCrcBlockBytes > 0) {
+         myCrcs.add(window, length * itemSize);
+      }
+      which = 1 - which;
+   }
+   timedWait(stats, WRITE_OP, &request, &status);
+}
+
+/********************************************************************
+ * autotune() probes a file system: it writes and reads back a 
+ *  scratch file with a ParallelWriter and a ParallelReader, using 
+ *  different profiles, and saves the fastest profile, so that the
+ *  later readers and writers of files on that file system use it.
+ ********************************************************************/
+
+const long   OO_MPI_IO_PROBE_BYTES = 1L << 26;   // default probe file size
+const int    OO_MPI_IO_PROBE_RUNS = 2;           // tries per profile
+const double OO_MPI_IO_PROBE_MARGIN = 0.05;      // how much faster to win
+
+/* Utility to time writing and reading a probe file with a profile
+ * @param: fileName, the name of the probe file
+ * @param: profile, the profile to use
+ * @param: chunk, this process's chunk of the file.
+ * Return: the least (over OO_MPI_IO_PROBE_RUNS runs) of the seconds
+ *          the slowest process took to write its chunk plus the 
+ *          seconds the slowest took to read it back.
+ * Postcondition: setProfileFor(fileName, profile) has been called.
+ * Note: This is a collective call.
+ */
+double timeProbe(const std::string& fileName, const OO_MPI_IO_Profile& profile,
+                  const std::vector<char>& chunk) {
+   int id = 0, numProcs = 1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   setProfileFor(fileName, profile);
+   double best = 0;
+   for (int run = 0; run < OO_MPI_IO_PROBE_RUNS; ++run) {
+      if (id == 0) {                         // (so hints that only apply
+         MPI_File_delete(fileName.c_str(), MPI_INFO_NULL);   // on creation
+      }                                                      //  do apply)
+      MPI_Barrier(MPI_COMM_WORLD);
+      double start = MPI_Wtime();
+      ParallelWriter<char> writer(fileName, MPI_CHAR, id, numProcs);
+      writer.writeChunk(chunk);
+      writer.close();
+      double myTimes[2] = { MPI_Wtime() - start, 0 }, times[2];
+      MPI_Barrier(MPI_COMM_WORLD);
+      start = MPI_Wtime();
+      ParallelReader<char> reader(fileName, MPI_CHAR, id, numProcs);
+      std::vector<char> readBack = reader.readChunk();
+      reader.close();
+      myTimes[1] = MPI_Wtime() - start;
+      MPI_Allreduce(myTimes, times, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      if (run == 0 || times[0] + times[1] < best) {
+         best = times[0] + times[1];
+      }
+   }
+   return best;
+}
+
+/* Utility to find (and save) the best profile for a file system
+ * @param: scratchFileName, the name of a file on the file system
+ * @param: probeBytes, the size of the probe file 
+ *          (default OO_MPI_IO_PROBE_BYTES)
+ * @param: save, a bool (default true).
+ * Precondition: every MPI process calls this, from one thread
+ *           &&  scratchFileName can be overwritten (and deleted).
+ * Return: the profile with which the probe file was written and
+ *          read back the fastest (the same for every process).
+ * Postcondition: this process's later readers and writers of files
+ *                 on the file system use that profile
+ *            &&  if save, process 0 has saved it in the profiles file
+ *                 (see saveProfile()), for later programs
+ *            &&  scratchFileName has been deleted.
+ *
+ * The parameters are tuned one at a time, starting from the default
+ *  profile: collective vs. independent I/O, the window size, then
+ *  (if collective I/O won) the number of aggregators and the collective
+ *  buffer size, and last the alignment. Each candidate value is tried
+ *  with the best values found so far, and is kept only if it is at
+ *  least OO_MPI_IO_PROBE_MARGIN faster, so that noise does not pick it.
+ *
+ * Note: This is a collective call; each profile's time is that of
+ *        the slowest process, so every process makes the same choices.
+ */
+OO_MPI_IO_Profile autotune(const std::string& scratchFileName, 
+                            long probeBytes = OO_MPI_IO_PROBE_BYTES,
+                            bool save = true) {
+   int id = 0, numProcs = 1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long start = 0, stop = 0;
+   getChunkStartStopValues(id, numProcs, probeBytes, start, stop);
+   std::vector<char> chunk(stop - start);
+   for (long i = start; i < stop; ++i) {
+      chunk[i - start] = 'a' + i % 26;
+   }
+
+   // the candidate values of each parameter, in the order they are tuned
+   const long MB = 1L << 20;
+   const int NUM_PARAMETERS = 5;
+   std::vector<long> candidates[NUM_PARAMETERS] = {
+      { 1 },                                          // collective
+      { MB, 4 * MB, 16 * MB, 64 * MB },               // windowBytes
+      { 1, std::max(1, numProcs / 2), numProcs },     // aggregators
+      { 4 * MB, 16 * MB, 64 * MB },                   // bufferBytes
+      { MB, 4 * MB }                                  // alignment
+   };
+   auto setParameter = [](OO_MPI_IO_Profile& profile, int parameter, 
+                           long value) {
+      switch (parameter) {
+         case 0: profile.collective = (value != 0); break;
+         case 1: profile.windowBytes = value; break;
+         case 2: profile.aggregators = value; break;
+         case 3: profile.bufferBytes = value; break;
+         default: profile.alignment = value; break;
+      }
+   };
+
+   OO_MPI_IO_Profile best = OO_MPI_IO_Profile();
+   double bestTime = timeProbe(scratchFileName, best, chunk);
+   for (int parameter = 0; parameter < NUM_PARAMETERS; ++parameter) {
+      if ( (parameter == 2 || parameter == 3) && !best.collective ) {
+         continue;                     // (these hints are for collective I/O)
+      }
+      std::vector<long>& values = candidates[parameter];
+      for (unsigned long v = 0; v < values.size(); ++v) {
+         if ( std::find(values.begin(), values.begin() + v, values[v]) 
+               != values.begin() + v ) {
+            continue;                               // (tried already)
+         }
+         OO_MPI_IO_Profile trial = best;
+         setParameter(trial, parameter, values[v]);
+         double time = timeProbe(scratchFileName, trial, chunk);
+         if (time < bestTime * (1 - OO_MPI_IO_PROBE_MARGIN)) {
+            best = trial;
+            bestTime = time;
+         }
+      }
+   }
+
+   setProfileFor(scratchFileName, best);
+   if (id == 0) {
+      MPI_File_delete(scratchFileName.c_str(), MPI_INFO_NULL);
+      if (save) {
+         saveProfile(getMountPoint(scratchFileName), best);
+      }
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+   return best;
+}
+
+/********************************************************************
+ * transformFile() connects a ParallelReader and a ParallelWriter 
+ *  through a ring of buffers, applying a function to each Item on
+ *  the way: while one block of the PE's chunk is being transformed,
+ *  the next blocks are being read and the previous ones written
+ *  (with non-blocking MPI-IO), so the stages overlap and no more
+ *  than the ring's blocks are ever in memory.
+ ********************************************************************/
+
+const int OO_MPI_IO_RING_SIZE = 3;       // blocks: read, transform, write
+
+/* Utility to write a file of the function's values of another's Items
+ * @param: reader, a ParallelReader (the input)
+ * @param: writer, a ParallelWriter (the output)
+ * @param: function, a function (e.g., a lambda) of an InDelivered
+ *          that returns something that converts to an OutSupplied
+ * @param: blockItems, the Items per block (default 0: the reader's
+ *          window size, see OO_MPI_IO_Profile)
+ * @param: numThreads, the threads that transform each block 
+ *          (default 1: just this one)
+ * @param: ringSize, the blocks in the ring (default 3).
+ * Precondition: reader and writer are this PE's, for different files
+ *           &&  ringSize >= 2.
+ * Postcondition: writer's file holds function(item) for each Item
+ *                 of reader's file, in order (with the header,
+ *                 checksums and zone map, if any, that writer has 
+ *                 been asked for, and reader's checksums checked if
+ *                 it isVerifying()).
+ * Note: Each block is read ringSize - 1 blocks ahead of the one being
+ *        transformed, and written while up to ringSize - 1 later
+ *        blocks are transformed, so the ring uses ringSize blocks of 
+ *        InItems and of OutItems.
+ *       numThreads > 1 transforms each block with an OpenMP parallel
+ *        loop (so function must be thread-safe); the I/O is still 
+ *        done by this thread.
+ *       Like writeChunk(), this is a collective call in MPI mode.
+ */
+template <class InItem, class InDelivered, class OutItem, class OutSupplied,
+          class Function>
+void transformFile(ParallelReader<InItem, InDelivered>& reader,
+                    ParallelWriter<OutItem, OutSupplied>& writer,
+                    Function function, unsigned long blockItems = 0,
+                    int numThreads = 1, int ringSize = OO_MPI_IO_RING_SIZE) {
+   OO_MPI_IO_TraceSpan span("transformFile");
+   if (ringSize < 2) {
+      fprintf(stderr, "\ntransformFile(): the ring needs 2 or more blocks,"
+                      " not %d\n\n", ringSize);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   long chunkSize = reader.beginChunk();
+   writer.beginChunk(chunkSize);
+   if (blockItems == 0) {
+      long windowBytes = reader.getProfile().windowBytes;
+      blockItems = std::max(1L, ((windowBytes > 0) ? windowBytes 
+                                                    : OO_MPI_IO_SWAP_WINDOW)
+                                  / (long) sizeof(InItem));
+   }
+   blockItems = std::min<unsigned long>( blockItems, INT_MAX );
+   blockItems = std::max(1UL, std::min(blockItems, (unsigned long) chunkSize));
+   long numBlocks = (chunkSize + blockItems - 1) / blockItems;
+   auto blockLength = [&](long block) -> unsigned long {
+      return std::min(blockItems, chunkSize - block * blockItems);
+   };
+
+   std::vector< std::vector<InItem> > inRing(ringSize);
+   std::vector< std::vector<OutItem> > outRing(ringSize);
+   std::vector<MPI_Request> reads(ringSize, MPI_REQUEST_NULL);
+   std::vector<MPI_Request> writes(ringSize, MPI_REQUEST_NULL);
+   for (int slot = 0; slot < ringSize && slot < numBlocks; ++slot) {
+      inRing[slot].resize(blockItems);
+      outRing[slot].resize(blockItems);
+   }
+   for (long block = 0; block < ringSize - 1 && block < numBlocks; ++block) {
+      reader.startPart(inRing[block].data(), blockLength(block), &reads[block]);
+   }
+   for (long block = 0; block < numBlocks; ++block) {
+      int slot = block % ringSize;
+      long count = blockLength(block);
+      reader.finishPart(inRing[slot].data(), count, &reads[slot]);
+      long ahead = block + ringSize - 1;        // (its slot's block is done)
+      if (ahead < numBlocks) {
+         int aheadSlot = ahead % ringSize;
+         reader.startPart(inRing[aheadSlot].data(), blockLength(ahead), 
+                           &reads[aheadSlot]);
+      }
+      writer.finishPart(&writes[slot]);         // (block - ringSize's write)
+      const InItem* in = inRing[slot].data();
+      OutItem* out = outRing[slot].data();
+      #pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+      for (long i = 0; i < count; ++i) {
+         out[i] = static_cast<OutItem>( static_cast<OutSupplied>( 
+                     function( static_cast<InDelivered>(in[i]) ) ) );
+      }
+      writer.startPart(out, count, &writes[slot]);
+   }
+   for (int slot = 0; slot < ringSize; ++slot) {
+      writer.finishPart(&writes[slot]);
+   }
+   reader.endChunk();
+   writer.endChunk();
+}
+
+/********************************************************************
+ * parallelSort() sorts a binary file of numbers into another file,
+ *  with a distributed sample sort: the processes sample their chunks
+ *  to choose splitters, each sorts its chunk (with radixSort()),
+ *  they exchange Items by splitter bucket (MPI_Alltoallv()), and 
+ *  each writes its bucket after those of lower ranks.
+ * A chunk larger than the memory allowed is sorted a run at a time:
+ *  each run is sorted and exchanged as above, and each process 
+ *  saves its part of the run in a run file, then merges its runs 
+ *  (a k-way merge) as it writes its bucket.
+ ********************************************************************/
+
+#include <queue>                     // priority_queue
+#include <numeric>                   // accumulate()
+
+const long OO_MPI_IO_SORT_MEMORY = 1L << 30;  // default bytes per process
+const int  OO_MPI_IO_SORT_SAMPLES = 64;       // samples per process per bucket
+
+/* The unsigned integer type the size of an Item (see toSortKey()) */
+template <int Size> struct OO_MPI_IO_SortKey { };
+template <> struct OO_MPI_IO_SortKey<1> { typedef uint8_t  type; };
+template <> struct OO_MPI_IO_SortKey<2> { typedef uint16_t type; };
+template <> struct OO_MPI_IO_SortKey<4> { typedef uint32_t type; };
+template <> struct OO_MPI_IO_SortKey<8> { typedef uint64_t type; };
+
+/* Utility to map a number to an unsigned key with the same order
+ * @param: item, an integer or floating-point number.
+ * Return: a key such that toSortKey(x) < toSortKey(y) iff x < y
+ *          (for floating-point numbers, -0.0 comes before 0.0 and
+ *           NaNs come first or last, according to their signs).
+ */
+template <class ItemType>
+typename OO_MPI_IO_SortKey<sizeof(ItemType)>::type toSortKey(ItemType item) {
+   static_assert(std::is_arithmetic<ItemType>::value,
+                  "sort keys are for integers and floating-point numbers");
+   typedef typename OO_MPI_IO_SortKey<sizeof(ItemType)>::type Key;
+   const Key topBit = Key(1) << (8 * sizeof(Key) - 1);
+   Key bits;
+   memcpy(&bits, &item, sizeof(Key));
+   if ( std::is_floating_point<ItemType>::value ) {
+      return (bits & topBit) ? Key(~bits) : Key(bits | topBit);
+   } else if ( std::is_signed<ItemType>::value ) {
+      return bits ^ topBit;
+   }
+   return bits;
+}
+
+/* Utility to sort numbers with an LSD radix sort (a byte at a time)
+ * @param: items, the address of the first number
+ * @param: count, an unsigned long
+ * @param: numThreads, an int (default 1).
+ * Postcondition: items[0..count-1] are in ascending order (of toSortKey()).
+ * Note: It uses a second buffer of count Items, and skips the passes
+ *        in which every Item has the same byte (e.g., the high bytes
+ *        of small integers). 
+ *       With numThreads > 1, each pass is done by that many OpenMP 
+ *        threads, each counting and then moving its own block of 
+ *        Items, so the sort stays stable.
+ */
+template <class ItemType>
+void radixSort(ItemType* items, unsigned long count, int numThreads = 1) {
+   if (count < 2) {
+      return;
+   }
+   const int RADIX = 256;
+   int numBlocks = std::max(1, numThreads);
+   unsigned long blockSize = (count + numBlocks - 1) / numBlocks;
+   std::vector<ItemType> buffer(count);
+   std::vector<unsigned long> offsets(numBlocks * RADIX);
+   ItemType* from = items;
+   ItemType* to = buffer.data();
+   for (unsigned pass = 0; pass < sizeof(ItemType); ++pass) {
+      int shift = 8 * pass;
+      std::fill(offsets.begin(), offsets.end(), 0);
+      #pragma omp parallel for num_threads(numBlocks) if(numBlocks > 1)
+      for (int block = 0; block < numBlocks; ++block) {
+         unsigned long* counts = &offsets[block * RADIX];
+         unsigned long last = std::min(count, (block + 1) * blockSize);
+         for (unsigned long i = block * blockSize; i < last; ++i) {
+            ++counts[ (toSortKey(from[i]) >> shift) & 0xFF ];
+         }
+      }
+      // each block's Items with each byte go after all those with 
+      //  smaller bytes and those of earlier blocks with the same byte
+      bool allSame = false;
+      unsigned long total = 0;
+      for (int digit = 0; digit < RADIX; ++digit) {
+         unsigned long digitTotal = 0;
+         for (int block = 0; block < numBlocks; ++block) {
+            unsigned long blockCount = offsets[block * RADIX + digit];
+            offsets[block * RADIX + digit] = total;
+            total += blockCount;
+            digitTotal += blockCount;
+         }
+         allSame = allSame || (digitTotal == count);
+      }
+      if (allSame) {
+         continue;
+      }
+      #pragma omp parallel for num_threads(numBlocks) if(numBlocks > 1)
+      for (int block = 0; block < numBlocks; ++block) {
+         unsigned long* next = &offsets[block * RADIX];
+         unsigned long last = std::min(count, (block + 1) * blockSize);
+         for (unsigned long i = block * blockSize; i < last; ++i) {
+            to[ next[(toSortKey(from[i]) >> shift) & 0xFF]++ ] = from[i];
+         }
+      }
+      std::swap(from, to);
+   }
+   if (from != items) {
+      memcpy(items, from, count * sizeof(ItemType));
+   }
+}
+
+/* Utility to compare numbers as radixSort() orders them */
+template <class ItemType>
+bool sortsBefore(const ItemType& left, const ItemType& right) {
+   return toSortKey(left) < toSortKey(right);
+}
+
+/* Utility to choose the splitters of a sample sort
+ * @param: reader, a ParallelReader.
+ * Precondition: reader.beginChunk() has been called.
+ * Return: numProcs - 1 ascending splitters: bucket b holds the Items
+ *          greater than splitter b-1 and no greater than splitter b.
+ * Note: Each process reads OO_MPI_IO_SORT_SAMPLES * numProcs evenly
+ *        spaced Items of its chunk (with one readItems() call), and 
+ *        every process chooses the same splitters from all of them.
+ *       This is a collective call.
+ */
+template <class ItemType>
+std::vector<ItemType> chooseSplitters(ParallelReader<ItemType>& reader) {
+   int numProcs = reader.getNumPEs();
+   long start = reader.getFirstItemOffset();
+   long stop = start + reader.getChunkSize();
+   long numSamples = std::min<long>(stop - start, 
+                                     OO_MPI_IO_SORT_SAMPLES * numProcs);
+   std::vector<uint64_t> indices(numSamples);
+   for (long s = 0; s < numSamples; ++s) {
+      indices[s] = start + (stop - start) * s / numSamples;
+   }
+   std::vector<ItemType> samples = reader.readItems(indices);
+   int mySampleBytes = samples.size() * sizeof(ItemType);
+   std::vector<int> sampleBytes(numProcs), offsets(numProcs, 0);
+   MPI_Allgather(&mySampleBytes, 1, MPI_INT, sampleBytes.data(), 1, MPI_INT,
+                  MPI_COMM_WORLD);
+   for (int p = 1; p < numProcs; ++p) {
+      offsets[p] = offsets[p-1] + sampleBytes[p-1];
+   }
+   std::vector<ItemType> all( (offsets[numProcs-1] + sampleBytes[numProcs-1]) 
+                               / sizeof(ItemType) );
+   MPI_Allgatherv(samples.data(), mySampleBytes, MPI_BYTE, all.data(), 
+                   sampleBytes.data(), offsets.data(), MPI_BYTE, MPI_COMM_WORLD);
+   radixSort(all.data(), all.size());
+   std::vector<ItemType> splitters(numProcs - 1);
+   for (int b = 0; b < numProcs - 1; ++b) {
+      splitters[b] = all[ (b + 1) * all.size() / numProcs ];
+   }
+   return splitters;
+}
+
+/* Utility to exchange sorted Items by splitter bucket
+ * @param: sorted, this process's Items, in ascending order
+ * @param: splitters, as chooseSplitters() returns them
+ * @param: itemType, an MPI_Datatype of sizeof(ItemType) bytes.
+ * Return: the Items of every process's sorted that fall in this 
+ *          process's bucket (each process's in ascending order,
+ *          one after another).
+ * Note: This is a collective call (MPI_Alltoall(), MPI_Alltoallv()).
+ */
+template <class ItemType>
+std::vector<ItemType> exchangeBuckets(const std::vector<ItemType>& sorted,
+                                       const std::vector<ItemType>& splitters,
+                                       MPI_Datatype itemType) {
+   int numProcs = splitters.size() + 1;
+   std::vector<int> sendCounts(numProcs), sendOffsets(numProcs, 0);
+   std::vector<int> recvCounts(numProcs), recvOffsets(numProcs, 0);
+   long first = 0;
+   for (int b = 0; b < numProcs; ++b) {
+      long last = (b < numProcs - 1) 
+                   ? std::upper_bound(sorted.begin() + first, sorted.end(), 
+                                       splitters[b], sortsBefore<ItemType>) 
+                      - sorted.begin()
+                   : sorted.size();
+      sendOffsets[b] = first;
+      sendCounts[b] = last - first;
+      first = last;
+   }
+   MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT,
+                 MPI_COMM_WORLD);
+   long total = recvCounts[0];
+   for (int p = 1; p < numProcs; ++p) {
+      recvOffsets[p] = recvOffsets[p-1] + recvCounts[p-1];
+      total += recvCounts[p];
+   }
+   if (total > INT_MAX) {
+      fprintf(stderr, "\nparallelSort(): a bucket of %ld Items is too big;"
+                      " use a smaller memoryBytes\n\n", total);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   std::vector<ItemType> bucket(total);
+   MPI_Alltoallv(sorted.data(), sendCounts.data(), sendOffsets.data(), itemType,
+                  bucket.data(), recvCounts.data(), recvOffsets.data(), itemType,
+                  MPI_COMM_WORLD);
+   return bucket;
+}
+
+/* Utility to merge a process's sorted runs into its bucket of the output
+ * @param: runFile, the file holding the runs, one after another
+ * @param: runLengths, the number of Items in each run
+ * @param: writer, the output's ParallelWriter
+ * @param: memoryBytes, the most bytes of buffers to use.
+ * Postcondition: the runs' Items have been merged (with a heap of the
+ *                 runs' next Items) and written, as this process's chunk.
+ * Note: This is a collective call (see ParallelWriter::beginChunk()).
+ */
+template <class ItemType>
+void mergeRuns(FILE* runFile, const std::vector<long>& runLengths,
+                ParallelWriter<ItemType>& writer, long memoryBytes) {
+   typedef typename OO_MPI_IO_SortKey<sizeof(ItemType)>::type Key;
+   int numRuns = runLengths.size();
+   std::vector<long> runStarts(numRuns + 1, 0);
+   for (int r = 0; r < numRuns; ++r) {
+      runStarts[r+1] = runStarts[r] + runLengths[r];
+   }
+   writer.beginChunk(runStarts[numRuns]);
+   unsigned long bufferItems = std::max(1L, memoryBytes 
+                                 / ((numRuns + 1) * (long) sizeof(ItemType)));
+   std::vector< std::vector<ItemType> > buffers(numRuns);
+   std::vector<long> nextItems(runStarts.begin(), runStarts.end() - 1);
+   std::vector<unsigned long> positions(numRuns, 0);
+   // refill a run's buffer with its next Items
+   auto refill = [&](int r) -> bool {
+      unsigned long length = std::min<long>(bufferItems, runStarts[r+1] - nextItems[r]);
+      buffers[r].resize(length);
+      positions[r] = 0;
+      if (length == 0) return false;
+      if ( fseek(runFile, nextItems[r] * sizeof(ItemType), SEEK_SET) != 0 ||
+            fread(buffers[r].data(), sizeof(ItemType), length, runFile) != length ) {
+         fprintf(stderr, "\nparallelSort(): could not read a run file\n\n");
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      nextItems[r] += length;
+      return true;
+   };
+   typedef std::pair<Key, int> Entry;                  // (next key, its run)
+   std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > heap;
+   for (int r = 0; r < numRuns; ++r) {
+      if ( refill(r) ) {
+         heap.push( Entry(toSortKey(buffers[r][0]), r) );
+      }
+   }
+   std::vector<ItemType> output;
+   output.reserve(bufferItems);
+   while ( !heap.empty() ) {
+      int r = heap.top().second;
+      heap.pop();
+      output.push_back( buffers[r][ positions[r]++ ] );
+      if (output.size() == bufferItems) {
+         writer.writePart(output);
+         output.clear();
+      }
+      if (positions[r] < buffers[r].size() || refill(r)) {
+         heap.push( Entry(toSortKey(buffers[r][ positions[r] ]), r) );
+      }
+   }
+   writer.writePart(output);
+   writer.endChunk();
+}
+
+/* Utility to sort a binary file of numbers into another file
+ * @param: inFileName, the name of the file to be sorted
+ * @param: outFileName, the name of the file to write
+ * @param: mpiType, the MPI_Datatype that corresponds to ItemType
+ * @param: memoryBytes, the most bytes of Items each process may hold
+ *          at once (default OO_MPI_IO_SORT_MEMORY)
+ * @param: numThreads, the threads each process sorts with (default 1).
+ * Precondition: inFileName is a file of integers or floating-point 
+ *                numbers of type ItemType (with at least as many Items
+ *                as there are processes)
+ *           &&  outFileName is a different file.
+ * Postcondition: outFileName holds inFileName's Items in ascending order
+ *                 (as radixSort() orders them), with its header, if any.
+ * Return: the number of Items this process wrote (its bucket).
+ * Note: Every MPI process must call this, as it is collective.
+ *       Each process's chunk is read a run of memoryBytes / 5 bytes at 
+ *        a time (the next run is read while this one is sorted and
+ *        exchanged); if every chunk is one run, each process writes 
+ *        its bucket directly, otherwise it saves its part of each run
+ *        in a run file (outFileName + ".run" + its rank) and merges 
+ *        the runs as it writes (see mergeRuns()).
+ *       Buckets are as even as the splitters make them, so many
+ *        copies of the same Item can make one bucket (and its 
+ *        process's share of each run) larger than the rest.
+ */
+template <class ItemType>
+long parallelSort(const std::string& inFileName, const std::string& outFileName,
+                   MPI_Datatype mpiType, long memoryBytes = OO_MPI_IO_SORT_MEMORY,
+                   int numThreads = 1) {
+   OO_MPI_IO_TraceSpan span("parallelSort");
+   int id = 0, numProcs = 1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   ParallelReader<ItemType> reader(inFileName, mpiType, id, numProcs);
+   long chunkSize = reader.beginChunk();
+   std::vector<ItemType> splitters = chooseSplitters(reader);
+   MPI_Datatype itemType;
+   MPI_Type_contiguous(sizeof(ItemType), MPI_BYTE, &itemType);
+   MPI_Type_commit(&itemType);
+
+   // two runs (one being read), the radix sort's buffer, and a bucket
+   //  (and the radix sort's buffer for it)
+   long runItems = std::max(1L, std::min<long>(INT_MAX, 
+                                  memoryBytes / (5 * (long) sizeof(ItemType))));
+   long myNumRuns = (chunkSize + runItems - 1) / runItems, numRuns = 0;
+   MPI_Allreduce(&myNumRuns, &numRuns, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+   ParallelWriter<ItemType> writer(outFileName, mpiType, id, numProcs);
+   if ( reader.hasHeader() ) {
+      writer.enableHeader(reader.getDims(), reader.getUserData());
+   }
+   auto runLength = [&](long run) -> long {
+      return std::max(0L, std::min(runItems, chunkSize - run * runItems));
+   };
+
+   std::vector<ItemType> runs[2], bucket;
+   MPI_Request requests[2];
+   runs[0].resize( runLength(0) );
+   reader.startPart(runs[0].data(), runs[0].size(), &requests[0]);
+   std::string runFileName = outFileName + ".run" + std::to_string(id);
+   FILE* runFile = NULL;
+   std::vector<long> runLengths;
+   for (long run = 0; run < numRuns; ++run) {
+      int which = run % 2;
+      reader.finishPart(runs[which].data(), runs[which].size(), &requests[which]);
+      if (run + 1 < numRuns) {                    // read the next run...
+         runs[1 - which].resize( runLength(run + 1) );
+         reader.startPart(runs[1 - which].data(), runs[1 - which].size(),
+                           &requests[1 - which]);
+      }
+      radixSort(runs[which].data(), runs[which].size(), numThreads);
+      bucket = exchangeBuckets(runs[which], splitters, itemType);
+      radixSort(bucket.data(), bucket.size(), numThreads);
+      if (numRuns > 1) {                          // ...and save this one
+         if (runFile == NULL) {
+            runFile = fopen(runFileName.c_str(), "w+b");
+         }
+         if ( runFile == NULL ||                  // (an empty bucket adds
+               (!bucket.empty() &&                //   an empty run)
+                 fwrite(bucket.data(), sizeof(ItemType), bucket.size(), 
+                         runFile) != bucket.size()) ) {
+            fprintf(stderr, "\nparallelSort(): could not write run file '%s'\n\n",
+                             runFileName.c_str());
+            MPI_Abort(MPI_COMM_WORLD, 1);
+         }
+         runLengths.push_back( bucket.size() );
+      }
+   }
+   reader.endChunk();
+   reader.close();
+   MPI_Type_free(&itemType);
+
+   long numWritten = bucket.size();
+   if (numRuns <= 1) {
+      writer.writeChunk(bucket);
+   } else {
+      std::vector<ItemType>().swap(bucket);
+      std::vector<ItemType>().swap(runs[0]);
+      std::vector<ItemType>().swap(runs[1]);
+      mergeRuns(runFile, runLengths, writer, memoryBytes);
+      fclose(runFile);
+      remove( runFileName.c_str() );
+      numWritten = std::accumulate(runLengths.begin(), runLengths.end(), 0L);
+   }
+   writer.close();
+   return numWritten;
+}
+
+/*******************************************************************
+ * The ParallelUpdater template provides an abstraction to hide
+ *  the details of updating scattered Items of an existing binary 
+ *  file in place (without truncating it, as ParallelWriter does).
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+/* What writeItems() does when different PEs write different
+ *  values to the same Item.
+ */
+enum ConflictPolicy {
+  LOWEST_ID_WINS,          // keep the value from the lowest-id PE
+  HIGHEST_ID_WINS,         // keep the value from the highest-id PE
+  ABORT_ON_CONFLICT        // report the conflict and abort
+};
+
+template<class ItemType> 
+class ParallelUpdater : public OO_MPI_IO_Base<ItemType> {
+public:
+  ParallelUpdater(const std::string& fileName, MPI_Datatype mpiType,
+                   int id, int numPEs, 
+                   ConflictPolicy policy = HIGHEST_ID_WINS);
+  void writeItems(const std::vector<uint64_t>& indices,
+                   const std::vector<ItemType>& values);
+
+  ConflictPolicy getConflictPolicy() const      { return myPolicy; }
+  void setConflictPolicy(ConflictPolicy policy) { myPolicy = policy; }
+  long getNumConflicts() const                  { return myNumConflicts; }
+private:
+  void exchangeItems(std::vector<uint64_t>& indices, 
+                      std::vector<ItemType>& values);
+  void applyItems(const std::vector<uint64_t>& indices,
+                   const std::vector<ItemType>& values);
+
+  ConflictPolicy myPolicy;         // how to resolve cross-PE conflicts
+  long           myNumConflicts;   // conflicts this PE has resolved
+};
+
+/* ParallelUpdater constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: policy, a ConflictPolicy (default HIGHEST_ID_WINS)
+ * Precondition: fileName is the name of an existing file containing
+ *                binary-format values of type ItemType
+ *           &&  mpiType is the MPI equivalent of ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
+ * Postcondition: the file has been opened for parallel input and
+ *                 output (its contents are unchanged)
+ *           &&  getConflictPolicy() == policy.
+ */
+template <class ItemType>
+ParallelUpdater<ItemType>::
+ParallelUpdater(const std::string& fileName, MPI_Datatype mpiType,
+                 int id, int numPEs, ConflictPolicy policy)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDWR, mpiType, id, numPEs)
+{
+   myPolicy = policy;
+   myNumConflicts = 0;
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+}
+
+/* method to overwrite scattered Items of the file
+ * @param: indices, a vector of Item numbers
+ * @param: values, a vector of Items.
+ * Precondition: indices.size() == values.size().
+ * Postcondition: for each i, Item number indices[i] of the file
+ *                 has been set to values[i]
+ *            &&  if a PE lists an index more than once,
+ *                 its last value for that index was written
+ *            &&  if different PEs wrote different values to
+ *                 the same index, getConflictPolicy() decided which
+ *                 value was written (or aborted the program)
+ *            &&  Items not listed by any PE are unchanged
+ *                 (the file grows if an index is beyond its end,
+ *                  unless the file has a header, whose Item count
+ *                  is fixed: then such an index aborts the program)
+ *            &&  the file's checksum sidecar, zone map and Bloom filter
+ *                 (if any) have been removed, since they would no
+ *                 longer match.
+ *
+ * Note: In MPI mode this is a collective call, so every process must
+ *        call it (possibly with no indices): the batches are routed
+ *        (via MPI_Alltoallv) to the PE that owns each index's range,
+ *        where conflicts are resolved and adjacent indices coalesced
+ *        before one indexed MPI_File_write_all().
+ *       In OpenMP mode, each thread writes its own batch, 
+ *        so conflicts between threads are not detected.
+ */
+template <class ItemType>
+void ParallelUpdater<ItemType>::writeItems(const std::vector<uint64_t>& indices,
+                                            const std::vector<ItemType>& values) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (indices.size() != values.size()) {
+      fprintf(stderr, "\nParallelUpdater::writeItems(): %lu indices but"
+                      " %lu values\n\n", (unsigned long)indices.size(),
+                      (unsigned long)values.size());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   if ( OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      uint64_t numItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+      for (unsigned long i = 0; i < indices.size(); ++i) {
+         if (indices[i] >= numItems) {
+            fprintf(stderr, "\nParallelUpdater::writeItems(): index %llu is"
+                            " beyond the %llu Items in the header of '%s'\n\n",
+                            (unsigned long long)indices[i],
+                            (unsigned long long)numItems,
+                            OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+            MPI_Abort(MPI_COMM_WORLD, 1);
+         }
+      }
+   }
+   if (OO_MPI_IO_Base<ItemType>::getID() == 0) {
+      removeSidecars( OO_MPI_IO_Base<ItemType>::getFileName() );
+   }
+
+   // sort my batch by index, keeping my last value for each index
+   std::vector<unsigned long> order( indices.size() );
+   for (unsigned long i = 0; i < order.size(); ++i) {
+      order[i] = i;
+   }
+   std::stable_sort(order.begin(), order.end(), 
+                    [&indices](unsigned long a, unsigned long b) 
+                     { return indices[a] < indices[b]; });
+   std::vector<uint64_t> myIndices;
+   std::vector<ItemType> myValues;
+   for (unsigned long i = 0; i < order.size(); ++i) {
+      if ( !myIndices.empty() && myIndices.back() == indices[order[i]] ) {
+         myValues.back() = values[order[i]];
+      } else {
+         myIndices.push_back( indices[order[i]] );
+         myValues.push_back( values[order[i]] );
+      }
+   }
+
+   if ( OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      exchangeItems(myIndices, myValues);
+   }
+   OO_MPI_IO_Base<ItemType>::convertItems(myValues.data(), myValues.size());
+   applyItems(myIndices, myValues);
+
+   // a header's Item count is fixed, so the file may not grow past it
+   if ( OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      return;
+   }
+   MPI_Offset fileSize;
+   timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+   OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile( fileSize / 
+                                  OO_MPI_IO_Base<ItemType>::getItemSize() );
+}
+
+/* utility to route each (index, value) pair to the PE that owns
+ *  the index and resolve the conflicts there
+ * @param: indices, a vector of Item numbers
+ * @param: values, a vector of Items
+ * Precondition: indices is sorted, with no duplicates
+ *           &&  values[i] is this PE's value for indices[i].
+ * Postcondition: indices and values hold the (sorted, unique) pairs
+ *                 in this PE's range of indices, from all PEs,
+ *                 with conflicts resolved according to myPolicy.
+ */
+template <class ItemType>
+void ParallelUpdater<ItemType>::exchangeItems(std::vector<uint64_t>& indices,
+                                               std::vector<ItemType>& values) {
+   int numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+   int itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+
+   // split the index space 0..maxIndex evenly among the PEs
+   uint64_t myMax = indices.empty() ? 0 : indices.back() + 1;
+   uint64_t numIndices = 0;
+   MPI_Allreduce(&myMax, &numIndices, 1, MPI_UINT64_T, MPI_MAX,
+                  MPI_COMM_WORLD);
+   uint64_t rangeSize = (numIndices + numPEs - 1) / numPEs;
+   if (rangeSize == 0) {
+      return;                                // no PE has any items
+   }
+
+   std::vector<int> sendCounts(numPEs, 0), recvCounts(numPEs, 0);
+   for (unsigned long i = 0; i < indices.size(); ++i) {
+      ++sendCounts[ indices[i] / rangeSize ];
+   }
+   MPI_Alltoall(sendCounts.data(), 1, MPI_INT, 
+                 recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+   std::vector<int> sendDispls(numPEs, 0), recvDispls(numPEs, 0);
+   for (int p = 1; p < numPEs; ++p) {
+      sendDispls[p] = sendDispls[p-1] + sendCounts[p-1];
+      recvDispls[p] = recvDispls[p-1] + recvCounts[p-1];
+   }
+   long numReceived = recvDispls[numPEs-1] + recvCounts[numPEs-1];
+
+   // indices are sorted, so each PE's pairs are already contiguous
+   std::vector<uint64_t> inIndices(numReceived);
+   MPI_Alltoallv(indices.data(), sendCounts.data(), sendDispls.data(), 
+                  MPI_UINT64_T, inIndices.data(), recvCounts.data(), 
+                  recvDispls.data(), MPI_UINT64_T, MPI_COMM_WORLD);
+   for (int p = 0; p < numPEs; ++p) {             // now count bytes
+      sendCounts[p] *= itemSize;   sendDispls[p] *= itemSize;
+      recvCounts[p] *= itemSize;   recvDispls[p] *= itemSize;
+   }
+   std::vector<ItemType> inValues(numReceived);
+   MPI_Alltoallv(values.data(), sendCounts.data(), sendDispls.data(),
+                  MPI_BYTE, inValues.data(), recvCounts.data(),
+                  recvDispls.data(), MPI_BYTE, MPI_COMM_WORLD);
+
+   // order by (index, source PE); the pairs arrived in PE order,
+   //  so a stable sort by index keeps each index's PEs in order
+   std::vector<long> order(numReceived);
+   for (long i = 0; i < numReceived; ++i) {
+      order[i] = i;
+   }
+   std::stable_sort(order.begin(), order.end(),
+                    [&inIndices](long a, long b) 
+                     { return inIndices[a] < inIndices[b]; });
+   indices.clear();
+   values.clear();
+   for (long i = 0; i < numReceived; ) {
+      long j = i + 1;                       // [i, j) share an index
+      while (j < numReceived && inIndices[order[j]] == inIndices[order[i]]) {
+         ++j;
+      }
+      const ItemType& first = inValues[ order[i] ];
+      const ItemType& last = inValues[ order[j-1] ];
+      bool conflict = false;
+      for (long k = i+1; k < j; ++k) {
+         conflict = conflict || 
+                     memcmp(&inValues[order[k]], &first, itemSize) != 0;
+      }
+      if (conflict) {
+         ++myNumConflicts;
+         if (myPolicy == ABORT_ON_CONFLICT) {
+            fprintf(stderr, "\nParallelUpdater::writeItems(): PEs wrote"
+                            " different values to Item %llu of '%s'\n\n",
+                            (unsigned long long)inIndices[order[i]],
+                            OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+            MPI_Abort(MPI_COMM_WORLD, 1);
+         }
+      }
+      indices.push_back( inIndices[order[i]] );
+      values.push_back( myPolicy == LOWEST_ID_WINS ? first : last );
+      i = j;
+   }
+}
+
+/* utility to write (index, value) pairs with one indexed write
+ * @param: indices, a vector of Item numbers
+ * @param: values, a vector of Items
+ * Precondition: indices is sorted, with no duplicates
+ *           &&  values[i] is the value for indices[i].
+ * Postcondition: each value has been written to its Item of the file,
+ *                 adjacent indices having been coalesced into runs.
+ */
+template <class ItemType>
+void ParallelUpdater<ItemType>::applyItems(const std::vector<uint64_t>& indices,
+                                            const std::vector<ItemType>& values) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   std::vector<MPI_Aint> byteOffsets;
+   std::vector<int> runLengths;
+   for (unsigned long i = 0; i < indices.size(); ++i) {
+      if ( !runLengths.empty() && runLengths.back() < INT_MAX &&
+            indices[i] == indices[i-1] + 1 ) {
+         ++runLengths.back();
+      } else {
+         byteOffsets.push_back( indices[i] * itemSize );
+         runLengths.push_back(1);
+      }
+   }
+
+   MPI_Datatype mpiType = OO_MPI_IO_Base<ItemType>::getMPIType();
+   MPI_Datatype fileType;
+   MPI_Type_create_hindexed(runLengths.size(), runLengths.data(),
+                             byteOffsets.data(), mpiType, &fileType);
+   MPI_Type_commit(&fileType);
+
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   MPI_Status status;
+   int writeResult = MPI_File_set_view(fh, 
+                                        OO_MPI_IO_Base<ItemType>::getDataOffset(),
+                                        mpiType, fileType,
+                                        "native", MPI_INFO_NULL);
+   checkResult(writeResult);
+   unsigned long itemsWritten = 0;
+   unsigned long itemsToWrite = values.size();
+   while (itemsToWrite > INT_MAX) {
+      writeResult = timedWrite(stats, fh, values.data()+itemsWritten, INT_MAX,
+                                       mpiType, &status);
+      checkResult(writeResult);
+      itemsWritten += INT_MAX;
+      itemsToWrite -= INT_MAX;
+   }
+   if ( OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      writeResult = timedWriteAll(stats, fh, values.data()+itemsWritten,
+                                          itemsToWrite, mpiType, &status);
+   } else {
+      writeResult = timedWrite(stats, fh, values.data()+itemsWritten,
+                                       itemsToWrite, mpiType, &status);
+   }
+   checkResult(writeResult);
+   // restore the default (byte-stream) view for any later calls
+   MPI_File_set_view(fh, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+   MPI_Type_free(&fileType);
+}
+
+/*******************************************************************
+ * OO_MPI_IO_ArrayBase extends OO_MPI_IO_Base with the bookkeeping
+ *  needed to block-decompose an N-dimensional, row-major array 
+ *  stored in a binary file across a grid of PEs.
+ *
+ * Its subclasses are ParallelArrayReader and ParallelArrayWriter.
+ ******************************************************************/
+
+template<class ItemType>
+class OO_MPI_IO_ArrayBase : public OO_MPI_IO_Base<ItemType> {
+public:
+  OO_MPI_IO_ArrayBase(const std::string& fileName, int openMode,
+                       MPI_Datatype mpiType, int id, int numPEs,
+                       const std::vector<long>& globalShape,
+                       const std::vector<int>& processGrid,
+                       int ghostWidth);
+
+  int getNumDims() const                        { return myGlobalShape.size(); }
+  int getGhostWidth() const                     { return myGhostWidth; }
+  const std::vector<long>& getGlobalShape() const { return myGlobalShape; }
+  const std::vector<int>& getProcessGrid() const  { return myProcessGrid; }
+  const std::vector<int>& getGridCoords() const   { return myGridCoords; }
+  const std::vector<long>& getLocalStart() const  { return myLocalStart; }
+  const std::vector<long>& getLocalShape() const  { return myLocalShape; }
+  const std::vector<long>& getBlockShape() const  { return myBlockShape; }
+  long getBlockSize() const;
+
+protected:
+  void buildTypes(bool withGhosts, 
+                   MPI_Datatype& fileType, MPI_Datatype& memType) const;
+
+private:
+  std::vector<long> myGlobalShape;       // extent of each dimension
+  std::vector<int>  myProcessGrid;       // num PEs along each dimension
+  std::vector<int>  myGridCoords;        // my position in the PE grid
+  std::vector<long> myLocalStart;        // global index of my first item
+  std::vector<long> myLocalShape;        // extent of my tile (no ghosts)
+  std::vector<long> myBlockShape;        // extent of my tile + ghosts
+  int               myGhostWidth;        // ghost layers on each side
+};
+
+/* OO_MPI_IO_ArrayBase constructor
+ * @param: fileName, a string
+ * @param: openMode, an int
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: globalShape, a vector of longs
+ * @param: processGrid, a vector of ints
+ * @param: ghostWidth, an int
+ * Precondition: fileName, openMode, mpiType, id and numPEs are
+ *                as described in the OO_MPI_IO_Base constructor
+ *           &&  globalShape contains the extent of each dimension
+ *                of a row-major array (slowest-varying first)
+ *           &&  processGrid.size() == globalShape.size()
+ *           &&  the product of processGrid's values == numPEs
+ *           &&  0 < processGrid[d] <= globalShape[d], for each d
+ *           &&  ghostWidth >= 0.
+ * Postcondition: the file has been opened as specified by openMode
+ *           &&  this PE's grid coordinates, tile start and tile shape
+ *                have been computed (PEs are numbered row-major 
+ *                within the grid, as in MPI_Cart_create())
+ *           &&  getBlockShape() == getLocalShape() + 2*ghostWidth
+ *                in each dimension.
+ */
+template <class ItemType>
+OO_MPI_IO_ArrayBase<ItemType>::
+OO_MPI_IO_ArrayBase(const std::string& fileName, int openMode,
+                     MPI_Datatype mpiType, int id, int numPEs,
+                     const std::vector<long>& globalShape,
+                     const std::vector<int>& processGrid,
+                     int ghostWidth)
+: OO_MPI_IO_Base<ItemType>(fileName, openMode, mpiType, id, numPEs)
+{
+   int numDims = globalShape.size();
+   if (numDims == 0 || (int)processGrid.size() != numDims) {
+      fprintf(stderr, "\nOO_MPI_IO_ArrayBase(): globalShape and processGrid"
+                      " must have the same (positive) number of dimensions\n\n");
+      exit(1);
+   }
+   long gridSize = 1;
+   for (int d = 0; d < numDims; ++d) {
+      if (processGrid[d] <= 0 || processGrid[d] > globalShape[d]) {
+         fprintf(stderr, "\nOO_MPI_IO_ArrayBase(): bad processGrid[%d] (%d)"
+                         " for globalShape[%d] (%ld)\n\n",
+                         d, processGrid[d], d, globalShape[d]);
+         exit(1);
+      }
+      gridSize *= processGrid[d];
+   }
+   if (gridSize != numPEs) {
+      fprintf(stderr, "\nOO_MPI_IO_ArrayBase(): processGrid has %ld PEs,"
+                      " but numPEs is %d\n\n", gridSize, numPEs);
+      exit(1);
+   }
+   if (ghostWidth < 0) {
+      fprintf(stderr, "\nOO_MPI_IO_ArrayBase(): ghostWidth must be"
+                      " non-negative\n\n");
+      exit(1);
+   }
+
+   myGlobalShape = globalShape;
+   myProcessGrid = processGrid;
+   myGhostWidth = ghostWidth;
+   myGridCoords.resize(numDims);
+   myLocalStart.resize(numDims);
+   myLocalShape.resize(numDims);
+   myBlockShape.resize(numDims);
+
+   // row-major PE numbering: the last dimension varies fastest
+   int rest = id;
+   for (int d = numDims-1; d >= 0; --d) {
+      myGridCoords[d] = rest % processGrid[d];
+      rest /= processGrid[d];
+   }
+
+   // split each dimension into (nearly) equal pieces,
+   //  just as getChunkStartStopValues() does for 1-D files
+   long numItems = 1, firstItem = 0;
+   for (int d = 0; d < numDims; ++d) {
+      long start = 0, stop = 0;
+      getChunkStartStopValues(myGridCoords[d], processGrid[d], 
+                               globalShape[d], start, stop);
+      myLocalStart[d] = start;
+      myLocalShape[d] = stop - start;
+      myBlockShape[d] = myLocalShape[d] + 2 * ghostWidth;
+      numItems *= myLocalShape[d];
+      firstItem = firstItem * globalShape[d] + start;
+   }
+
+   long totalItems = 1;
+   for (int d = 0; d < numDims; ++d) {
+      totalItems *= globalShape[d];
+   }
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile(totalItems);
+   OO_MPI_IO_Base<ItemType>::setChunkSize(numItems);
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(firstItem);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(
+                          firstItem * OO_MPI_IO_Base<ItemType>::getItemSize());
+}
+
+/* number of Items in this PE's tile, including its ghost layers
+ */
+template <class ItemType>
+long OO_MPI_IO_ArrayBase<ItemType>::getBlockSize() const {
+   long result = 1;
+   for (unsigned d = 0; d < myBlockShape.size(); ++d) {
+      result *= myBlockShape[d];
+   }
+   return result;
+}
+
+/* utility to build the file- and memory-datatypes for this PE's tile
+ * @param: withGhosts, a bool
+ * @param: fileType, an MPI_Datatype reference
+ * @param: memType, an MPI_Datatype reference
+ * Precondition: withGhosts is true iff the ghost layers are to be
+ *                included in the region of the file being accessed.
+ * Postcondition: fileType is a committed subarray of the global array
+ *                 selecting this PE's tile (plus its ghost layers, 
+ *                 clipped to the array's bounds, if withGhosts)
+ *            &&  memType is a committed subarray of a getBlockShape() 
+ *                 buffer selecting the same Items
+ *            &&  the caller is responsible for freeing both types.
+ */
+template <class ItemType>
+void OO_MPI_IO_ArrayBase<ItemType>::
+buildTypes(bool withGhosts, MPI_Datatype& fileType, MPI_Datatype& memType) const {
+   int numDims = myGlobalShape.size();
+   std::vector<int> globalSizes(numDims), subSizes(numDims), 
+                    fileStarts(numDims), blockSizes(numDims), 
+                    memStarts(numDims);
+   int ghosts = withGhosts ? myGhostWidth : 0;
+   for (int d = 0; d < numDims; ++d) {
+      long lo = myLocalStart[d] - ghosts;
+      long hi = myLocalStart[d] + myLocalShape[d] + ghosts;
+      if (lo < 0) lo = 0;
+      if (hi > myGlobalShape[d]) hi = myGlobalShape[d];
+      globalSizes[d] = myGlobalShape[d];
+      subSizes[d] = hi - lo;
+      fileStarts[d] = lo;
+      blockSizes[d] = myBlockShape[d];
+      memStarts[d] = lo - (myLocalStart[d] - myGhostWidth);
+   }
+   MPI_Datatype mpiType = OO_MPI_IO_Base<ItemType>::getMPIType();
+   MPI_Type_create_subarray(numDims, globalSizes.data(), subSizes.data(),
+                             fileStarts.data(), MPI_ORDER_C, mpiType,
+                             &fileType);
+   MPI_Type_commit(&fileType);
+   MPI_Type_create_subarray(numDims, blockSizes.data(), subSizes.data(),
+                             memStarts.data(), MPI_ORDER_C, mpiType,
+                             &memType);
+   MPI_Type_commit(&memType);
+}
+
+/*******************************************************************
+ * The ParallelArrayReader template provides an abstraction to hide
+ *  the details of reading a block-decomposed N-dimensional array.
+ *
+ * It uses OO_MPI_IO_ArrayBase as its superclass.
+ ******************************************************************/
+
+template<class ItemType> 
+class ParallelArrayReader : public OO_MPI_IO_ArrayBase<ItemType> {
+public:
+  ParallelArrayReader(const std::string& fileName, MPI_Datatype mpiType,
+                       int id, int numPEs, 
+                       const std::vector<long>& globalShape,
+                       const std::vector<int>& processGrid,
+                       int ghostWidth = 0);
+  std::vector<ItemType> readBlock();
+};
+
+/* ParallelArrayReader constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: globalShape, a vector of longs
+ * @param: processGrid, a vector of ints
+ * @param: ghostWidth, an int (default 0)
+ * Precondition: fileName is the name of a file containing a 
+ *                row-major array of binary-format ItemType values
+ *                whose dimensions are given by globalShape
+ *           &&  the other parameters are as described in the 
+ *                OO_MPI_IO_ArrayBase constructor.
+ * Postcondition: the file has been opened for parallel input
+ *           &&  this PE's tile has been computed.
+ */
+template <class ItemType>
+ParallelArrayReader<ItemType>::
+ParallelArrayReader(const std::string& fileName, MPI_Datatype mpiType,
+                     int id, int numPEs,
+                     const std::vector<long>& globalShape,
+                     const std::vector<int>& processGrid,
+                     int ghostWidth)
+: OO_MPI_IO_ArrayBase<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, 
+                                 id, numPEs, globalShape, processGrid,
+                                 ghostWidth)
+{
+   long shapeItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+   if ( OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      std::vector<uint64_t> dims = OO_MPI_IO_Base<ItemType>::getDims();
+      bool shapeMatches = dims.empty() || dims.size() == globalShape.size();
+      for (unsigned d = 0; shapeMatches && d < dims.size(); ++d) {
+         shapeMatches = ( dims[d] == (uint64_t)globalShape[d] );
+      }
+      if ( !shapeMatches ) {
+         fprintf(stderr, "\nParallelArrayReader(): the shape in the header"
+                         " of '%s' does not match globalShape\n\n",
+                         fileName.c_str());
+         exit(1);
+      }
+      // the header's count describes the file; the shape, the array
+      OO_MPI_IO_Base<ItemType>::setNumItemsInFile(shapeItems);
+   }
+}
+
+/* method to read this PE's tile (and its ghost layers)
+ * Return: a row-major vector of getBlockSize() Items,
+ *          with shape getBlockShape(), whose interior contains
+ *          this PE's tile and whose ghost layers contain the
+ *          neighboring PEs' boundary Items.
+ *          Ghost Items that lie outside the array are value-initialized.
+ * Note: In MPI mode this is a collective call (MPI_File_read_all),
+ *        so every process must call it.
+ */
+template <class ItemType>
+std::vector<ItemType> 
+ParallelArrayReader<ItemType>::readBlock() {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_Offset fileSize;
+   timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+   OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+   long dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   long bytesNeeded = dataOffset 
+                       + OO_MPI_IO_Base<ItemType>::getNumItemsInFile() 
+                       * OO_MPI_IO_Base<ItemType>::getItemSize();
+   if (fileSize < bytesNeeded) {
+      fprintf(stderr, "\nParallelArrayReader::readBlock(): '%s' has %lld bytes,"
+                      " but its shape needs %ld\n\n",
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str(),
+                      (long long)fileSize, bytesNeeded);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   std::vector<ItemType> v( OO_MPI_IO_ArrayBase<ItemType>::getBlockSize() );
+   MPI_Datatype fileType, memType;
+   OO_MPI_IO_ArrayBase<ItemType>::buildTypes(true, fileType, memType);
+
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   MPI_Status status;
+   int result = MPI_File_set_view(fh, dataOffset, 
+                                   OO_MPI_IO_Base<ItemType>::getMPIType(),
+                                   fileType, "native", MPI_INFO_NULL);
+   checkResult(result);
+   if ( OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      result = timedReadAll(stats, fh, v.data(), 1, memType, &status);
+   } else {
+      result = timedRead(stats, fh, v.data(), 1, memType, &status);
+   }
+   checkResult(result);
+   // restore the default (byte-stream) view for any later calls
+   MPI_File_set_view(fh, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+   OO_MPI_IO_Base<ItemType>::convertItems(v.data(), v.size());
+
+   MPI_Type_free(&fileType);
+   MPI_Type_free(&memType);
+   return v;
+}
+
+/*******************************************************************
+ * The ParallelArrayWriter template provides an abstraction to hide
+ *  the details of writing a block-decomposed N-dimensional array.
+ *
+ * It uses OO_MPI_IO_ArrayBase as its superclass.
+ ******************************************************************/
+
+template<class ItemType> 
+class ParallelArrayWriter : public OO_MPI_IO_ArrayBase<ItemType> {
+public:
+  ParallelArrayWriter(const std::string& fileName, MPI_Datatype mpiType,
+                       int id, int numPEs, 
+                       const std::vector<long>& globalShape,
+                       const std::vector<int>& processGrid,
+                       int ghostWidth = 0);
+  void writeBlock(const std::vector<ItemType>& v);
+};
+
+/* ParallelArrayWriter constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: globalShape, a vector of longs
+ * @param: processGrid, a vector of ints
+ * @param: ghostWidth, an int (default 0)
+ * Precondition: fileName is the name of an output file to which
+ *                a row-major array of binary-format ItemType values
+ *                whose dimensions are given by globalShape
+ *                is to be written
+ *           &&  the other parameters are as described in the 
+ *                OO_MPI_IO_ArrayBase constructor.
+ * Postcondition: the file has been opened for parallel output
+ *           &&  this PE's tile has been computed.
+ */
+template <class ItemType>
+ParallelArrayWriter<ItemType>::
+ParallelArrayWriter(const std::string& fileName, MPI_Datatype mpiType,
+                     int id, int numPEs,
+                     const std::vector<long>& globalShape,
+                     const std::vector<int>& processGrid,
+                     int ghostWidth)
+: OO_MPI_IO_ArrayBase<ItemType>(fileName, MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                 mpiType, id, numPEs, globalShape, 
+                                 processGrid, ghostWidth)
+{ }
+
+/* method to write this PE's tile to the file
+ * @param: v, a vector of Items.
+ * Precondition: v is a row-major block with shape getBlockShape()
+ *                (i.e., laid out as returned by 
+ *                ParallelArrayReader::readBlock()).
+ * Postcondition: the interior of v (not its ghost layers) has been
+ *                 written to this PE's tile of the file
+ *            &&  the file's size is that of the global array
+ *            &&  the file's (now stale) sidecars have been removed.
+ * Note: In MPI mode this is a collective call (MPI_File_write_all),
+ *        so every process must call it.
+ */
+template <class ItemType>
+void ParallelArrayWriter<ItemType>::writeBlock(const std::vector<ItemType>& v) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if ((long)v.size() != OO_MPI_IO_ArrayBase<ItemType>::getBlockSize()) {
+      fprintf(stderr, "\nParallelArrayWriter::writeBlock(): block has %lu"
+                      " Items, but its shape needs %ld\n\n",
+                      (unsigned long)v.size(), 
+                      OO_MPI_IO_ArrayBase<ItemType>::getBlockSize());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   long totalBytes = OO_MPI_IO_Base<ItemType>::getNumItemsInFile()
+                      * OO_MPI_IO_Base<ItemType>::getItemSize();
+   timedSetSize(stats, fh, totalBytes);    // truncate or extend
+   OO_MPI_IO_Base<ItemType>::setFileSize(totalBytes);
+   if (OO_MPI_IO_Base<ItemType>::getID() == 0) {
+      removeSidecars( OO_MPI_IO_Base<ItemType>::getFileName() );
+   }
+
+   // convert a copy, if need be (the caller's block is unchanged)
+   const ItemType* data = v.data();
+   std::vector<ItemType> converted;
+   if ( OO_MPI_IO_Base<ItemType>::needsByteSwap() ) {
+      converted = v;
+      OO_MPI_IO_Base<ItemType>::convertItems(converted.data(), 
+                                              converted.size());
+      data = converted.data();
+   }
+
+   MPI_Datatype fileType, memType;
+   OO_MPI_IO_ArrayBase<ItemType>::buildTypes(false, fileType, memType);
+
+   MPI_Status status;
+   int result = MPI_File_set_view(fh, 0, 
+                                   OO_MPI_IO_Base<ItemType>::getMPIType(),
+                                   fileType, "native", MPI_INFO_NULL);
+   checkResult(result);
+   if ( OO_MPI_IO_Base<ItemType>::isCollective() ) {
+      result = timedWriteAll(stats, fh, data, 1, memType, &status);
+   } else {
+      result = timedWrite(stats, fh, data, 1, memType, &status);
+   }
+   checkResult(result);
+   MPI_File_set_view(fh, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+
+   MPI_Type_free(&fileType);
+   MPI_Type_free(&memType);
+}
+
+/*******************************************************************
+ * The TiledArray template provides an out-of-core 2-D array:
+ *  a row-major matrix stored in a binary file is accessed one
+ *  fixed-size tile at a time, through a bounded LRU cache of tiles.
+ *
+ * Tiles are fetched on demand (or ahead of time, via prefetch())
+ *  using non-blocking MPI-IO, and modified tiles are written back 
+ *  when they are evicted or when flush() is called.
+ *
+ * Each PE has its own independent cache, so PEs that modify 
+ *  the array should modify disjoint tiles.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType>
+class TiledArray : public OO_MPI_IO_Base<ItemType> {
+public:
+  TiledArray(const std::string& fileName, MPI_Datatype mpiType,
+              int id, int numPEs, long numRows, long numCols,
+              long tileRows, long tileCols, int maxTiles);
+  ~TiledArray();
+
+  ItemType get(long row, long col);
+  void set(long row, long col, const ItemType& value);
+  ItemType* getTile(long tileRow, long tileCol, bool willModify = false);
+  void prefetch(long tileRow, long tileCol);
+  void setAutoPrefetch(bool flag)      { myAutoPrefetch = flag; }
+  void flush();
+  void close();
+
+  long getNumRows() const              { return myNumRows; }
+  long getNumCols() const              { return myNumCols; }
+  long getTileRows() const             { return myTileRows; }
+  long getTileCols() const             { return myTileCols; }
+  long getNumTileRows() const          { return myNumTileRows; }
+  long getNumTileCols() const          { return myNumTileCols; }
+  int getMaxTiles() const              { return myMaxTiles; }
+  int getNumCachedTiles() const        { return myTiles.size(); }
+
+  long getHits() const                 { return myHits; }
+  long getMisses() const               { return myMisses; }
+  long getPrefetches() const           { return myPrefetches; }
+  long getEvictions() const            { return myEvictions; }
+  long getWriteBacks() const           { return myWriteBacks; }
+  long getBytesRead() const            { return myBytesRead; }
+  long getBytesWritten() const         { return myBytesWritten; }
+  double getReadSeconds() const        { return myReadSeconds; }
+  double getWriteSeconds() const       { return myWriteSeconds; }
+  double getReadBandwidth() const;
+  double getWriteBandwidth() const;
+
+private:
+  struct Tile {
+     std::vector<ItemType>     data;       // tileRows x tileCols Items
+     std::vector<MPI_Request>  requests;   // outstanding reads, if any
+     std::list<long>::iterator lruPos;     // position in myLRU
+     bool                      dirty;      // modified since fetched?
+  };
+
+  Tile& findTile(long tileRow, long tileCol, bool countAccess);
+  Tile& loadTile(long key);
+  void waitFor(Tile& tile);
+  void writeBack(long key, Tile& tile);
+  void evictOne();
+  void checkTileCoords(long tileRow, long tileCol) const;
+
+  long myNumRows, myNumCols;              // shape of the matrix
+  long myTileRows, myTileCols;            // shape of one tile
+  long myNumTileRows, myNumTileCols;      // shape of the tile grid
+  int  myMaxTiles;                        // capacity of the cache
+  bool myAutoPrefetch;                    // prefetch the next tile?
+  bool myClosedFlag;                      // has close() been called?
+  bool mySidecarsRemoved;                 // by this PE's first write-back?
+
+  std::unordered_map<long, Tile> myTiles; // the cache, keyed by tile #
+  std::list<long> myLRU;                  // tile #s, most recent first
+  long  myLastKey;                        // most recently used tile #
+  Tile* myLastTile;                       //  and its cache entry
+
+  long   myHits, myMisses, myPrefetches, myEvictions, myWriteBacks;
+  long   myBytesRead, myBytesWritten;
+  double myReadSeconds, myWriteSeconds;
+};
+
+/* TiledArray constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: numRows, numCols, longs
+ * @param: tileRows, tileCols, longs
+ * @param: maxTiles, an int
+ * Precondition: fileName is the name of a file containing (or that
+ *                is to contain) a numRows x numCols row-major matrix
+ *                of binary-format values of type ItemType
+ *           &&  mpiType is the MPI equivalent of ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes
+ *           &&  numRows, numCols, tileRows, tileCols are positive
+ *           &&  maxTiles > 0 is the number of tiles the cache may hold.
+ * Postcondition: the file has been opened (and created, if need be)
+ *                 for parallel input and output
+ *           &&  the cache is empty and its counters are zero.
+ * Note: Items beyond the end of the file read as value-initialized Items.
+ */
+template <class ItemType>
+TiledArray<ItemType>::
+TiledArray(const std::string& fileName, MPI_Datatype mpiType,
+            int id, int numPEs, long numRows, long numCols,
+            long tileRows, long tileCols, int maxTiles)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDWR | MPI_MODE_CREATE,
+                            mpiType, id, numPEs)
+{
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (numRows <= 0 || numCols <= 0 || tileRows <= 0 || tileCols <= 0) {
+      fprintf(stderr, "\nTiledArray(): matrix and tile dimensions"
+                      " must be positive\n\n");
+      exit(1);
+   }
+   if (maxTiles <= 0) {
+      fprintf(stderr, "\nTiledArray(): maxTiles must be positive\n\n");
+      exit(1);
+   }
+   myNumRows = numRows;
+   myNumCols = numCols;
+   myTileRows = tileRows;
+   myTileCols = tileCols;
+   myNumTileRows = (numRows + tileRows - 1) / tileRows;
+   myNumTileCols = (numCols + tileCols - 1) / tileCols;
+   myMaxTiles = maxTiles;
+   myAutoPrefetch = false;
+   myClosedFlag = false;
+   mySidecarsRemoved = false;
+   myLastKey = -1;
+   myLastTile = NULL;
+   myHits = myMisses = myPrefetches = myEvictions = myWriteBacks = 0;
+   myBytesRead = myBytesWritten = 0;
+   myReadSeconds = myWriteSeconds = 0.0;
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile(numRows * numCols);
+   MPI_Offset fileSize;
+   timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+   OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+}
+
+/* TiledArray destructor
+ * Postcondition: if close() was not called (and MPI is still active),
+ *                 any modified tiles have been written back.
+ */
+template <class ItemType>
+TiledArray<ItemType>::~TiledArray() {
+   int finalizedFlag = 0;
+   MPI_Finalized(&finalizedFlag);
+   if (!myClosedFlag && !finalizedFlag) {
+      flush();
+   }
+}
+
+/* utility to validate a tile's coordinates
+ */
+template <class ItemType>
+void TiledArray<ItemType>::checkTileCoords(long tileRow, long tileCol) const {
+   if (tileRow < 0 || tileRow >= myNumTileRows || 
+        tileCol < 0 || tileCol >= myNumTileCols) {
+      fprintf(stderr, "\nTiledArray: bad tile (%ld, %ld)\n\n", 
+                      tileRow, tileCol);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+}
+
+/* utility to start reading a tile into a new cache entry
+ * @param: key, a long
+ * Precondition: tile key is not in the cache.
+ * Postcondition: the cache has room for tile key (via eviction)
+ *            &&  non-blocking reads of tile key's rows have been started
+ *            &&  tile key is the most-recently-used tile.
+ * Return: the new cache entry.
+ */
+template <class ItemType>
+typename TiledArray<ItemType>::Tile& TiledArray<ItemType>::loadTile(long key) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   while ((int)myTiles.size() >= myMaxTiles) {
+      evictOne();
+   }
+   Tile& tile = myTiles[key];
+   tile.data.assign(myTileRows * myTileCols, ItemType());
+   tile.dirty = false;
+   myLRU.push_front(key);
+   tile.lruPos = myLRU.begin();
+
+   long row0 = (key / myNumTileCols) * myTileRows;
+   long col0 = (key % myNumTileCols) * myTileCols;
+   long rows = std::min(myTileRows, myNumRows - row0);
+   long cols = std::min(myTileCols, myNumCols - col0);
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   long dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   double startTime = MPI_Wtime();
+   // don't read past end-of-file (the file may be new, or still growing);
+   //  besides being wasted work, some MPI-IO implementations hang on it
+   long lastByte = dataOffset 
+                    + ((row0 + rows - 1) * myNumCols + col0 + cols) * itemSize;
+   if (lastByte > OO_MPI_IO_Base<ItemType>::getFileSize()) {
+      MPI_Offset fileSize;
+      timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+      OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+   }
+   long itemsInFile = (OO_MPI_IO_Base<ItemType>::getFileSize() - dataOffset)
+                       / itemSize;
+   tile.requests.reserve(rows);
+   for (long r = 0; r < rows; ++r) {
+      long firstItem = (row0 + r) * myNumCols + col0;
+      long count = std::min(cols, itemsInFile - firstItem);
+      if (count <= 0) {
+         break;
+      }
+      MPI_Request request;
+      int readResult = timedIreadAt(stats, 
+                               OO_MPI_IO_Base<ItemType>::getFileHandle(),
+                               dataOffset + firstItem * itemSize, 
+                               tile.data.data() + r * myTileCols,
+                               count, OO_MPI_IO_Base<ItemType>::getMPIType(),
+                               &request);
+      checkResult(readResult);
+      tile.requests.push_back(request);
+      myBytesRead += count * itemSize;
+   }
+   myReadSeconds += MPI_Wtime() - startTime;
+   return tile;
+}
+
+/* utility to wait for a tile's outstanding reads (if any) to finish
+ */
+template <class ItemType>
+void TiledArray<ItemType>::waitFor(Tile& tile) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if ( !tile.requests.empty() ) {
+      double startTime = MPI_Wtime();
+      timedWaitall(stats, READ_OP, tile.requests.size(), tile.requests.data(),
+                   MPI_STATUSES_IGNORE);
+      OO_MPI_IO_Base<ItemType>::convertItems(tile.data.data(), 
+                                              tile.data.size());
+      myReadSeconds += MPI_Wtime() - startTime;
+      tile.requests.clear();
+   }
+}
+
+/* utility to write a modified tile back to the file
+ *  (removing the file's stale sidecars first, if this PE has not yet)
+ */
+template <class ItemType>
+void TiledArray<ItemType>::writeBack(long key, Tile& tile) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   waitFor(tile);
+   if (!mySidecarsRemoved) {
+      removeSidecars( OO_MPI_IO_Base<ItemType>::getFileName() );
+      mySidecarsRemoved = true;
+   }
+   long row0 = (key / myNumTileCols) * myTileRows;
+   long col0 = (key % myNumTileCols) * myTileCols;
+   long rows = std::min(myTileRows, myNumRows - row0);
+   long cols = std::min(myTileCols, myNumCols - col0);
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   double startTime = MPI_Wtime();
+   long dataOffset = OO_MPI_IO_Base<ItemType>::getDataOffset();
+   // convert to the file's byte order for the writes, then back again
+   OO_MPI_IO_Base<ItemType>::convertItems(tile.data.data(), tile.data.size());
+   MPI_Status status;
+   for (long r = 0; r < rows; ++r) {
+      MPI_Offset byteOffset = dataOffset 
+                               + ((row0 + r) * myNumCols + col0) * itemSize;
+      int writeResult = timedWriteAt(stats, 
+                               OO_MPI_IO_Base<ItemType>::getFileHandle(),
+                               byteOffset, tile.data.data() + r * myTileCols,
+                               cols, OO_MPI_IO_Base<ItemType>::getMPIType(),
+                               &status);
+      checkResult(writeResult);
+   }
+   OO_MPI_IO_Base<ItemType>::convertItems(tile.data.data(), tile.data.size());
+   myWriteSeconds += MPI_Wtime() - startTime;
+   myBytesWritten += rows * cols * itemSize;
+   long lastByte = dataOffset 
+                    + ((row0 + rows - 1) * myNumCols + col0 + cols) * itemSize;
+   if (lastByte > OO_MPI_IO_Base<ItemType>::getFileSize()) {
+      OO_MPI_IO_Base<ItemType>::setFileSize(lastByte);
+   }
+   ++myWriteBacks;
+   tile.dirty = false;
+}
+
+/* utility to evict the least-recently-used tile from the cache
+ */
+template <class ItemType>
+void TiledArray<ItemType>::evictOne() {
+   long key = myLRU.back();
+   Tile& tile = myTiles[key];
+   if (tile.dirty) {
+      writeBack(key, tile);
+   } else {
+      waitFor(tile);           // MPI still owns the buffer until done
+   }
+   myLRU.pop_back();
+   myTiles.erase(key);
+   if (key == myLastKey) {
+      myLastKey = -1;
+      myLastTile = NULL;
+   }
+   ++myEvictions;
+}
+
+/* utility to find a tile, fetching it on a miss
+ * @param: tileRow, tileCol, longs
+ * @param: countAccess, a bool
+ * Postcondition: the tile is in the cache, its reads have completed,
+ *                 and it is the most-recently-used tile
+ *            &&  if countAccess, the hit or miss has been counted
+ *                 (and the next tile prefetched, if auto-prefetching).
+ */
+template <class ItemType>
+typename TiledArray<ItemType>::Tile& 
+TiledArray<ItemType>::findTile(long tileRow, long tileCol, bool countAccess) {
+   long key = tileRow * myNumTileCols + tileCol;
+   if (key == myLastKey) {                        // fast path
+      if (countAccess) ++myHits;
+      return *myLastTile;
+   }
+   checkTileCoords(tileRow, tileCol);
+   typename std::unordered_map<long, Tile>::iterator it = myTiles.find(key);
+   Tile* tile = NULL;
+   if (it != myTiles.end()) {
+      if (countAccess) ++myHits;
+      tile = &(it->second);
+      myLRU.splice(myLRU.begin(), myLRU, tile->lruPos);
+   } else {
+      if (countAccess) ++myMisses;
+      tile = &loadTile(key);
+   }
+   waitFor(*tile);
+   myLastKey = key;
+   myLastTile = tile;
+   if (countAccess && myAutoPrefetch && 
+        key + 1 < myNumTileRows * myNumTileCols) {
+      prefetch( (key+1) / myNumTileCols, (key+1) % myNumTileCols );
+   }
+   return *myLastTile;
+}
+
+/* method to read one Item of the matrix
+ * @param: row, col, longs
+ * Precondition: 0 <= row < getNumRows() && 0 <= col < getNumCols().
+ * Return: the Item at [row][col].
+ */
+template <class ItemType>
+ItemType TiledArray<ItemType>::get(long row, long col) {
+   Tile& tile = findTile(row / myTileRows, col / myTileCols, true);
+   return tile.data[(row % myTileRows) * myTileCols + (col % myTileCols)];
+}
+
+/* method to change one Item of the matrix
+ * @param: row, col, longs
+ * @param: value, an Item
+ * Precondition: 0 <= row < getNumRows() && 0 <= col < getNumCols().
+ * Postcondition: the Item at [row][col] == value
+ *            &&  its tile will be written back on eviction or flush().
+ */
+template <class ItemType>
+void TiledArray<ItemType>::set(long row, long col, const ItemType& value) {
+   Tile& tile = findTile(row / myTileRows, col / myTileCols, true);
+   tile.data[(row % myTileRows) * myTileCols + (col % myTileCols)] = value;
+   tile.dirty = true;
+}
+
+/* method to access a whole tile
+ * @param: tileRow, tileCol, longs
+ * @param: willModify, a bool (default false)
+ * Precondition: 0 <= tileRow < getNumTileRows()
+ *           &&  0 <= tileCol < getNumTileCols()
+ *           &&  willModify is true iff the caller will change the tile.
+ * Return: the address of the tile's getTileRows() x getTileCols()
+ *          row-major buffer (edge tiles are padded).
+ * Note: the address is valid only until the next call that may
+ *        evict a tile (get(), set(), getTile(), prefetch(), flush()).
+ */
+template <class ItemType>
+ItemType* TiledArray<ItemType>::getTile(long tileRow, long tileCol, 
+                                         bool willModify) {
+   Tile& tile = findTile(tileRow, tileCol, true);
+   if (willModify) {
+      tile.dirty = true;
+   }
+   return tile.data.data();
+}
+
+/* method to hint that a tile will be needed soon
+ * @param: tileRow, tileCol, longs
+ * Postcondition: if the tile was not in the cache, 
+ *                 non-blocking reads of it have been started
+ *                 (possibly evicting the least-recently-used tile).
+ */
+template <class ItemType>
+void TiledArray<ItemType>::prefetch(long tileRow, long tileCol) {
+   checkTileCoords(tileRow, tileCol);
+   long key = tileRow * myNumTileCols + tileCol;
+   if (myTiles.find(key) == myTiles.end()) {
+      // keep the tile in use: don't let a prefetch evict it
+      if (myMaxTiles == 1 && myLastKey >= 0) {
+         return;
+      }
+      loadTile(key);
+      // the tile in use stays the most-recently-used one
+      if (myLastKey >= 0) {
+         myLRU.splice(myLRU.begin(), myLRU, myLastTile->lruPos);
+      }
+      ++myPrefetches;
+   }
+}
+
+/* method to write back all modified tiles
+ * Postcondition: each modified tile in the cache has been written
+ *                 to the file (the cache contents are unchanged).
+ */
+template <class ItemType>
+void TiledArray<ItemType>::flush() {
+   typename std::unordered_map<long, Tile>::iterator it;
+   for (it = myTiles.begin(); it != myTiles.end(); ++it) {
+      if (it->second.dirty) {
+         writeBack(it->first, it->second);
+      }
+   }
+}
+
+/* method to close the file
+ * Postcondition: modified tiles have been written back
+ *            &&  the cache has been emptied
+ *            &&  the file has been closed.
+ */
+template <class ItemType>
+void TiledArray<ItemType>::close() {
+   flush();
+   typename std::unordered_map<long, Tile>::iterator it;
+   for (it = myTiles.begin(); it != myTiles.end(); ++it) {
+      waitFor(it->second);
+   }
+   myTiles.clear();
+   myLRU.clear();
+   myLastKey = -1;
+   myLastTile = NULL;
+   OO_MPI_IO_Base<ItemType>::close();
+   myClosedFlag = true;
+}
+
+/* bandwidth accessors
+ * Return: bytes read (written) per second spent in (or waiting for) 
+ *          MPI-IO reads (writes), or 0 if no time has been spent.
+ */
+template <class ItemType>
+double TiledArray<ItemType>::getReadBandwidth() const {
+   return myReadSeconds > 0.0 ? myBytesRead / myReadSeconds : 0.0;
+}
+
+template <class ItemType>
+double TiledArray<ItemType>::getWriteBandwidth() const {
+   return myWriteSeconds > 0.0 ? myBytesWritten / myWriteSeconds : 0.0;
+}
+
+/*******************************************************************
+ * The EpochReader template supports repeated passes ("epochs")
+ *  over a binary file, as in machine-learning training loops.
+ *
+ * The file is cut into fixed-size blocks; each epoch, a seeded
+ *  permutation (the same on every PE) shuffles the blocks and 
+ *  deals them out round-robin to the PEs, so each PE sees a 
+ *  different, balanced set of blocks in a different order each
+ *  epoch. Upcoming blocks are prefetched using non-blocking reads,
+ *  and the file stays open from one epoch to the next.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType>
+class EpochReader : public OO_MPI_IO_Base<ItemType> {
+public:
+  EpochReader(const std::string& fileName, MPI_Datatype mpiType,
+               int id, int numPEs, long blockSize, uint64_t seed,
+               int prefetchDepth = 2);
+  ~EpochReader();
+
+  void beginEpoch(long epoch);
+  bool nextBlock(std::vector<ItemType>& block);
+
+  long getBlockSize() const                  { return myBlockSize; }
+  long getNumBlocks() const                  { return myNumBlocks; }
+  uint64_t getSeed() const                   { return mySeed; }
+  int getPrefetchDepth() const               { return myBuffers.size(); }
+  long getEpoch() const                      { return myEpoch; }
+  const std::vector<long>& getEpochBlocks() const { return myEpochBlocks; }
+  long getCurrentBlock() const               { return myCurrentBlock; }
+
+private:
+  void startRead(int slot, long block);
+  void waitForAll();
+
+  long     myBlockSize;                     // Items per block
+  long     myNumBlocks;                     // blocks in the file
+  uint64_t mySeed;                          // seed of the permutations
+  long     myEpoch;                         // current epoch (or -1)
+  std::vector<long> myEpochBlocks;          // my blocks, this epoch
+  long     myNextToRead;                    // index in myEpochBlocks
+  long     myNextToReturn;                  //  "
+  long     myCurrentBlock;                  // block nextBlock() returned
+  std::vector< std::vector<ItemType> > myBuffers;  // prefetch ring
+  std::vector<MPI_Request> myRequests;      //  and its reads
+};
+
+/* EpochReader constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: blockSize, a long
+ * @param: seed, a uint64_t
+ * @param: prefetchDepth, an int (default 2)
+ * Precondition: fileName is the name of a file containing
+ *                binary-format values of type ItemType
+ *           &&  mpiType is the MPI equivalent of ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes
+ *           &&  blockSize > 0 is the number of Items per block
+ *                (the file's last block may be smaller)
+ *           &&  seed is the same on every PE
+ *           &&  prefetchDepth > 0 is the number of blocks to read ahead.
+ * Postcondition: the file has been opened for parallel input
+ *           &&  getNumBlocks() == the number of blocks in the file
+ *           &&  no epoch has begun (getEpoch() == -1).
+ */
+template <class ItemType>
+EpochReader<ItemType>::
+EpochReader(const std::string& fileName, MPI_Datatype mpiType,
+             int id, int numPEs, long blockSize, uint64_t seed,
+             int prefetchDepth)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, id, numPEs)
+{
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (blockSize <= 0 || prefetchDepth <= 0) {
+      fprintf(stderr, "\nEpochReader(): blockSize and prefetchDepth"
+                      " must be positive\n\n");
+      exit(1);
+   }
+   myBlockSize = blockSize;
+   mySeed = seed;
+   myEpoch = -1;
+   myNextToRead = myNextToReturn = 0;
+   myCurrentBlock = -1;
+   myBuffers.resize(prefetchDepth);
+   myRequests.assign(prefetchDepth, MPI_REQUEST_NULL);
+
+   // the file's size is fixed, so query it (or its header) just once
+   OO_MPI_IO_Base<ItemType>::loadHeader();
+   if ( !OO_MPI_IO_Base<ItemType>::hasHeader() ) {
+      MPI_Offset fileSize;
+      timedGetSize(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
+      OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
+      OO_MPI_IO_Base<ItemType>::setNumItemsInFile( fileSize / 
+                                    OO_MPI_IO_Base<ItemType>::getItemSize() );
+   }
+   long numItems = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
+   myNumBlocks = (numItems + blockSize - 1) / blockSize;
+}
+
+/* EpochReader destructor
+ * Postcondition: any outstanding prefetches have completed.
+ */
+template <class ItemType>
+EpochReader<ItemType>::~EpochReader() {
+   int finalizedFlag = 0;
+   MPI_Finalized(&finalizedFlag);
+   if (!finalizedFlag) {
+      waitForAll();
+   }
+}
+
+/* utility to wait for all outstanding prefetches
+ */
+template <class ItemType>
+void EpochReader<ItemType>::waitForAll() {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   timedWaitall(stats, READ_OP, myRequests.size(), myRequests.data(),
+                MPI_STATUSES_IGNORE);
+}
+
+/* utility to start reading a block into a slot of the prefetch ring
+ */
+template <class ItemType>
+void EpochReader<ItemType>::startRead(int slot, long block) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   long itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   long firstItem = block * myBlockSize;
+   long count = std::min(myBlockSize, 
+                  OO_MPI_IO_Base<ItemType>::getNumItemsInFile() - firstItem);
+   myBuffers[slot].resize(count);
+   int readResult = timedIreadAt(stats, OO_MPI_IO_Base<ItemType>::getFileHandle(),
+                                        OO_MPI_IO_Base<ItemType>::getDataOffset()
+                                         + firstItem * itemSize, 
+                                        myBuffers[slot].data(), count,
+                                        OO_MPI_IO_Base<ItemType>::getMPIType(),
+                                        &myRequests[slot]);
+   checkResult(readResult);
+}
+
+/* method to begin an epoch
+ * @param: epoch, a long.
+ * Precondition: every PE passes the same epoch.
+ * Postcondition: getEpoch() == epoch
+ *            &&  getEpochBlocks() contains the block numbers this PE
+ *                 is to read this epoch, in order: positions id, 
+ *                 id+numPEs, id+2*numPEs, ... of a permutation of 
+ *                 0..getNumBlocks()-1 determined by getSeed() and epoch
+ *            &&  reads of the first getPrefetchDepth() of those blocks
+ *                 have been started.
+ */
+template <class ItemType>
+void EpochReader<ItemType>::beginEpoch(long epoch) {
+   waitForAll();                 // abandon the rest of the last epoch
+
+   // Fisher-Yates shuffle driven by splitmix64, so the permutation
+   //  is identical on every PE (and on every platform)
+   std::vector<long> permutation(myNumBlocks);
+   for (long b = 0; b < myNumBlocks; ++b) {
+      permutation[b] = b;
+   }
+   uint64_t state = mySeed ^ ((uint64_t)epoch * 0x9E3779B97F4A7C15ULL);
+   for (long i = myNumBlocks - 1; i > 0; --i) {
+      uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      z ^= (z >> 31);
+      long j = z % (uint64_t)(i + 1);
+      std::swap(permutation[i], permutation[j]);
+   }
+
+   int id = OO_MPI_IO_Base<ItemType>::getID();
+   int numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
+   myEpochBlocks.clear();
+   for (long i = id; i < myNumBlocks; i += numPEs) {
+      myEpochBlocks.push_back( permutation[i] );
+   }
+   long chunkSize = 0;
+   for (unsigned long i = 0; i < myEpochBlocks.size(); ++i) {
+      chunkSize += std::min(myBlockSize, 
+                  OO_MPI_IO_Base<ItemType>::getNumItemsInFile() 
+                   - myEpochBlocks[i] * myBlockSize);
+   }
+   OO_MPI_IO_Base<ItemType>::setChunkSize(chunkSize);
+
+   myEpoch = epoch;
+   myCurrentBlock = -1;
+   myNextToRead = myNextToReturn = 0;
+   while (myNextToRead < (long)myEpochBlocks.size() &&
+           myNextToRead < (long)myBuffers.size()) {
+      startRead(myNextToRead, myEpochBlocks[myNextToRead]);
+      ++myNextToRead;
+   }
+}
+
+/* method to get this PE's next block of the current epoch
+ * @param: block, a vector of Items.
+ * Precondition: beginEpoch() has been called.
+ * Postcondition: if this PE has blocks left this epoch:
+ *                  block contains the Items of the next one
+ *                  (whose number is getCurrentBlock())
+ *               && the read of a later block has been started;
+ *                otherwise block is unchanged.
+ * Return: true if a block was returned, false if the epoch is over.
+ * Note: block's storage is recycled as a prefetch buffer, so
+ *        passing the same vector each time avoids reallocation.
+ */
+template <class ItemType>
+bool EpochReader<ItemType>::nextBlock(std::vector<ItemType>& block) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   if (myEpoch < 0) {
+      fprintf(stderr, "\nEpochReader::nextBlock(): call beginEpoch()"
+                      " first\n\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   if (myNextToReturn >= (long)myEpochBlocks.size()) {
+      return false;
+   }
+   int slot = myNextToReturn % myBuffers.size();
+   timedWait(stats, READ_OP, &myRequests[slot], MPI_STATUS_IGNORE);
+   OO_MPI_IO_Base<ItemType>::convertItems(myBuffers[slot].data(), 
+                                           myBuffers[slot].size());
+   block.swap(myBuffers[slot]);
+   myCurrentBlock = myEpochBlocks[myNextToReturn];
+   ++myNextToReturn;
+   if (myNextToRead < (long)myEpochBlocks.size()) {
+      startRead(slot, myEpochBlocks[myNextToRead]);
+      ++myNextToRead;
+   }
+   return true;
+}
+
+/********************************************************************
+ * Block compression: a compressed container holds an array of Items
+ *  as independently compressed blocks, so that any PE can decompress 
+ *  just the blocks that hold its Items.
+ *
+ * A container consists of:
+ *  - a 64-byte OO_MPI_IO_BlockPrologue, 
+ *  - the compressed blocks, one after another, and
+ *  - a footer index with one OO_MPI_IO_BlockIndexEntry per block.
+ *
+ * Each block is compressed with the container's codec, unless that
+ *  would not make it smaller, in which case it is stored as is
+ *  (a block whose stored size equals its raw size is raw).
+ * The prologue and index are stored in the writer's byte order;
+ *  for arithmetic Items, each index entry also records its block's
+ *  least and greatest Items (and how many of its Items are not NaN),
+ *  so min/max queries need not decode.
+ ********************************************************************/
+
+const char OO_MPI_IO_BLOCK_MAGIC[8] = {'O','O','M','P','I','B','L','K'};
+const int  OO_MPI_IO_PROLOGUE_SIZE = 64;
+
+/* The codecs a compressed container can use */
+enum BlockCodec {
+  CODEC_NONE = 0,            // blocks are stored as is
+  CODEC_LZ = 1,              // LZ77-style byte codec
+  CODEC_SHUFFLE_LZ = 2,      // byte-shuffle filter, then CODEC_LZ
+  CODEC_FOR_BITPACK = 3,     // integers: frame of reference + bit-packing
+  CODEC_DELTA_BITPACK = 4,   // integers: deltas, then CODEC_FOR_BITPACK
+  CODEC_XOR_FLOAT = 5        // floats/doubles: XOR with previous, bit-packed
+};
+
+/* prologue flags */
+const uint64_t OO_MPI_IO_BLOCK_MINMAX = 1;  // index entries hold min/max
+
+struct OO_MPI_IO_BlockPrologue {
+  char     magic[8];                  // OO_MPI_IO_BLOCK_MAGIC
+  uint32_t version;                   // container format (1)
+  uint32_t codec;                     // a BlockCodec
+  uint32_t itemSize;                  // sizeof(ItemType)
+  uint32_t byteOrderMark;             // OO_MPI_IO_BYTE_ORDER_MARK
+  uint64_t numItems;                  // Items in the container
+  uint64_t numBlocks;                 // blocks in the container
+  uint64_t indexOffset;               // byte offset of the footer index
+  uint64_t blockItems;                // (maximum) Items per block
+  uint64_t flags;                     // OO_MPI_IO_BLOCK_MINMAX, ...
+};
+
+struct OO_MPI_IO_BlockIndexEntry {
+  uint64_t byteOffset;                // where the block begins
+  uint64_t firstItem;                 // number of the block's first Item
+  uint64_t minimum;                   // the bytes of its least Item
+  uint64_t maximum;                   //  and of its greatest Item
+  uint64_t count;                     // the number of its Items that are
+};                                    //  not NaN (0: min/max are unset)
+
+static_assert(sizeof(OO_MPI_IO_BlockPrologue) == OO_MPI_IO_PROLOGUE_SIZE,
+              "OO_MPI_IO_BlockPrologue must be exactly 64 bytes");
+
+/* Utility to group the bytes of a sequence of Items by significance
+ *  (all first bytes, then all second bytes, ...), which makes numeric
+ *  data far more compressible
+ * @param: in, the address of the Items' bytes
+ * @param: out, the address of a buffer of count * itemSize bytes
+ * @param: count, the number of Items
+ * @param: itemSize, the size of an Item.
+ * Postcondition: out[b*count + i] == in[i*itemSize + b].
+ */
+void shuffleBytes(const unsigned char* in, unsigned char* out,
+                   unsigned long count, int itemSize) {
+   for (int b = 0; b < itemSize; ++b) {
+      unsigned char* lane = out + b * count;
+      for (unsigned long i = 0; i < count; ++i) {
+         lane[i] = in[i * itemSize + b];
+      }
+   }
+}
+
+/* Utility to undo shuffleBytes()
+ * Postcondition: out[i*itemSize + b] == in[b*count + i].
+ */
+void unshuffleBytes(const unsigned char* in, unsigned char* out,
+                     unsigned long count, int itemSize) {
+   for (int b = 0; b < itemSize; ++b) {
+      const unsigned char* lane = in + b * count;
+      for (unsigned long i = 0; i < count; ++i) {
+         out[i * itemSize + b] = lane[i];
+      }
+   }
+}
+
+/* The LZ codec encodes its input as a sequence of (literals, match)
+ *  pairs: a token byte holds the literal count (high 4 bits) and the
+ *  match length minus 4 (low 4 bits), with longer lengths continued
+ *  in extra bytes of 255; the literals follow, then the match's 
+ *  2-byte (little-endian) distance back. The last pair has no match.
+ */
+const int OO_MPI_IO_LZ_MIN_MATCH = 4;
+const int OO_MPI_IO_LZ_HASH_BITS = 14;
+
+/* Utility to find the most space lzCompress() can need
+ * @param: numBytes, the size of the input.
+ * Return: the maximum size of the compressed output.
+ */
+unsigned long lzCompressBound(unsigned long numBytes) {
+   return numBytes + numBytes / 255 + 16;
+}
+
+/* utility to append a length's continuation bytes (for lengths >= 15)
+ */
+unsigned char* lzPutLength(unsigned char* op, unsigned long length) {
+   for ( ; length >= 255; length -= 255) {
+      *op++ = 255;
+   }
+   *op++ = (unsigned char) length;
+   return op;
+}
+
+/* utility to append one (literals, match) pair
+ *  (matchLength == 0 means the final, literals-only pair)
+ */
+unsigned char* lzPutSequence(unsigned char* op, const unsigned char* literals,
+                              unsigned long numLiterals,
+                              unsigned long matchLength, unsigned distance) {
+   unsigned long matchCode = matchLength ? matchLength - OO_MPI_IO_LZ_MIN_MATCH
+                                         : 0;
+   *op++ = (unsigned char)( (std::min(numLiterals, 15UL) << 4) 
+                             | std::min(matchCode, 15UL) );
+   if (numLiterals >= 15) {
+      op = lzPutLength(op, numLiterals - 15);
+   }
+   if (numLiterals > 0) {                         // (literals may be NULL)
+      memcpy(op, literals, numLiterals);
+      op += numLiterals;
+   }
+   if (matchLength) {
+      *op++ = (unsigned char)(distance & 0xFF);
+      *op++ = (unsigned char)(distance >> 8);
+      if (matchCode >= 15) {
+         op = lzPutLength(op, matchCode - 15);
+      }
+   }
+   return op;
+}
+
+/* Utility to compress a sequence of bytes with the LZ codec
+ * @param: in, the address of the input
+ * @param: numBytes, the size of the input
+ * @param: out, the address of a buffer of lzCompressBound(numBytes) bytes.
+ * Return: the size of the compressed output.
+ */
+unsigned long lzCompress(const unsigned char* in, unsigned long numBytes,
+                          unsigned char* out) {
+   std::vector<long> table(1 << OO_MPI_IO_LZ_HASH_BITS, -1);
+   unsigned char* op = out;
+   unsigned long anchor = 0;              // first Item not yet encoded
+   unsigned long pos = 0;
+   // stop looking for matches a little before the end
+   unsigned long limit = (numBytes > 12) ? numBytes - 5 : 0;
+   while (pos < limit) {
+      uint32_t sequence, candidateSequence;
+      memcpy(&sequence, in + pos, 4);
+      uint32_t hash = (sequence * 2654435761u) 
+                       >> (32 - OO_MPI_IO_LZ_HASH_BITS);
+      long candidate = table[hash];
+      table[hash] = pos;
+      if (candidate >= 0 && pos - candidate <= 65535) {
+         memcpy(&candidateSequence, in + candidate, 4);
+         if (candidateSequence == sequence) {
+            unsigned long length = OO_MPI_IO_LZ_MIN_MATCH;
+            while (pos + length < numBytes && 
+                    in[candidate + length] == in[pos + length]) {
+               ++length;
+            }
+            op = lzPutSequence(op, in + anchor, pos - anchor, 
+                                length, pos - candidate);
+            pos += length;
+            anchor = pos;
+            continue;
+         }
+      }
+      ++pos;
+   }
+   op = lzPutSequence(op, in + anchor, numBytes - anchor, 0, 0);
+   return op - out;
+}
+
+/* utility to read a length's continuation bytes
+ * Return: false if the input ran out.
+ */
+bool lzGetLength(const unsigned char*& ip, const unsigned char* end,
+                  unsigned long& length) {
+   unsigned char byte;
+   do {
+      if (ip >= end) return false;
+      byte = *ip++;
+      length += byte;
+   } while (byte == 255);
+   return true;
+}
+
+/* Utility to decompress the output of lzCompress()
+ * @param: in, the address of the compressed input
+ * @param: inBytes, the size of the compressed input
+ * @param: out, the address of the output buffer
+ * @param: outBytes, the size of the decompressed output.
+ * Return: true if in decompressed to exactly outBytes bytes,
+ *          false if it is corrupt (or truncated).
+ */
+bool lzDecompress(const unsigned char* in, unsigned long inBytes,
+                   unsigned char* out, unsigned long outBytes) {
+   const unsigned char* ip = in;
+   const unsigned char* inEnd = in + inBytes;
+   unsigned char* op = out;
+   unsigned char* outEnd = out + outBytes;
+   while (ip < inEnd) {
+      unsigned char token = *ip++;
+      unsigned long numLiterals = token >> 4;
+      if (numLiterals == 15 && !lzGetLength(ip, inEnd, numLiterals)) {
+         return false;
+      }
+      if (numLiterals > (unsigned long)(inEnd - ip) ||
+           numLiterals > (unsigned long)(outEnd - op)) {
+         return false;
+      }
+      if (numLiterals > 0) {
+         memcpy(op, ip, numLiterals);
+         ip += numLiterals;
+         op += numLiterals;
+      }
+      if (ip == inEnd) {
+         return op == outEnd;                     // the final pair
+      }
+      if (inEnd - ip < 2) return false;
+      unsigned long distance = ip[0] | (ip[1] << 8);
+      ip += 2;
+      unsigned long length = token & 0x0F;
+      if (length == 15 && !lzGetLength(ip, inEnd, length)) {
+         return false;
+      }
+      length += OO_MPI_IO_LZ_MIN_MATCH;
+      if (distance == 0 || distance > (unsigned long)(op - out) ||
+           length > (unsigned long)(outEnd - op)) {
+         return false;
+      }
+      const unsigned char* match = op - distance;
+      if (distance >= length) {
+         memcpy(op, match, length);
+         op += length;
+      } else {                                    // overlapping copy
+         for (unsigned long i = 0; i < length; ++i) {
+            *op++ = *match++;
+         }
+      }
+   }
+   return false;                                  // no final pair
+}
+
+/* Utility to compress one block
+ * @param: codec, a BlockCodec
+ * @param: raw, the address of the block's bytes
+ * @param: numItems, the number of Items in the block
+ * @param: itemSize, the size of an Item
+ * @param: out, a vector to which the compressed block is appended
+ * @param: scratch, a vector the codec may use.
+ * Return: the size of the (compressed or raw) block appended to out.
+ */
+unsigned long compressBlock(BlockCodec codec, const unsigned char* raw,
+                             unsigned long numItems, int itemSize,
+                             std::vector<unsigned char>& out,
+                             std::vector<unsigned char>& scratch) {
+   unsigned long rawBytes = numItems * itemSize;
+   unsigned long oldSize = out.size();
+   unsigned long packedBytes = rawBytes;             // i.e., not packed
+   if (codec != CODEC_NONE) {
+      const unsigned char* input = raw;
+      if (codec == CODEC_SHUFFLE_LZ) {
+         scratch.resize(rawBytes);
+         shuffleBytes(raw, scratch.data(), numItems, itemSize);
+         input = scratch.data();
+      }
+      out.resize(oldSize + lzCompressBound(rawBytes));
+      packedBytes = lzCompress(input, rawBytes, out.data() + oldSize);
+   }
+   if (packedBytes >= rawBytes) {                    // store it as is
+      out.resize(oldSize + rawBytes);
+      memcpy(out.data() + oldSize, raw, rawBytes);
+      return rawBytes;
+   }
+   out.resize(oldSize + packedBytes);
+   return packedBytes;
+}
+
+/* Utility to decompress one block
+ * @param: codec, a BlockCodec
+ * @param: in, the address of the stored block
+ * @param: inBytes, the size of the stored block
+ * @param: raw, the address of a buffer for the block's Items
+ * @param: numItems, the number of Items in the block
+ * @param: itemSize, the size of an Item
+ * @param: scratch, a vector the codec may use.
+ * Return: true if the block was decompressed, false if it is corrupt.
+ */
+bool decompressBlock(BlockCodec codec, const unsigned char* in,
+                      unsigned long inBytes, unsigned char* raw,
+                      unsigned long numItems, int itemSize,
+                      std::vector<unsigned char>& scratch) {
+   unsigned long rawBytes = numItems * itemSize;
+   if (inBytes == rawBytes) {                        // stored as is
+      memcpy(raw, in, rawBytes);
+      return true;
+   }
+   if (codec == CODEC_LZ) {
+      return lzDecompress(in, inBytes, raw, rawBytes);
+   } else if (codec == CODEC_SHUFFLE_LZ) {
+      scratch.resize(rawBytes);
+      if ( !lzDecompress(in, inBytes, scratch.data(), rawBytes) ) {
+         return false;
+      }
+      unshuffleBytes(scratch.data(), raw, numItems, itemSize);
+      return true;
+   }
+   return false;
+}
+
+/* The numeric codecs encode a block of Items as a 24-byte header
+ *  (two 64-bit reference values, the bit width, and a shift),
+ *  followed by one width-bit unsigned code per Item, packed 
+ *  least-significant bit first, plus 8 bytes of padding (so that
+ *  every code can be fetched with one unaligned 64-bit load):
+ *  - CODEC_FOR_BITPACK: code[i] = Item[i] - minimum (reference 0);
+ *  - CODEC_DELTA_BITPACK: code[i] = (Item[i+1] - Item[i]) - least delta
+ *     (reference 0 is Item[0], reference 1 the least delta);
+ *  - CODEC_XOR_FLOAT: code[i] = (bits[i+1] ^ bits[i]) >> shift
+ *     (reference 0 is bits[0], shift the XORs' common trailing zeros).
+ * All arithmetic wraps modulo 2^64, and the header and codes are
+ *  little-endian. A block whose codes would be wider than 
+ *  OO_MPI_IO_MAX_PACK_WIDTH bits is stored as is.
+ */
+const int OO_MPI_IO_NUMERIC_HEADER_SIZE = 24;
+const int OO_MPI_IO_MAX_PACK_WIDTH = 56;
+
+/* Utility to tell whether a codec is one of the numeric codecs
+ */
+bool isNumericCodec(BlockCodec codec) {
+   return codec == CODEC_FOR_BITPACK || codec == CODEC_DELTA_BITPACK
+           || codec == CODEC_XOR_FLOAT;
+}
+
+/* utility to load a little-endian 64-bit value from any address
+ */
+uint64_t loadLittle64(const unsigned char* bytes) {
+   uint64_t x;
+   memcpy(&x, bytes, 8);
+   if (getHostByteOrder() == BIG_ENDIAN_ORDER) swapBytesScalar(&x, 1, 8);
+   return x;
+}
+
+/* utility to store a 64-bit value little-endian at any address
+ */
+void storeLittle64(unsigned char* bytes, uint64_t x) {
+   if (getHostByteOrder() == BIG_ENDIAN_ORDER) swapBytesScalar(&x, 1, 8);
+   memcpy(bytes, &x, 8);
+}
+
+/* Utility to find how many bits a code needs
+ * Return: the position of x's highest set bit, plus 1 (0 if x == 0).
+ */
+int bitWidth(uint64_t x) {
+   int width = 0;
+   for ( ; x != 0; x >>= 1) {
+      ++width;
+   }
+   return width;
+}
+
+/* Utility to find the size of a sequence of packed codes
+ * Return: the bytes needed for count width-bit codes, plus padding.
+ */
+unsigned long packedSize(unsigned long count, int width) {
+   return (count * width + 7) / 8 + 8;
+}
+
+/* Utility to pack a sequence of codes into width bits each
+ * @param: codes, the address of the codes
+ * @param: count, the number of codes
+ * @param: width, the number of bits per code
+ * @param: out, the address of packedSize(count, width) zeroed bytes.
+ * Precondition: 0 <= width <= OO_MPI_IO_MAX_PACK_WIDTH
+ *            && each code is less than 2^width.
+ */
+void packBits(const uint64_t* codes, unsigned long count, int width,
+               unsigned char* out) {
+   if (width == 0) return;
+   for (unsigned long i = 0; i < count; ++i) {
+      unsigned long bitPos = i * width;
+      unsigned char* word = out + bitPos / 8;
+      storeLittle64(word, loadLittle64(word) | (codes[i] << (bitPos % 8)));
+   }
+}
+
+/* Utility to undo packBits() (the scalar version, for any host)
+ * @param: in, the address of the packed codes
+ * @param: count, the number of codes
+ * @param: width, the number of bits per code
+ * @param: codes, the address of a buffer for count codes
+ * @param: first, the first code to unpack (default 0).
+ * Postcondition: codes[first..count-1] hold the unpacked codes.
+ */
+void unpackBitsScalar(const unsigned char* in, unsigned long count, int width,
+                       uint64_t* codes, unsigned long first = 0) {
+   uint64_t mask = (width == 0) ? 0 : (~0ULL >> (64 - width));
+   for (unsigned long i = first; i < count; ++i) {
+      unsigned long bitPos = i * width;
+      codes[i] = (loadLittle64(in + bitPos / 8) >> (bitPos % 8)) & mask;
+   }
+}
+
+/* Utility to undo packBits(), fetching and shifting 4 codes
+ *  at a time with AVX2 gathers and variable shifts when available
+ * Postcondition: codes[0..count-1] hold the unpacked codes.
+ */
+void unpackBits(const unsigned char* in, unsigned long count, int width,
+                 uint64_t* codes) {
+   unsigned long done = 0;
+#if defined(__AVX2__)
+   if (width > 0 && getHostByteOrder() == LITTLE_ENDIAN_ORDER) {
+      const __m256i mask = _mm256_set1_epi64x(~0ULL >> (64 - width));
+      const __m256i seven = _mm256_set1_epi64x(7);
+      const __m256i step = _mm256_set1_epi64x(4L * width);
+      __m256i bitPos = _mm256_set_epi64x(3L * width, 2L * width, width, 0);
+      for ( ; done + 4 <= count; done += 4) {
+         __m256i words = _mm256_i64gather_epi64((const long long*) in,
+                                        _mm256_srli_epi64(bitPos, 3), 1);
+         words = _mm256_srlv_epi64(words, _mm256_and_si256(bitPos, seven));
+         _mm256_storeu_si256((__m256i*)(codes + done),
+                             _mm256_and_si256(words, mask));
+         bitPos = _mm256_add_epi64(bitPos, step);
+      }
+   }
+#endif
+   unpackBitsScalar(in, count, width, codes, done);
+}
+
+/* utility to append a numeric block to out, if it is worthwhile
+ * @param: codes, the block's codes
+ * @param: reference0, reference1, shift, the header's values
+ * @param: rawBytes, the size of the block as is
+ * @param: out, a vector to which the block is appended.
+ * Return: true if the block was appended, false if its codes are too 
+ *          wide or it would not be smaller than rawBytes.
+ */
+bool putNumericBlock(std::vector<uint64_t>& codes, uint64_t reference0,
+                      uint64_t reference1, int shift, unsigned long rawBytes,
+                      std::vector<unsigned char>& out) {
+   uint64_t combined = 0;
+   for (unsigned long i = 0; i < codes.size(); ++i) {
+      combined |= codes[i];
+   }
+   int width = bitWidth(combined);
+   unsigned long blockBytes = OO_MPI_IO_NUMERIC_HEADER_SIZE 
+                               + packedSize(codes.size(), width);
+   if (width > OO_MPI_IO_MAX_PACK_WIDTH || blockBytes >= rawBytes) {
+      return false;
+   }
+   unsigned long oldSize = out.size();
+   out.resize(oldSize + blockBytes, 0);
+   unsigned char* header = out.data() + oldSize;
+   storeLittle64(header, reference0);
+   storeLittle64(header + 8, reference1);
+   header[16] = (unsigned char) width;
+   header[17] = (unsigned char) shift;
+   packBits(codes.data(), codes.size(), width, 
+             header + OO_MPI_IO_NUMERIC_HEADER_SIZE);
+   return true;
+}
+
+/* utility to read a numeric block's header and unpack its codes
+ * @param: in, the address of the block
+ * @param: inBytes, the size of the block
+ * @param: numCodes, the number of codes it should hold
+ * @param: reference0, reference1, shift, its header's values
+ * @param: codes, a vector to hold its codes.
+ * Return: true if the block is well-formed, false if it is corrupt.
+ */
+bool getNumericBlock(const unsigned char* in, unsigned long inBytes,
+                      unsigned long numCodes, uint64_t& reference0,
+                      uint64_t& reference1, int& shift,
+                      std::vector<uint64_t>& codes) {
+   if (inBytes < (unsigned long) OO_MPI_IO_NUMERIC_HEADER_SIZE) {
+      return false;
+   }
+   int width = in[16];
+   shift = in[17];
+   if (width > OO_MPI_IO_MAX_PACK_WIDTH || shift > 63 ||
+        inBytes != OO_MPI_IO_NUMERIC_HEADER_SIZE + packedSize(numCodes, width)) {
+      return false;
+   }
+   reference0 = loadLittle64(in);
+   reference1 = loadLittle64(in + 8);
+   codes.resize(numCodes);
+   unpackBits(in + OO_MPI_IO_NUMERIC_HEADER_SIZE, numCodes, width, 
+               codes.data());
+   return true;
+}
+
+/* Utility to encode a block of integers with CODEC_FOR_BITPACK
+ *  or CODEC_DELTA_BITPACK (see encodeNumbers())
+ */
+template <class ItemType>
+bool encodeNumbers(BlockCodec codec, const ItemType* items,
+                    unsigned long numItems, std::vector<unsigned char>& out,
+                    std::true_type, std::false_type) {
+   typedef typename std::conditional<std::is_signed<ItemType>::value,
+                                     int64_t, uint64_t>::type Wide;
+   if (numItems == 0 || 
+        (codec != CODEC_FOR_BITPACK && codec != CODEC_DELTA_BITPACK)) {
+      return false;
+   }
+   std::vector<uint64_t> codes;
+   uint64_t reference0 = 0, reference1 = 0;
+   if (codec == CODEC_FOR_BITPACK) {
+      Wide least = items[0];
+      for (unsigned long i = 1; i < numItems; ++i) {
+         least = std::min(least, (Wide) items[i]);
+      }
+      reference0 = (uint64_t) least;
+      codes.resize(numItems);
+      for (unsigned long i = 0; i < numItems; ++i) {
+         codes[i] = (uint64_t)(Wide) items[i] - reference0;
+      }
+   } else {
+      reference0 = (uint64_t)(Wide) items[0];
+      codes.resize(numItems - 1);
+      int64_t leastDelta = 0;
+      for (unsigned long i = 1; i < numItems; ++i) {
+         codes[i-1] = (uint64_t)(Wide) items[i] - (uint64_t)(Wide) items[i-1];
+         if (i == 1 || (int64_t) codes[i-1] < leastDelta) {
+            leastDelta = (int64_t) codes[i-1];
+         }
+      }
+      reference1 = (uint64_t) leastDelta;
+      for (unsigned long i = 0; i < codes.size(); ++i) {
+         codes[i] -= reference1;
+      }
+   }
+   return putNumericBlock(codes, reference0, reference1, 0,
+                           numItems * sizeof(ItemType), out);
+}
+
+/* utility to get the bits of a float or double as an unsigned integer
+ */
+template <class ItemType>
+uint64_t getFloatBits(const ItemType& x) {
+   typename std::conditional<sizeof(ItemType) == 4, uint32_t, uint64_t>::type
+      bits;
+   memcpy(&bits, &x, sizeof(bits));
+   return bits;
+}
+
+/* utility to make a float or double from its bits
+ */
+template <class ItemType>
+ItemType makeFloat(uint64_t bits) {
+   typename std::conditional<sizeof(ItemType) == 4, uint32_t, uint64_t>::type
+      narrowBits = bits;
+   ItemType x;
+   memcpy(&x, &narrowBits, sizeof(x));
+   return x;
+}
+
+/* Utility to encode a block of floats or doubles with CODEC_XOR_FLOAT
+ *  (see encodeNumbers())
+ */
+template <class ItemType>
+bool encodeNumbers(BlockCodec codec, const ItemType* items,
+                    unsigned long numItems, std::vector<unsigned char>& out,
+                    std::false_type, std::true_type) {
+   if (numItems == 0 || codec != CODEC_XOR_FLOAT ||
+        (sizeof(ItemType) != 4 && sizeof(ItemType) != 8)) {
+      return false;
+   }
+   std::vector<uint64_t> codes(numItems - 1);
+   uint64_t previous = getFloatBits(items[0]), combined = 0;
+   for (unsigned long i = 1; i < numItems; ++i) {
+      uint64_t bits = getFloatBits(items[i]);
+      codes[i-1] = bits ^ previous;
+      combined |= codes[i-1];
+      previous = bits;
+   }
+   int shift = 0;                          // the common trailing zeros
+   for ( ; combined != 0 && (combined & 1) == 0; combined >>= 1) {
+      ++shift;
+   }
+   for (unsigned long i = 0; i < codes.size(); ++i) {
+      codes[i] >>= shift;
+   }
+   return putNumericBlock(codes, getFloatBits(items[0]), 0, shift,
+                           numItems * sizeof(ItemType), out);
+}
+
+/* utility for Items the numeric codecs cannot encode
+ */
+template <class ItemType>
+bool encodeNumbers(BlockCodec codec, const ItemType* items,
+                    unsigned long numItems, std::vector<unsigned char>& out,
+                    std::false_type, std::false_type) {
+   return false;
+}
+
+/* Utility to encode a block of Items with a numeric codec
+ * @param: codec, CODEC_FOR_BITPACK or CODEC_DELTA_BITPACK (for integers)
+ *                 or CODEC_XOR_FLOAT (for floats and doubles)
+ * @param: items, the address of the block's Items (in the host's order)
+ * @param: numItems, the number of Items in the block
+ * @param: out, a vector to which the encoded block is appended.
+ * Return: true if the block was encoded and appended,
+ *          false if the codec does not suit it (out is unchanged).
+ */
+template <class ItemType>
+bool encodeNumbers(BlockCodec codec, const ItemType* items,
+                    unsigned long numItems, std::vector<unsigned char>& out) {
+   return encodeNumbers(codec, items, numItems, out, 
+                         std::is_integral<ItemType>(),
+                         std::is_floating_point<ItemType>());
+}
+
+/* Utility to decode a block of integers (see decodeNumbers())
+ */
+template <class ItemType>
+bool decodeNumbers(BlockCodec codec, const unsigned char* in,
+                    unsigned long inBytes, ItemType* items,
+                    unsigned long numItems, std::vector<uint64_t>& codes,
+                    std::true_type, std::false_type) {
+   typedef typename std::conditional<std::is_signed<ItemType>::value,
+                                     int64_t, uint64_t>::type Wide;
+   uint64_t reference0 = 0, reference1 = 0;
+   int shift = 0;
+   if (codec == CODEC_FOR_BITPACK) {
+      if ( !getNumericBlock(in, inBytes, numItems, reference0, reference1,
+                             shift, codes) ) {
+         return false;
+      }
+      for (unsigned long i = 0; i < numItems; ++i) {
+         items[i] = (ItemType)(Wide)(reference0 + codes[i]);
+      }
+      return true;
+   } else if (codec == CODEC_DELTA_BITPACK && numItems > 0) {
+      if ( !getNumericBlock(in, inBytes, numItems - 1, reference0, reference1,
+                             shift, codes) ) {
+         return false;
+      }
+      uint64_t value = reference0;
+      items[0] = (ItemType)(Wide) value;
+      for (unsigned long i = 1; i < numItems; ++i) {
+         value += reference1 + codes[i-1];
+         items[i] = (ItemType)(Wide) value;
+      }
+      return true;
+   }
+   return false;
+}
+
+/* Utility to decode a block of floats or doubles (see decodeNumbers())
+ */
+template <class ItemType>
+bool decodeNumbers(BlockCodec codec, const unsigned char* in,
+                    unsigned long inBytes, ItemType* items,
+                    unsigned long numItems, std::vector<uint64_t>& codes,
+                    std::false_type, std::true_type) {
+   uint64_t reference0 = 0, reference1 = 0;
+   int shift = 0;
+   if (codec != CODEC_XOR_FLOAT || numItems == 0 ||
+        (sizeof(ItemType) != 4 && sizeof(ItemType) != 8) ||
+        !getNumericBlock(in, inBytes, numItems - 1, reference0, reference1,
+                          shift, codes) ) {
+      return false;
+   }
+   uint64_t bits = reference0;
+   items[0] = makeFloat<ItemType>(bits);
+   for (unsigned long i = 1; i < numItems; ++i) {
+      bits ^= codes[i-1] << shift;
+      items[i] = makeFloat<ItemType>(bits);
+   }
+   return true;
+}
+
+/* utility for Items the numeric codecs cannot decode
+ */
+template <class ItemType>
+bool decodeNumbers(BlockCodec codec, const unsigned char* in,
+                    unsigned long inBytes, ItemType* items,
+                    unsigned long numItems, std::vector<uint64_t>& codes,
+                    std::false_type, std::false_type) {
+   return false;
+}
+
+/* Utility to decode a block encoded by encodeNumbers()
+ * @param: codec, the numeric codec that encoded it
+ * @param: in, the address of the encoded block
+ * @param: inBytes, the size of the encoded block
+ * @param: items, the address of a buffer for the block's Items
+ * @param: numItems, the number of Items in the block
+ * @param: codes, a vector the codec may use.
+ * Return: true if the block was decoded (into the host's byte order),
+ *          false if it is corrupt.
+ */
+template <class ItemType>
+bool decodeNumbers(BlockCodec codec, const unsigned char* in,
+                    unsigned long inBytes, ItemType* items,
+                    unsigned long numItems, std::vector<uint64_t>& codes) {
+   return decodeNumbers(codec, in, inBytes, items, numItems, codes,
+                         std::is_integral<ItemType>(),
+                         std::is_floating_point<ItemType>());
+}
+
+/* Utility to tell whether a codec can be used for an ItemType
+ * Return: true for the byte codecs, and for the numeric codecs
+ *          that suit ItemType.
+ */
+template <class ItemType>
+bool codecSuitsItems(BlockCodec codec) {
+   if (codec == CODEC_FOR_BITPACK || codec == CODEC_DELTA_BITPACK) {
+      return std::is_integral<ItemType>::value;
+   } else if (codec == CODEC_XOR_FLOAT) {
+      return std::is_floating_point<ItemType>::value &&
+              (sizeof(ItemType) == 4 || sizeof(ItemType) == 8);
+   }
+   return codec == CODEC_NONE || codec == CODEC_LZ || codec == CODEC_SHUFFLE_LZ;
+}
+
+/* utility to convert a prologue to (or from) the other byte order
+ */
+void swapPrologue(OO_MPI_IO_BlockPrologue& prologue) {
+   // (offsets from the whole struct, so compilers see the runs are in it)
+   unsigned char* bytes = reinterpret_cast<unsigned char*>(&prologue);
+   swapBytes(bytes + offsetof(OO_MPI_IO_BlockPrologue, version), 
+              4, 4);                              // version .. byteOrderMark
+   swapBytes(bytes + offsetof(OO_MPI_IO_BlockPrologue, numItems), 
+              5, 8);                              // numItems .. flags
+}
+
+/* utility to convert index entries to (or from) the other byte order
+ * @param: entries, a vector of index entries
+ * @param: itemSize, the size of an Item
+ * @param: hasMinMax, whether the entries hold their blocks' min/max.
+ */
+void swapIndexEntries(std::vector<OO_MPI_IO_BlockIndexEntry>& entries,
+                       int itemSize, bool hasMinMax) {
+   for (unsigned long b = 0; b < entries.size(); ++b) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&entries[b]);
+      swapBytes(bytes + offsetof(OO_MPI_IO_BlockIndexEntry, byteOffset), 
+                 2, 8);                           // byteOffset, firstItem
+      if (hasMinMax) {
+         swapBytes(&entries[b].minimum, 1, itemSize);
+         swapBytes(&entries[b].maximum, 1, itemSize);
+         swapBytes(&entries[b].count, 1, 8);
+      }
+   }
+}
+
+/*******************************************************************
+ * The CompressedWriter template writes a compressed container:
+ *  each PE cuts its chunk into blocks, compresses them locally,
+ *  and writes them where a prefix sum of the PEs' compressed 
+ *  sizes places them, along with its part of the footer index.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType> 
+class CompressedWriter : public OO_MPI_IO_Base<ItemType> {
+public:
+  CompressedWriter(const std::string& fileName, MPI_Datatype mpiType,
+                    int id, int numPEs, BlockCodec codec = CODEC_SHUFFLE_LZ,
+                    long blockItems = 65536);
+  void writeChunk(const std::vector<ItemType>& v);
+
+  BlockCodec getCodec() const          { return myCodec; }
+  long getBlockItems() const           { return myBlockItems; }
+  long getNumBlocks() const            { return myNumBlocks; }
+  long getCompressedSize() const       { return myCompressedSize; }
+private:
+  BlockCodec myCodec;               // how blocks are compressed
+  long       myBlockItems;          // (max) Items per block
+  long       myNumBlocks;           // blocks in the container
+  long       myCompressedSize;      // bytes of blocks in the container
+};
+
+/* CompressedWriter constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: codec, a BlockCodec (default CODEC_SHUFFLE_LZ)
+ * @param: blockItems, a long (default 65536).
+ * Precondition: fileName is the name of an output file
+ *           &&  mpiType is the MPI equivalent of ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes
+ *           &&  blockItems > 0 is the number of Items per block
+ *           &&  codec suits ItemType (CODEC_FOR_BITPACK and
+ *                CODEC_DELTA_BITPACK need integers, CODEC_XOR_FLOAT
+ *                needs floats or doubles).
+ * Postcondition: the file has been opened for parallel output
+ *           &&  getCodec() == codec && getBlockItems() == blockItems.
+ */
+template <class ItemType>
+CompressedWriter<ItemType>::
+CompressedWriter(const std::string& fileName, MPI_Datatype mpiType,
+                  int id, int numPEs, BlockCodec codec, long blockItems)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                            mpiType, id, numPEs)
+{
+   if (blockItems <= 0 || (unsigned long)blockItems * sizeof(ItemType) 
+                            > (unsigned long)INT_MAX) {
+      fprintf(stderr, "\nCompressedWriter(): bad blockItems (%ld)\n\n",
+                      blockItems);
+      exit(1);
+   }
+   if ( !codecSuitsItems<ItemType>(codec) ) {
+      fprintf(stderr, "\nCompressedWriter(): codec %d cannot encode"
+                      " %d-byte Items\n\n", codec, (int) sizeof(ItemType));
+      exit(1);
+   }
+   myCodec = codec;
+   myBlockItems = blockItems;
+   myNumBlocks = myCompressedSize = 0;
+}
+
+/* method to write this PE's chunk to the container
+ * @param: v, a vector of Items.
+ * Precondition: v contains this PE's Items, which follow those of
+ *                the PEs with lower ids.
+ * Postcondition: the file is a container holding every PE's Items,
+ *                 in order of id, in blocks of (at most) getBlockItems()
+ *            &&  getNumBlocks() and getCompressedSize() describe it.
+ * Note: In MPI mode this is a collective call (MPI_Exscan()), 
+ *        so every process must call it.
+ */
+template <class ItemType>
+void CompressedWriter<ItemType>::writeChunk(const std::vector<ItemType>& v) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   timedSetSize(stats, fh, 0);                                // truncate
+   int itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+
+   // compress my blocks (in the file's byte order), noting their min/max
+   std::vector<unsigned char> packed, scratch;
+   std::vector<ItemType> converted;
+   std::vector<uint64_t> localOffsets, localFirstItems;
+   std::vector<uint64_t> localMinimums, localMaximums, localCounts;
+   bool hasMinMax = std::is_arithmetic<ItemType>::value && itemSize <= 8;
+   for (unsigned long first = 0; first < v.size(); first += myBlockItems) {
+      unsigned long count = std::min((unsigned long)myBlockItems, 
+                                      v.size() - first);
+      const ItemType* block = v.data() + first;
+      localOffsets.push_back(packed.size());
+      localFirstItems.push_back(first);
+      uint64_t minimum = 0, maximum = 0, numOrdered = 0;
+      ItemType least, greatest;
+      if ( hasMinMax && findMinMax(block, count, least, greatest) ) {
+         memcpy(&minimum, &least, itemSize);
+         memcpy(&maximum, &greatest, itemSize);
+         numOrdered = count - countNaNs(block, count, 
+                                         std::is_floating_point<ItemType>());
+      }
+      localMinimums.push_back(minimum);
+      localMaximums.push_back(maximum);
+      localCounts.push_back(numOrdered);
+      if ( isNumericCodec(myCodec) && 
+            encodeNumbers(myCodec, block, count, packed) ) {
+         continue;                      // encoded, in a fixed byte order
+      }
+      if ( OO_MPI_IO_Base<ItemType>::needsByteSwap() ) {
+         converted.assign(block, block + count);
+         OO_MPI_IO_Base<ItemType>::convertItems(converted.data(), count);
+         block = converted.data();
+      }
+      compressBlock(isNumericCodec(myCodec) ? CODEC_NONE : myCodec,
+                     (const unsigned char*) block, count, itemSize,
+                     packed, scratch);
+   }
+
+   // place my blocks and index entries after those of lower-id PEs
+   long mine[3] = { (long)v.size(), (long)localOffsets.size(), 
+                    (long)packed.size() };
+   long before[3] = {0, 0, 0}, total[3] = {0, 0, 0};
+   MPI_Exscan(mine, before, 3, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   MPI_Allreduce(mine, total, 3, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   if (OO_MPI_IO_Base<ItemType>::getID() == 0) {
+      before[0] = before[1] = before[2] = 0;       // Exscan leaves these
+   }
+   myNumBlocks = total[1];
+   myCompressedSize = total[2];
+   long dataOffset = OO_MPI_IO_PROLOGUE_SIZE;
+   long indexOffset = dataOffset + total[2];
+   OO_MPI_IO_Base<ItemType>::setDataOffset(dataOffset);
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile(total[0]);
+   OO_MPI_IO_Base<ItemType>::setChunkSize(v.size());
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(before[0]);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(dataOffset + before[2]);
+   OO_MPI_IO_Base<ItemType>::setFileSize(indexOffset + 
+                               total[1] * sizeof(OO_MPI_IO_BlockIndexEntry));
+
+   std::vector<OO_MPI_IO_BlockIndexEntry> entries( localOffsets.size() );
+   for (unsigned long b = 0; b < entries.size(); ++b) {
+      entries[b].byteOffset = dataOffset + before[2] + localOffsets[b];
+      entries[b].firstItem = before[0] + localFirstItems[b];
+      entries[b].minimum = localMinimums[b];
+      entries[b].maximum = localMaximums[b];
+      entries[b].count = localCounts[b];
+   }
+   OO_MPI_IO_BlockPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   memcpy(prologue.magic, OO_MPI_IO_BLOCK_MAGIC, sizeof(prologue.magic));
+   prologue.version = 1;
+   prologue.codec = myCodec;
+   prologue.itemSize = itemSize;
+   prologue.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   prologue.numItems = total[0];
+   prologue.numBlocks = total[1];
+   prologue.indexOffset = indexOffset;
+   prologue.blockItems = myBlockItems;
+   prologue.flags = hasMinMax ? OO_MPI_IO_BLOCK_MINMAX : 0;
+   if ( OO_MPI_IO_Base<ItemType>::needsByteSwap() ) {
+      swapPrologue(prologue);
+      swapIndexEntries(entries, itemSize, hasMinMax);
+   }
+
+   MPI_Status status;
+   unsigned long bytesWritten = 0;
+   int writeResult = 0;
+   while (packed.size() - bytesWritten > INT_MAX) {
+      writeResult = timedWriteAt(stats, fh, dataOffset + before[2] + bytesWritten,
+                                         packed.data() + bytesWritten, INT_MAX,
+                                         MPI_BYTE, &status);
+      checkResult(writeResult);
+      bytesWritten += INT_MAX;
+   }
+   writeResult = timedWriteAt(stats, fh, dataOffset + before[2] + bytesWritten,
+                                      packed.data() + bytesWritten,
+                                      packed.size() - bytesWritten,
+                                      MPI_BYTE, &status);
+   checkResult(writeResult);
+   writeResult = timedWriteAt(stats, fh, indexOffset + 
+                                      before[1] * sizeof(OO_MPI_IO_BlockIndexEntry),
+                                      entries.data(), 
+                                      entries.size() * sizeof(OO_MPI_IO_BlockIndexEntry),
+                                      MPI_BYTE, &status);
+   checkResult(writeResult);
+   if (OO_MPI_IO_Base<ItemType>::getID() == 0) {
+      writeResult = timedWriteAt(stats, fh, 0, &prologue, sizeof(prologue),
+                                         MPI_BYTE, &status);
+      checkResult(writeResult);
+   }
+}
+
+/*******************************************************************
+ * The CompressedReader template reads a compressed container:
+ *  it loads the footer index when it is constructed, then maps
+ *  each requested range of Items to the blocks that hold them,
+ *  reads just those blocks' bytes and decompresses them.
+ * For arithmetic Items, it answers min/max queries from the 
+ *  index, decoding only the blocks a range covers partially.
+ *
+ * It uses OO_MPI_IO_Base as its superclass.
+ ******************************************************************/
+
+template<class ItemType> 
+class CompressedReader : public OO_MPI_IO_Base<ItemType> {
+public:
+  CompressedReader(const std::string& fileName, MPI_Datatype mpiType,
+                    int id, int numPEs);
+  std::vector<ItemType> readChunk();
+  std::vector<ItemType> readRange(uint64_t firstItem, uint64_t numItems);
+  void getRangeMinMax(uint64_t firstItem, uint64_t numItems,
+                      ItemType& least, ItemType& greatest);
+  ItemType getMin();
+  ItemType getMax();
+
+  BlockCodec getCodec() const           { return myCodec; }
+  long getBlockItems() const            { return myBlockItems; }
+  long getNumBlocks() const             { return myFirstItems.size() - 1; }
+  long getCompressedBytesRead() const   { return myCompressedBytesRead; }
+  bool hasMinMax() const                { return myHasMinMax; }
+  ItemType getBlockMin(long block) const  { return myMinimums[block]; }
+  ItemType getBlockMax(long block) const  { return myMaximums[block]; }
+  uint64_t getBlockCount(long block) const { return myCounts[block]; }
+private:
+  void loadIndex();
+
+  BlockCodec            myCodec;             // how blocks are compressed
+  long                  myBlockItems;        // (max) Items per block
+  std::vector<uint64_t> myOffsets;           // where each block begins
+  std::vector<uint64_t> myFirstItems;        // each block's first Item
+  bool                  myHasMinMax;         // does the index hold min/max?
+  std::vector<ItemType> myMinimums;          // each block's least Item
+  std::vector<ItemType> myMaximums;          //  and greatest Item
+  std::vector<uint64_t> myCounts;            //  and Items that are not NaN
+  long                  myCompressedBytesRead;
+};
+
+/* CompressedReader constructor
+ * @param: fileName, a string
+ * @param: mpiType, an MPI_Datatype value
+ * @param: id, an int
+ * @param: numPEs, an int
+ * Precondition: fileName is the name of a container written by
+ *                a CompressedWriter<ItemType>
+ *           &&  mpiType is the MPI equivalent of ItemType
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
+ * Postcondition: the file has been opened for parallel input
+ *           &&  its prologue and footer index have been loaded.
+ * Note: In MPI mode, every process must construct its CompressedReader
+ *        (as process 0 reads the index and broadcasts it).
+ */
+template <class ItemType>
+CompressedReader<ItemType>::
+CompressedReader(const std::string& fileName, MPI_Datatype mpiType,
+                  int id, int numPEs)
+: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, id, numPEs)
+{
+   myCompressedBytesRead = 0;
+   loadIndex();
+}
+
+/* utility to load (and validate) the prologue and footer index
+ * Postcondition: myOffsets and myFirstItems hold the index, 
+ *                 each ending with a sentinel (the index's offset,
+ *                 and the number of Items in the container)
+ *            &&  myMinimums, myMaximums and myCounts hold the blocks'
+ *                 min/max and counts of Items that are not NaN
+ *                 (if hasMinMax()).
+ */
+template <class ItemType>
+void CompressedReader<ItemType>::loadIndex() {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   bool collective = OO_MPI_IO_Base<ItemType>::isCollective();
+   bool readsFile = !collective || OO_MPI_IO_Base<ItemType>::getID() == 0;
+   MPI_Status status;
+
+   OO_MPI_IO_BlockPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   if (readsFile) {
+      int readResult = timedReadAt(stats, fh, 0, &prologue, sizeof(prologue),
+                                           MPI_BYTE, &status);
+      checkResult(readResult);
+   }
+   if (collective) {
+      MPI_Bcast(&prologue, sizeof(prologue), MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   uint32_t reversedMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   swapBytes(&reversedMark, 1, 4);
+   bool foreignOrder = (prologue.byteOrderMark == reversedMark);
+   if (foreignOrder) {
+      swapPrologue(prologue);
+   }
+   if (memcmp(prologue.magic, OO_MPI_IO_BLOCK_MAGIC, 8) != 0 ||
+        prologue.byteOrderMark != OO_MPI_IO_BYTE_ORDER_MARK ||
+        !codecSuitsItems<ItemType>((BlockCodec) prologue.codec) ||
+        prologue.itemSize != (uint32_t)OO_MPI_IO_Base<ItemType>::getItemSize()) {
+      fprintf(stderr, "\nCompressedReader(): '%s' is not a container"
+                      " of %ld-byte Items\n\n", 
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str(),
+                      OO_MPI_IO_Base<ItemType>::getItemSize());
+      exit(1);
+   }
+   if (foreignOrder) {
+      OO_MPI_IO_Base<ItemType>::setByteOrder(
+                 getHostByteOrder() == LITTLE_ENDIAN_ORDER ? BIG_ENDIAN_ORDER
+                                                           : LITTLE_ENDIAN_ORDER);
+   }
+   myCodec = (BlockCodec) prologue.codec;
+   myBlockItems = prologue.blockItems;
+   myHasMinMax = (prologue.flags & OO_MPI_IO_BLOCK_MINMAX) != 0;
+
+   std::vector<OO_MPI_IO_BlockIndexEntry> entries(prologue.numBlocks);
+   long indexBytes = entries.size() * sizeof(OO_MPI_IO_BlockIndexEntry);
+   if (readsFile && indexBytes > 0) {
+      int readResult = timedReadAt(stats, fh, prologue.indexOffset, 
+                                           entries.data(), indexBytes,
+                                           MPI_BYTE, &status);
+      checkResult(readResult);
+   }
+   if (collective && indexBytes > 0) {
+      MPI_Bcast(entries.data(), indexBytes, MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   int itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   if (foreignOrder) {
+      swapIndexEntries(entries, itemSize, myHasMinMax);
+   }
+   myOffsets.resize(entries.size() + 1);
+   myFirstItems.resize(entries.size() + 1);
+   myMinimums.resize(myHasMinMax ? entries.size() : 0);
+   myMaximums.resize(myHasMinMax ? entries.size() : 0);
+   myCounts.resize(myHasMinMax ? entries.size() : 0);
+   for (unsigned long b = 0; b < entries.size(); ++b) {
+      myOffsets[b] = entries[b].byteOffset;
+      myFirstItems[b] = entries[b].firstItem;
+      if (myHasMinMax) {
+         memcpy(&myMinimums[b], &entries[b].minimum, itemSize);
+         memcpy(&myMaximums[b], &entries[b].maximum, itemSize);
+         myCounts[b] = entries[b].count;
+      }
+   }
+   myOffsets.back() = prologue.indexOffset;
+   myFirstItems.back() = prologue.numItems;
+
+   OO_MPI_IO_Base<ItemType>::setDataOffset(OO_MPI_IO_PROLOGUE_SIZE);
+   OO_MPI_IO_Base<ItemType>::setNumItemsInFile(prologue.numItems);
+   OO_MPI_IO_Base<ItemType>::setFileSize(prologue.indexOffset + indexBytes);
+}
+
+/* method to read this PE's chunk of the container's Items
+ * Return: a vector containing the values of this PE's chunk
+ *          (the same Items ParallelReader::readChunk() would return
+ *           for the uncompressed file).
+ */
+template <class ItemType>
+std::vector<ItemType> CompressedReader<ItemType>::readChunk() {
+   long start = 0, stop = 0;
+   getChunkStartStopValues(OO_MPI_IO_Base<ItemType>::getID(), 
+                           OO_MPI_IO_Base<ItemType>::getNumPEs(),
+                           OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
+                           start, stop);
+   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
+   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
+   return readRange(start, stop - start);
+}
+
+/* method to read a range of the container's Items
+ * @param: firstItem, a uint64_t
+ * @param: numItems, a uint64_t.
+ * Precondition: firstItem + numItems <= getNumItemsInFile().
+ * Return: a vector containing Items firstItem .. firstItem+numItems-1.
+ * Note: Only the blocks holding those Items are read (with one read)
+ *        and decompressed (blocks encoded by a numeric codec decode
+ *        straight to the host's byte order; others are converted).
+ */
+template <class ItemType>
+std::vector<ItemType> 
+CompressedReader<ItemType>::readRange(uint64_t firstItem, uint64_t numItems) {
+   OO_MPI_IO_Stats* stats = OO_MPI_IO_Base<ItemType>::getStatsRecorder();
+   std::vector<ItemType> v(numItems);
+   if (numItems == 0) {
+      return v;
+   }
+   if (firstItem + numItems > myFirstItems.back()) {
+      fprintf(stderr, "\nCompressedReader::readRange(): Items %llu..%llu are"
+                      " beyond the end of '%s'\n\n",
+                      (unsigned long long)firstItem,
+                      (unsigned long long)(firstItem + numItems - 1),
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   uint64_t lastItem = firstItem + numItems - 1;
+   long firstBlock = std::upper_bound(myFirstItems.begin(), myFirstItems.end(),
+                                       firstItem) - myFirstItems.begin() - 1;
+   long lastBlock = std::upper_bound(myFirstItems.begin(), myFirstItems.end(),
+                                      lastItem) - myFirstItems.begin() - 1;
+
+   // read the blocks' bytes
+   MPI_File& fh = OO_MPI_IO_Base<ItemType>::getFileHandle();
+   uint64_t base = myOffsets[firstBlock];
+   std::vector<unsigned char> packed(myOffsets[lastBlock+1] - base);
+   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(base);
+   MPI_Status status;
+   unsigned long bytesRead = 0;
+   int readResult = 0;
+   while (packed.size() - bytesRead > INT_MAX) {
+      readResult = timedReadAt(stats, fh, base + bytesRead, 
+                                       packed.data() + bytesRead, INT_MAX,
+                                       MPI_BYTE, &status);
+      checkResult(readResult);
+      bytesRead += INT_MAX;
+   }
+   readResult = timedReadAt(stats, fh, base + bytesRead, 
+                                    packed.data() + bytesRead,
+                                    packed.size() - bytesRead, MPI_BYTE, &status);
+   checkResult(readResult);
+   myCompressedBytesRead += packed.size();
+
+   // decompress them: whole blocks in place, partial ones via a buffer
+   int itemSize = OO_MPI_IO_Base<ItemType>::getItemSize();
+   std::vector<ItemType> blockBuffer;
+   std::vector<unsigned char> scratch;
+   std::vector<uint64_t> codes;
+   bool numeric = isNumericCodec(myCodec);
+   for (long b = firstBlock; b <= lastBlock; ++b) {
+      uint64_t blockFirst = myFirstItems[b];
+      uint64_t blockCount = myFirstItems[b+1] - blockFirst;
+      bool whole = (blockFirst >= firstItem && 
+                     blockFirst + blockCount - 1 <= lastItem);
+      ItemType* target = v.data() + (blockFirst - firstItem);
+      if ( !whole ) {
+         blockBuffer.resize(blockCount);
+         target = blockBuffer.data();
+      }
+      const unsigned char* in = packed.data() + (myOffsets[b] - base);
+      unsigned long inBytes = myOffsets[b+1] - myOffsets[b];
+      bool decoded = false;
+      if (numeric && inBytes != blockCount * itemSize) {
+         decoded = decodeNumbers(myCodec, in, inBytes, target, blockCount,
+                                  codes);
+      } else {
+         decoded = decompressBlock(numeric ? CODEC_NONE : myCodec, in, 
+                                    inBytes, (unsigned char*) target, 
+                                    blockCount, itemSize, scratch);
+         OO_MPI_IO_Base<ItemType>::convertItems(target, blockCount);
+      }
+      if ( !decoded ) {
+         fprintf(stderr, "\nCompressedReader::readRange(): block %ld of '%s'"
+                         " is corrupt\n\n", b,
+                         OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      if ( !whole ) {
+         uint64_t from = std::max(blockFirst, firstItem);
+         uint64_t to = std::min(blockFirst + blockCount - 1, lastItem);
+         std::copy(blockBuffer.begin() + (from - blockFirst),
+                   blockBuffer.begin() + (to - blockFirst) + 1,
+                   v.begin() + (from - firstItem));
+      }
+   }
+   return v;
+}
+
+/* method to find the least and greatest of a range of Items
+ * @param: firstItem, a uint64_t
+ * @param: numItems, a uint64_t
+ * @param: least, greatest, ItemType variables.
+ * Precondition: hasMinMax() 
+ *            && numItems > 0 && firstItem + numItems <= getNumItemsInFile().
+ * Postcondition: least and greatest are the least and greatest of
+ *                 Items firstItem .. firstItem+numItems-1 (ignoring NaNs;
+ *                 both are NaN if every one of those Items is NaN).
+ * Note: The min/max of blocks within the range come from the index;
+ *        only the (at most two) blocks the range covers partially
+ *        are read and decoded. Blocks and parts of blocks with no
+ *        Items but NaNs are skipped.
+ */
+template <class ItemType>
+void CompressedReader<ItemType>::getRangeMinMax(uint64_t firstItem,
+                                                 uint64_t numItems,
+                                                 ItemType& least,
+                                                 ItemType& greatest) {
+   if ( !myHasMinMax || numItems == 0 ||
+         firstItem + numItems > myFirstItems.back() ) {
+      fprintf(stderr, "\nCompressedReader::getRangeMinMax(): no min/max"
+                      " for %llu Items from Item %llu of '%s'\n\n",
+                      (unsigned long long)numItems,
+                      (unsigned long long)firstItem,
+                      OO_MPI_IO_Base<ItemType>::getFileName().c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   uint64_t lastItem = firstItem + numItems - 1;
+   long firstBlock = std::upper_bound(myFirstItems.begin(), myFirstItems.end(),
+                                       firstItem) - myFirstItems.begin() - 1;
+   long lastBlock = std::upper_bound(myFirstItems.begin(), myFirstItems.end(),
+                                      lastItem) - myFirstItems.begin() - 1;
+   std::vector<ItemType> candidates;
+   for (long b = firstBlock; b <= lastBlock; ++b) {
+      uint64_t from = std::max(myFirstItems[b], firstItem);
+      uint64_t to = std::min(myFirstItems[b+1] - 1, lastItem);
+      if (from == myFirstItems[b] && to == myFirstItems[b+1] - 1) {
+         if (myCounts[b] > 0) {
+            candidates.push_back(myMinimums[b]);
+            candidates.push_back(myMaximums[b]);
+         }
+      } else if (myCounts[b] > 0) {
+         std::vector<ItemType> part = readRange(from, to - from + 1);
+         ItemType partLeast, partGreatest;
+         if ( findMinMax(part.data(), part.size(), partLeast, partGreatest)
+               && partLeast == partLeast ) {             // (not all NaNs)
+            candidates.push_back(partLeast);
+            candidates.push_back(partGreatest);
+         }
+      }
+   }
+   if ( !findMinMax(candidates.data(), candidates.size(), least, greatest) ) {
+      least = greatest = std::numeric_limits<ItemType>::quiet_NaN();
+   }
+}
+
+/* method to find the least Item in the container
+ * Precondition: hasMinMax() && getNumItemsInFile() > 0.
+ * Return: the least Item (ignoring NaNs; NaN if all are NaN), 
+ *          from the index alone.
+ */
+template <class ItemType>
+ItemType CompressedReader<ItemType>::getMin() {
+   ItemType least, greatest;
+   getRangeMinMax(0, myFirstItems.back(), least, greatest);
+   return least;
+}
+
+/* method to find the greatest Item in the container
+ * Precondition: hasMinMax() && getNumItemsInFile() > 0.
+ * Return: the greatest Item (ignoring NaNs; NaN if all are NaN), 
+ *          from the index alone.
+ */
+template <class ItemType>
+ItemType CompressedReader<ItemType>::getMax() {
+   ItemType least, greatest;
+   getRangeMinMax(0, myFirstItems.back(), least, greatest);
+   return greatest;
+}
+
+/********************************************************************
+ * Record files hold variable-length records (e.g., strings or 
+ *  serialized messages), each stored as its length (a uint32_t)
+ *  followed by its bytes.
+ *
+ * A record file consists of:
+ *  - a 64-byte OO_MPI_IO_RecordPrologue, then
+ *  - the records, with a 16-byte sync marker (random, per file)
+ *     before the first record and wherever at least syncInterval 
+ *     bytes have followed the last marker.
+ * A reader can thus split the file by bytes and snap each split to
+ *  the next marker, so every PE gets whole records, with no gaps or
+ *  duplicates, and without a serial pre-scan. An optional index
+ *  (the file's name plus ".idx") lists every record's offset, so
+ *  splits can snap to any record, and records can be read by number.
+ * The prologue, lengths and index are in the writer's byte order.
+ ********************************************************************/
+
+const long OO_MPI_IO_SYNC_INTERVAL = 1L << 16;    // default bytes per marker
+const int  OO_MPI_IO_SYNC_SIZE = 16;
+const char OO_MPI_IO_RECORD_MAGIC[8] = {'O','O','M','P','I','R','E','C'};
+const char OO_MPI_IO_RECORD_INDEX_MAGIC[8] = {'O','O','M','P','I','I','D','X'};
+
+struct OO_MPI_IO_RecordPrologue {
+  char     magic[8];                  // OO_MPI_IO_RECORD_MAGIC
+  uint32_t version;                   // record file format (1)
+  uint32_t byteOrderMark;             // OO_MPI_IO_BYTE_ORDER_MARK
+  uint64_t syncInterval;              // (least) bytes between markers
+  uint64_t numRecords;                // records in the file
+  uint64_t dataEnd;                   // where the last record ends
+  unsigned char sync[OO_MPI_IO_SYNC_SIZE];   // the file's sync marker
+  uint64_t reserved;
+};
+
+static_assert(sizeof(OO_MPI_IO_RecordPrologue) == OO_MPI_IO_PROLOGUE_SIZE,
+              "OO_MPI_IO_RecordPrologue must be exactly 64 bytes");
+
+/* The beginning of a record index; one uint64_t offset per record follows */
+struct OO_MPI_IO_RecordIndexPrologue {
+  char     magic[8];                  // OO_MPI_IO_RECORD_INDEX_MAGIC
+  uint32_t version;                   // record index format (1)
+  uint32_t byteOrderMark;             // OO_MPI_IO_BYTE_ORDER_MARK
+  uint64_t numRecords;                // records in the file
+  uint64_t dataEnd;                   // where the last record ends
+};
+
+/* A record, as a view of its bytes in a RecordReader's buffer
+ *  (valid until the reader's next read).
+ */
+struct RecordView {
+  const char* data;                   // the record's first byte
+  uint32_t    length;                 // the number of its bytes
+  std::string toString() const        { return std::string(data, length); }
+};
+
+/* Utility to find the name of a record file's index
+ */
+std::string getRecordIndexFileName(const std::string& fileName) {
+   return fileName + ".idx";
+}
+
+/* Utility to write bytes at an offset (in pieces of at most INT_MAX)
+ * @param: fh, an MPI_File open for output
+ * @param: offset, where the bytes go
+ * @param: data, the address of the bytes
+ * @param: numBytes, the number of bytes
+ * @param: stats, the I/O counters of the writer (or NULL).
+ */
+void writeBytesAt(MPI_File& fh, uint64_t offset, const void* data, 
+                   uint64_t numBytes, OO_MPI_IO_Stats* stats = NULL) {
+   const char* bytes = (const char*) data;
+   MPI_Status status;
+   for (uint64_t done = 0; done < numBytes; done += INT_MAX) {
+      int count = std::min<uint64_t>(INT_MAX, numBytes - done);
+      int writeResult = timedWriteAt(stats, fh, offset + done, bytes + done, 
+                                             count, MPI_BYTE, &status);
+      checkResult(writeResult);
+   }
+}
+
+/* Utility to read bytes from an offset (in pieces of at most INT_MAX)
+ * @param: fh, an MPI_File open for input
+ * @param: offset, where the bytes are
+ * @param: data, the address of a buffer of numBytes bytes
+ * @param: numBytes, the number of bytes
+ * @param: stats, the I/O counters of the reader (or NULL).
+ */
+void readBytesAt(MPI_File& fh, uint64_t offset, void* data, uint64_t numBytes,
+                  OO_MPI_IO_Stats* stats = NULL) {
+   char* bytes = (char*) data;
+   MPI_Status status;
+   for (uint64_t done = 0; done < numBytes; done += INT_MAX) {
+      int count = std::min<uint64_t>(INT_MAX, numBytes - done);
+      int readResult = timedReadAt(stats, fh, offset + done, bytes + done, 
+                                           count, MPI_BYTE, &status);
+      checkResult(readResult);
+   }
+}
+
+/*******************************************************************
+ * The RecordWriter class writes a record file: each PE frames its
+ *  records (with sync markers) locally, and writes them where a
+ *  prefix sum of the PEs' sizes places them, along with its part
+ *  of the index (if enableIndex() has been called).
+ *
+ * It uses OO_MPI_IO_Base (of bytes) as its superclass.
+ ******************************************************************/
+
+class RecordWriter : public OO_MPI_IO_Base<char> {
+public:
+  RecordWriter(const std::string& fileName, int id, int numPEs,
+                long syncInterval = OO_MPI_IO_SYNC_INTERVAL);
+  void enableIndex()                   { myIndexFlag = true; }
+  void writeChunk(const std::vector<std::string>& records);
+
+  long getSyncInterval() const         { return mySyncInterval; }
+  bool hasIndex() const                { return myIndexFlag; }
+  uint64_t getNumRecords() const       { return myNumRecords; }
+private:
+  long     mySyncInterval;          // (least) bytes between sync markers
+  bool     myIndexFlag;             // write an index?
+  uint64_t myNumRecords;            // records in the file
+};
+
+/* RecordWriter constructor
+ * @param: fileName, a string
+ * @param: id, an int
+ * @param: numPEs, an int
+ * @param: syncInterval, a long (default OO_MPI_IO_SYNC_INTERVAL).
+ * Precondition: fileName is the name of an output file
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes
+ *           &&  syncInterval > 0.
+ * Postcondition: the file has been opened for parallel output
+ *           &&  getSyncInterval() == syncInterval && !hasIndex().
+ */
+RecordWriter::RecordWriter(const std::string& fileName, int id, int numPEs,
+                            long syncInterval)
+: OO_MPI_IO_Base<char>(fileName, MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                        MPI_CHAR, id, numPEs)
+{
+   if (syncInterval <= 0) {
+      fprintf(stderr, "\nRecordWriter(): bad syncInterval (%ld)\n\n",
+                      syncInterval);
+      exit(1);
+   }
+   mySyncInterval = syncInterval;
+   myIndexFlag = false;
+   myNumRecords = 0;
+}
+
+/* method to write this PE's records to the file
+ * @param: records, a vector of strings (each of any bytes).
+ * Precondition: records contains this PE's records, which follow 
+ *                those of the PEs with lower ids
+ *           &&  each record is shorter than 4 GB (or else an error 
+ *                 is reported and the program is terminated).
+ * Postcondition: the file holds every PE's records, in order of id
+ *            &&  its index holds every record's offset, if hasIndex()
+ *                 (or else it has been removed, as it would not match)
+ *            &&  getNumRecords() is the number of records in the file.
+ * Note: This is a collective call (MPI_Exscan()), so every process 
+ *        must call it.
+ */
+void RecordWriter::writeChunk(const std::vector<std::string>& records) {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   MPI_File& fh = getFileHandle();
+   timedSetSize(stats, fh, 0);                                // truncate
+   std::string fileName = getFileName();
+   bool isZero = (getID() == 0);
+
+   // a marker that is (almost certainly) in no record
+   OO_MPI_IO_RecordPrologue prologue;
+   memset(&prologue, 0, sizeof(prologue));
+   if (isZero) {
+      uint64_t seed = hashKey( MPI_Wtime() ) ^ (uint64_t)(uintptr_t) &seed;
+      uint64_t words[2] = { hashKey(seed), hashKey(seed + 1) };
+      memcpy(prologue.sync, words, OO_MPI_IO_SYNC_SIZE);
+   }
+   MPI_Bcast(prologue.sync, OO_MPI_IO_SYNC_SIZE, MPI_BYTE, 0, MPI_COMM_WORLD);
+
+   // frame my records: a marker, then (length, bytes) pairs, with
+   //  another marker wherever syncInterval bytes follow the last
+   std::vector<char> packed;
+   std::vector<uint64_t> localOffsets( records.size() );
+   long sinceSync = mySyncInterval;
+   for (unsigned long r = 0; r < records.size(); ++r) {
+      if (sinceSync >= mySyncInterval) {
+         packed.insert(packed.end(), prologue.sync, 
+                        prologue.sync + OO_MPI_IO_SYNC_SIZE);
+         sinceSync = 0;
+      }
+      if (records[r].size() > UINT32_MAX) {        // (its length won't fit)
+         fprintf(stderr, "\nRecordWriter::writeChunk(): record %lu of PE %d"
+                         " has %lu bytes, but records must be shorter"
+                         " than 4 GB\n\n", r, getID(), 
+                         (unsigned long)records[r].size());
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      uint32_t length = records[r].size();
+      localOffsets[r] = packed.size();
+      packed.insert(packed.end(), (const char*) &length, 
+                     (const char*) &length + 4);
+      packed.insert(packed.end(), records[r].begin(), records[r].end());
+      sinceSync += 4 + length;
+   }
+
+   // place my records after those of lower-id PEs
+   long mine[2] = { (long)records.size(), (long)packed.size() };
+   long before[2] = {0, 0}, total[2] = {0, 0};
+   MPI_Exscan(mine, before, 2, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   MPI_Allreduce(mine, total, 2, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   if (isZero) {
+      before[0] = before[1] = 0;                   // Exscan leaves these
+   }
+   myNumRecords = total[0];
+   long dataOffset = OO_MPI_IO_PROLOGUE_SIZE;
+   setDataOffset(dataOffset);
+   setNumItemsInFile(total[1]);
+   setChunkSize(packed.size());
+   setFirstByteOffset(dataOffset + before[1]);
+   setFileSize(dataOffset + total[1]);
+   writeBytesAt(fh, dataOffset + before[1], packed.data(), packed.size(), stats);
+
+   memcpy(prologue.magic, OO_MPI_IO_RECORD_MAGIC, sizeof(prologue.magic));
+   prologue.version = 1;
+   prologue.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   prologue.syncInterval = mySyncInterval;
+   prologue.numRecords = total[0];
+   prologue.dataEnd = dataOffset + total[1];
+   if (isZero) {
+      writeBytesAt(fh, 0, &prologue, sizeof(prologue), stats);
+   }
+
+   std::string indexFileName = getRecordIndexFileName(fileName);
+   if (myIndexFlag) {
+      OO_MPI_IO_RecordIndexPrologue indexPrologue;
+      memset(&indexPrologue, 0, sizeof(indexPrologue));
+      memcpy(indexPrologue.magic, OO_MPI_IO_RECORD_INDEX_MAGIC, 8);
+      indexPrologue.version = 1;
+      indexPrologue.byteOrderMark = OO_MPI_IO_BYTE_ORDER_MARK;
+      indexPrologue.numRecords = total[0];
+      indexPrologue.dataEnd = prologue.dataEnd;
+      for (unsigned long r = 0; r < localOffsets.size(); ++r) {
+         localOffsets[r] += dataOffset + before[1];
+      }
+      MPI_File indexFile;
+      int result = timedOpen(stats, MPI_COMM_WORLD, indexFileName.c_str(),
+                                     MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                     MPI_INFO_NULL, &indexFile);
+      checkResult(result);
+      timedSetSize(stats, indexFile, 0);
+      writeBytesAt(indexFile, sizeof(indexPrologue) + before[0] * 8,
+                    localOffsets.data(), localOffsets.size() * 8, stats);
+      if (isZero) {
+         writeBytesAt(indexFile, 0, &indexPrologue, sizeof(indexPrologue), stats);
+      }
+      timedClose(stats, &indexFile);
+   } else if (isZero) {
+      MPI_File_delete(indexFileName.c_str(), MPI_INFO_NULL); // if there is one
+   }
+}
+
+/*******************************************************************
+ * The RecordReader class reads a record file: each PE takes an 
+ *  equal share of the file's bytes, snapped forward to the next 
+ *  sync marker (or, with an index, to the next record), so that 
+ *  the PEs' records are whole and neither overlap nor leave gaps.
+ * A PE's records are returned as views into one buffer, into which
+ *  they were read with a single read.
+ *
+ * It uses OO_MPI_IO_Base (of bytes) as its superclass.
+ ******************************************************************/
+
+class RecordReader : public OO_MPI_IO_Base<char> {
+public:
+  RecordReader(const std::string& fileName, int id, int numPEs);
+  std::vector<RecordView> readChunk();
+  std::vector<RecordView> readRecords(uint64_t firstRecord, uint64_t numRecords);
+  void close();
+
+  uint64_t getNumRecords() const       { return myPrologue.numRecords; }
+  long getSyncInterval() const         { return myPrologue.syncInterval; }
+  bool hasIndex() const                { return myIndexFlag; }
+  const std::vector<char>& getBuffer() const  { return myBuffer; }
+private:
+  void loadPrologue();
+  uint64_t findBoundary(uint64_t offset);
+  uint64_t readIndexEntry(uint64_t record);
+  std::vector<RecordView> parseRecords(uint64_t numRecords);
+
+  OO_MPI_IO_RecordPrologue myPrologue;   // (in the host's byte order)
+  bool                  mySwapFlag;      // lengths in the other order?
+  bool                  myIndexFlag;     // is there an index?
+  bool                  myIndexSwapFlag; // is it in the other order?
+  MPI_File              myIndexFile;     // (if so)
+  std::vector<char>     myBuffer;        // the bytes of the last read
+};
+
+/* RecordReader constructor
+ * @param: fileName, a string
+ * @param: id, an int
+ * @param: numPEs, an int
+ * Precondition: fileName is the name of a file written by a RecordWriter
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
+ * Postcondition: the file (and its index, if any) has been opened 
+ *                 for parallel input
+ *           &&  its prologue has been loaded.
+ * Note: In MPI mode, every process must construct its RecordReader
+ *        (as process 0 reads the prologues and broadcasts them).
+ */
+RecordReader::RecordReader(const std::string& fileName, int id, int numPEs)
+: OO_MPI_IO_Base<char>(fileName, MPI_MODE_RDONLY, MPI_CHAR, id, numPEs)
+{
+   loadPrologue();
+}
+
+/* utility to load (and validate) the prologues of the file and index
+ * Postcondition: myPrologue holds the file's prologue
+ *            &&  myIndexFlag is true iff the file has an index that 
+ *                 matches it, in which case myIndexFile is open.
+ */
+void RecordReader::loadPrologue() {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   bool collective = isCollective();
+   bool readsFile = !collective || getID() == 0;
+   uint32_t reversedMark = OO_MPI_IO_BYTE_ORDER_MARK;
+   swapBytes(&reversedMark, 1, 4);
+
+   memset(&myPrologue, 0, sizeof(myPrologue));
+   if (readsFile) {
+      readBytesAt(getFileHandle(), 0, &myPrologue, sizeof(myPrologue), stats);
+   }
+   if (collective) {
+      MPI_Bcast(&myPrologue, sizeof(myPrologue), MPI_BYTE, 0, MPI_COMM_WORLD);
+   }
+   mySwapFlag = (myPrologue.byteOrderMark == reversedMark);
+   if (mySwapFlag) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&myPrologue);
+      swapBytes(bytes + offsetof(OO_MPI_IO_RecordPrologue, version), 
+                 2, 4);                           // version, byteOrderMark
+      swapBytes(bytes + offsetof(OO_MPI_IO_RecordPrologue, syncInterval), 
+                 3, 8);                           // syncInterval .. dataEnd
+   }
+   if (memcmp(myPrologue.magic, OO_MPI_IO_RECORD_MAGIC, 8) != 0 ||
+        myPrologue.byteOrderMark != OO_MPI_IO_BYTE_ORDER_MARK ||
+        myPrologue.dataEnd < (uint64_t) OO_MPI_IO_PROLOGUE_SIZE) {
+      fprintf(stderr, "\nRecordReader(): '%s' is not a record file\n\n", 
+                      getFileName().c_str());
+      exit(1);
+   }
+   setDataOffset(OO_MPI_IO_PROLOGUE_SIZE);
+   setFileSize(myPrologue.dataEnd);
+   setNumItemsInFile(myPrologue.dataEnd - OO_MPI_IO_PROLOGUE_SIZE);
+
+   // the index (if there is one), which each PE opens for itself
+   OO_MPI_IO_RecordIndexPrologue indexPrologue;
+   memset(&indexPrologue, 0, sizeof(indexPrologue));
+   int openResult = timedOpen(stats, MPI_COMM_SELF, 
+                             getRecordIndexFileName(getFileName()).c_str(),
+                             MPI_MODE_RDONLY, MPI_INFO_NULL, &myIndexFile);
+   if (openResult == MPI_SUCCESS) {
+      readBytesAt(myIndexFile, 0, &indexPrologue, sizeof(indexPrologue), stats);
+   }
+   myIndexSwapFlag = (indexPrologue.byteOrderMark == reversedMark);
+   if (myIndexSwapFlag) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&indexPrologue);
+      swapBytes(bytes + offsetof(OO_MPI_IO_RecordIndexPrologue, version), 
+                 2, 4);
+      swapBytes(bytes + offsetof(OO_MPI_IO_RecordIndexPrologue, numRecords), 
+                 2, 8);
+   }
+   myIndexFlag = (openResult == MPI_SUCCESS &&
+                   memcmp(indexPrologue.magic, OO_MPI_IO_RECORD_INDEX_MAGIC, 
+                           8) == 0 &&
+                   indexPrologue.byteOrderMark == OO_MPI_IO_BYTE_ORDER_MARK &&
+                   indexPrologue.numRecords == myPrologue.numRecords &&
+                   indexPrologue.dataEnd == myPrologue.dataEnd);
+   if (openResult == MPI_SUCCESS && !myIndexFlag) {
+      timedClose(stats, &myIndexFile);              // a stale index
+   }
+}
+
+/* utility to read an entry of the index
+ * @param: record, a record number.
+ * Precondition: hasIndex() && record <= getNumRecords().
+ * Return: the offset of the record (or, if record == getNumRecords(), 
+ *          of the end of the records).
+ */
+uint64_t RecordReader::readIndexEntry(uint64_t record) {
+   if (record == myPrologue.numRecords) {
+      return myPrologue.dataEnd;
+   }
+   uint64_t offset = 0;
+   readBytesAt(myIndexFile, sizeof(OO_MPI_IO_RecordIndexPrologue) + record * 8,
+                &offset, 8, getStatsRecorder());
+   if (myIndexSwapFlag) {
+      swapBytes(&offset, 1, 8);
+   }
+   return offset;
+}
+
+/* utility to snap an offset to the next place a PE's records can begin
+ * @param: offset, a byte offset within the records.
+ * Return: with an index, the offset of the first record that begins at
+ *          or after offset; otherwise, the offset of the first sync marker
+ *          that begins at or after offset (or, if there is none, the end
+ *          of the records).
+ * Note: Without an index, this reads (about) syncInterval bytes at a
+ *        time until it finds a marker, which is seldom more than one read.
+ */
+uint64_t RecordReader::findBoundary(uint64_t offset) {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   uint64_t dataEnd = myPrologue.dataEnd;
+   if (offset <= (uint64_t) OO_MPI_IO_PROLOGUE_SIZE || offset >= dataEnd) {
+      return std::min(std::max<uint64_t>(offset, OO_MPI_IO_PROLOGUE_SIZE), 
+                       dataEnd);
+   }
+   if (myIndexFlag) {                             // binary search
+      uint64_t low = 0, high = myPrologue.numRecords;
+      while (low < high) {
+         uint64_t middle = low + (high - low) / 2;
+         if (readIndexEntry(middle) < offset) {
+            low = middle + 1;
+         } else {
+            high = middle;
+         }
+      }
+      return readIndexEntry(low);
+   }
+   std::vector<char> window;
+   const unsigned char* sync = myPrologue.sync;
+   uint64_t windowSize = myPrologue.syncInterval + 2 * OO_MPI_IO_SYNC_SIZE;
+   for (uint64_t start = offset; start < dataEnd; 
+         start += windowSize - OO_MPI_IO_SYNC_SIZE + 1) {
+      window.resize( std::min(windowSize, dataEnd - start) );
+      readBytesAt(getFileHandle(), start, window.data(), window.size(), stats);
+      std::vector<char>::iterator found = std::search(window.begin(), 
+                                   window.end(), sync, sync + OO_MPI_IO_SYNC_SIZE);
+      if (found != window.end()) {
+         return start + (found - window.begin());
+      }
+   }
+   return dataEnd;
+}
+
+/* utility to make views of the records in myBuffer
+ * @param: numRecords, the number of records wanted (or 0 for all).
+ * Precondition: myBuffer begins at a record or sync marker.
+ * Return: views of the (first numRecords) records in myBuffer.
+ */
+std::vector<RecordView> RecordReader::parseRecords(uint64_t numRecords) {
+   std::vector<RecordView> views;
+   const char* sync = (const char*) myPrologue.sync;
+   uint64_t position = 0, size = myBuffer.size();
+   while (position < size && (numRecords == 0 || views.size() < numRecords)) {
+      if (size - position >= (uint64_t) OO_MPI_IO_SYNC_SIZE &&
+           memcmp(&myBuffer[position], sync, OO_MPI_IO_SYNC_SIZE) == 0) {
+         position += OO_MPI_IO_SYNC_SIZE;
+         continue;
+      }
+      uint32_t length = 0;
+      if (size - position >= 4) {
+         memcpy(&length, &myBuffer[position], 4);
+         if (mySwapFlag) swapBytes(&length, 1, 4);
+      }
+      if (size - position < 4 || size - position - 4 < length) {
+         fprintf(stderr, "\nRecordReader: a record at byte %llu of '%s'"
+                         " is cut off\n\n", 
+                         (unsigned long long)(getFirstByteOffset() + position),
+                         getFileName().c_str());
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      RecordView view = { myBuffer.data() + position + 4, length };
+      views.push_back(view);
+      position += 4 + length;
+   }
+   return views;
+}
+
+/* method to read this PE's share of the records
+ * Return: views of this PE's records, in file order (concatenating 
+ *          the PEs' records in order of id gives every record once).
+ * Postcondition: getFirstByteOffset() is where this PE's records begin
+ *            &&  getChunkSize() is the number of their bytes
+ *            &&  getBuffer() holds those bytes (into which the views point).
+ * Note: Each PE finds its boundaries for itself (reading a little past
+ *        each end of its share, or searching the index), so no
+ *        communication or serial pre-scan is needed.
+ */
+std::vector<RecordView> RecordReader::readChunk() {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   uint64_t dataOffset = OO_MPI_IO_PROLOGUE_SIZE;
+   uint64_t numBytes = myPrologue.dataEnd - dataOffset;
+   uint64_t id = getID(), numPEs = getNumPEs();
+   uint64_t begin = findBoundary(dataOffset + numBytes * id / numPEs);
+   uint64_t end = findBoundary(dataOffset + numBytes * (id + 1) / numPEs);
+   setFirstByteOffset(begin);
+   setChunkSize(end - begin);
+   myBuffer.resize(end - begin);
+   readBytesAt(getFileHandle(), begin, myBuffer.data(), myBuffer.size(), stats);
+   return parseRecords(0);
+}
+
+/* method to read a range of records by number
+ * @param: firstRecord, a uint64_t
+ * @param: numRecords, a uint64_t.
+ * Precondition: hasIndex() 
+ *           &&  firstRecord + numRecords <= getNumRecords().
+ * Return: views of records firstRecord .. firstRecord+numRecords-1.
+ * Postcondition: getBuffer() holds their bytes.
+ */
+std::vector<RecordView> RecordReader::readRecords(uint64_t firstRecord,
+                                                   uint64_t numRecords) {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   if ( !myIndexFlag || firstRecord + numRecords > myPrologue.numRecords ) {
+      fprintf(stderr, "\nRecordReader::readRecords(): cannot read records"
+                      " %llu..%llu of '%s' (it has %llu%s)\n\n",
+                      (unsigned long long)firstRecord,
+                      (unsigned long long)(firstRecord + numRecords - 1),
+                      getFileName().c_str(), 
+                      (unsigned long long)myPrologue.numRecords,
+                      myIndexFlag ? "" : ", and no index");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myBuffer.clear();
+   if (numRecords == 0) {
+      return std::vector<RecordView>();
+   }
+   uint64_t begin = readIndexEntry(firstRecord);
+   uint64_t end = readIndexEntry(firstRecord + numRecords);
+   setFirstByteOffset(begin);
+   myBuffer.resize(end - begin);
+   readBytesAt(getFileHandle(), begin, myBuffer.data(), myBuffer.size(), stats);
+   return parseRecords(numRecords);
+}
+
+/* method to close the file (and its index, if any)
+ */
+void RecordReader::close() {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   if (myIndexFlag) {
+      timedClose(stats, &myIndexFile);
+      myIndexFlag = false;
+   }
+   OO_MPI_IO_Base<char>::close();
+}
+
+/********************************************************************
+ * Text files hold one value per line, as written by the programs in
+ *  genTextAndBinaryFiles (which may also write the number of values
+ *  on the first line).
+ *
+ * ParallelTextReader splits such a file evenly by bytes, moves each
+ *  split forward to the start of the next line, and parses its lines
+ *  into Items, so that the PEs need not convert the file serially.
+ * ParallelTextWriter formats each PE's Items and writes them after
+ *  those of the lower-id PEs, so the file matches a serial write.
+ * A char is read (and written) as the one character on its line;
+ *  other types are parsed (and formatted) with std::from_chars()
+ *  (and std::to_chars()) when the compiler provides them (C++17),
+ *  or with the C library (strtod(), snprintf(), ...) otherwise.
+ ********************************************************************/
+
+#if __cplusplus >= 201703L
+#include <charconv>                  // from_chars()
+#endif
+#include <cstdlib>                   // strtod(), strtof(), strtoll(), ...
+#include <cctype>                    // isspace()
+#include <cerrno>                    // errno
+#include <cstdio>                    // snprintf()
+
+const long OO_MPI_IO_TEXT_WINDOW = 4096;  // bytes read to find a line start
+const int  OO_MPI_IO_TEXT_PLACES = 15;    // default places after the point
+const int  OO_MPI_IO_TEXT_MAX_PLACES = 100;
+const int  OO_MPI_IO_TEXT_MAX_SIZE = 512; // most bytes in a formatted value
+
+/* Utility to count the newlines in some bytes
+ * @param: data, the address of the bytes
+ * @param: numBytes, the number of bytes.
+ * Return: the number of '\n' bytes among them.
+ * Note: This uses AVX2 byte compares (32 bytes at a time)
+ *        when the compiler targets them.
+ */
+uint64_t countNewlines(const char* data, uint64_t numBytes) {
+   uint64_t count = 0, i = 0;
+#if defined(__AVX2__)
+   const __m256i newlines = _mm256_set1_epi8('\n');
+   for ( ; i + 32 <= numBytes; i += 32) {
+      __m256i bytes = _mm256_loadu_si256((const __m256i*)(data + i));
+      unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newlines));
+      count += __builtin_popcount(mask);
+   }
+#endif
+   for ( ; i < numBytes; ++i) {
+      count += (data[i] == '\n');
+   }
+   return count;
+}
+
+/* Utility to parse the text of a char
+ * @param: first, the address of a line's first non-space byte
+ * @param: last, the address just past its last non-space byte
+ * @param: item, a char.
+ * Precondition: first < last.
+ * Postcondition: item is the line's first character.
+ * Return: true iff the line holds just that character.
+ */
+bool parseTextItem(const char* first, const char* last, char& item) {
+   item = *first;
+   return last - first == 1;
+}
+
+#if defined(__cpp_lib_to_chars)
+
+/* Utility to parse the text of a number (using from_chars())
+ * @param: first, the address of a line's first non-space byte
+ * @param: last, the address just past its last non-space byte
+ * @param: item, an ItemType.
+ * Precondition: first < last.
+ * Postcondition: item is the value of the line's text.
+ * Return: true iff the line holds just a value in ItemType's range.
+ */
+template <class ItemType>
+bool parseTextItem(const char* first, const char* last, ItemType& item) {
+   if (*first == '+' && last - first > 1) ++first;  // from_chars() rejects '+'
+   std::from_chars_result result = std::from_chars(first, last, item);
+   return result.ec == std::errc() && result.ptr == last;
+}
+
+#else
+
+/* utilities to convert text to a float, double or long double
+ *  (the type of their last argument), so that range errors are
+ *  those of that type
+ */
+inline float textToFloat(const char* text, char** end, float) {
+   return strtof(text, end);
+}
+
+inline double textToFloat(const char* text, char** end, double) {
+   return strtod(text, end);
+}
+
+inline long double textToFloat(const char* text, char** end, long double) {
+   return strtold(text, end);
+}
+
+/* Utilities to parse the text of a number (using the C library),
+ *  for floating-point and integral ItemTypes
+ * Precondition: *last is a space, a '\0', or some other byte that
+ *                ends a number.
+ * Note: As with from_chars(), a value too small for ItemType's 
+ *        normal range is accepted as a subnormal (although the C library
+ *        reports a range error for it), but one that underflows 
+ *        to 0 or overflows to infinity is rejected.
+ */
+template <class ItemType>
+bool parseTextNumber(const char* first, const char* last, ItemType& item,
+                      std::true_type /* floating point */) {
+   char* end = NULL;
+   errno = 0;
+   item = textToFloat(first, &end, item);
+   bool inRange = (errno != ERANGE) || (item != 0 && !std::isinf(item));
+   return end == last && inRange;
+}
+
+template <class ItemType>
+bool parseTextNumber(const char* first, const char* last, ItemType& item,
+                      std::false_type /* integral */) {
+   char* end = NULL;
+   errno = 0;
+   if (std::is_signed<ItemType>::value) {
+      long long value = strtoll(first, &end, 10);
+      item = (ItemType) value;
+      return end == last && errno == 0 && (long long) item == value;
+   } else {
+      unsigned long long value = strtoull(first, &end, 10);
+      item = (ItemType) value;
+      return end == last && errno == 0 && *first != '-' &&
+              (unsigned long long) item == value;
+   }
+}
+
+/* Utility to parse the text of a number (using the C library)
+ * @param: first, the address of a line's first non-space byte
+ * @param: last, the address just past its last non-space byte
+ * @param: item, an ItemType.
+ * Precondition: first < last 
+ *           &&  *last ends the number (see parseTextNumber()).
+ * Postcondition: item is the value of the line's text.
+ * Return: true iff the line holds just a value in ItemType's range.
+ */
+template <class ItemType>
+bool parseTextItem(const char* first, const char* last, ItemType& item) {
+   return parseTextNumber(first, last, item,
+                     std::integral_constant<bool, 
+                           std::is_floating_point<ItemType>::value>());
+}
+
+#endif
+
+/* Utility to format a char as text
+ * @param: out, the address of at least OO_MPI_IO_TEXT_MAX_SIZE bytes
+ * @param: item, a char
+ * @param: places, (ignored).
+ * Return: the number of bytes written to out (1: the char itself).
+ */
+int formatTextItem(char* out, char item, int places) {
+   *out = item;
+   return 1;
+}
+
+#if defined(__cpp_lib_to_chars)
+
+/* Utilities to format a number as text (using to_chars()),
+ *  for floating-point and integral ItemTypes
+ */
+template <class ItemType>
+int formatTextNumber(char* out, ItemType item, int places,
+                      std::true_type /* floating point */) {
+   std::to_chars_result result = (places < 0)
+      ? std::to_chars(out, out + OO_MPI_IO_TEXT_MAX_SIZE, item)
+      : std::to_chars(out, out + OO_MPI_IO_TEXT_MAX_SIZE, item,
+                       std::chars_format::fixed, places);
+   return result.ptr - out;
+}
+
+template <class ItemType>
+int formatTextNumber(char* out, ItemType item, int places,
+                      std::false_type /* integral */) {
+   return std::to_chars(out, out + OO_MPI_IO_TEXT_MAX_SIZE, item).ptr - out;
 }
 
+#else
+
+/* Utilities to format a number as text (using snprintf()),
+ *  for floating-point and integral ItemTypes
+ */
 template <class ItemType>
-void OO_MPI_IO_Base<ItemType>::setNumPEs(int newNumPEs) {
-   if (newNumPEs < 0) {
-      fprintf(stderr, "\nOO_MPI_IO_Base::setNumPEs(): bad numPEs (%d)\n\n",
-                     newNumPEs);
-      exit(1);
+int formatTextNumber(char* out, ItemType item, int places,
+                      std::true_type /* floating point */) {
+   if (places < 0) {                       // enough digits to round-trip
+      int digits = (sizeof(ItemType) == sizeof(float)) ? 9 : 17;
+      return snprintf(out, OO_MPI_IO_TEXT_MAX_SIZE, "%.*g", digits, 
+                       (double) item);
    }
-   myNumPEs = newNumPEs;
+   return snprintf(out, OO_MPI_IO_TEXT_MAX_SIZE, "%.*f", places, 
+                    (double) item);
 }
 
-/* OO_MPI_IO_BASE destructor cleans up at object's end-of-life
- * Postcondition: the shared file has been closed 
- *             && if we called MPI_Init_thread(),
- *                  we have called MPI_Finalize().
- */
 template <class ItemType>
-OO_MPI_IO_Base<ItemType>::~OO_MPI_IO_Base() {
-   if (myFinalizeFlag &&                   // if MPI_Init() was not called 
-        myID == 0) {                       //  and we are the main thread,
-         MPI_Finalize();                   //  then we need to finalize
+int formatTextNumber(char* out, ItemType item, int places,
+                      std::false_type /* integral */) {
+   if (std::is_signed<ItemType>::value) {
+      return snprintf(out, OO_MPI_IO_TEXT_MAX_SIZE, "%lld", (long long) item);
    }
- }
+   return snprintf(out, OO_MPI_IO_TEXT_MAX_SIZE, "%llu", 
+                    (unsigned long long) item);
+}
 
-/* Calculate the start and stop values for this PE's 
- *  contiguous chunk of a set of loop-iterations, 0..REPS-1,
- *  so that PEs' chunk-sizes are equal (or nearly so).
- *
- * @param: id, an int containing this PE's id (thread id or MPI rank)
- * @param: numPEs, an int containing the number of PEs
- * @param: REPS, a const unsigned containing the for loop's iteration total
- * Precondition: id == this thread's id or MPI process's rank
- *            && numPEs == the number of threads or MPI processes
- *            && REPS == the total number of 0-based loop iterations needed
- *            && numPEs <= REPS 
- *            && REPS < 2^32
- * @param: start, a long reference through which the 
- *          starting value of this PE's chunk should be returned
- * @param: stop, a long reference through which the
- *          stopping value of this PE's chunk should be returned
- * Postcondition: start == this PE's first iteration value 
- *             && stop == this PE's last iteration value + 1.
- */
-void getChunkStartStopValues(int id, int numPEs, const unsigned REPS,
-                              long& start, long& stop)
-{
-   // check precondition before proceeding
-   if ((unsigned)numPEs > REPS) {
-      if (id == 0) {
-         printf("\n*** Number of PEs (%u) exceeds REPS (%u)\n",
-                 numPEs, REPS);
-         printf("*** Please run using PEs less than or equal to %u\n\n", REPS);
-      }
-      MPI_Finalize();
-      exit(1);
-   }
+#endif
 
-   // compute the chunk size that works in many cases
-   unsigned chunkSize1 = (long)ceil(((double)REPS) / numPEs);
-   unsigned begin = id * chunkSize1;
-   unsigned end = begin + chunkSize1;
-   // see if there are any leftover iterations
-   unsigned remainder = REPS % numPEs;
-   // If remainder == 0, chunkSize1 = chunk-size for all PEs;
-   // If remainder != 0, chunkSize1 = chunk-size for p_0..p_remainder-1
-   //   but for PEs p_remainder..p_numPEs-1
-   //   recompute begin and end using a smaller-by-1 chunk size, chunkSize2.
-   if (remainder > 0 && (unsigned)id >= remainder) {
-     unsigned chunkSize2 = chunkSize1 - 1;
-     unsigned remainderBase = remainder * chunkSize1;
-     unsigned peOffset = (id-remainder) * chunkSize2;
-     begin = remainderBase + peOffset;
-     end = begin + chunkSize2;
-   } 
-   // pass back this PE's begin and end values via start and stop
-   start = begin;
-   stop = end;
-} 
+/* Utility to format a number as text
+ * @param: out, the address of at least OO_MPI_IO_TEXT_MAX_SIZE bytes
+ * @param: item, an ItemType
+ * @param: places, an int.
+ * Precondition: ItemType is an integral type, float or double
+ *           &&  places <= OO_MPI_IO_TEXT_MAX_PLACES.
+ * Return: the number of bytes written to out: a floating-point item 
+ *          has places digits after the point (like printf("%.*f")),
+ *          or, if places < 0, as few as will read back as item.
+ */
+template <class ItemType>
+int formatTextItem(char* out, ItemType item, int places) {
+   static_assert(sizeof(ItemType) <= 8, 
+                 "formatTextItem() formats Items of at most 8 bytes");
+   return formatTextNumber(out, item, places,
+                     std::integral_constant<bool, 
+                           std::is_floating_point<ItemType>::value>());
+}
 
 /*******************************************************************
- * The ParallelReader template provides an abstraction to hide the
- *  details of MPI-IO parallel input.
+ * The ParallelTextReader class reads a text file of one value per
+ *  line: each PE takes an equal share of the file's bytes, with
+ *  each end moved forward to the start of a line, reads its share
+ *  with a single read, and parses its lines into Items.
  *
- * It uses OO_MPI_IO_Base as its superclass.
+ * It uses OO_MPI_IO_Base (of bytes) as its superclass.
  ******************************************************************/
 
-template<class ItemType> 
-class ParallelReader : public OO_MPI_IO_Base<ItemType> {
+template<class ItemType>
+class ParallelTextReader : public OO_MPI_IO_Base<char> {
 public:
-  ParallelReader(const std::string& fileName, MPI_Datatype mpiType,
-                  int id, int numPEs);
+  ParallelTextReader(const std::string& fileName, int id, int numPEs);
+  void expectCountLine();
   std::vector<ItemType> readChunk();
-  std::vector<ItemType> readChunkPlus(unsigned numExtras);
+
+  bool hasCountLine() const            { return myCountLineFlag; }
+  long getDeclaredCount() const        { return myDeclaredCount; }
+private:
+  uint64_t findLineStart(uint64_t offset);
+
+  bool     myCountLineFlag;         // is the first line a count?
+  long     myDeclaredCount;         // (if so) the count on it
 };
 
-/* ParallelReader constructor
+/* ParallelTextReader constructor
  * @param: fileName, a string
- * @param: mpiType, an MPI_Datatype value
  * @param: id, an int
  * @param: numPEs, an int
- * Precondition: fileName is the name of a file containing
- *                binary-format values of type ItemType
- *           &&  mpiType is the MPI_Datatype that corresonds to ItemType
- *               (e.g., MPI_DOUBLE for double)
+ * Precondition: fileName is the name of a text file of ItemType values,
+ *                one per line
  *           &&  id is a thread id or MPI process rank
  *           &&  numPEs is the number of threads or processes.
  * Postcondition: the file has been opened for parallel input
- *           &&  each instance variable have been initialized
- *                as appropriate for this PE using the file's info.
+ *           &&  getFileSize() is its size (in bytes)
+ *           &&  !hasCountLine().
  */
 template <class ItemType>
-ParallelReader<ItemType>::
-ParallelReader(const std::string& fileName, MPI_Datatype mpiType,
-                int id, int numPEs)
-: OO_MPI_IO_Base<ItemType>(fileName, MPI_MODE_RDONLY, mpiType, id, numPEs)
-{ }
+ParallelTextReader<ItemType>::
+ParallelTextReader(const std::string& fileName, int id, int numPEs)
+: OO_MPI_IO_Base<char>(fileName, MPI_MODE_RDONLY, MPI_CHAR, id, numPEs)
+{
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   MPI_Offset fileSize = 0;
+   int sizeResult = timedGetSize(stats, getFileHandle(), &fileSize);
+   checkResult(sizeResult);
+   setFileSize(fileSize);
+   setNumItemsInFile(fileSize);
+   myCountLineFlag = false;
+   myDeclaredCount = -1;
+}
 
-/* method to read a chunk from the file (in its entirety).
- * Return: a vector containing the values of this PE's chunk.
- * Note: vector was chosen as the return-type because it
- *        uses contiguous memory and provides a move-constructor.
+/* method to treat the file's first line as a count of its values
+ *  (as the programs in genTextAndBinaryFiles can write)
+ * Postcondition: hasCountLine()
+ *            &&  getDeclaredCount() is the number on the first line
+ *            &&  the first line will not be read as a value.
+ * Note: In MPI mode, every process must call this method
+ *        (as process 0 reads the line and broadcasts it).
  */
 template <class ItemType>
-std::vector<ItemType> 
-ParallelReader<ItemType>::readChunk() {
-   // Note: We could compute the following attributes in the constructor, 
-   //  but do them here for symmetry with ParallelWriter
-   MPI_Offset fileSize;
-   MPI_File_get_size(OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
-   OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
-   // Note: EOF char seems inconsistent on different platforms;
-   //  if char tests fail and off-by-one, uncomment the next 3 lines 
-//   if (std::is_same<ItemType, char>::value) {         // if ItemType is char
-//      --fileSize;                                     // ignore EOF char
-//   }
-   OO_MPI_IO_Base<ItemType>::setNumItemsInFile( fileSize / OO_MPI_IO_Base<ItemType>::getItemSize() );
-
-   long start = 0, stop = 0;
-   getChunkStartStopValues(OO_MPI_IO_Base<ItemType>::getID(), 
-                           OO_MPI_IO_Base<ItemType>::getNumPEs(),
-                           OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
-                           start, stop);
-   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
-   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
-   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(
-                              start * OO_MPI_IO_Base<ItemType>::getItemSize());
-
-   MPI_Status status;
-   unsigned long itemsRead = 0;
-   unsigned long itemsToRead = OO_MPI_IO_Base<ItemType>::getChunkSize();
-   std::vector<ItemType> v( itemsToRead );
-   int readResult = 0;
-   // handle very large files where chunkSize > INT_MAX
-   while (itemsToRead > INT_MAX) {
-      readResult = MPI_File_read_at(OO_MPI_IO_Base<ItemType>::getFileHandle(), 
-                      OO_MPI_IO_Base<ItemType>::getFirstByteOffset()+itemsRead, 
-                      v.data()+itemsRead,
-                      INT_MAX, 
-                      OO_MPI_IO_Base<ItemType>::getMPIType(), 
-                      &status);
-      checkResult(readResult);
-      itemsRead += INT_MAX;
-      itemsToRead -= INT_MAX;
+void ParallelTextReader<ItemType>::expectCountLine() {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   bool collective = isCollective();
+   long found[2] = {0, -1};                      // (line length, count)
+   if (!collective || getID() == 0) {
+      std::vector<char> window;
+      uint64_t fileSize = getFileSize(), start = 0;
+      const char* newline = NULL;
+      while (newline == NULL && start < fileSize) {
+         window.resize( std::min<uint64_t>(start + OO_MPI_IO_TEXT_WINDOW, 
+                                           fileSize) );
+         readBytesAt(getFileHandle(), start, window.data() + start, 
+                      window.size() - start, stats);
+         newline = (const char*) memchr(window.data() + start, '\n', 
+                                         window.size() - start);
+         start = window.size();
+      }
+      found[0] = newline ? newline - window.data() + 1 : window.size();
+      window.push_back('\0');
+      char* end = NULL;
+      long count = strtol(window.data(), &end, 10);
+      while (end < window.data() + found[0] && isspace((unsigned char)*end)) {
+         ++end;
+      }
+      found[1] = (end == window.data() + found[0] && end > window.data() &&
+                  count >= 0) ? count : -1;
    }
-   // read in remaining Items (or if itemsToRead <= INT_MAX initially)
-   readResult = MPI_File_read_at(OO_MPI_IO_Base<ItemType>::getFileHandle(), 
-                    OO_MPI_IO_Base<ItemType>::getFirstByteOffset()+itemsRead, 
-                    v.data()+itemsRead,
-                    itemsToRead, 
-                    OO_MPI_IO_Base<ItemType>::getMPIType(), 
-                    &status);
-   checkResult(readResult);
-
-   return v;
+   if (collective) {
+      MPI_Bcast(found, 2, MPI_LONG, 0, MPI_COMM_WORLD);
+   }
+   if (found[1] < 0) {
+      fprintf(stderr, "\nParallelTextReader::expectCountLine(): "
+                      "the first line of '%s' is not a count\n\n",
+                      getFileName().c_str());
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   setDataOffset(found[0]);
+   myCountLineFlag = true;
+   myDeclaredCount = found[1];
 }
 
-/* method to read a chunk from the file (in its entirety)
- *  plus a few items from the next PE's chunk.
- *  This version of the method is useful for search problems where
- *  the sought-after value straddles the boundary between two chunks.
- * @param: numExtras, an unsigned.
- * Precondition: numExtras is the number of additional Items to be read
- *                beyond the end of this PE's chunk.
- * Return: a vector containing the values of this PE's chunk
- *          plus numExtras values of the next PE's chunk
- *          for all PEs except the last one.
- *
- * Note: Giving numExtras a default parameter value would let us eliminate
- *        the other readChunk() method and adhere to the DRY principle,
- *        but defining each separately lets us more clearly explain
- *        the difference between the two versions.
+/* utility to move an offset forward to the start of a line
+ * @param: offset, a byte offset within the values.
+ * Return: the least offset at or after offset at which a line begins
+ *          (or, if there is none, the size of the file).
+ * Note: This reads OO_MPI_IO_TEXT_WINDOW bytes at a time until it 
+ *        finds a newline, which is seldom more than one read.
  */
 template <class ItemType>
-std::vector<ItemType>
-ParallelReader<ItemType>::readChunkPlus(unsigned numExtras) {
-   // Note: We could compute the following attributes in the constructor,
-   //  but do them here for symmetry with ParallelWriter
-   MPI_Offset fileSize;
-   MPI_File_get_size(OO_MPI_IO_Base<ItemType>::getFileHandle(), &fileSize);
-   OO_MPI_IO_Base<ItemType>::setFileSize(fileSize);
-   // Note: EOF char seems inconsistent on different platforms;
-   //  if char tests fail and off-by-one, uncomment the next 3 lines 
-//   if (std::is_same<ItemType, char>::value) {         // if ItemType is char
-//      --fileSize;                                     // ignore EOF char
-//   }
-   OO_MPI_IO_Base<ItemType>::setNumItemsInFile( fileSize / OO_MPI_IO_Base<ItemType>::getItemSize() );
-
-   long numItemsInFile = OO_MPI_IO_Base<ItemType>::getNumItemsInFile();
-   long start = 0, stop = 0;
-   int id = OO_MPI_IO_Base<ItemType>::getID();
-   int numPEs = OO_MPI_IO_Base<ItemType>::getNumPEs();
-   getChunkStartStopValues(id, numPEs, numItemsInFile, start, stop);
-   if (id < numPEs-1) {
-      stop += numExtras;
+uint64_t ParallelTextReader<ItemType>::findLineStart(uint64_t offset) {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   uint64_t fileSize = getFileSize();
+   if (offset <= (uint64_t) getDataOffset() || offset >= fileSize) {
+      return std::min(std::max<uint64_t>(offset, getDataOffset()), fileSize);
    }
-   if (stop > numItemsInFile ) {
-      stop = numItemsInFile;
+   std::vector<char> window;
+   for (uint64_t start = offset - 1; start < fileSize; 
+         start += OO_MPI_IO_TEXT_WINDOW) {             // (from the byte before)
+      window.resize( std::min<uint64_t>(OO_MPI_IO_TEXT_WINDOW, 
+                                        fileSize - start) );
+      readBytesAt(getFileHandle(), start, window.data(), window.size(), stats);
+      const char* newline = (const char*) memchr(window.data(), '\n', 
+                                                  window.size());
+      if (newline != NULL) {
+         return start + (newline - window.data()) + 1;
+      }
    }
-   OO_MPI_IO_Base<ItemType>::setChunkSize(stop - start);
-   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
-   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(start * OO_MPI_IO_Base<ItemType>::getItemSize());
+   return fileSize;
+}
 
-   MPI_Status status;
-   unsigned long itemsRead = 0;
-   unsigned long itemsToRead = OO_MPI_IO_Base<ItemType>::getChunkSize();
-   std::vector<ItemType> v( itemsToRead );
-   int readResult = 0;
-   // handle very large files where chunkSize > INT_MAX
-   while (itemsToRead > INT_MAX) {
-      readResult = MPI_File_read_at(OO_MPI_IO_Base<ItemType>::getFileHandle(), 
-                      OO_MPI_IO_Base<ItemType>::getFirstByteOffset()+itemsRead, 
-                      v.data()+itemsRead,
-                      INT_MAX, 
-                      OO_MPI_IO_Base<ItemType>::getMPIType(), 
-                      &status);
-      checkResult(readResult);
-      itemsRead += INT_MAX;
-      itemsToRead -= INT_MAX;
-   }
-   // read in remaining Items (or if itemsToRead <= INT_MAX initially)
-   readResult = MPI_File_read_at(OO_MPI_IO_Base<ItemType>::getFileHandle(), 
-                    OO_MPI_IO_Base<ItemType>::getFirstByteOffset()+itemsRead, 
-                    v.data()+itemsRead,
-                    itemsToRead, 
-                    OO_MPI_IO_Base<ItemType>::getMPIType(), 
-                    &status);
-   checkResult(readResult);
+/* method to read and parse this PE's share of the values
+ * Return: this PE's values, in file order (concatenating the PEs' 
+ *          values in order of id gives every value once).
+ * Postcondition: getFirstByteOffset() is where this PE's lines begin
+ *            &&  getChunkSize() is the number of their bytes.
+ * Note: Blank lines, and spaces (or '\r's) around values, are skipped;
+ *        a line that does not hold a value of ItemType is reported
+ *        (with its byte offset) and the program is aborted.
+ */
+template <class ItemType>
+std::vector<ItemType> ParallelTextReader<ItemType>::readChunk() {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   uint64_t dataOffset = getDataOffset();
+   uint64_t numBytes = getFileSize() - dataOffset;
+   uint64_t id = getID(), numPEs = getNumPEs();
+   uint64_t begin = findLineStart(dataOffset + numBytes * id / numPEs);
+   uint64_t end = findLineStart(dataOffset + numBytes * (id + 1) / numPEs);
+   setFirstByteOffset(begin);
+   setChunkSize(end - begin);
 
-   return v;
+   std::vector<char> buffer(end - begin + 1, '\0');   // (+ a terminator)
+   readBytesAt(getFileHandle(), begin, buffer.data(), end - begin, stats);
+   std::vector<ItemType> items;
+   items.reserve( countNewlines(buffer.data(), end - begin) + 1 );
+   const char* line = buffer.data();
+   const char* stop = line + (end - begin);
+   while (line < stop) {
+      const char* newline = (const char*) memchr(line, '\n', stop - line);
+      const char* lineEnd = newline ? newline : stop;
+      const char* first = line;
+      const char* last = lineEnd;
+      while (first < last && isspace((unsigned char) *first)) ++first;
+      while (last > first && isspace((unsigned char) last[-1])) --last;
+      if (first < last) {
+         ItemType item;
+         if ( !parseTextItem(first, last, item) ) {
+            fprintf(stderr, "\nParallelTextReader::readChunk(): bad value"
+                            " '%.*s' at byte %llu of '%s'\n\n",
+                            (int)(last - first), first,
+                            (unsigned long long)(begin + (first - buffer.data())),
+                            getFileName().c_str());
+            MPI_Abort(MPI_COMM_WORLD, 1);
+         }
+         items.push_back(item);
+      }
+      line = lineEnd + 1;
+   }
+   return items;
 }
 
 /*******************************************************************
- * The ParallelWriter template provides an abstraction to hide the
- *  details of MPI-IO parallel output.
+ * The ParallelTextWriter class writes a text file of one value per
+ *  line: each PE formats its chunk locally and writes it after the
+ *  chunks of the lower-id PEs (a prefix sum of the PEs' sizes in 
+ *  bytes), so the file is the same, byte for byte, as if one PE 
+ *  had written every value.
  *
- * It uses OO_MPI_IO_Base as its superclass.
+ * It uses OO_MPI_IO_Base (of bytes) as its superclass.
  ******************************************************************/
 
-template<class ItemType> 
-class ParallelWriter : public OO_MPI_IO_Base<ItemType> {
+template<class ItemType>
+class ParallelTextWriter : public OO_MPI_IO_Base<char> {
 public:
-  ParallelWriter(const std::string& fileName, MPI_Datatype mpiType,
-                  int id, int numPEs); 
+  ParallelTextWriter(const std::string& fileName, int id, int numPEs);
+  void setPlaces(int places);
+  void enableCountLine()               { myCountLineFlag = true; }
   void writeChunk(const std::vector<ItemType>& v);
+
+  int getPlaces() const                { return myPlaces; }
+  bool hasCountLine() const            { return myCountLineFlag; }
 private:
+  int      myPlaces;                // digits after a floating-point's point
+  bool     myCountLineFlag;         // write a count line first?
 };
 
-/* ParallelWriter constructor
+/* ParallelTextWriter constructor
  * @param: fileName, a string
  * @param: id, an int
  * @param: numPEs, an int
- * Precondition: fileName is the name of an output file 
- *                to which binary-format values 
- *                of type ItemType are to be written.
- *             && mpiType is the MPI equivalent of ItemType
- *                 (e.g., MPI_DOUBLE for double)
- *             && id is a thread id or MPI process rank
- *             && numPEs is the number of threads or MPI processes.
+ * Precondition: fileName is the name of an output file
+ *           &&  id is a thread id or MPI process rank
+ *           &&  numPEs is the number of threads or processes.
  * Postcondition: the file has been opened for parallel output
- *             &&  each instance variable have been initialized
- *                  as appropriate for this PE using id, numPEs,
- *                  and size info from the file.
+ *           &&  getPlaces() == OO_MPI_IO_TEXT_PLACES 
+ *                (as genDoubles writes doubles)
+ *           &&  !hasCountLine().
  */
 template <class ItemType>
-ParallelWriter<ItemType>::
-ParallelWriter(const std::string& fileName, MPI_Datatype mpiType,
-                int id, int numPEs)
-: OO_MPI_IO_Base<ItemType>(fileName,
-                            MPI_MODE_WRONLY | MPI_MODE_CREATE,  
-                            mpiType, id, numPEs)
-{}  // no instance variables, so no local initializations
+ParallelTextWriter<ItemType>::
+ParallelTextWriter(const std::string& fileName, int id, int numPEs)
+: OO_MPI_IO_Base<char>(fileName, MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                        MPI_CHAR, id, numPEs)
+{
+   myPlaces = OO_MPI_IO_TEXT_PLACES;
+   myCountLineFlag = false;
+}
 
+/* method to set how floating-point Items are formatted
+ * @param: places, an int.
+ * Precondition: places <= OO_MPI_IO_TEXT_MAX_PLACES.
+ * Postcondition: getPlaces() == places, so that writeChunk() writes
+ *                 floating-point Items with places digits after 
+ *                 the point or, if places < 0, with as few digits 
+ *                 as will read back as the same values.
+ */
+template <class ItemType>
+void ParallelTextWriter<ItemType>::setPlaces(int places) {
+   if (places > OO_MPI_IO_TEXT_MAX_PLACES) {
+      fprintf(stderr, "\nParallelTextWriter::setPlaces(): at most %d places"
+                      " (not %d)\n\n", OO_MPI_IO_TEXT_MAX_PLACES, places);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   myPlaces = places;
+}
 
 /* method to write this PE's chunk to the file
  * @param: v, a vector of Items.
- * Precondition: v contains the Items to be output to a file.
- * Postcondition: v's values have been written to the file
- *         at the appropriate offsets for this PE.
- * Note: It would be cleaner to pass mpiType as a template parameter
- *         but doing so produces errors (at least for OpenMPI and clang),
- *         so this is a hack-ey workaround.
- *       Could instead pass it as a parameter to the constructor...
+ * Precondition: v contains this PE's Items, which follow those of 
+ *                the PEs with lower ids.
+ * Postcondition: the file holds every PE's Items, one per line,
+ *                 in order of id (after a line holding the number of
+ *                 Items, if enableCountLine() has been called)
+ *            &&  getFirstByteOffset() is where this PE's lines begin
+ *            &&  getChunkSize() is the number of their bytes.
+ * Note: This is a collective call (MPI_Exscan()), so every process 
+ *        must call it.
  */
 template <class ItemType>
-void ParallelWriter<ItemType>::writeChunk(const std::vector<ItemType>& v) {
-   MPI_File_set_size(OO_MPI_IO_Base<ItemType>::getFileHandle(), 0); // truncate
+void ParallelTextWriter<ItemType>::writeChunk(const std::vector<ItemType>& v) {
+   OO_MPI_IO_Stats* stats = getStatsRecorder();
+   MPI_File& fh = getFileHandle();
+   timedSetSize(stats, fh, 0);                                // truncate
 
-   long chunkSize = v.size();
-   OO_MPI_IO_Base<ItemType>::setChunkSize(chunkSize);
-   
-   long totalItems;
-   MPI_Allreduce(&chunkSize, &totalItems, 1,   // find total #
-                   MPI_LONG, MPI_SUM, MPI_COMM_WORLD);  //  of Items
+   long numItems = v.size(), totalItems = 0;
+   MPI_Allreduce(&numItems, &totalItems, 1, MPI_LONG, MPI_SUM, 
+                 MPI_COMM_WORLD);
+   std::vector<char> text;
+   long used = 0;
+   if (myCountLineFlag && getID() == 0) {
+      text.resize(OO_MPI_IO_TEXT_MAX_SIZE);
+      used = formatTextItem(text.data(), totalItems, 0);
+      text[used++] = '\n';
+   }
+   for (long i = 0; i < numItems; ++i) {
+      if (used + OO_MPI_IO_TEXT_MAX_SIZE + 1 > (long) text.size()) {
+         text.resize( std::max<long>(2 * text.size(), 
+                                     used + OO_MPI_IO_TEXT_MAX_SIZE + 1) );
+      }
+      used += formatTextItem(&text[used], v[i], myPlaces);
+      text[used++] = '\n';
+   }
 
-   OO_MPI_IO_Base<ItemType>::setNumItemsInFile(totalItems);
-   int itemSize = sizeof(ItemType);
-   long totalBytes = totalItems * itemSize;
-   OO_MPI_IO_Base<ItemType>::setFileSize(totalBytes); 
-   long start = 0, stop = 0;
-   getChunkStartStopValues(OO_MPI_IO_Base<ItemType>::getID(), 
-                           OO_MPI_IO_Base<ItemType>::getNumPEs(),
-                           OO_MPI_IO_Base<ItemType>::getNumItemsInFile(),
-                           start, stop);
+   // place my lines after those of lower-id PEs
+   long before = 0, totalBytes = 0;
+   MPI_Exscan(&used, &before, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   MPI_Allreduce(&used, &totalBytes, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   if (getID() == 0) before = 0;                  // Exscan leaves this
+   setNumItemsInFile(totalBytes);
+   setFileSize(totalBytes);
+   setChunkSize(used);
+   setFirstByteOffset(before);
+   writeBytesAt(fh, before, text.data(), used, stats);
+}
 
-   OO_MPI_IO_Base<ItemType>::setFirstItemOffset(start);
-   OO_MPI_IO_Base<ItemType>::setFirstByteOffset(start * itemSize);
-   MPI_Status status;
-   unsigned long itemsWritten = 0;
-   unsigned long itemsToWrite = OO_MPI_IO_Base<ItemType>::getChunkSize();
-   int writeResult = 0;
-   while (itemsToWrite > INT_MAX) {
-     writeResult = MPI_File_write_at(OO_MPI_IO_Base<ItemType>::getFileHandle(), 
-                   OO_MPI_IO_Base<ItemType>::getFirstByteOffset()+itemsWritten, 
-                    v.data()+itemsWritten,
-                    INT_MAX, 
-                    OO_MPI_IO_Base<ItemType>::getMPIType(), 
-                    &status);
-     checkResult(writeResult);
-     itemsWritten += INT_MAX;
-     itemsToWrite -= INT_MAX;
-   }
-
-   writeResult = MPI_File_write_at(OO_MPI_IO_Base<ItemType>::getFileHandle(), 
-                   OO_MPI_IO_Base<ItemType>::getFirstByteOffset()+itemsWritten, 
-                   v.data()+itemsWritten,
-                   itemsToWrite, 
-                   OO_MPI_IO_Base<ItemType>::getMPIType(), 
-                   &status);
-   checkResult(writeResult);
+/********************************************************************
+ * Counter-based random numbers: Philox4x32-10 (Salmon et al.,
+ *  "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011) maps a
+ *  128-bit counter and a 64-bit key (the seed) to 128 random bits.
+ * The random bits for Item i can thus be computed directly from i,
+ *  by any PE, without generating those for Items 0..i-1, so a data
+ *  set generated in parallel is the same for any number of PEs.
+ ********************************************************************/
+
+class Philox4x32 {
+public:
+  Philox4x32(uint64_t seed = 0);
+  void generate(const uint32_t counter[4], uint32_t out[4]) const;
+  void generateIndex(uint64_t index, uint32_t out[4]) const;
+  double uniform(uint64_t index) const;
+
+  uint64_t getSeed() const  { return ((uint64_t) myKey[1] << 32) | myKey[0]; }
+private:
+  uint32_t myKey[2];                // the seed, as Philox's key
+};
+
+/* Philox4x32 constructor
+ * @param: seed, a uint64_t (default 0).
+ * Postcondition: getSeed() == seed.
+ */
+Philox4x32::Philox4x32(uint64_t seed) {
+   myKey[0] = (uint32_t) seed;
+   myKey[1] = (uint32_t)(seed >> 32);
 }
 
-#endif
+/* method to generate the random bits for a counter
+ * @param: counter, 4 uint32_t values
+ * @param: out, the address of 4 uint32_t values.
+ * Postcondition: out holds the 128 bits that Philox4x32-10 
+ *                 maps counter to (with this generator's key).
+ */
+void Philox4x32::generate(const uint32_t counter[4], uint32_t out[4]) const {
+   uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+   uint32_t k0 = myKey[0], k1 = myKey[1];
+   for (int round = 0; round < 10; ++round) {
+      uint64_t product0 = (uint64_t) 0xD2511F53 * c0;
+      uint64_t product1 = (uint64_t) 0xCD9E8D57 * c2;
+      uint32_t hi0 = product0 >> 32, lo0 = (uint32_t) product0;
+      uint32_t hi1 = product1 >> 32, lo1 = (uint32_t) product1;
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += 0x9E3779B9;                              // the Weyl sequence
+      k1 += 0xBB67AE85;
+   }
+   out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+/* method to generate the random bits for an index (e.g., an Item's)
+ * @param: index, a uint64_t
+ * @param: out, the address of 4 uint32_t values.
+ * Postcondition: out holds the 128 bits for counter {index, 0}.
+ */
+void Philox4x32::generateIndex(uint64_t index, uint32_t out[4]) const {
+   uint32_t counter[4] = { (uint32_t) index, (uint32_t)(index >> 32), 0, 0 };
+   generate(counter, out);
+}
 
+/* method to generate a uniformly-distributed double for an index
+ * @param: index, a uint64_t.
+ * Return: a double in [0, 1), from 53 of index's random bits.
+ */
+double Philox4x32::uniform(uint64_t index) const {
+   uint32_t bits[4];
+   generateIndex(index, bits);
+   uint64_t word = ((uint64_t) bits[1] << 32) | bits[0];
+   return (word >> 11) * (1.0 / 9007199254740992.0);   // 2^-53
+}
+
+#endif
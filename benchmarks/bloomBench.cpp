@@ -0,0 +1,142 @@
+/* bloomBench.cpp measures BloomFilter: the time to build a file's
+ *  filter, the rate at which it tests keys (one at a time, and in
+ *  batches), its false positive rate, and the time it saves a
+ *  batch of mostly-absent keys looked up with SortedLookup.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./bloomBench [<megabytes> [<keysPerPE> [<fileName>]]]
+ *
+ * A <megabytes> MB (default 512) file of sorted longs (by default 
+ *  ./bloomBench.bin) is written, its filter is built, each PE tests
+ *  <keysPerPE> (default 1000000) random keys, 1% of which are present,
+ *  and the file and its filter are deleted.
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelWriter, BloomFilter, ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+#include <random>           // mt19937_64
+using namespace std;
+
+/* time a collective operation on every PE
+ * Return: the slowest PE's time.
+ */
+template <class Operation>
+double timeAll(Operation operation) {
+   MPI_Barrier(MPI_COMM_WORLD);
+   double start = MPI_Wtime();
+   operation();
+   double time = MPI_Wtime() - start, maxTime = 0;
+   MPI_Allreduce(&time, &maxTime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   return maxTime;
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long megabytes = (argc > 1) ? atol(argv[1]) : 512;
+   long numKeys = (argc > 2) ? atol(argv[2]) : 1000000;
+   const char* fileName = (argc > 3) ? argv[3] : "./bloomBench.bin";
+   long numItems = (megabytes << 20) / sizeof(long);
+
+   long start = 0, stop = 0;
+   getChunkStartStopValues(id, numProcs, numItems, start, stop);
+   vector<long> v(stop - start);
+   for (long i = start; i < stop; ++i) {
+      v[i - start] = 2 * i;                          // the even numbers
+   }
+   ParallelWriter<long> writer(fileName, MPI_LONG, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   v.clear();
+   v.shrink_to_fit();
+
+   mt19937_64 generator(id + 1);                     // 1% even (present)
+   vector<long> keys(numKeys);
+   for (long k = 0; k < numKeys; ++k) {
+      keys[k] = 2 * (generator() % numItems) + (k % 100 != 0);
+   }
+
+   double readTime = timeAll([&]() {
+      ParallelReader<long> reader(fileName, MPI_LONG, id, numProcs);
+      vector<long> chunk = reader.readChunk();
+      reader.close();
+   });
+   BloomFilter<long>* filter = NULL;
+   double buildTime = timeAll([&]() {
+      filter = new BloomFilter<long>( 
+                    buildBloomFilter<long>(fileName, MPI_LONG, id, numProcs) );
+   });
+   double loadTime = timeAll([&]() {
+      BloomFilter<long> loaded(fileName, id, numProcs);
+   });
+
+   long oneHits = 0;
+   double oneTime = timeAll([&]() {
+      for (long k = 0; k < numKeys; ++k) {
+         oneHits += filter->mayContain(keys[k]);
+      }
+   });
+   vector<char> answers;
+   double batchTime = timeAll([&]() {
+      answers = filter->mayContain(keys);
+   });
+   long hits = 0, present = 0;
+   for (long k = 0; k < numKeys; ++k) {
+      if (keys[k] % 2 == 0 && !answers[k]) {
+         fprintf(stderr, "PE %d: false negative for %ld\n", id, keys[k]);
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      hits += answers[k];
+      present += (keys[k] % 2 == 0);
+   }
+   if (hits != oneHits) {
+      fprintf(stderr, "PE %d: batch and single probes differ\n", id);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   long myCounts[2] = {hits - present, numKeys - present}, counts[2];
+   MPI_Allreduce(myCounts, counts, 2, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+   // exact answers: look up every key, or just those the filter passes
+   SortedLookup<long> lookup(fileName, MPI_LONG, id, numProcs);
+   vector<long> survivors;
+   double allTime = timeAll([&]() {
+      lookup.find(keys);
+   });
+   double filteredTime = timeAll([&]() {
+      vector<char> passed = filter->mayContain(keys);
+      survivors.clear();
+      for (long k = 0; k < numKeys; ++k) {
+         if (passed[k]) survivors.push_back(keys[k]);
+      }
+      lookup.find(survivors);
+   });
+   lookup.close();
+
+   if (id == 0) {
+      double totalKeys = (double) numKeys * numProcs;
+      printf("\n%ld MB of longs, %ld keys per PE (1%% present), %d PEs:\n",
+              megabytes, numKeys, numProcs);
+      printf("  readChunk():                %8.3f s\n", readTime);
+      printf("  buildBloomFilter():         %8.3f s (%lu KB filter)\n", 
+              buildTime, (unsigned long)(filter->getNumBits() / 8192));
+      printf("  load the filter:            %8.3f s\n", loadTime);
+      printf("  mayContain(key):            %8.2f Mkeys/s\n", 
+              totalKeys / oneTime / 1e6);
+      printf("  mayContain(keys):           %8.2f Mkeys/s\n", 
+              totalKeys / batchTime / 1e6);
+      printf("  false positive rate:        %8.3f %%\n",
+              100.0 * counts[0] / counts[1]);
+      printf("  find(keys):                 %8.3f s\n", allTime);
+      printf("  mayContain(), then find():  %8.3f s\n\n", filteredTime);
+      MPI_File_delete(fileName, MPI_INFO_NULL);
+      MPI_File_delete(getBloomFileName(fileName).c_str(), MPI_INFO_NULL);
+   }
+   delete filter;
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,185 @@
+/* compressBench.cpp measures what OO_MPI_IO's compressed containers
+ * gain over raw binary files: the compression ratio of each codec,
+ * its compression and decompression speeds, and the effective
+ * read bandwidth (uncompressed bytes delivered per second).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./compressBench [<megabytes> [<fileName>]]
+ *
+ * The data is <megabytes> MB (default 256) of int "sensor readings"
+ * (a slow random walk), then as many MB of double "temperatures"
+ * (a slowly varying series). Each is written raw and with each codec
+ * that suits it (by default to ./compressBench.bin), read back, 
+ * and deleted.
+ *
+ * Note: the files just written are likely in the page cache,
+ *  so the measured read speeds are those of memory, not storage.
+ *  The 'modeled' column estimates the effective bandwidth over
+ *  storage that delivers STORAGE_GBS: min(STORAGE_GBS * ratio,
+ *  decompression speed).
+ */
+
+#include "../OO_MPI_IO.h"   // CompressedWriter, CompressedReader, ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+#include <cmath>            // sin(), floor()
+using namespace std;
+
+const double STORAGE_GBS = 1.0;      // storage bandwidth to model (GB/s)
+
+/* time a collective operation on every PE
+ * Return: the slowest PE's time.
+ */
+template <class Operation>
+double timeAll(Operation operation) {
+   MPI_Barrier(MPI_COMM_WORLD);
+   double start = MPI_Wtime();
+   operation();
+   double time = MPI_Wtime() - start, maxTime = 0;
+   MPI_Allreduce(&time, &maxTime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   return maxTime;
+}
+
+/* write and read v raw and with each codec in codecs */
+template <class ItemType>
+void benchCodecs(const char* title, const vector<ItemType>& v,
+                  MPI_Datatype mpiType, const vector<BlockCodec>& codecs,
+                  const char* fileName, int id, int numProcs) {
+   long numItems = 0, myItems = v.size();
+   MPI_Allreduce(&myItems, &numItems, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   double rawBytes = numItems * (double) sizeof(ItemType);
+   if (id == 0) {
+      printf("\n%.0f MB of %s on %d PEs\n", rawBytes / (1 << 20), title,
+              numProcs);
+      printf("  codec          ratio   write GB/s   read GB/s"
+             "   decompress GB/s   modeled GB/s\n");
+   }
+   double rawWrite = timeAll([&]() {
+      ParallelWriter<ItemType> writer(fileName, mpiType, id, numProcs);
+      writer.writeChunk(v);
+      writer.close();
+   });
+   double rawRead = timeAll([&]() {
+      ParallelReader<ItemType> reader(fileName, mpiType, id, numProcs);
+      reader.readChunk();
+      reader.close();
+   });
+   if (id == 0) {
+      printf("  raw            %5.2f   %10.2f   %9.2f   %15s   %12.2f\n",
+              1.0, rawBytes / rawWrite / 1e9, rawBytes / rawRead / 1e9,
+              "-", STORAGE_GBS);
+   }
+
+   const char* names[6] = {"none", "lz", "shuffle+lz", "for+bitpack",
+                           "delta+bitpack", "xor-float"};
+   for (unsigned c = 0; c < codecs.size(); ++c) {
+      long compressedSize = 0;
+      double writeTime = timeAll([&]() {
+         CompressedWriter<ItemType> writer(fileName, mpiType, id, numProcs, 
+                                            codecs[c]);
+         writer.writeChunk(v);
+         writer.close();
+         compressedSize = writer.getCompressedSize();
+      });
+      double readTime = timeAll([&]() {
+         CompressedReader<ItemType> reader(fileName, mpiType, id, numProcs);
+         reader.readChunk();
+         reader.close();
+      });
+
+      // decoding alone, from memory, on PE 0's first blocks
+      if (id == 0) {
+         const long BLOCK_ITEMS = 65536;
+         long blocks = std::max(1L, std::min(64L, (long)v.size() / BLOCK_ITEMS));
+         int itemSize = sizeof(ItemType);
+         vector<unsigned char> packed, scratch;
+         vector<unsigned long> sizes;
+         for (long b = 0; b < blocks; ++b) {
+            const ItemType* block = v.data() + b * BLOCK_ITEMS;
+            unsigned long before = packed.size();
+            if ( !isNumericCodec(codecs[c]) ||
+                  !encodeNumbers(codecs[c], block, BLOCK_ITEMS, packed) ) {
+               compressBlock(isNumericCodec(codecs[c]) ? CODEC_NONE : codecs[c],
+                              (const unsigned char*) block, BLOCK_ITEMS,
+                              itemSize, packed, scratch);
+            }
+            sizes.push_back(packed.size() - before);
+         }
+         vector<ItemType> out(BLOCK_ITEMS);
+         vector<uint64_t> codes;
+         double t0 = MPI_Wtime();
+         unsigned long offset = 0;
+         for (long b = 0; b < blocks; ++b) {
+            if ( isNumericCodec(codecs[c]) && 
+                  sizes[b] != (unsigned long) BLOCK_ITEMS * itemSize ) {
+               decodeNumbers(codecs[c], packed.data() + offset, sizes[b],
+                              out.data(), BLOCK_ITEMS, codes);
+            } else {
+               decompressBlock(codecs[c], packed.data() + offset, sizes[b],
+                                (unsigned char*) out.data(), BLOCK_ITEMS, 
+                                itemSize, scratch);
+            }
+            offset += sizes[b];
+         }
+         double decodeRate = blocks * BLOCK_ITEMS * itemSize 
+                              / (MPI_Wtime() - t0) / 1e9;
+         double ratio = rawBytes / compressedSize;
+         printf("  %-13s  %5.2f   %10.2f   %9.2f   %15.2f   %12.2f\n",
+                 names[codecs[c]], ratio, rawBytes / writeTime / 1e9,
+                 rawBytes / readTime / 1e9, decodeRate,
+                 std::min(STORAGE_GBS * ratio, decodeRate * numProcs));
+      }
+   }
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long megabytes = (argc > 1) ? atol(argv[1]) : 256;
+   const char* fileName = (argc > 2) ? argv[2] : "./compressBench.bin";
+
+   // a slow random walk (each PE continues from a known value)
+   long numInts = (megabytes << 20) / sizeof(int);
+   long start = 0, stop = 0;
+   getChunkStartStopValues(id, numProcs, numInts, start, stop);
+   vector<int> ints(stop - start);
+   uint64_t state = 0x9E3779B97F4A7C15ull * (id + 1);
+   int value = 20000 + id;
+   for (long i = 0; i < stop - start; ++i) {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      int step = (int)(state >> 62);                   // -1, 0, 0 or +1
+      value += (step == 0) ? -1 : (step == 3);
+      ints[i] = value;
+   }
+   benchCodecs("ints", ints, MPI_INT, 
+               {CODEC_NONE, CODEC_LZ, CODEC_SHUFFLE_LZ, 
+                CODEC_FOR_BITPACK, CODEC_DELTA_BITPACK},
+               fileName, id, numProcs);
+   vector<int>().swap(ints);
+
+   // temperatures, recorded to 1/16 of a degree, that change slowly
+   long numDoubles = (megabytes << 20) / sizeof(double);
+   getChunkStartStopValues(id, numProcs, numDoubles, start, stop);
+   vector<double> doubles(stop - start);
+   for (long i = 0; i < stop - start; ++i) {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      double noise = (int)(state >> 61) - 3.5;         // -3.5 .. +3.5
+      doubles[i] = 20.0 + floor(16.0 * (4.0 * sin((start + i) * 1e-4) 
+                                        + noise / 16.0)) / 16.0;
+   }
+   benchCodecs("doubles", doubles, MPI_DOUBLE, 
+               {CODEC_NONE, CODEC_LZ, CODEC_SHUFFLE_LZ, CODEC_XOR_FLOAT},
+               fileName, id, numProcs);
+
+   if (id == 0) {
+      printf("\n(modeled: effective bandwidth over %.1f GB/s storage)\n\n",
+              STORAGE_GBS);
+      MPI_File_delete(fileName, MPI_INFO_NULL);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,106 @@
+/* crcBench.cpp measures the cost of OO_MPI_IO's integrity checking:
+ *  the throughput of the crc32c() kernels (SSE 4.2 vs. slice-by-8),
+ *  and the time readChunk() takes with and without verifyChecksums().
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./crcBench [<megabytes> [<fileName>]]
+ *
+ * The kernels are timed on a <megabytes> MB (default 256) buffer; 
+ * a <megabytes> MB file of doubles (by default ./crcBench.bin) 
+ * is written with checksums, read with and without verification
+ * (the better of 3 tries each), and deleted.
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelReader, ParallelWriter, crc32c(), ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+using namespace std;
+
+const int TRIES = 3;
+
+/* time a collective operation on every PE
+ * Return: the slowest PE's time (the best of TRIES tries).
+ */
+template <class Operation>
+double timeAll(Operation operation) {
+   double best = 1e30;
+   for (int t = 0; t < TRIES; ++t) {
+      MPI_Barrier(MPI_COMM_WORLD);
+      double start = MPI_Wtime();
+      operation();
+      double time = MPI_Wtime() - start, maxTime = 0;
+      MPI_Allreduce(&time, &maxTime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      best = std::min(best, maxTime);
+   }
+   return best;
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long megabytes = (argc > 1) ? atol(argv[1]) : 256;
+   const char* fileName = (argc > 2) ? argv[2] : "./crcBench.bin";
+   long numBytes = megabytes << 20;
+
+   if (id == 0) {
+      vector<unsigned char> buffer(numBytes);
+      for (long i = 0; i < numBytes; ++i) {
+         buffer[i] = (unsigned char)(i * 131 + 7);
+      }
+      uint32_t checks[2] = {0, 0};
+      double start = MPI_Wtime();
+      checks[0] = crc32c(buffer.data(), numBytes);
+      double fastTime = MPI_Wtime() - start;
+      start = MPI_Wtime();
+      checks[1] = crc32cScalar(buffer.data(), numBytes);
+      double scalarTime = MPI_Wtime() - start;
+      printf("\ncrc32c() on %ld MB:\n", megabytes);
+#if defined(__SSE4_2__)
+      printf("  SSE 4.2:     %6.2f GB/s\n", numBytes / fastTime / 1e9);
+#else
+      printf("  (no SSE 4.2: crc32c() is the slice-by-8 version)\n");
+#endif
+      printf("  slice-by-8:  %6.2f GB/s%s\n", numBytes / scalarTime / 1e9,
+              (checks[0] == checks[1]) ? "" : "  (MISMATCH!)");
+   }
+
+   long numItems = numBytes / sizeof(double);
+   long start = 0, stop = 0;
+   getChunkStartStopValues(id, numProcs, numItems, start, stop);
+   vector<double> v(stop - start);
+   for (long i = 0; i < stop - start; ++i) {
+      v[i] = (start + i) * 0.5;
+   }
+   ParallelWriter<double> writer(fileName, MPI_DOUBLE, id, numProcs);
+   writer.enableChecksums();
+   writer.writeChunk(v);
+   writer.close();
+
+   double plainTime = timeAll([&]() {
+      ParallelReader<double> reader(fileName, MPI_DOUBLE, id, numProcs);
+      reader.readChunk();
+      reader.close();
+   });
+   double verifyTime = timeAll([&]() {
+      ParallelReader<double> reader(fileName, MPI_DOUBLE, id, numProcs);
+      reader.verifyChecksums();
+      reader.readChunk();
+      reader.close();
+   });
+   if (id == 0) {
+      printf("\nreadChunk() of %ld MB on %d PEs:\n", megabytes, numProcs);
+      printf("  plain:     %7.3f s (%6.2f GB/s)\n", plainTime, 
+              numBytes / plainTime / 1e9);
+      printf("  verified:  %7.3f s (%6.2f GB/s), %+.1f%%\n\n", verifyTime,
+              numBytes / verifyTime / 1e9, 
+              100.0 * (verifyTime - plainTime) / plainTime);
+      MPI_File_delete(fileName, MPI_INFO_NULL);
+      MPI_File_delete(getCrcFileName(fileName).c_str(), MPI_INFO_NULL);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,448 @@
+/* ioBench.cpp measures the read and write throughput of OO_MPI_IO
+ *  over a grid of parameters: file size (or per-PE chunk size), Item
+ *  type, window size, independent vs. collective MPI-IO and, in
+ *  separate runs, the number of PEs and whether they are MPI processes
+ *  or OpenMP threads.
+ *  Each measurement is repeated, the warm-up runs are discarded, and
+ *  the median (and least and greatest) time of the rest is reported,
+ *  in a table and in a JSON file for comparing runs.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./ioBench [-m <MB,...>] [-c <KB,...>]
+ *                                  [-t <type,...>] [-w <KB,...>]
+ *                                  [-x <threads,...>] [-r <reps>]
+ *                                  [-u <warmups>] [-o <jsonFile>]
+ *                                  [-f <fileName>]
+ *
+ *  -m: the file sizes, in MB (default 64, unless -c is given)
+ *  -c: the chunk sizes, in KB per PE; each file is a chunk per PE
+ *       (so the file grows with the number of PEs)
+ *  -t: the Item types: char, int, long, float or double (default int,double)
+ *  -w: the window sizes, in KB, of the part and block benchmarks
+ *       (default 64,1024)
+ *  -x: instead of using the P processes as PEs, run one process
+ *       (P must be 1) with each of these numbers of OpenMP threads as PEs
+ *  -r: the timed repetitions of each benchmark (default 5)
+ *  -u: the untimed warm-up runs before them (default 1)
+ *  -o: the JSON file (default ./ioBench.json)
+ *  -f: the file to write, read and delete (default ./ioBench.bin)
+ *
+ * The benchmarks (per type and size) are:
+ *  write             ParallelWriter::writeChunk(), run twice: with the
+ *                     file system's profile set (by setProfileFor())
+ *                     to independent and then to collective I/O
+ *  write-parts       ParallelWriter::writePart(), a window at a time
+ *                     (always independent)
+ *  read              ParallelReader::readChunk(), run twice, like write
+ *  read-blocks       EpochReader::nextBlock(), a window-sized block at a
+ *                     time, with prefetching, until the epoch is done.
+ * Each result records the profile its reader or writer actually used
+ *  (getProfile()); the saved profile is restored afterwards.
+ * In OpenMP mode only the reads are run, and only independently (since
+ *  threads do independent I/O): ParallelWriter::beginChunk() sizes and
+ *  places the chunks using MPI reductions, so it needs one PE per
+ *  process.
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelReader, ParallelWriter, ...
+#include <cstdio>           // printf(), fopen()
+#include <cstdlib>          // atol()
+#include <cstring>          // strcmp()
+#include <sstream>          // stringstream
+#include <algorithm>        // sort()
+#ifdef _OPENMP
+#include <omp.h>            // omp_get_thread_num()
+#endif
+using namespace std;
+
+/* One benchmark's times */
+struct Result {
+  string op;                          // e.g. "read-blocks"
+  string mode;                        // "mpi" or "openmp"
+  string type;                        // e.g. "double"
+  int    pes;                         // processes or threads
+  double megabytes;                   // file size
+  long   chunkKB;                     // chunk size per PE
+  long   windowKB;                    // window size (or 0)
+  bool   collective;                  // true iff collective MPI-IO
+  OO_MPI_IO_Profile profile;          // the profile used
+  double median, least, greatest;     // seconds (of the slowest PE)
+  double gbPerSec;                    // file bytes / median / 1e9
+};
+
+/* utility to split a comma-separated list */
+vector<string> splitList(const char* list) {
+   vector<string> items;
+   stringstream in(list);
+   string item;
+   while (getline(in, item, ',')) {
+      if ( !item.empty() ) items.push_back(item);
+   }
+   return items;
+}
+
+/* utility to find the median of some times */
+double median(vector<double> times) {
+   sort(times.begin(), times.end());
+   unsigned long n = times.size();
+   return (n % 2 == 1) ? times[n/2] : (times[n/2 - 1] + times[n/2]) / 2;
+}
+
+/* time an operation that every PE performs
+ * @param: operation, a function of (id, numPEs)
+ * @param: threads, the number of OpenMP threads (or 0, for MPI mode)
+ * @param: reps, the number of timed runs
+ * @param: warmups, the number of untimed runs before them.
+ * Return: the time of each timed run (that of the slowest PE).
+ */
+template <class Operation>
+vector<double> timeAll(Operation operation, int threads, int reps,
+                        int warmups) {
+   int id = 0, numProcs = 1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   vector<double> times;
+   for (int run = 0; run < warmups + reps; ++run) {
+      double time = 0;
+      if (threads == 0) {
+         MPI_Barrier(MPI_COMM_WORLD);
+         double start = MPI_Wtime();
+         operation(id, numProcs);
+         double myTime = MPI_Wtime() - start;
+         MPI_Allreduce(&myTime, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      } else {
+         double start = MPI_Wtime();
+         #pragma omp parallel num_threads(threads)
+         {
+            #ifdef _OPENMP
+            operation(omp_get_thread_num(), omp_get_num_threads());
+            #else
+            operation(0, 1);
+            #endif
+         }
+         time = MPI_Wtime() - start;
+      }
+      if (run >= warmups) times.push_back(time);
+   }
+   return times;
+}
+
+/* utility to summarize a benchmark's times */
+Result summarize(const string& op, const string& type, int threads, int pes,
+                  long fileBytes, long windowKB, 
+                  const OO_MPI_IO_Profile& profile, bool collective,
+                  const vector<double>& times) {
+   Result result;
+   result.op = op;
+   result.mode = (threads == 0) ? "mpi" : "openmp";
+   result.type = type;
+   result.pes = pes;
+   result.megabytes = fileBytes / 1048576.0;
+   result.chunkKB = (fileBytes / pes) >> 10;
+   result.windowKB = windowKB;
+   result.collective = collective;
+   result.profile = profile;
+   result.median = median(times);
+   result.least = *min_element(times.begin(), times.end());
+   result.greatest = *max_element(times.begin(), times.end());
+   result.gbPerSec = fileBytes / result.median / 1e9;
+   return result;
+}
+
+/* run the benchmarks for one type and file size
+ * @param: fileBytes, the file size
+ * @param: threads, the number of OpenMP threads (or 0, for MPI mode)
+ * @param: results, the results so far.
+ * Postcondition: the results of these benchmarks have been appended
+ *            &&  getProfileFor(fileName) is as it was.
+ */
+template <class ItemType>
+void runBenchmarks(const string& fileName, MPI_Datatype mpiType,
+                    const string& type, long fileBytes,
+                    const vector<long>& windowsKB, int threads,
+                    int reps, int warmups, vector<Result>& results) {
+   int id = 0, numProcs = 1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   int pes = (threads == 0) ? numProcs : threads;
+   long numItems = fileBytes / sizeof(ItemType);
+   const OO_MPI_IO_Profile savedProfile = getProfileFor(fileName);
+   OO_MPI_IO_Profile used = savedProfile;    // as PE 0's reader or writer
+   int numModes = (threads == 0) ? 2 : 1;    // independent (, collective)
+
+   if (threads == 0) {
+      long start = 0, stop = 0;
+      getChunkStartStopValues(id, numProcs, numItems, start, stop);
+      vector<ItemType> chunk(stop - start);
+      for (long i = start; i < stop; ++i) {
+         chunk[i - start] = (ItemType)(i % 100);
+      }
+      for (int collective = 0; collective < numModes; ++collective) {
+         OO_MPI_IO_Profile profile = savedProfile;
+         profile.collective = (collective == 1);
+         setProfileFor(fileName, profile);
+         vector<double> times = timeAll([&](int id, int numPEs) {
+            ParallelWriter<ItemType> writer(fileName, mpiType, id, numPEs);
+            writer.writeChunk(chunk);
+            if (id == 0) used = writer.getProfile();
+            writer.close();
+         }, threads, reps, warmups);
+         results.push_back( summarize("write", type, threads, pes,
+                                       fileBytes, 0, used, used.collective,
+                                       times) );
+      }
+      setProfileFor(fileName, savedProfile);
+      for (unsigned long w = 0; w < windowsKB.size(); ++w) {
+         long partItems = (windowsKB[w] << 10) / sizeof(ItemType);
+         vector<ItemType> part(chunk.begin(), chunk.begin() +
+                                 min(partItems, stop - start));
+         vector<ItemType> lastPart(chunk.begin() +
+                                    ((stop - start) / partItems) * partItems,
+                                    chunk.end());
+         vector<double> times = timeAll([&](int id, int numPEs) {
+            ParallelWriter<ItemType> writer(fileName, mpiType, id, numPEs);
+            writer.beginChunk(stop - start);
+            for (long left = stop - start; left > 0; left -= partItems) {
+               writer.writePart( (left >= partItems) ? part : lastPart );
+            }
+            writer.endChunk();
+            if (id == 0) used = writer.getProfile();
+            writer.close();
+         }, threads, reps, warmups);
+         results.push_back( summarize("write-parts", type, threads, pes,
+                                       fileBytes, windowsKB[w], used, false,
+                                       times) );
+      }
+   } else if (id == 0) {                   // (1 writer: see the Note above)
+      vector<ItemType> all(numItems);
+      for (long i = 0; i < numItems; ++i) {
+         all[i] = (ItemType)(i % 100);
+      }
+      ParallelWriter<ItemType> writer(fileName, mpiType, 0, 1);
+      writer.writeChunk(all);
+      writer.close();
+   }
+
+   for (int collective = 0; collective < numModes; ++collective) {
+      OO_MPI_IO_Profile profile = savedProfile;
+      profile.collective = (collective == 1);
+      setProfileFor(fileName, profile);
+      vector<double> times = timeAll([&](int id, int numPEs) {
+         ParallelReader<ItemType> reader(fileName, mpiType, id, numPEs);
+         vector<ItemType> chunk = reader.readChunk();
+         if (id == 0) used = reader.getProfile();
+         reader.close();
+      }, threads, reps, warmups);
+      results.push_back( summarize("read", type, threads, pes, fileBytes, 0,
+                                    used, used.collective && threads == 0,
+                                    times) );
+   }
+   setProfileFor(fileName, savedProfile);
+   for (unsigned long w = 0; w < windowsKB.size(); ++w) {
+      long blockItems = (windowsKB[w] << 10) / sizeof(ItemType);
+      vector<double> times = timeAll([&](int id, int numPEs) {
+         EpochReader<ItemType> reader(fileName, mpiType, id, numPEs,
+                                       blockItems, 1);
+         reader.beginEpoch(0);
+         vector<ItemType> block;
+         while ( reader.nextBlock(block) ) { }
+         if (id == 0) used = reader.getProfile();
+         reader.close();
+      }, threads, reps, warmups);
+      results.push_back( summarize("read-blocks", type, threads, pes,
+                                    fileBytes, windowsKB[w], used, false,
+                                    times) );
+   }
+}
+
+/* run the benchmarks for one type, for each file size and each
+ *  chunk size (and thread count)
+ */
+template <class ItemType>
+void runAll(const string& fileName, MPI_Datatype mpiType, const string& type,
+             const vector<long>& sizes, const vector<long>& chunksKB,
+             const vector<long>& windowsKB, const vector<int>& threadCounts,
+             int reps, int warmups, vector<Result>& results) {
+   int numProcs = 1;
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   for (unsigned long s = 0; s < sizes.size(); ++s) {
+      for (unsigned long t = 0; t < threadCounts.size(); ++t) {
+         runBenchmarks<ItemType>(fileName, mpiType, type, sizes[s] << 20,
+                                  windowsKB, threadCounts[t], reps, warmups,
+                                  results);
+      }
+   }
+   for (unsigned long c = 0; c < chunksKB.size(); ++c) {
+      for (unsigned long t = 0; t < threadCounts.size(); ++t) {
+         int pes = (threadCounts[t] == 0) ? numProcs : threadCounts[t];
+         runBenchmarks<ItemType>(fileName, mpiType, type, 
+                                  (chunksKB[c] << 10) * pes, windowsKB, 
+                                  threadCounts[t], reps, warmups, results);
+      }
+   }
+}
+
+/* write the results as JSON */
+void writeJson(const char* jsonName, const vector<Result>& results,
+                int numProcs, int reps, int warmups) {
+   FILE* out = fopen(jsonName, "w");
+   if (out == NULL) {
+      fprintf(stderr, "\nioBench: cannot write '%s'\n\n", jsonName);
+      return;
+   }
+   fprintf(out, "{\n  \"benchmark\": \"ioBench\",\n  \"processes\": %d,\n"
+                "  \"repetitions\": %d,\n  \"warmups\": %d,\n"
+                "  \"results\": [\n", numProcs, reps, warmups);
+   for (unsigned long r = 0; r < results.size(); ++r) {
+      const Result& result = results[r];
+      const OO_MPI_IO_Profile& profile = result.profile;
+      fprintf(out, "    {\"op\": \"%s\", \"mode\": \"%s\", \"type\": \"%s\", "
+                   "\"pes\": %d, \"megabytes\": %.4f, \"chunkKB\": %ld, "
+                   "\"windowKB\": %ld, \"collective\": %s, "
+                   "\"profile\": {\"collective\": %s, \"aggregators\": %ld, "
+                   "\"bufferBytes\": %ld, \"alignment\": %ld, "
+                   "\"windowBytes\": %ld}, "
+                   "\"median\": %.6f, \"min\": %.6f, "
+                   "\"max\": %.6f, \"gbPerSec\": %.4f}%s\n",
+              result.op.c_str(), result.mode.c_str(), result.type.c_str(),
+              result.pes, result.megabytes, result.chunkKB, result.windowKB,
+              result.collective ? "true" : "false",
+              profile.collective ? "true" : "false", profile.aggregators,
+              profile.bufferBytes, profile.alignment, profile.windowBytes,
+              result.median, result.least, result.greatest, result.gbPerSec,
+              (r + 1 < results.size()) ? "," : "");
+   }
+   fprintf(out, "  ]\n}\n");
+   fclose(out);
+}
+
+int main(int argc, char** argv) {
+   int provided = 0;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+
+   vector<string> types = splitList("int,double");
+   vector<long> sizes, chunksKB, windowsKB;
+   windowsKB.push_back(64);
+   windowsKB.push_back(1024);
+   vector<int> threadCounts(1, 0);
+   int reps = 5, warmups = 1;
+   const char* jsonName = "./ioBench.json";
+   const char* fileName = "./ioBench.bin";
+   bool ok = true;
+   for (int arg = 1; ok && arg < argc; ++arg) {
+      if (arg + 1 >= argc) {
+         ok = false;
+      } else if (strcmp(argv[arg], "-m") == 0) {
+         vector<string> list = splitList(argv[++arg]);
+         sizes.clear();
+         for (unsigned long i = 0; i < list.size(); ++i) {
+            sizes.push_back( atol(list[i].c_str()) );
+            ok = ok && sizes.back() > 0;
+         }
+      } else if (strcmp(argv[arg], "-c") == 0) {
+         vector<string> list = splitList(argv[++arg]);
+         chunksKB.clear();
+         for (unsigned long i = 0; i < list.size(); ++i) {
+            chunksKB.push_back( atol(list[i].c_str()) );
+            ok = ok && chunksKB.back() > 0;
+         }
+      } else if (strcmp(argv[arg], "-t") == 0) {
+         types = splitList(argv[++arg]);
+      } else if (strcmp(argv[arg], "-w") == 0) {
+         vector<string> list = splitList(argv[++arg]);
+         windowsKB.clear();
+         for (unsigned long i = 0; i < list.size(); ++i) {
+            windowsKB.push_back( atol(list[i].c_str()) );
+            ok = ok && windowsKB.back() > 0;
+         }
+      } else if (strcmp(argv[arg], "-x") == 0) {
+         vector<string> list = splitList(argv[++arg]);
+         threadCounts.clear();
+         for (unsigned long i = 0; i < list.size(); ++i) {
+            threadCounts.push_back( atoi(list[i].c_str()) );
+            ok = ok && threadCounts.back() > 0;
+         }
+         ok = ok && numProcs == 1 && provided == MPI_THREAD_MULTIPLE;
+      } else if (strcmp(argv[arg], "-r") == 0) {
+         reps = atoi(argv[++arg]);
+         ok = (reps > 0);
+      } else if (strcmp(argv[arg], "-u") == 0) {
+         warmups = atoi(argv[++arg]);
+         ok = (warmups >= 0);
+      } else if (strcmp(argv[arg], "-o") == 0) {
+         jsonName = argv[++arg];
+      } else if (strcmp(argv[arg], "-f") == 0) {
+         fileName = argv[++arg];
+      } else {
+         ok = false;
+      }
+   }
+   if (!ok) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./ioBench [-m <MB,...>]"
+                         " [-c <KB,...>] [-t <type,...>] [-w <KB,...>]"
+                         "\n        [-x <threads,...>] [-r <reps>]"
+                         " [-u <warmups>] [-o <jsonFile>] [-f <fileName>]"
+                         "\n  (-x needs P = 1 and MPI_THREAD_MULTIPLE)\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   if ( sizes.empty() && chunksKB.empty() ) {
+      sizes.push_back(64);
+   }
+
+   vector<Result> results;
+   for (unsigned long t = 0; t < types.size(); ++t) {
+      const string& type = types[t];
+      if (type == "char") {
+         runAll<char>(fileName, MPI_CHAR, type, sizes, chunksKB,
+                      windowsKB, threadCounts, reps, warmups, results);
+      } else if (type == "int") {
+         runAll<int>(fileName, MPI_INT, type, sizes, chunksKB,
+                     windowsKB, threadCounts, reps, warmups, results);
+      } else if (type == "long") {
+         runAll<long>(fileName, MPI_LONG, type, sizes, chunksKB,
+                      windowsKB, threadCounts, reps, warmups, results);
+      } else if (type == "float") {
+         runAll<float>(fileName, MPI_FLOAT, type, sizes, chunksKB,
+                       windowsKB, threadCounts, reps, warmups, results);
+      } else if (type == "double") {
+         runAll<double>(fileName, MPI_DOUBLE, type, sizes, chunksKB,
+                        windowsKB, threadCounts, reps, warmups, results);
+      } else if (id == 0) {
+         fprintf(stderr, "\nioBench: unknown type '%s' (skipped)\n",
+                  type.c_str());
+      }
+   }
+
+   if (id == 0) {
+      printf("\n%-12s %-7s %-6s %-7s %4s %9s %8s %7s %9s %9s %9s %8s\n",
+              "benchmark", "mode", "I/O", "type", "PEs", "MB", "chunk",
+              "window", "median(s)", "min(s)", "max(s)", "GB/s");
+      for (unsigned long r = 0; r < results.size(); ++r) {
+         const Result& result = results[r];
+         char window[32] = "-";
+         if (result.windowKB > 0) {
+            snprintf(window, sizeof(window), "%ldK", result.windowKB);
+         }
+         printf("%-12s %-7s %-6s %-7s %4d %9.2f %7ldK %7s %9.4f %9.4f %9.4f"
+                " %8.3f\n", result.op.c_str(), result.mode.c_str(),
+                 result.collective ? "coll" : "indep", result.type.c_str(),
+                 result.pes, result.megabytes, result.chunkKB, window,
+                 result.median, result.least, result.greatest,
+                 result.gbPerSec);
+      }
+      writeJson(jsonName, results, numProcs, reps, warmups);
+      printf("\n(medians of %d runs, after %d warm-up runs; JSON in '%s')\n\n",
+              reps, warmups, jsonName);
+      MPI_File_delete(fileName, MPI_INFO_NULL);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,107 @@
+/* lookupBench.cpp measures SortedLookup: the time to build the fence 
+ *  index and to look up a batch of random keys in a sorted file,
+ *  compared with reading every PE's whole chunk (which a lookup 
+ *  without an index has to do).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./lookupBench [<megabytes> [<keysPerPE> [<fileName>]]]
+ *
+ * A <megabytes> MB (default 512) file of sorted longs (by default 
+ *  ./lookupBench.bin) is written, each PE looks up <keysPerPE> 
+ *  (default 100000) random keys, for several fence intervals,
+ *  and the file is deleted.
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelWriter, SortedLookup, ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+#include <random>           // mt19937_64
+using namespace std;
+
+/* time a collective operation on every PE
+ * Return: the slowest PE's time.
+ */
+template <class Operation>
+double timeAll(Operation operation) {
+   MPI_Barrier(MPI_COMM_WORLD);
+   double start = MPI_Wtime();
+   operation();
+   double time = MPI_Wtime() - start, maxTime = 0;
+   MPI_Allreduce(&time, &maxTime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   return maxTime;
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long megabytes = (argc > 1) ? atol(argv[1]) : 512;
+   long numKeys = (argc > 2) ? atol(argv[2]) : 100000;
+   const char* fileName = (argc > 3) ? argv[3] : "./lookupBench.bin";
+   long numItems = (megabytes << 20) / sizeof(long);
+
+   long start = 0, stop = 0;
+   getChunkStartStopValues(id, numProcs, numItems, start, stop);
+   vector<long> v(stop - start);
+   for (long i = start; i < stop; ++i) {
+      v[i - start] = 2 * i;                          // the even numbers
+   }
+   ParallelWriter<long> writer(fileName, MPI_LONG, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   v.clear();
+   v.shrink_to_fit();
+
+   mt19937_64 generator(id + 1);
+   vector<long> keys(numKeys);
+   for (long k = 0; k < numKeys; ++k) {
+      keys[k] = generator() % (2 * numItems);
+   }
+
+   double readTime = timeAll([&]() {
+      ParallelReader<long> reader(fileName, MPI_LONG, id, numProcs);
+      vector<long> chunk = reader.readChunk();
+      reader.close();
+   });
+   if (id == 0) {
+      printf("\n%ld MB of sorted longs, %ld keys per PE, %d PEs:\n",
+              megabytes, numKeys, numProcs);
+      printf("  readChunk() (no index):  %7.3f s\n\n", readTime);
+      printf("  %8s %9s %9s %10s %12s\n", "interval", "fences", 
+              "build(s)", "lookup(s)", "Mkeys/s");
+   }
+   long intervals[3] = {1024, 4096, 16384};
+   for (int k = 0; k < 3; ++k) {
+      SortedLookup<long>* lookup = NULL;
+      double buildTime = timeAll([&]() {
+         lookup = new SortedLookup<long>(fileName, MPI_LONG, id, numProcs,
+                                          intervals[k]);
+      });
+      vector<uint64_t> bounds;
+      double lookupTime = timeAll([&]() {
+         bounds = lookup->lowerBound(keys);
+      });
+      for (long i = 0; i < numKeys; ++i) {
+         if ((long)bounds[i] != (keys[i] + 1) / 2) {
+            fprintf(stderr, "PE %d: wrong lower bound for %ld\n", id, keys[i]);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+         }
+      }
+      if (id == 0) {
+         printf("  %8ld %9lu %9.3f %10.3f %12.2f\n", intervals[k],
+                 (unsigned long) lookup->getFences().size(), buildTime,
+                 lookupTime, numKeys * numProcs / lookupTime / 1e6);
+      }
+      lookup->close();
+      delete lookup;
+   }
+   if (id == 0) {
+      printf("\n");
+      MPI_File_delete(fileName, MPI_INFO_NULL);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,124 @@
+/* swapBench.cpp measures the throughput of OO_MPI_IO's byte-order
+ * conversion: the swapBytes() kernels on their own, and reading
+ * a file in a foreign byte order with ParallelReader.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./swapBench [<megabytes> [<fileName>]]
+ *
+ * The kernels are timed on a buffer of <megabytes> MB (default 256);
+ * a file of that size (default ./swapBench.bin) is written in the
+ * foreign byte order, read back three ways, and then deleted.
+ */
+
+#include "../OO_MPI_IO.h"   // swapBytes(), ParallelReader, ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+using namespace std;
+
+const int REPS = 5;
+
+/* time the fastest of REPS calls of a conversion kernel
+ * Return: the kernel's throughput, in GB/s.
+ */
+double timeKernel(void (*kernel)(void*, unsigned long, int),
+                   vector<unsigned char>& buffer, int itemSize) {
+   double best = 1e30;
+   for (int rep = 0; rep < REPS; ++rep) {
+      double start = MPI_Wtime();
+      kernel(buffer.data(), buffer.size() / itemSize, itemSize);
+      best = min(best, MPI_Wtime() - start);
+   }
+   return buffer.size() / best / 1e9;
+}
+
+/* time the fastest of REPS reads of the file
+ * @param: mode, 0 (no conversion), 1 (windowed conversion),
+ *          or 2 (read, then convert the chunk in a separate pass).
+ * Return: the slowest PE's aggregate read throughput, in GB/s.
+ */
+double timeRead(const char* fileName, int mode, int id, int numProcs) {
+   double best = 1e30;
+   long bytes = 0;
+   for (int rep = 0; rep < REPS; ++rep) {
+      MPI_Barrier(MPI_COMM_WORLD);
+      double start = MPI_Wtime();
+      ParallelReader<double> reader(fileName, MPI_DOUBLE, id, numProcs);
+      if (mode == 1) {
+         reader.setByteOrder(getHostByteOrder() == LITTLE_ENDIAN_ORDER 
+                              ? BIG_ENDIAN_ORDER : LITTLE_ENDIAN_ORDER);
+      }
+      vector<double> v = reader.readChunk();
+      if (mode == 2) {
+         swapBytes(v.data(), v.size(), sizeof(double));
+      }
+      reader.close();
+      double time = MPI_Wtime() - start, maxTime = 0;
+      MPI_Allreduce(&time, &maxTime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      best = min(best, maxTime);
+      bytes = reader.getFileSize();
+   }
+   return bytes / best / 1e9;
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long megabytes = (argc > 1) ? atol(argv[1]) : 256;
+   const char* fileName = (argc > 2) ? argv[2] : "./swapBench.bin";
+   long numBytes = megabytes << 20;
+
+   if (id == 0) {
+#if defined(__AVX2__)
+      const char* simd = "AVX2";
+#elif defined(__SSSE3__)
+      const char* simd = "SSSE3";
+#else
+      const char* simd = "none (scalar only)";
+#endif
+      printf("\nswapBytes() kernels, %ld MB buffer, SIMD: %s\n", 
+              megabytes, simd);
+      printf("  itemSize    scalar GB/s    swapBytes GB/s\n");
+      vector<unsigned char> buffer(numBytes, 1);
+      for (int itemSize = 2; itemSize <= 8; itemSize *= 2) {
+         double scalar = timeKernel(swapBytesScalar, buffer, itemSize);
+         double simdRate = timeKernel(swapBytes, buffer, itemSize);
+         printf("  %8d    %11.2f    %14.2f\n", itemSize, scalar, simdRate);
+      }
+   }
+
+   // write a foreign-order file of doubles
+   long numItems = numBytes / sizeof(double);
+   long start = 0, stop = 0;
+   getChunkStartStopValues(id, numProcs, numItems, start, stop);
+   vector<double> v(stop - start);
+   for (long i = start; i < stop; ++i) {
+      v[i - start] = i * 0.5;
+   }
+   ParallelWriter<double> writer(fileName, MPI_DOUBLE, id, numProcs);
+   writer.setByteOrder(getHostByteOrder() == LITTLE_ENDIAN_ORDER 
+                        ? BIG_ENDIAN_ORDER : LITTLE_ENDIAN_ORDER);
+   double writeStart = MPI_Wtime();
+   writer.writeChunk(v);
+   writer.close();
+   double writeTime = MPI_Wtime() - writeStart;
+
+   double native = timeRead(fileName, 0, id, numProcs);
+   double windowed = timeRead(fileName, 1, id, numProcs);
+   double twoPass = timeRead(fileName, 2, id, numProcs);
+   if (id == 0) {
+      printf("\nreadChunk() of %ld MB of doubles on %d PEs (best of %d)\n",
+              megabytes, numProcs, REPS);
+      printf("  no conversion:          %8.2f GB/s\n", native);
+      printf("  windowed conversion:    %8.2f GB/s\n", windowed);
+      printf("  read, then convert:     %8.2f GB/s\n", twoPass);
+      printf("writeChunk() with conversion: %8.2f GB/s\n\n", 
+              numBytes / writeTime / 1e9);
+      MPI_File_delete(fileName, MPI_INFO_NULL);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,98 @@
+/* binaryToText.cpp converts a binary file of values (such as the .bin
+ *  files written by genChars, genInts and genDoubles) to a text file
+ *  of one value per line, in parallel.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./binaryToText <type> <binaryFile> <textFile>
+ *                                        [<places>] [-c]
+ *
+ *  where <type> is one of char, int, long, float or double,
+ *  <places> (default 15, as genDoubles writes) is the number of digits
+ *   after the point of a float or double (or -1 for as few as will
+ *   read back as the same value),
+ *  and -c means to write the number of values on the first line.
+ *  Each process formats its chunk of values and writes it after the 
+ *  text of the lower-ranked processes, so <textFile> is the same, 
+ *  byte for byte, as a serial conversion would write.
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelReader, ParallelTextWriter
+#include <cstdio>           // printf()
+#include <cstdlib>          // atoi()
+#include <cstring>          // strcmp()
+using namespace std;
+
+/* convert binaryFile to textFile
+ * Return: the number of values converted.
+ */
+template <class ItemType>
+long convert(const char* binaryFile, const char* textFile, int places,
+              bool countLine, MPI_Datatype mpiType, int id, int numProcs) {
+   ParallelReader<ItemType> reader(binaryFile, mpiType, id, numProcs);
+   vector<ItemType> values = reader.readChunk();
+   reader.close();
+
+   ParallelTextWriter<ItemType> writer(textFile, id, numProcs);
+   writer.setPlaces(places);
+   if (countLine) {
+      writer.enableCountLine();
+   }
+   writer.writeChunk(values);
+   writer.close();
+   return reader.getNumItemsInFile();
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   bool countLine = (argc > 4 && strcmp(argv[argc-1], "-c") == 0);
+   int numArgs = argc - (countLine ? 1 : 0);
+   if (numArgs < 4 || numArgs > 5) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./binaryToText"
+                         " <type> <binaryFile> <textFile> [<places>] [-c]\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* type = argv[1];
+   const char* binaryFile = argv[2];
+   const char* textFile = argv[3];
+   int places = (numArgs > 4) ? atoi(argv[4]) : OO_MPI_IO_TEXT_PLACES;
+
+   double start = MPI_Wtime();
+   long count = 0;
+   if (strcmp(type, "char") == 0) {
+      count = convert<char>(binaryFile, textFile, places, countLine,
+                             MPI_CHAR, id, numProcs);
+   } else if (strcmp(type, "int") == 0) {
+      count = convert<int>(binaryFile, textFile, places, countLine,
+                            MPI_INT, id, numProcs);
+   } else if (strcmp(type, "long") == 0) {
+      count = convert<long>(binaryFile, textFile, places, countLine,
+                             MPI_LONG, id, numProcs);
+   } else if (strcmp(type, "float") == 0) {
+      count = convert<float>(binaryFile, textFile, places, countLine,
+                              MPI_FLOAT, id, numProcs);
+   } else if (strcmp(type, "double") == 0) {
+      count = convert<double>(binaryFile, textFile, places, countLine,
+                               MPI_DOUBLE, id, numProcs);
+   } else {
+      if (id == 0) {
+         fprintf(stderr, "\nbinaryToText: unknown type '%s'\n\n", type);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   double time = MPI_Wtime() - start;
+   if (id == 0) {
+      printf("\nConverted %ld values from '%s' to '%s' in %.3f secs\n\n",
+              count, binaryFile, textFile, time);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
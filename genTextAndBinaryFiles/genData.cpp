@@ -0,0 +1,193 @@
+/* genData.cpp generates N pseudo-random values of a chosen type and
+ *  distribution, in parallel, and writes them to a binary file.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./genData <type> <N> <fileName> [-d <distribution>]
+ *                                  [-r <a> <b>] [-s <seed>] [-b <blockItems>]
+ *
+ *  where <type> is one of char, int, long, float or double,
+ *  and the values are written to <fileName>.bin.
+ *  -d: uniform (default), normal or sequence
+ *  -r: uniform: values from a to b (inclusive, for chars, ints and longs;
+ *       default: 'A' to 'Z', 0 to 9, 0 to 9, 0.0 to 1.0, 0.0 to 1.0);
+ *      normal: mean a and standard deviation b (default: 0 and 1,
+ *       rounded and clamped to the type's range for integer types);
+ *      sequence: a, a+b, a+2b, ... (default: 0, 1, 2, ...)
+ *  -s: the seed (default 1)
+ *  -b: the number of values each process generates (and writes)
+ *       at a time (default 1048576), which bounds its memory.
+ *
+ * Value i is computed from i and the seed alone (using the counter-based
+ *  Philox4x32 generator), so the file is the same for any number of
+ *  processes (or OpenMP threads, which share each block's values).
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelWriter, Philox4x32
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol(), atof(), strtoull()
+#include <cstring>          // strcmp()
+#include <cmath>            // sqrt(), log(), cos(), floor(), llround()
+#include <limits>           // numeric_limits
+using namespace std;
+
+enum Distribution { UNIFORM, NORMAL, SEQUENCE };
+
+const double TWO_PI = 6.283185307179586;
+
+/* utility to fit a value to ItemType (rounding and clamping integers) */
+template <class ItemType>
+ItemType toItem(double value) {
+   if ( !std::is_integral<ItemType>::value ) {
+      return (ItemType) value;
+   }
+   double least = (double) numeric_limits<ItemType>::min();
+   double greatest = (double) numeric_limits<ItemType>::max();
+   value = min(max(value, least), greatest);
+   return (value >= greatest) ? numeric_limits<ItemType>::max()
+                              : (ItemType) llround(value);
+}
+
+/* utility to compute value i
+ * Return: value i of the distribution (with parameters a and b).
+ */
+template <class ItemType>
+ItemType makeValue(const Philox4x32& rng, Distribution distribution,
+                    uint64_t i, double a, double b) {
+   if (distribution == SEQUENCE) {
+      return toItem<ItemType>(a + b * (double) i);
+   }
+   uint32_t bits[4];
+   rng.generateIndex(i, bits);
+   uint64_t word0 = ((uint64_t) bits[1] << 32) | bits[0];
+   double u0 = (word0 >> 11) * (1.0 / 9007199254740992.0);    // [0, 1)
+   if (distribution == UNIFORM) {
+      if ( std::is_integral<ItemType>::value ) {
+         return toItem<ItemType>( min(b, a + floor(u0 * (b - a + 1))) );
+      }
+      return (ItemType)(a + u0 * (b - a));
+   }
+   // normal (Box-Muller)
+   uint64_t word1 = ((uint64_t) bits[3] << 32) | bits[2];
+   double u1 = ((word1 >> 11) + 1) * (1.0 / 9007199254740992.0); // (0, 1]
+   double z = sqrt(-2.0 * log(u1)) * cos(TWO_PI * u0);
+   return toItem<ItemType>(a + b * z);
+}
+
+/* generate numItems values and write them to fileName
+ * Return: the number of seconds it took.
+ */
+template <class ItemType>
+double generate(const string& fileName, MPI_Datatype mpiType, long numItems,
+                 Distribution distribution, double a, double b,
+                 uint64_t seed, long blockItems, int id, int numProcs) {
+   double startTime = MPI_Wtime();
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, numItems, start, stop);
+   Philox4x32 rng(seed);
+   ParallelWriter<ItemType> writer(fileName, mpiType, id, numProcs);
+   writer.beginChunk(stop - start);
+   vector<ItemType> block;
+   for (long first = start; first < stop; first += blockItems) {
+      long count = min(blockItems, stop - first);
+      block.resize(count);
+      #pragma omp parallel for
+      for (long k = 0; k < count; ++k) {
+         block[k] = makeValue<ItemType>(rng, distribution, first + k, a, b);
+      }
+      writer.writePart(block);
+   }
+   writer.endChunk();
+   writer.close();
+   return MPI_Wtime() - startTime;
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+
+   Distribution distribution = UNIFORM;
+   bool rangeGiven = false;
+   double a = 0, b = 0;
+   uint64_t seed = 1;
+   long blockItems = 1L << 20;
+   bool ok = (argc >= 4);
+   for (int arg = 4; ok && arg < argc; ++arg) {
+      if (strcmp(argv[arg], "-d") == 0 && arg + 1 < argc) {
+         const char* name = argv[++arg];
+         if (strcmp(name, "uniform") == 0)       distribution = UNIFORM;
+         else if (strcmp(name, "normal") == 0)   distribution = NORMAL;
+         else if (strcmp(name, "sequence") == 0) distribution = SEQUENCE;
+         else ok = false;
+      } else if (strcmp(argv[arg], "-r") == 0 && arg + 2 < argc) {
+         a = atof(argv[++arg]);
+         b = atof(argv[++arg]);
+         rangeGiven = true;
+      } else if (strcmp(argv[arg], "-s") == 0 && arg + 1 < argc) {
+         seed = strtoull(argv[++arg], NULL, 10);
+      } else if (strcmp(argv[arg], "-b") == 0 && arg + 1 < argc) {
+         blockItems = atol(argv[++arg]);
+         ok = (blockItems > 0);
+      } else {
+         ok = false;
+      }
+   }
+   long numItems = ok ? atol(argv[2]) : 0;
+   if ( !ok || numItems < numProcs ) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./genData <type> <N>"
+                         " <fileName> [-d uniform|normal|sequence]"
+                         "\n        [-r <a> <b>] [-s <seed>]"
+                         " [-b <blockItems>]   (with N >= P)\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* type = argv[1];
+   string fileName = string(argv[3]) + ".bin";
+   if (!rangeGiven) {
+      bool isChar = (strcmp(type, "char") == 0);
+      bool isInteger = isChar || strcmp(type, "int") == 0 ||
+                                 strcmp(type, "long") == 0;
+      if (distribution == UNIFORM) {
+         a = isChar ? 'A' : 0;
+         b = isChar ? 'Z' : (isInteger ? 9 : 1);
+      } else {                               // normal or sequence
+         a = 0;
+         b = 1;
+      }
+   }
+
+   double time = 0;
+   if (strcmp(type, "char") == 0) {
+      time = generate<char>(fileName, MPI_CHAR, numItems, distribution,
+                             a, b, seed, blockItems, id, numProcs);
+   } else if (strcmp(type, "int") == 0) {
+      time = generate<int>(fileName, MPI_INT, numItems, distribution,
+                            a, b, seed, blockItems, id, numProcs);
+   } else if (strcmp(type, "long") == 0) {
+      time = generate<long>(fileName, MPI_LONG, numItems, distribution,
+                             a, b, seed, blockItems, id, numProcs);
+   } else if (strcmp(type, "float") == 0) {
+      time = generate<float>(fileName, MPI_FLOAT, numItems, distribution,
+                              a, b, seed, blockItems, id, numProcs);
+   } else if (strcmp(type, "double") == 0) {
+      time = generate<double>(fileName, MPI_DOUBLE, numItems, distribution,
+                               a, b, seed, blockItems, id, numProcs);
+   } else {
+      if (id == 0) {
+         fprintf(stderr, "\ngenData: unknown type '%s'\n\n", type);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   if (id == 0) {
+      printf("\nWrote %ld %s values to '%s' in %.3f secs\n\n",
+              numItems, type, fileName.c_str(), time);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,98 @@
+/* textToBinary.cpp converts a text file of values (one per line,
+ *  such as the .txt files written by genChars, genInts and genDoubles)
+ *  to a binary file, in parallel.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./textToBinary <type> <textFile> <binaryFile> [-c]
+ *
+ *  where <type> is one of char, int, long, float or double,
+ *  and -c means that the first line of <textFile> is the number of values.
+ *  Each process parses an equal share of the text's bytes (moved to
+ *  line boundaries), and writes its values after those of the
+ *  lower-ranked processes, so <binaryFile> is the same as a serial
+ *  conversion would write.
+ */
+
+#include "../OO_MPI_IO.h"   // ParallelTextReader, ParallelWriter
+#include <cstdio>           // printf()
+#include <cstring>          // strcmp()
+using namespace std;
+
+/* convert textFile to binaryFile
+ * Return: the number of values converted.
+ */
+template <class ItemType>
+long convert(const char* textFile, const char* binaryFile, bool countLine,
+              MPI_Datatype mpiType, int id, int numProcs) {
+   ParallelTextReader<ItemType> reader(textFile, id, numProcs);
+   if (countLine) {
+      reader.expectCountLine();
+   }
+   vector<ItemType> values = reader.readChunk();
+   reader.close();
+
+   ParallelWriter<ItemType> writer(binaryFile, mpiType, id, numProcs);
+   writer.writeChunk(values);
+   writer.close();
+   if (countLine && writer.getNumItemsInFile() != reader.getDeclaredCount()) {
+      if (id == 0) {
+         fprintf(stderr, "\ntextToBinary: '%s' declares %ld values,"
+                         " but holds %ld\n\n", textFile,
+                         reader.getDeclaredCount(), writer.getNumItemsInFile());
+      }
+   }
+   return writer.getNumItemsInFile();
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   bool countLine = (argc == 5 && strcmp(argv[4], "-c") == 0);
+   if (argc != 4 && !countLine) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./textToBinary"
+                         " <type> <textFile> <binaryFile> [-c]\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* type = argv[1];
+   const char* textFile = argv[2];
+   const char* binaryFile = argv[3];
+
+   double start = MPI_Wtime();
+   long count = 0;
+   if (strcmp(type, "char") == 0) {
+      count = convert<char>(textFile, binaryFile, countLine, MPI_CHAR,
+                             id, numProcs);
+   } else if (strcmp(type, "int") == 0) {
+      count = convert<int>(textFile, binaryFile, countLine, MPI_INT,
+                            id, numProcs);
+   } else if (strcmp(type, "long") == 0) {
+      count = convert<long>(textFile, binaryFile, countLine, MPI_LONG,
+                             id, numProcs);
+   } else if (strcmp(type, "float") == 0) {
+      count = convert<float>(textFile, binaryFile, countLine, MPI_FLOAT,
+                              id, numProcs);
+   } else if (strcmp(type, "double") == 0) {
+      count = convert<double>(textFile, binaryFile, countLine, MPI_DOUBLE,
+                               id, numProcs);
+   } else {
+      if (id == 0) {
+         fprintf(stderr, "\ntextToBinary: unknown type '%s'\n\n", type);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   double time = MPI_Wtime() - start;
+   if (id == 0) {
+      printf("\nConverted %ld values from '%s' to '%s' in %.3f secs\n\n",
+              count, textFile, binaryFile, time);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,145 @@
+/* ArrayReaderTester.h declares the class that tests ParallelArrayReader
+ *   by treating files/12ints.bin as a 3x4 array of ints.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <fstream>                 // ifstream, ofstream, fstream
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelArrayReader
+using namespace std;
+
+class ArrayReaderTester {
+public:
+  ArrayReaderTester();
+  void runTests();
+  void runTileTests(const ParallelArrayReader<int>& reader);
+  void runReadTests(ParallelArrayReader<int>& reader);
+  void runGhostTests(ParallelArrayReader<int>& reader);
+private:
+   const int MASTER = 0;
+   const int ROWS = 3;
+   const int COLS = 4;
+   int id;
+   int numProcs;
+   vector<int> grid;
+   vector<int> expected;           // the 3x4 array, from 12ints.txt
+};
+
+ArrayReaderTester::ArrayReaderTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+
+   // decompose 3x4 as 1x1 (P=1), 1x2 (P=2), 3x1 (P=3)
+   switch (numProcs) {
+     case 1:  grid = {1, 1}; break;
+     case 2:  grid = {1, 2}; break;
+     case 3:  grid = {3, 1}; break;
+     default: cerr << "\n*** ArrayReaderTester: run with 1-3 PEs\n\n";
+              MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   ifstream fin("files/12ints.txt");
+   assert( fin.is_open() );
+   int iVal;
+   for (int i = 0; i < ROWS*COLS; ++i) {
+      fin >> iVal;
+      expected.push_back(iVal);
+   }
+   fin.close();
+}
+
+void ArrayReaderTester::runTests() {
+   if (id == MASTER) cout << "\nTesting ParallelArrayReader using ints...\n"
+                          << flush;
+
+   ParallelArrayReader<int>
+     reader("./files/12ints.bin", MPI_INT, id, numProcs, {3, 4}, grid);
+   runTileTests(reader);
+   runReadTests(reader);
+
+   ParallelArrayReader<int>
+     reader1("./files/12ints.bin", MPI_INT, id, numProcs, {3, 4}, grid, 1);
+   runGhostTests(reader1);
+
+   if (id == MASTER) cout << "All array tests passed!\n" << endl;
+}
+
+void ArrayReaderTester::
+runTileTests(const ParallelArrayReader<int>& reader) {
+   if (id == MASTER) cout << "- Running tile-related tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   assert( reader.getNumDims() == 2 );
+   assert( reader.getNumItemsInFile() == 12 );
+   assert( reader.getGhostWidth() == 0 );
+   switch (numProcs) {
+     case 1:
+           assert( reader.getLocalShape() == vector<long>({3, 4}) );
+           assert( reader.getLocalStart() == vector<long>({0, 0}) );
+           break;
+     case 2:
+           assert( reader.getLocalShape() == vector<long>({3, 2}) );
+           assert( reader.getLocalStart() == vector<long>({0, 2*id}) );
+           assert( reader.getFirstItemOffset() == 2*id );
+           break;
+     case 3:
+           assert( reader.getLocalShape() == vector<long>({1, 4}) );
+           assert( reader.getLocalStart() == vector<long>({id, 0}) );
+           assert( reader.getFirstItemOffset() == 4*id );
+           assert( reader.getFirstByteOffset() == 16*id );
+           break;
+   }
+   assert( reader.getBlockShape() == reader.getLocalShape() );
+   assert( reader.getChunkSize() == 12 / numProcs );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void ArrayReaderTester::
+runReadTests(ParallelArrayReader<int>& reader) {
+   if (id == MASTER) cout << "- Running readBlock() tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   vector<int> v = reader.readBlock();
+   assert( (long)v.size() == reader.getBlockSize() );
+   long rows = reader.getLocalShape()[0], cols = reader.getLocalShape()[1];
+   long r0 = reader.getLocalStart()[0], c0 = reader.getLocalStart()[1];
+   for (long r = 0; r < rows; ++r) {
+      for (long c = 0; c < cols; ++c) {
+         assert( v[r*cols + c] == expected[(r0+r)*COLS + (c0+c)] );
+      }
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void ArrayReaderTester::
+runGhostTests(ParallelArrayReader<int>& reader) {
+   if (id == MASTER) cout << "- Running ghost-layer tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   vector<int> v = reader.readBlock();
+   long rows = reader.getBlockShape()[0], cols = reader.getBlockShape()[1];
+   assert( rows == reader.getLocalShape()[0] + 2 );
+   assert( cols == reader.getLocalShape()[1] + 2 );
+   long r0 = reader.getLocalStart()[0] - 1, c0 = reader.getLocalStart()[1] - 1;
+   for (long r = 0; r < rows; ++r) {
+      for (long c = 0; c < cols; ++c) {
+         long gr = r0 + r, gc = c0 + c;
+         if (gr < 0 || gr >= ROWS || gc < 0 || gc >= COLS) {
+            assert( v[r*cols + c] == 0 );      // outside the array
+         } else {
+            assert( v[r*cols + c] == expected[gr*COLS + gc] );
+         }
+      }
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
@@ -0,0 +1,86 @@
+/* ArrayWriterTester.h declares the class that tests ParallelArrayWriter
+ *   by writing a 4x6 array of doubles, one tile per PE.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelArrayWriter, ParallelReader
+using namespace std;
+
+class ArrayWriterTester {
+public:
+  ArrayWriterTester();
+  void runTests();
+  void runWriteTests(ParallelArrayWriter<double>& writer);
+private:
+   const int MASTER = 0;
+   const int ROWS = 4;
+   const int COLS = 6;
+   int id;
+   int numProcs;
+   vector<int> grid;
+};
+
+ArrayWriterTester::ArrayWriterTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+
+   // decompose 4x6 as 1x1 (P=1), 2x1 (P=2), 1x3 (P=3), 2x2 (P=4)
+   switch (numProcs) {
+     case 1:  grid = {1, 1}; break;
+     case 2:  grid = {2, 1}; break;
+     case 3:  grid = {1, 3}; break;
+     case 4:  grid = {2, 2}; break;
+     default: cerr << "\n*** ArrayWriterTester: run with 1-4 PEs\n\n";
+              MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+}
+
+void ArrayWriterTester::runTests() {
+   if (id == MASTER) cout << "\nTesting ParallelArrayWriter using doubles...\n"
+                          << flush;
+
+   ParallelArrayWriter<double>
+     writer("./files/4x6doubles.bin", MPI_DOUBLE, id, numProcs,
+             {ROWS, COLS}, grid, 1);
+   runWriteTests(writer);
+
+   if (id == MASTER) cout << "All array tests passed!\n" << endl;
+}
+
+void ArrayWriterTester::
+runWriteTests(ParallelArrayWriter<double>& writer) {
+   if (id == MASTER) cout << "- Running writeBlock() tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // fill the interior with r.c and the ghost layers with -1
+   vector<double> v( writer.getBlockSize(), -1.0 );
+   long rows = writer.getLocalShape()[0], cols = writer.getLocalShape()[1];
+   long r0 = writer.getLocalStart()[0], c0 = writer.getLocalStart()[1];
+   long blockCols = writer.getBlockShape()[1];
+   for (long r = 0; r < rows; ++r) {
+      for (long c = 0; c < cols; ++c) {
+         v[(r+1)*blockCols + (c+1)] = (r0+r) + (c0+c) / 10.0;
+      }
+   }
+   writer.writeBlock(v);
+   writer.close();
+   assert( writer.getFileSize() == ROWS * COLS * 8 );
+
+   ParallelReader<double> pReader( writer.getFileName(),
+                                    MPI_DOUBLE, id, numProcs );
+   vector<double> v2 = pReader.readChunk();
+   pReader.close();
+   for (unsigned i = 0; i < v2.size(); ++i) {
+      long item = pReader.getFirstItemOffset() + i;
+      assert( v2[i] == (item / COLS) + (item % COLS) / 10.0 );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete("./files/4x6doubles.bin", MPI_INFO_NULL);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
@@ -0,0 +1,210 @@
+/* BloomFilterTester.h declares the class that tests Bloom filters
+ *   (BloomFilter and buildBloomFilter()).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cstdio>                  // fopen()
+#include "../OO_MPI_IO.h"          // ParallelWriter, BloomFilter, ...
+using namespace std;
+
+class BloomFilterTester {
+public:
+  BloomFilterTester();
+  void runTests();
+  void runFilterTests();
+  void runBuildTests();
+  void runForeignBuildTests();
+
+private:
+   bool sidecarExists() const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/bloomFilter.bin";
+   int id;
+   int numProcs;
+};
+
+BloomFilterTester::BloomFilterTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void BloomFilterTester::runTests() {
+   if (id == MASTER) cout << "\nTesting Bloom filters...\n" << flush;
+
+   runFilterTests();
+   runBuildTests();
+   runForeignBuildTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(getBloomFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      cout << "All Bloom filter tests passed!\n" << endl;
+   }
+}
+
+bool BloomFilterTester::sidecarExists() const {
+   FILE* f = fopen(getBloomFileName(FILE_NAME).c_str(), "rb");
+   if (f != NULL) fclose(f);
+   return f != NULL;
+}
+
+void BloomFilterTester::runFilterTests() {
+   if (id == MASTER) cout << "- Running in-memory filter tests..." << flush;
+
+   // keys 0, 3, 6, ...: no false negatives, and few false positives
+   const long NUM_KEYS = 20000;
+   BloomFilter<long> filter(NUM_KEYS);
+   assert( filter.getNumBlocks() == (NUM_KEYS * 10 + 511) / 512 );
+   assert( filter.getNumKeys() == 0 );
+   vector<long> keys, others;
+   for (long i = 0; i < NUM_KEYS; ++i) {
+      keys.push_back(3 * i);
+      others.push_back(3 * i + 1);
+   }
+   filter.insert(keys);
+   assert( filter.getNumKeys() == NUM_KEYS );
+   vector<char> answers = filter.mayContain(keys);
+   assert( answers.size() == keys.size() );
+   for (unsigned long i = 0; i < keys.size(); ++i) {
+      assert( answers[i] == 1 && filter.mayContain(keys[i]) );
+   }
+   answers = filter.mayContain(others);
+   long falsePositives = 0;
+   for (unsigned long i = 0; i < others.size(); ++i) {
+      assert( answers[i] == filter.mayContain(others[i]) );
+      falsePositives += answers[i];
+   }
+   assert( falsePositives < NUM_KEYS / 50 );          // under 2%
+   assert( filter.mayContain(vector<long>()).empty() );
+
+   // 0.0 and -0.0 are the same key; an empty filter holds nothing
+   BloomFilter<double> doubles(1);
+   assert( doubles.getNumBlocks() == 1 );
+   assert( !doubles.mayContain(0.0) && !doubles.mayContain(1.5) );
+   doubles.insert({-0.0, 1.5});
+   assert( doubles.mayContain(0.0) && doubles.mayContain(1.5) );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void BloomFilterTester::runBuildTests() {
+   if (id == MASTER) cout << "- Running buildBloomFilter() tests..." << flush;
+
+   const long SIZE = 5000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i * 7);
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // every PE's filter holds every PE's keys
+   BloomFilter<int> built = buildBloomFilter<int>(FILE_NAME, MPI_INT, 
+                                                   id, numProcs, 16);
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( sidecarExists() );
+   assert( (long)built.getNumKeys() == SIZE );
+   assert( (long)built.getNumBlocks() == (SIZE * 16 + 511) / 512 );
+   vector<int> all, absent;
+   for (long i = 0; i < SIZE; ++i) {
+      all.push_back(i * 7);
+      absent.push_back(i * 7 + 3);
+   }
+   vector<char> answers = built.mayContain(all);
+   for (unsigned long i = 0; i < all.size(); ++i) {
+      assert( answers[i] == 1 );
+   }
+
+   // the saved filter is the same filter
+   BloomFilter<int> loaded(FILE_NAME, id, numProcs);
+   assert( loaded.getNumKeys() == built.getNumKeys() );
+   assert( loaded.getWords() == built.getWords() );
+   assert( loaded.mayContain(absent) == built.mayContain(absent) );
+   // process 0 saved and loaded the sidecar, and counted doing so
+   if (OO_MPI_IO_STATS_ENABLED && id == MASTER) {
+      uint64_t bytes = sizeof(OO_MPI_IO_BloomPrologue) + built.getNumBlocks() * 64;
+      const OO_MPI_IO_Stats& saved = built.getStats();
+      assert( saved.ops[OPEN_OP].calls == 1 && saved.ops[CLOSE_OP].calls == 1 );
+      assert( saved.ops[TRUNCATE_OP].calls == 1 );
+      assert( saved.ops[WRITE_OP].bytes == bytes );
+      const OO_MPI_IO_Stats& read = loaded.getStats();
+      assert( read.ops[OPEN_OP].calls == 1 && read.ops[CLOSE_OP].calls == 1 );
+      assert( read.ops[READ_OP].bytes == bytes );
+      assert( read.ops[WRITE_OP].calls == 0 );
+   }
+   loaded.resetStats();
+   assert( loaded.getStats().ops[READ_OP].calls == 0 );
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // a writer removes the (stale) filter
+   ParallelWriter<int> plainWriter(FILE_NAME, MPI_INT, id, numProcs);
+   plainWriter.writeChunk(v);
+   plainWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !sidecarExists() );
+
+   // and so do array and tile writes
+   buildBloomFilter<int>(FILE_NAME, MPI_INT, id, numProcs);
+   MPI_Barrier(MPI_COMM_WORLD);
+   ParallelArrayWriter<int> arrayWriter(FILE_NAME, MPI_INT, id, numProcs,
+                                        {SIZE}, {numProcs});
+   arrayWriter.writeBlock( vector<int>(arrayWriter.getBlockSize(), 1) );
+   arrayWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !sidecarExists() );
+   buildBloomFilter<int>(FILE_NAME, MPI_INT, id, numProcs);
+   MPI_Barrier(MPI_COMM_WORLD);
+   TiledArray<int> matrix(FILE_NAME, MPI_INT, id, numProcs, 1, SIZE, 1, 64, 1);
+   if (id == MASTER) {
+      matrix.set(0, 0, 2);
+   }
+   matrix.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !sidecarExists() );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* keys are hashed by value, so a file's byte order does not matter */
+void BloomFilterTester::runForeignBuildTests() {
+   if (id == MASTER) cout << "- Running converted build tests..." << flush;
+
+   const long SIZE = 3000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i * 0.5 - 100.0);
+   }
+   ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   writer.setByteOrder(BIG_ENDIAN_ORDER);
+   writer.enableHeader();
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   buildBloomFilter<double>(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   MPI_Barrier(MPI_COMM_WORLD);
+   BloomFilter<double> filter(FILE_NAME, id, numProcs);
+   assert( (long)filter.getNumKeys() == SIZE );
+   vector<char> answers = filter.mayContain(v);
+   for (unsigned long i = 0; i < v.size(); ++i) {
+      assert( answers[i] == 1 );
+   }
+   assert( filter.mayContain(-100.0) && filter.mayContain(-0.0) );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
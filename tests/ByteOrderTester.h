@@ -0,0 +1,186 @@
+/* ByteOrderTester.h declares the class that tests byte-order
+ *   conversion (swapBytes() and setByteOrder()) using int values.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelWriter, ParallelReader, ...
+using namespace std;
+
+class ByteOrderTester {
+public:
+  ByteOrderTester();
+  void runTests();
+  void runSwapBytesTests();
+  void runConversionTests();
+  void runHeaderConversionTests();
+
+private:
+   ByteOrder getForeignOrder() const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/byteOrder.bin";
+   int id;
+   int numProcs;
+};
+
+ByteOrderTester::ByteOrderTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void ByteOrderTester::runTests() {
+   if (id == MASTER) cout << "\nTesting byte-order conversion using ints...\n"
+                          << flush;
+
+   runSwapBytesTests();
+   runConversionTests();
+   runHeaderConversionTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+   if (id == MASTER) cout << "All byte-order tests passed!\n" << endl;
+}
+
+/* the byte order that is not this host's */
+ByteOrder ByteOrderTester::getForeignOrder() const {
+   return (getHostByteOrder() == LITTLE_ENDIAN_ORDER) ? BIG_ENDIAN_ORDER
+                                                      : LITTLE_ENDIAN_ORDER;
+}
+
+void ByteOrderTester::runSwapBytesTests() {
+   if (id == MASTER) cout << "- Running swapBytes() tests..." << flush;
+
+   uint16_t s = 0x0102;
+   swapBytes(&s, 1, 2);
+   assert( s == 0x0201 );
+   uint32_t i = 0x01020304;
+   swapBytes(&i, 1, 4);
+   assert( i == 0x04030201 );
+   uint64_t l = 0x0102030405060708ull;
+   swapBytes(&l, 1, 8);
+   assert( l == 0x0807060504030201ull );
+
+   // the vector paths (and their scalar tails) agree with the scalar loop
+   for (int itemSize = 2; itemSize <= 8; itemSize *= 2) {
+      const int COUNT = 67;
+      vector<unsigned char> bytes(COUNT * itemSize), expected;
+      for (unsigned j = 0; j < bytes.size(); ++j) {
+         bytes[j] = (unsigned char)(j * 7 + 3);
+      }
+      expected = bytes;
+      swapBytesScalar(expected.data(), COUNT, itemSize);
+      swapBytes(bytes.data(), COUNT, itemSize);
+      assert( bytes == expected );
+      swapBytes(bytes.data(), COUNT, itemSize);        // an involution
+      swapBytesScalar(expected.data(), COUNT, itemSize);
+      assert( bytes == expected );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void ByteOrderTester::runConversionTests() {
+   if (id == MASTER) cout << "- Running conversion tests..." << flush;
+
+   // give each PE several conversion windows, plus a partial one
+   const long SIZE = numProcs * (OO_MPI_IO_SWAP_WINDOW / 4 * 2 + 7);
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long j = start; j < stop; ++j) {
+      v.push_back(j + 1);
+   }
+
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.setByteOrder(BIG_ENDIAN_ORDER);
+   assert( writer.getByteOrder() == BIG_ENDIAN_ORDER );
+   assert( writer.needsByteSwap() == (getHostByteOrder() != BIG_ENDIAN_ORDER) );
+   writer.writeChunk(v);
+   assert( v[0] == start + 1 );                     // caller's data unchanged
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // Items really are big-endian in the file
+   ParallelReader<int> rawReader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( !rawReader.needsByteSwap() );
+   vector<int> raw = rawReader.readChunk();
+   rawReader.close();
+   unsigned char firstBytes[4];
+   memcpy(firstBytes, raw.data(), 4);
+   long first = start + 1;
+   assert( firstBytes[0] == ((first >> 24) & 0xFF) );
+   assert( firstBytes[3] == (first & 0xFF) );
+
+   // external32 is big-endian for ints, so either name reads them back
+   ByteOrder orders[2] = {BIG_ENDIAN_ORDER, EXTERNAL32_ORDER};
+   for (int k = 0; k < 2; ++k) {
+      ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+      reader.setByteOrder(orders[k]);
+      vector<int> v2 = reader.readChunk();
+      assert( v2 == v );
+      vector<int> items = reader.readItems({(uint64_t)SIZE-1, 0});
+      assert( items[0] == SIZE && items[1] == 1 );
+      reader.close();
+   }
+
+   // setting the host's own order means no conversion
+   ParallelReader<int> nativeReader(FILE_NAME, MPI_INT, id, numProcs);
+   nativeReader.setByteOrder(getHostByteOrder());
+   assert( !nativeReader.needsByteSwap() );
+   nativeReader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void ByteOrderTester::runHeaderConversionTests() {
+   if (id == MASTER) cout << "- Running header conversion tests..." << flush;
+
+   const long SIZE = 24;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long j = start; j < stop; ++j) {
+      v.push_back(-j);
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.setByteOrder( getForeignOrder() );
+   writer.enableHeader({4, 6}, "foreign");
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // the reader notices the reversed byte-order mark by itself
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( reader.hasHeader() );
+   assert( reader.needsByteSwap() );
+   assert( reader.getByteOrder() == getForeignOrder() );
+   assert( reader.getNumItemsInFile() == SIZE );
+   vector<uint64_t> dims = reader.getDims();
+   assert( dims.size() == 2 && dims[0] == 4 && dims[1] == 6 );
+   assert( reader.getUserData() == "foreign" );
+   vector<int> v2 = reader.readChunk();
+   assert( v2 == v );
+   reader.close();
+
+   // as do the other readers
+   EpochReader<int> epochReader(FILE_NAME, MPI_INT, id, numProcs, 5, 17);
+   assert( epochReader.needsByteSwap() );
+   epochReader.beginEpoch(0);
+   vector<int> block;
+   while ( epochReader.nextBlock(block) ) {
+      long first = epochReader.getCurrentBlock() * 5;
+      for (unsigned j = 0; j < block.size(); ++j) {
+         assert( block[j] == -(first + j) );
+      }
+   }
+   epochReader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,254 @@
+/* ChecksumTester.h declares the class that tests CRC32C checksums
+ *   (crc32c(), ParallelWriter::enableChecksums() and
+ *    ParallelReader::verifyChecksums()) using int values.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cstdio>                  // fopen()
+#include "../OO_MPI_IO.h"          // ParallelWriter, ParallelReader, ...
+using namespace std;
+
+class ChecksumTester {
+public:
+  ChecksumTester();
+  void runTests();
+  void runCrcTests();
+  void runVerifyTests();
+  void runConversionVerifyTests();
+  void runCorruptionTests();
+
+private:
+   vector<int> writeInts(long size, long blockBytes,
+                         ByteOrder order = NATIVE_ORDER);
+   bool sidecarExists() const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/checksum.bin";
+   int id;
+   int numProcs;
+};
+
+ChecksumTester::ChecksumTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void ChecksumTester::runTests() {
+   if (id == MASTER) cout << "\nTesting CRC32C checksums using ints...\n"
+                          << flush;
+
+   runCrcTests();
+   runVerifyTests();
+   runConversionVerifyTests();
+   runCorruptionTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(getCrcFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      cout << "All checksum tests passed!\n" << endl;
+   }
+}
+
+/* write Items 0, 1, ..., size-1 with checksums of blockBytes bytes
+ * Return: this PE's chunk.
+ */
+vector<int> ChecksumTester::writeInts(long size, long blockBytes,
+                                      ByteOrder order) {
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, size, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i);
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.setByteOrder(order);
+   writer.enableChecksums(blockBytes);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   return v;
+}
+
+bool ChecksumTester::sidecarExists() const {
+   FILE* f = fopen(getCrcFileName(FILE_NAME).c_str(), "rb");
+   if (f != NULL) fclose(f);
+   return f != NULL;
+}
+
+void ChecksumTester::runCrcTests() {
+   if (id == MASTER) cout << "- Running crc32c() tests..." << flush;
+
+   const char* check = "123456789";                   // the standard check
+   assert( crc32c(check, 9) == 0xE3069283 );
+   assert( crc32cScalar(check, 9) == 0xE3069283 );
+   assert( crc32c(check, 0) == 0 );
+
+   // both versions agree, at every alignment and length
+   vector<unsigned char> bytes(1000);
+   for (unsigned i = 0; i < bytes.size(); ++i) {
+      bytes[i] = (unsigned char)(i * 31 + 7);
+   }
+   for (int offset = 0; offset < 8; ++offset) {
+      for (unsigned long length = 0; length < 40; ++length) {
+         assert( crc32c(bytes.data() + offset, length) ==
+                 crc32cScalar(bytes.data() + offset, length) );
+      }
+   }
+   // checksums can be continued and combined
+   uint32_t whole = crc32c(bytes.data(), bytes.size());
+   uint32_t first = crc32c(bytes.data(), 333);
+   uint32_t rest = crc32c(bytes.data() + 333, bytes.size() - 333);
+   assert( crc32c(bytes.data() + 333, bytes.size() - 333, first) == whole );
+   assert( crc32cCombine(first, rest, bytes.size() - 333) == whole );
+   assert( crc32cCombine(0, whole, bytes.size()) == whole );
+   assert( crc32cCombine(whole, 0, 0) == whole );
+
+   // the accumulator splits a range at block boundaries
+   OO_MPI_IO_CrcAccumulator crcs;
+   crcs.begin(250, 100);                          // bytes 250..549
+   crcs.add(bytes.data(), 120);
+   crcs.add(bytes.data() + 120, 180);
+   crcs.finish();
+   assert( crcs.getNumPieces() == 4 );
+   assert( crcs.getBlock(0) == 2 && crcs.getLength(0) == 50 );
+   assert( crcs.getBlock(1) == 3 && crcs.getLength(1) == 100 );
+   assert( crcs.getBlock(3) == 5 && crcs.getLength(3) == 50 );
+   assert( crcs.getCrc(1) == crc32c(bytes.data() + 50, 100) );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void ChecksumTester::runVerifyTests() {
+   if (id == MASTER) cout << "- Running verification tests..." << flush;
+
+   // blocks that do not align with Items or chunks
+   const long SIZE = 1000 + numProcs;
+   vector<int> v = writeInts(SIZE, 1001);
+   assert( sidecarExists() );
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( !reader.isVerifying() );
+   reader.verifyChecksums();
+   assert( reader.isVerifying() );
+   assert( reader.readChunk() == v );
+   vector<int> plus = reader.readChunkPlus(5);
+   assert( plus.size() == v.size() + (id < numProcs-1 ? 5 : 0) );
+   assert( reader.getCorruptBlocks().empty() );
+   reader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // several read windows per PE, with the default block size
+   const long BIG_SIZE = numProcs * (OO_MPI_IO_SWAP_WINDOW / 4 + 1001);
+   vector<int> big = writeInts(BIG_SIZE, OO_MPI_IO_CRC_BLOCK_SIZE);
+   ParallelReader<int> bigReader(FILE_NAME, MPI_INT, id, numProcs);
+   bigReader.verifyChecksums();
+   assert( bigReader.readChunk() == big );
+   bigReader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // a writer without checksums removes the (stale) sidecar
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !sidecarExists() );
+
+   // and so do array and tile writes
+   writeInts(SIZE, 1001);
+   ParallelArrayWriter<int> arrayWriter(FILE_NAME, MPI_INT, id, numProcs,
+                                        {SIZE}, {numProcs});
+   arrayWriter.writeBlock( vector<int>(arrayWriter.getBlockSize(), 1) );
+   arrayWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !sidecarExists() );
+   writeInts(SIZE, 1001);
+   TiledArray<int> matrix(FILE_NAME, MPI_INT, id, numProcs, 1, SIZE, 1, 64, 1);
+   if (id == MASTER) {
+      matrix.set(0, 0, 2);
+   }
+   matrix.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !sidecarExists() );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* checksums cover the bytes as stored, in any byte order, with a header */
+void ChecksumTester::runConversionVerifyTests() {
+   if (id == MASTER) cout << "- Running conversion verification tests..."
+                          << flush;
+
+   const long SIZE = 777;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int32_t> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(-i);
+   }
+   ParallelWriter<int64_t, int32_t> writer(FILE_NAME, MPI_INT64_T,
+                                            id, numProcs);
+   writer.setByteOrder(BIG_ENDIAN_ORDER);
+   writer.enableHeader({(uint64_t)SIZE});
+   writer.enableChecksums(512);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int64_t, int32_t> reader(FILE_NAME, MPI_INT64_T,
+                                            id, numProcs);
+   reader.verifyChecksums();
+   assert( reader.readChunk() == v );
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void ChecksumTester::runCorruptionTests() {
+   if (id == MASTER) cout << "- Running corruption tests"
+                          << " (expect CRC32C reports)..." << flush;
+
+   const long SIZE = 2000, BLOCK_BYTES = 400;
+   vector<int> v = writeInts(SIZE, BLOCK_BYTES);
+   const long BAD_BYTE = 1234;                          // in block 3
+   if (id == MASTER) {
+      MPI_File fh;
+      MPI_File_open(MPI_COMM_SELF, FILE_NAME, MPI_MODE_WRONLY,
+                    MPI_INFO_NULL, &fh);
+      unsigned char junk = 0xEE;
+      MPI_Status status;
+      MPI_File_write_at(fh, BAD_BYTE, &junk, 1, MPI_BYTE, &status);
+      MPI_File_close(&fh);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   reader.verifyChecksums(false);                       // report, don't abort
+   vector<int> chunk = reader.readChunk();
+   reader.close();
+   // the PE(s) whose reads covered block 3 report it, and only it
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   bool covers = (start * 4 / BLOCK_BYTES <= BAD_BYTE / BLOCK_BYTES) &&
+                 ((stop * 4 - 1) / BLOCK_BYTES >= BAD_BYTE / BLOCK_BYTES);
+   vector<uint64_t> corrupt = reader.getCorruptBlocks();
+   if (covers) {
+      assert( corrupt.size() == 1 && corrupt[0] == BAD_BYTE / BLOCK_BYTES );
+   } else {
+      assert( corrupt.empty() );
+      assert( chunk == v );
+   }
+   int myReports = corrupt.size(), totalReports = 0;
+   MPI_Allreduce(&myReports, &totalReports, 1, MPI_INT, MPI_SUM,
+                 MPI_COMM_WORLD);
+   assert( totalReports >= 1 );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
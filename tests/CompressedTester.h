@@ -0,0 +1,461 @@
+/* CompressedTester.h declares the class that tests the block codecs
+ *   (byte and numeric), CompressedWriter and CompressedReader.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // CompressedWriter, CompressedReader, ...
+using namespace std;
+
+class CompressedTester {
+public:
+  CompressedTester();
+  void runTests();
+  void runCodecTests();
+  void runContainerTests(BlockCodec codec);
+  void runDoubleContainerTests();
+  void runNumericCodecTests();
+  void runNumericContainerTests();
+  void runMinMaxTests();
+
+private:
+   void checkRoundTrip(const vector<unsigned char>& data);
+   template <class ItemType>
+   void checkNumbers(BlockCodec codec, const vector<ItemType>& items,
+                     bool shouldShrink);
+   long valueOf(long i) const   { return 1000 + i / 3; }  // compressible
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/compressed.bin";
+   int id;
+   int numProcs;
+};
+
+CompressedTester::CompressedTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void CompressedTester::runTests() {
+   if (id == MASTER) cout << "\nTesting compressed containers...\n"
+                          << flush;
+
+   runCodecTests();
+   runContainerTests(CODEC_NONE);
+   runContainerTests(CODEC_LZ);
+   runContainerTests(CODEC_SHUFFLE_LZ);
+   runDoubleContainerTests();
+   runNumericCodecTests();
+   runNumericContainerTests();
+   runMinMaxTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+   if (id == MASTER) cout << "All compressed container tests passed!\n"
+                          << endl;
+}
+
+/* compress and decompress data with the LZ codec */
+void CompressedTester::checkRoundTrip(const vector<unsigned char>& data) {
+   vector<unsigned char> packed( lzCompressBound(data.size()) );
+   unsigned long packedBytes = lzCompress(data.data(), data.size(),
+                                           packed.data());
+   assert( packedBytes <= packed.size() );
+   vector<unsigned char> unpacked(data.size());
+   assert( lzDecompress(packed.data(), packedBytes,
+                         unpacked.data(), unpacked.size()) );
+   assert( unpacked == data );
+   if (packedBytes > 1) {                          // truncation is detected
+      assert( !lzDecompress(packed.data(), packedBytes - 1,
+                             unpacked.data(), unpacked.size()) );
+   }
+}
+
+void CompressedTester::runCodecTests() {
+   if (id == MASTER) cout << "- Running codec tests..." << flush;
+
+   checkRoundTrip( vector<unsigned char>() );
+   checkRoundTrip( vector<unsigned char>(5, 'x') );
+   checkRoundTrip( vector<unsigned char>(100000, 'a') );  // long matches
+   vector<unsigned char> noise(5000), text;
+   uint64_t state = 12345;
+   for (unsigned i = 0; i < noise.size(); ++i) {          // long literals
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      noise[i] = (unsigned char)(state >> 56);
+   }
+   checkRoundTrip(noise);
+   const char* phrase = "the quick brown fox jumps over the lazy dog; ";
+   for (int i = 0; i < 300; ++i) {
+      text.insert(text.end(), phrase, phrase + strlen(phrase));
+      text.push_back('0' + i % 10);
+   }
+   checkRoundTrip(text);
+
+   // shuffling is invertible, and a block that won't compress is stored
+   vector<unsigned char> shuffled(24), unshuffled(24), packed, scratch;
+   vector<unsigned char> raw(24);
+   for (int i = 0; i < 24; ++i) raw[i] = i;
+   shuffleBytes(raw.data(), shuffled.data(), 3, 8);
+   assert( shuffled[1] == 8 && shuffled[3] == 1 );
+   unshuffleBytes(shuffled.data(), unshuffled.data(), 3, 8);
+   assert( unshuffled == raw );
+   assert( compressBlock(CODEC_SHUFFLE_LZ, noise.data(), 1250, 4,
+                          packed, scratch) == 5000 );
+   vector<unsigned char> back(5000);
+   assert( decompressBlock(CODEC_SHUFFLE_LZ, packed.data(), packed.size(),
+                            back.data(), 1250, 4, scratch) );
+   assert( back == noise );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void CompressedTester::runContainerTests(BlockCodec codec) {
+   if (id == MASTER) cout << "- Running container tests (codec "
+                          << codec << ")..." << flush;
+
+   // uneven chunks: PE i writes 250 + 37*i Items
+   const long BLOCK_ITEMS = 100;
+   long myFirst = 0;
+   for (int pe = 0; pe < id; ++pe) {
+      myFirst += 250 + 37 * pe;
+   }
+   long myCount = 250 + 37 * id;
+   long total = 0;
+   for (int pe = 0; pe < numProcs; ++pe) {
+      total += 250 + 37 * pe;
+   }
+   vector<int> v;
+   for (long i = myFirst; i < myFirst + myCount; ++i) {
+      v.push_back( valueOf(i) );
+   }
+
+   CompressedWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs,
+                                 codec, BLOCK_ITEMS);
+   assert( writer.getCodec() == codec );
+   writer.writeChunk(v);
+   writer.close();
+   assert( writer.getNumItemsInFile() == total );
+   assert( writer.getFirstItemOffset() == myFirst );
+   long blocks = 0;
+   for (int pe = 0; pe < numProcs; ++pe) {
+      blocks += (250 + 37 * pe + BLOCK_ITEMS - 1) / BLOCK_ITEMS;
+   }
+   assert( writer.getNumBlocks() == blocks );
+   if (codec == CODEC_NONE) {
+      assert( writer.getCompressedSize() == total * 4 );
+   } else if (codec == CODEC_LZ) {
+      assert( writer.getCompressedSize() < total * 4 * 3 / 4 );
+   } else {                                  // shuffling helps a lot
+      assert( writer.getCompressedSize() < total * 4 / 2 );
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   CompressedReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( reader.getCodec() == codec );
+   assert( reader.getBlockItems() == BLOCK_ITEMS );
+   assert( reader.getNumBlocks() == blocks );
+   assert( reader.getNumItemsInFile() == total );
+   vector<int> chunk = reader.readChunk();
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, total, start, stop);
+   assert( (long)chunk.size() == stop - start );
+   for (unsigned i = 0; i < chunk.size(); ++i) {
+      assert( chunk[i] == valueOf(start + i) );
+   }
+   // ranges within a block, across blocks, and across writers' chunks
+   long firsts[4] = {0, 5, 95, total - 130};
+   long counts[4] = {total, 3, 110, 130};
+   for (int k = 0; k < 4; ++k) {
+      vector<int> range = reader.readRange(firsts[k], counts[k]);
+      assert( (long)range.size() == counts[k] );
+      for (long i = 0; i < counts[k]; ++i) {
+         assert( range[i] == valueOf(firsts[k] + i) );
+      }
+   }
+   assert( reader.readRange(7, 0).empty() );
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* doubles, written in the other byte order */
+void CompressedTester::runDoubleContainerTests() {
+   if (id == MASTER) cout << "- Running double container tests..." << flush;
+
+   const long SIZE = 1000;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(20.0 + (i / 10) * 0.5);
+   }
+   CompressedWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs,
+                                    CODEC_SHUFFLE_LZ, 64);
+   writer.setByteOrder(getHostByteOrder() == LITTLE_ENDIAN_ORDER
+                        ? BIG_ENDIAN_ORDER : LITTLE_ENDIAN_ORDER);
+   writer.writeChunk(v);
+   writer.close();
+   assert( writer.getCompressedSize() < SIZE * 8 / 4 );
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   CompressedReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( reader.needsByteSwap() );
+   vector<double> chunk = reader.readChunk();
+   assert( chunk == v );
+   assert( reader.getCompressedBytesRead() < (long)v.size() * 8 );
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* encode and decode items with a numeric codec */
+template <class ItemType>
+void CompressedTester::checkNumbers(BlockCodec codec, 
+                                    const vector<ItemType>& items,
+                                    bool shouldShrink) {
+   vector<unsigned char> packed(3, 'x');                // appends after these
+   bool encoded = encodeNumbers(codec, items.data(), items.size(), packed);
+   assert( encoded == shouldShrink );
+   if ( !encoded ) {
+      assert( packed.size() == 3 );
+      return;
+   }
+   assert( packed.size() - 3 < items.size() * sizeof(ItemType) );
+   vector<ItemType> back(items.size());
+   vector<uint64_t> codes;
+   assert( decodeNumbers(codec, packed.data() + 3, packed.size() - 3,
+                          back.data(), back.size(), codes) );
+   assert( memcmp(back.data(), items.data(), 
+                   items.size() * sizeof(ItemType)) == 0 );
+   assert( !decodeNumbers(codec, packed.data() + 3, packed.size() - 4,
+                           back.data(), back.size(), codes) );
+}
+
+void CompressedTester::runNumericCodecTests() {
+   if (id == MASTER) cout << "- Running numeric codec tests..." << flush;
+
+   // the vector unpack (and its scalar tail) agrees with the scalar one
+   const unsigned long COUNT = 103;
+   for (int width = 0; width <= OO_MPI_IO_MAX_PACK_WIDTH; ++width) {
+      vector<uint64_t> codes(COUNT), fast(COUNT), slow(COUNT);
+      uint64_t mask = (width == 0) ? 0 : (~0ULL >> (64 - width));
+      for (unsigned long i = 0; i < COUNT; ++i) {
+         codes[i] = (i * 0x9E3779B97F4A7C15ull) & mask;
+      }
+      vector<unsigned char> bits(packedSize(COUNT, width), 0);
+      packBits(codes.data(), COUNT, width, bits.data());
+      unpackBits(bits.data(), COUNT, width, fast.data());
+      unpackBitsScalar(bits.data(), COUNT, width, slow.data());
+      assert( fast == codes && slow == codes );
+   }
+
+   // integers: negative, unsigned, narrow, and extreme values
+   vector<int> sensor, constant(500, -7), wild;
+   for (int i = 0; i < 1000; ++i) {
+      sensor.push_back(-300 + (i * 7) % 50);
+      wild.push_back( (i % 2 == 0) ? INT_MAX - i : INT_MIN + i );
+   }
+   checkNumbers(CODEC_FOR_BITPACK, sensor, true);
+   checkNumbers(CODEC_DELTA_BITPACK, sensor, true);
+   checkNumbers(CODEC_FOR_BITPACK, constant, true);
+   checkNumbers(CODEC_DELTA_BITPACK, constant, true);
+   checkNumbers(CODEC_FOR_BITPACK, wild, false);      // 32 bits each: no gain
+   checkNumbers(CODEC_DELTA_BITPACK, vector<int>(1, 42), false);
+   vector<int64_t> walk;
+   vector<uint16_t> counts;
+   for (int i = 0; i < 1000; ++i) {
+      walk.push_back(INT64_MIN / 2 + (long)i * i);
+      counts.push_back(65535 - i % 20);
+   }
+   checkNumbers(CODEC_DELTA_BITPACK, walk, true);
+   checkNumbers(CODEC_FOR_BITPACK, counts, true);
+   vector<int64_t> extremes = {INT64_MAX, INT64_MIN, 0, INT64_MAX};
+   checkNumbers(CODEC_FOR_BITPACK, extremes, false);   // too wide: stored
+
+   // floats and doubles, including NaN and negative zero
+   vector<double> series;
+   vector<float> readings;
+   for (int i = 0; i < 1000; ++i) {
+      series.push_back(20.0 + (i / 10) * 0.5);
+      readings.push_back(-1.0f - (i / 25) * 0.25f);
+   }
+   series[500] = NAN;
+   series[501] = -0.0;
+   checkNumbers(CODEC_XOR_FLOAT, series, true);
+   checkNumbers(CODEC_XOR_FLOAT, readings, true);
+
+   // a codec that does not suit the Items encodes nothing
+   checkNumbers(CODEC_XOR_FLOAT, sensor, false);
+   checkNumbers(CODEC_FOR_BITPACK, series, false);
+   assert( codecSuitsItems<int>(CODEC_DELTA_BITPACK) );
+   assert( !codecSuitsItems<int>(CODEC_XOR_FLOAT) );
+   assert( codecSuitsItems<float>(CODEC_SHUFFLE_LZ) );
+   assert( !codecSuitsItems<double>(CODEC_FOR_BITPACK) );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* integers and doubles in containers with numeric codecs */
+void CompressedTester::runNumericContainerTests() {
+   if (id == MASTER) cout << "- Running numeric container tests..." << flush;
+
+   const long SIZE = 2000 + 17 * numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> ints;
+   vector<double> doubles;
+   for (long i = start; i < stop; ++i) {
+      ints.push_back( valueOf(i) - 5000 );
+      doubles.push_back( 100.0 - (i / 8) * 0.125 );
+   }
+
+   // both integer codecs, in both byte orders
+   BlockCodec codecs[2] = {CODEC_FOR_BITPACK, CODEC_DELTA_BITPACK};
+   ByteOrder orders[2] = {NATIVE_ORDER, 
+                          getHostByteOrder() == LITTLE_ENDIAN_ORDER 
+                           ? BIG_ENDIAN_ORDER : LITTLE_ENDIAN_ORDER};
+   for (int c = 0; c < 2; ++c) {
+      for (int k = 0; k < 2; ++k) {
+         CompressedWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs,
+                                       codecs[c], 256);
+         writer.setByteOrder(orders[k]);
+         writer.writeChunk(ints);
+         writer.close();
+         assert( writer.getCompressedSize() < SIZE * 4 / 3 );
+         MPI_Barrier(MPI_COMM_WORLD);
+
+         CompressedReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+         assert( reader.getCodec() == codecs[c] );
+         assert( reader.needsByteSwap() == (k == 1) );
+         assert( reader.readChunk() == ints );
+         vector<int> range = reader.readRange(250, 300);
+         for (long i = 0; i < 300; ++i) {
+            assert( range[i] == valueOf(250 + i) - 5000 );
+         }
+         reader.close();
+         MPI_Barrier(MPI_COMM_WORLD);
+      }
+   }
+
+   CompressedWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs,
+                                    CODEC_XOR_FLOAT, 256);
+   writer.writeChunk(doubles);
+   writer.close();
+   assert( writer.getCompressedSize() < SIZE * 8 / 4 );
+   MPI_Barrier(MPI_COMM_WORLD);
+   CompressedReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( reader.getCodec() == CODEC_XOR_FLOAT );
+   assert( reader.readChunk() == doubles );
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* min/max queries answered from the index */
+void CompressedTester::runMinMaxTests() {
+   if (id == MASTER) cout << "- Running min/max tests..." << flush;
+
+   // a zig-zag: the extremes are not at the ends of blocks or chunks
+   const long SIZE = 1000, BLOCK_ITEMS = 100;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( (i % 37) * ((i / 37) % 2 == 0 ? 1 : -1) + (i == 613) * 999 );
+   }
+   CompressedWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs,
+                                 CODEC_DELTA_BITPACK, BLOCK_ITEMS);
+   writer.setByteOrder(BIG_ENDIAN_ORDER);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   vector<int> all(SIZE);
+   for (long i = 0; i < SIZE; ++i) {
+      all[i] = (i % 37) * ((i / 37) % 2 == 0 ? 1 : -1) + (i == 613) * 999;
+   }
+   CompressedReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( reader.hasMinMax() );
+   assert( reader.getMax() == *max_element(all.begin(), all.end()) );
+   assert( reader.getMin() == *min_element(all.begin(), all.end()) );
+   assert( reader.getCompressedBytesRead() == 0 );      // nothing decoded
+   // each PE's chunk begins a new block
+   vector<long> blockStarts;
+   for (int pe = 0; pe < numProcs; ++pe) {
+      long peStart = -1, peStop = -1;
+      getChunkStartStopValues(pe, numProcs, SIZE, peStart, peStop);
+      for (long i = peStart; i < peStop; i += BLOCK_ITEMS) {
+         blockStarts.push_back(i);
+      }
+   }
+   blockStarts.push_back(SIZE);
+   assert( reader.getNumBlocks() == (long)blockStarts.size() - 1 );
+   for (long b = 0; b < reader.getNumBlocks(); ++b) {
+      assert( reader.getBlockMin(b) == *min_element(all.begin() + blockStarts[b],
+                                                  all.begin() + blockStarts[b+1]) );
+      assert( reader.getBlockMax(b) == *max_element(all.begin() + blockStarts[b],
+                                                  all.begin() + blockStarts[b+1]) );
+   }
+   // partial blocks at either end are decoded
+   long firsts[3] = {0, 50, 613};
+   long counts[3] = {SIZE, 555, 1};
+   for (int k = 0; k < 3; ++k) {
+      int least = 0, greatest = 0;
+      reader.getRangeMinMax(firsts[k], counts[k], least, greatest);
+      assert( least == *min_element(all.begin() + firsts[k],
+                                    all.begin() + firsts[k] + counts[k]) );
+      assert( greatest == *max_element(all.begin() + firsts[k],
+                                       all.begin() + firsts[k] + counts[k]) );
+   }
+   assert( reader.getCompressedBytesRead() > 0 );
+   reader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // doubles written with a byte codec also carry min/max (NaNs ignored)
+   vector<double> d;
+   for (long i = start; i < stop; ++i) {
+      d.push_back( (i == 0) ? NAN : i * 0.5 );
+   }
+   CompressedWriter<double> dWriter(FILE_NAME, MPI_DOUBLE, id, numProcs,
+                                     CODEC_LZ, BLOCK_ITEMS);
+   dWriter.writeChunk(d);
+   dWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   CompressedReader<double> dReader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( dReader.getMin() == 0.5 );
+   assert( dReader.getMax() == (SIZE - 1) * 0.5 );
+   assert( dReader.getBlockCount(0) == BLOCK_ITEMS - 1 );
+   dReader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // blocks and parts of blocks that are all NaNs are skipped
+   vector<double> neg;
+   for (long i = start; i < stop; ++i) {
+      neg.push_back( (i >= 200 && i < 500) ? NAN : -(i + 1) * 0.5 );
+   }
+   CompressedWriter<double> nWriter(FILE_NAME, MPI_DOUBLE, id, numProcs,
+                                     CODEC_XOR_FLOAT, BLOCK_ITEMS);
+   nWriter.writeChunk(neg);
+   nWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   CompressedReader<double> nReader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( nReader.getMax() == -0.5 );                  // not 0
+   assert( nReader.getMin() == -SIZE * 0.5 );
+   double least = 0, greatest = 0;
+   nReader.getRangeMinMax(150, 200, least, greatest);   // 150..349
+   assert( least == -100.0 && greatest == -75.5 );
+   nReader.getRangeMinMax(250, 100, least, greatest);   // all NaNs
+   assert( least != least && greatest != greatest );
+   nReader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
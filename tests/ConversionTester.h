@@ -0,0 +1,159 @@
+/* ConversionTester.h declares the class that tests numeric type
+ *   conversion (ParallelReader<Stored, Delivered> and
+ *   ParallelWriter<Stored, Supplied>).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelWriter, ParallelReader, ...
+using namespace std;
+
+class ConversionTester {
+public:
+  ConversionTester();
+  void runTests();
+  void runConvertNumbersTests();
+  void runWidenTests();
+  void runNarrowTests();
+
+private:
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/conversion.bin";
+   int id;
+   int numProcs;
+};
+
+ConversionTester::ConversionTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void ConversionTester::runTests() {
+   if (id == MASTER) cout << "\nTesting numeric type conversion...\n"
+                          << flush;
+
+   runConvertNumbersTests();
+   runWidenTests();
+   runNarrowTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+   if (id == MASTER) cout << "All conversion tests passed!\n" << endl;
+}
+
+void ConversionTester::runConvertNumbersTests() {
+   if (id == MASTER) cout << "- Running convertNumbers() tests..." << flush;
+
+   // odd counts, so that both the vector loops and the tails run
+   const int COUNT = 11;
+   double d[COUNT];
+   float f[COUNT];
+   int32_t i32[COUNT];
+   int64_t i64[COUNT];
+   short s[COUNT];
+   for (int i = 0; i < COUNT; ++i) {
+      d[i] = i / 3.0 - 1.0;
+      i32[i] = (i % 2 == 0) ? -i * 100000 : i * 100000;
+   }
+   convertNumbers(d, f, COUNT);
+   for (int i = 0; i < COUNT; ++i) {
+      assert( f[i] == (float) d[i] );
+   }
+   convertNumbers(f, d, COUNT);
+   for (int i = 0; i < COUNT; ++i) {
+      assert( d[i] == (double) f[i] );
+   }
+   convertNumbers(i32, i64, COUNT);
+   for (int i = 0; i < COUNT; ++i) {
+      assert( i64[i] == i32[i] );
+   }
+   convertNumbers(i64, s, COUNT);                  // the generic version
+   for (int i = 0; i < COUNT; ++i) {
+      assert( s[i] == (short) i64[i] );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* write int32_t values as int64_t values, and read them back both ways */
+void ConversionTester::runWidenTests() {
+   if (id == MASTER) cout << "- Running widening tests..." << flush;
+
+   // give each PE more than one conversion window
+   const long SIZE = numProcs * (OO_MPI_IO_SWAP_WINDOW / 8 + 5);
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int32_t> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( (i % 2 == 0) ? -i : i );
+   }
+   ParallelWriter<int64_t, int32_t> writer(FILE_NAME, MPI_INT64_T,
+                                            id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   assert( writer.getFileSize() == SIZE * 8 );
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int64_t> reader(FILE_NAME, MPI_INT64_T, id, numProcs);
+   vector<int64_t> v64 = reader.readChunk();
+   reader.close();
+   assert( v64.size() == v.size() );
+   for (unsigned i = 0; i < v.size(); ++i) {
+      assert( v64[i] == v[i] );
+   }
+
+   ParallelReader<int64_t, int32_t> reader32(FILE_NAME, MPI_INT64_T,
+                                              id, numProcs);
+   vector<int32_t> v32 = reader32.readChunk();
+   assert( v32 == v );
+   vector<int32_t> items = reader32.readItems({(uint64_t)SIZE-1, 1, 2});
+   assert( items.size() == 3 );
+   assert( items[0] == ((SIZE-1) % 2 == 0 ? -(SIZE-1) : SIZE-1) );
+   assert( items[1] == 1 && items[2] == -2 );
+   reader32.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* read doubles as floats (also in the other byte order) */
+void ConversionTester::runNarrowTests() {
+   if (id == MASTER) cout << "- Running narrowing tests..." << flush;
+
+   const long SIZE = 1000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i / 7.0);
+   }
+   ByteOrder orders[2] = {NATIVE_ORDER, BIG_ENDIAN_ORDER};
+   for (int k = 0; k < 2; ++k) {
+      ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+      writer.setByteOrder(orders[k]);
+      writer.writeChunk(v);
+      writer.close();
+      MPI_Barrier(MPI_COMM_WORLD);
+
+      ParallelReader<double, float> reader(FILE_NAME, MPI_DOUBLE,
+                                            id, numProcs);
+      reader.setByteOrder(orders[k]);
+      vector<float> f = reader.readChunk();
+      assert( f.size() == v.size() );
+      for (unsigned i = 0; i < v.size(); ++i) {
+         assert( f[i] == (float) v[i] );
+      }
+      vector<float> fPlus = reader.readChunkPlus(3);
+      assert( fPlus.size() == v.size() + (id < numProcs-1 ? 3 : 0) );
+      assert( fPlus.back() == (float)((start + fPlus.size() - 1) / 7.0) );
+      reader.close();
+      MPI_Barrier(MPI_COMM_WORLD);
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,117 @@
+/* EpochReaderTester.h declares the class that tests EpochReader
+ *   using files/12ints.bin.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <fstream>                 // ifstream
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // EpochReader
+using namespace std;
+
+class EpochReaderTester {
+public:
+  EpochReaderTester();
+  void runTests();
+  void runEpochTests(long blockSize, int prefetchDepth);
+  void runShuffleTests();
+private:
+   const int MASTER = 0;
+   int id;
+   int numProcs;
+   vector<int> expected;           // the contents of 12ints.txt
+};
+
+EpochReaderTester::EpochReaderTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+
+   ifstream fin("files/12ints.txt");
+   assert( fin.is_open() );
+   int iVal;
+   for (int i = 0; i < 12; ++i) {
+      fin >> iVal;
+      expected.push_back(iVal);
+   }
+   fin.close();
+}
+
+void EpochReaderTester::runTests() {
+   if (id == MASTER) cout << "\nTesting EpochReader using ints...\n" << flush;
+
+   runEpochTests(5, 2);               // blocks of 5, 5, 2 Items
+   runEpochTests(1, 3);               // 12 blocks of 1 Item
+   runEpochTests(4, 1);               // 3 blocks of 4 Items
+   runShuffleTests();
+
+   if (id == MASTER) cout << "All epoch tests passed!\n" << endl;
+}
+
+/* each epoch, every block must be read by exactly one PE,
+ *  with the right contents
+ */
+void EpochReaderTester::runEpochTests(long blockSize, int prefetchDepth) {
+   if (id == MASTER) cout << "- Running epoch tests (block size " 
+                          << blockSize << ")..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   EpochReader<int> reader("./files/12ints.bin", MPI_INT, id, numProcs,
+                            blockSize, 374, prefetchDepth);
+   assert( reader.getNumBlocks() == (12 + blockSize - 1) / blockSize );
+   assert( reader.getPrefetchDepth() == prefetchDepth );
+
+   vector<int> block;
+   for (long epoch = 0; epoch < 3; ++epoch) {
+      reader.beginEpoch(epoch);
+      assert( reader.getEpoch() == epoch );
+      vector<int> timesRead(reader.getNumBlocks(), 0);
+      long numRead = 0, itemsRead = 0;
+      while ( reader.nextBlock(block) ) {
+         long b = reader.getCurrentBlock();
+         assert( b == reader.getEpochBlocks()[numRead] );
+         ++timesRead[b];
+         ++numRead;
+         itemsRead += block.size();
+         for (unsigned i = 0; i < block.size(); ++i) {
+            assert( block[i] == expected[b * blockSize + i] );
+         }
+      }
+      assert( numRead == (long)reader.getEpochBlocks().size() );
+      assert( itemsRead == reader.getChunkSize() );
+      vector<int> total(reader.getNumBlocks(), 0);
+      MPI_Allreduce(timesRead.data(), total.data(), total.size(), MPI_INT,
+                     MPI_SUM, MPI_COMM_WORLD);
+      for (unsigned b = 0; b < total.size(); ++b) {
+         assert( total[b] == 1 );
+      }
+   }
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* the same seed and epoch give the same order; 
+ *  a different epoch gives a different order
+ */
+void EpochReaderTester::runShuffleTests() {
+   if (id == MASTER) cout << "- Running shuffle tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   EpochReader<int> reader("./files/12ints.bin", MPI_INT, 0, 1, 1, 374);
+   reader.beginEpoch(0);
+   vector<long> order0 = reader.getEpochBlocks();
+   reader.beginEpoch(1);
+   vector<long> order1 = reader.getEpochBlocks();
+   reader.beginEpoch(0);
+   assert( reader.getEpochBlocks() == order0 );
+   assert( order0 != order1 );
+   assert( order0.size() == 12 );
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
@@ -0,0 +1,157 @@
+/* GeneratorTester.h declares the class that tests what parallel data
+ *   generation uses: Philox4x32, getChunkStartStopValues() for large
+ *   counts, and ParallelWriter's beginChunk(), writePart() and endChunk().
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // Philox4x32, ParallelWriter, ...
+using namespace std;
+
+class GeneratorTester {
+public:
+  GeneratorTester();
+  void runTests();
+  void runPhiloxTests();
+  void runChunkTests();
+  void runPartTests();
+
+private:
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/generator.bin";
+   int id;
+   int numProcs;
+};
+
+GeneratorTester::GeneratorTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void GeneratorTester::runTests() {
+   if (id == MASTER) cout << "\nTesting data generation...\n" << flush;
+
+   runPhiloxTests();
+   runChunkTests();
+   runPartTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(getCrcFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      MPI_File_delete(getZoneMapFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      cout << "All data generation tests passed!\n" << endl;
+   }
+}
+
+void GeneratorTester::runPhiloxTests() {
+   if (id == MASTER) cout << "- Running Philox4x32 tests..." << flush;
+
+   // the known-answer tests of Random123's philox4x32-10
+   uint32_t out[4];
+   const uint32_t zeros[4] = {0, 0, 0, 0};
+   Philox4x32(0).generate(zeros, out);
+   assert( out[0] == 0x6627e8d5 && out[1] == 0xe169c58d );
+   assert( out[2] == 0xbc57ac4c && out[3] == 0x9b00dbd8 );
+   const uint32_t ones[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+   Philox4x32(UINT64_MAX).generate(ones, out);
+   assert( out[0] == 0x408f276d && out[1] == 0x41c83b0e );
+   assert( out[2] == 0xa20bc7c6 && out[3] == 0x6d5451fd );
+   const uint32_t pi[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+   Philox4x32 piGenerator(0x299f31d0a4093822ULL);
+   assert( piGenerator.getSeed() == 0x299f31d0a4093822ULL );
+   piGenerator.generate(pi, out);
+   assert( out[0] == 0xd16cfe09 && out[1] == 0x94fdcceb );
+   assert( out[2] == 0x5001e420 && out[3] == 0x24126ea1 );
+
+   // indices (of any size) are counters; uniform() is in [0, 1)
+   Philox4x32 rng(42);
+   const uint32_t counter[4] = {5, 1, 0, 0};
+   uint32_t viaIndex[4];
+   rng.generate(counter, out);
+   rng.generateIndex((1ULL << 32) + 5, viaIndex);
+   assert( memcmp(out, viaIndex, sizeof(out)) == 0 );
+   double sum = 0;
+   for (uint64_t i = 0; i < 10000; ++i) {
+      double u = rng.uniform(i);
+      assert( u >= 0.0 && u < 1.0 );
+      sum += u;
+   }
+   assert( sum > 4900 && sum < 5100 );
+   assert( Philox4x32(43).uniform(0) != rng.uniform(0) );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* chunks of more than 2^32 Items */
+void GeneratorTester::runChunkTests() {
+   if (id == MASTER) cout << "- Running large chunk tests..." << flush;
+
+   const long BIG = 10000000000L + 3;
+   long start = -1, stop = -1, previousStop = 0;
+   for (int pe = 0; pe < 7; ++pe) {
+      getChunkStartStopValues(pe, 7, BIG, start, stop);
+      assert( start == previousStop );
+      assert( stop - start == BIG / 7 + (pe < BIG % 7 ? 1 : 0) );
+      previousStop = stop;
+   }
+   assert( stop == BIG );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* writing a chunk in parts gives the same file (and sidecars) */
+void GeneratorTester::runPartTests() {
+   if (id == MASTER) cout << "- Running writePart() tests..." << flush;
+
+   const long SIZE = 10000 + numProcs, PART_ITEMS = 333;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   Philox4x32 rng(7);
+   ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   writer.enableHeader();
+   writer.enableChecksums(1000);
+   writer.enableZoneMap(100);
+   writer.beginChunk(stop - start);
+   assert( writer.getFirstItemOffset() == start );
+   vector<double> part, chunk;
+   for (long first = start; first < stop; first += PART_ITEMS) {
+      part.clear();
+      for (long i = first; i < min(stop, first + PART_ITEMS); ++i) {
+         part.push_back( rng.uniform(i) );
+      }
+      writer.writePart(part);
+      chunk.insert(chunk.end(), part.begin(), part.end());
+   }
+   writer.writePart( vector<double>() );              // (an empty part)
+   writer.endChunk();
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   reader.verifyChecksums();
+   assert( reader.getNumItemsInFile() == SIZE );
+   assert( reader.readChunk() == chunk );
+   assert( reader.getCorruptBlocks().empty() );
+   reader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   RangeScanReader<double> scanner(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   long myCount = scanner.scanRange(0.25, 0.5).size(), count = 0;
+   MPI_Allreduce(&myCount, &count, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   long expected = 0;
+   for (long i = 0; i < SIZE; ++i) {
+      double u = rng.uniform(i);
+      expected += (u >= 0.25 && u <= 0.5);
+   }
+   assert( count == expected );
+   scanner.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
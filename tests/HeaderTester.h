@@ -0,0 +1,162 @@
+/* HeaderTester.h declares the class that tests the optional
+ *   self-describing file header, using double values.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelWriter, ParallelReader, ...
+using namespace std;
+
+class HeaderTester {
+public:
+  HeaderTester();
+  void runTests();
+  void runWriteHeaderTests();
+  void runReadHeaderTests();
+  void runArrayHeaderTests();
+  void runUpdaterHeaderTests();
+
+private:
+   const int MASTER = 0;
+   const int ROWS = 3;
+   const int COLS = 4;
+   const char* FILE_NAME = "./files/header.bin";
+   const char* USER_DATA = "units=meters";
+   int id;
+   int numProcs;
+};
+
+HeaderTester::HeaderTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void HeaderTester::runTests() {
+   if (id == MASTER) cout << "\nTesting file headers using doubles...\n"
+                          << flush;
+
+   runWriteHeaderTests();
+   runReadHeaderTests();
+   runArrayHeaderTests();
+   runUpdaterHeaderTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+   if (id == MASTER) cout << "All header tests passed!\n" << endl;
+}
+
+/* write 0.5, 1.5, ..., 11.5 as a 3x4 array with a header */
+void HeaderTester::runWriteHeaderTests() {
+   if (id == MASTER) cout << "- Running header write tests..." << flush;
+
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, ROWS*COLS, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i + 0.5);
+   }
+   ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( !writer.hasHeader() );
+   writer.enableHeader({(uint64_t)ROWS, (uint64_t)COLS}, USER_DATA);
+   writer.writeChunk(v);
+   assert( writer.hasHeader() );
+   assert( writer.getDataOffset() == OO_MPI_IO_HEADER_SIZE );
+   assert( writer.getFileSize() == OO_MPI_IO_HEADER_SIZE + ROWS*COLS*8 );
+   assert( writer.getFirstByteOffset() == OO_MPI_IO_HEADER_SIZE + start*8 );
+   writer.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void HeaderTester::runReadHeaderTests() {
+   if (id == MASTER) cout << "- Running header read tests..." << flush;
+
+   ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( reader.hasHeader() );
+   assert( reader.getDataOffset() == OO_MPI_IO_HEADER_SIZE );
+   assert( reader.getNumItemsInFile() == ROWS*COLS );
+   assert( reader.getHeader().typeCode == OO_MPI_IO_FLOAT64 );
+   vector<uint64_t> dims = reader.getDims();
+   assert( dims.size() == 2 );
+   assert( dims[0] == (uint64_t)ROWS && dims[1] == (uint64_t)COLS );
+   assert( reader.getUserData() == USER_DATA );
+
+   vector<double> v = reader.readChunk();
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, ROWS*COLS, start, stop);
+   assert( (long)v.size() == stop - start );
+   for (unsigned i = 0; i < v.size(); ++i) {
+      assert( v[i] == start + i + 0.5 );
+   }
+   assert( reader.getFirstByteOffset() == OO_MPI_IO_HEADER_SIZE + start*8 );
+
+   vector<double> items = reader.readItems({11, 0, 6});
+   assert( items.size() == 3 );
+   assert( items[0] == 11.5 && items[1] == 0.5 && items[2] == 6.5 );
+   reader.close();
+
+   // a raw file has no header
+   ParallelReader<double> rawReader("./files/6doubles.bin", MPI_DOUBLE,
+                                     id, numProcs);
+   assert( !rawReader.hasHeader() );
+   assert( rawReader.getDataOffset() == 0 );
+   assert( rawReader.getDims().empty() );
+   rawReader.readChunk();
+   assert( rawReader.getNumItemsInFile() == 6 );
+   rawReader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void HeaderTester::runArrayHeaderTests() {
+   if (id == MASTER) cout << "- Running header array tests..." << flush;
+
+   vector<int> grid = {numProcs, 1};
+   if (numProcs > ROWS) {                        // only ROWS rows to split
+      grid = {1, numProcs};
+   }
+   ParallelArrayReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs,
+                                       {ROWS, COLS}, grid);
+   assert( reader.hasHeader() );
+   vector<double> v = reader.readBlock();
+   vector<long> start = reader.getLocalStart();
+   vector<long> shape = reader.getLocalShape();
+   assert( (long)v.size() == shape[0] * shape[1] );
+   for (long r = 0; r < shape[0]; ++r) {
+      for (long c = 0; c < shape[1]; ++c) {
+         long item = (start[0] + r) * COLS + start[1] + c;
+         assert( v[r * shape[1] + c] == item + 0.5 );
+      }
+   }
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void HeaderTester::runUpdaterHeaderTests() {
+   if (id == MASTER) cout << "- Running header update tests..." << flush;
+
+   ParallelUpdater<double> updater(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( updater.hasHeader() );
+   updater.writeItems({(uint64_t)id}, {-1.0 - id});
+   updater.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, 0, 1);
+   vector<double> v = reader.readChunk();
+   reader.close();
+   assert( (int)v.size() == ROWS*COLS );
+   for (int i = 0; i < ROWS*COLS; ++i) {
+      assert( v[i] == (i < numProcs ? -1.0 - i : i + 0.5) );
+   }
+   assert( reader.getUserData() == USER_DATA );     // header intact
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -17,6 +17,7 @@ public:
   void runGetterTests(const ParallelReader<int>& reader);
   void runChunkTests(const ParallelReader<int>& reader);
   void runReadTests(ParallelReader<int>& reader);
+  void runReadItemsTests(ParallelReader<int>& reader);
 private:
    const int MASTER = 0;
    int id;
@@ -39,6 +40,7 @@ void IntReaderTester::runTests() {
    runGetterTests(reader);
    runReadTests(reader);
    runChunkTests(reader);
+   runReadItemsTests(reader);
 
    if (id == MASTER) cout << "All int tests passed!\n" << endl;
 }
@@ -568,3 +570,39 @@ runReadTests(ParallelReader<int>& reader) {
    if (id == MASTER) cout << " Passed!" << endl;
 }
 
+
+void IntReaderTester::
+runReadItemsTests(ParallelReader<int>& reader) {
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << "- Running readItems() tests... " << flush;
+
+   vector<int> all;
+   int iVal;
+   ifstream fin("files/12ints.txt");
+   assert( fin.is_open() );
+   for (int i = 0; i < 12; ++i) {
+      fin >> iVal;
+      all.push_back(iVal);
+   }
+   fin.close();
+
+   // unsorted, with duplicates, adjacent and distant indices
+   vector<uint64_t> indices = {11, 3, 0, 4, 3, 9, (uint64_t)id};
+   assert( reader.getGapThreshold() == 16 );
+   for (unsigned long gap = 0; gap < 4; ++gap) {
+      reader.setGapThreshold(gap);
+      vector<int> v = reader.readItems(indices);
+      assert( v.size() == indices.size() );
+      for (unsigned i = 0; i < v.size(); ++i) {
+         assert( v[i] == all[ indices[i] ] );
+      }
+   }
+
+   // the last PE asks for nothing (but must still take part)
+   vector<uint64_t> none;
+   vector<int> v = reader.readItems(id == numProcs-1 ? none : indices);
+   assert( v.size() == (id == numProcs-1 ? 0 : indices.size()) );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed!" << endl;
+}
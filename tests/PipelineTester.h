@@ -0,0 +1,235 @@
+/* PipelineTester.h declares the class that tests the fused
+ *   read-transform-write pipeline (transformFile()) and the
+ *   non-blocking parts it is built from (ParallelReader::beginChunk(),
+ *   startPart(), finishPart() and endChunk(), and likewise for
+ *   ParallelWriter).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // transformFile(), ParallelReader, ...
+using namespace std;
+
+class PipelineTester {
+public:
+  PipelineTester();
+  void runTests();
+  void runPartTests();
+  void runTransformTests();
+  void runConversionTests();
+  void runSidecarTests();
+
+private:
+   vector<int> writeInts(long size, long blockBytes = 0);
+   ByteOrder getForeignOrder() const;
+
+   const int MASTER = 0;
+   const char* IN_NAME = "./files/pipelineIn.bin";
+   const char* OUT_NAME = "./files/pipelineOut.bin";
+   int id;
+   int numProcs;
+};
+
+PipelineTester::PipelineTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void PipelineTester::runTests() {
+   if (id == MASTER) cout << "\nTesting the read-transform-write pipeline...\n"
+                          << flush;
+
+   runPartTests();
+   runTransformTests();
+   runConversionTests();
+   runSidecarTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      const char* names[] = { IN_NAME, OUT_NAME };
+      for (const char* name : names) {
+         MPI_File_delete(name, MPI_INFO_NULL);
+         MPI_File_delete(getCrcFileName(name).c_str(), MPI_INFO_NULL);
+         MPI_File_delete(getZoneMapFileName(name).c_str(), MPI_INFO_NULL);
+      }
+      cout << "All pipeline tests passed!\n" << endl;
+   }
+}
+
+ByteOrder PipelineTester::getForeignOrder() const {
+   return (getHostByteOrder() == LITTLE_ENDIAN_ORDER) ? BIG_ENDIAN_ORDER
+                                                      : LITTLE_ENDIAN_ORDER;
+}
+
+/* write Items 0, 1, ..., size-1 (in the other byte order, with
+ *  checksums of blockBytes bytes, if blockBytes > 0) to IN_NAME
+ * Return: this PE's chunk.
+ */
+vector<int> PipelineTester::writeInts(long size, long blockBytes) {
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, size, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i);
+   }
+   ParallelWriter<int> writer(IN_NAME, MPI_INT, id, numProcs);
+   if (blockBytes > 0) {
+      writer.setByteOrder( getForeignOrder() );
+      writer.enableChecksums(blockBytes);
+   }
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   return v;
+}
+
+/* several parts in flight at once, byte-swapped both ways */
+void PipelineTester::runPartTests() {
+   if (id == MASTER) cout << "- Running non-blocking part tests..." << flush;
+
+   const long SIZE = 100 + numProcs;
+   vector<int> v = writeInts(SIZE, 64);
+   ParallelReader<int> reader(IN_NAME, MPI_INT, id, numProcs);
+   reader.setByteOrder( getForeignOrder() );
+   reader.verifyChecksums();
+   long chunkSize = reader.beginChunk();
+   assert( chunkSize == (long) v.size() && reader.getChunkSize() == chunkSize );
+   vector<int> parts(chunkSize);
+   long half = chunkSize / 2;
+   MPI_Request requests[2];
+   reader.startPart(parts.data(), half, &requests[0]);
+   reader.startPart(parts.data() + half, chunkSize - half, &requests[1]);
+   reader.finishPart(parts.data(), half, &requests[0]);
+   reader.finishPart(parts.data() + half, chunkSize - half, &requests[1]);
+   reader.endChunk();
+   assert( parts == v );
+   assert( reader.getCorruptBlocks().empty() );
+   reader.close();
+
+   ParallelWriter<int> writer(OUT_NAME, MPI_INT, id, numProcs);
+   writer.setByteOrder( getForeignOrder() );
+   writer.beginChunk(chunkSize);
+   writer.startPart(parts.data(), half, &requests[0]);
+   writer.startPart(parts.data() + half, chunkSize - half, &requests[1]);
+   writer.finishPart(&requests[1]);
+   writer.finishPart(&requests[0]);
+   MPI_Request none = MPI_REQUEST_NULL;
+   writer.finishPart(&none);                      // (nothing to wait for)
+   writer.endChunk();
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int> check(OUT_NAME, MPI_INT, id, numProcs);
+   check.setByteOrder( getForeignOrder() );
+   assert( check.readChunk() == v );
+   check.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* blocks of different sizes, rings of different sizes, and threads */
+void PipelineTester::runTransformTests() {
+   if (id == MASTER) cout << "- Running transformFile() tests..." << flush;
+
+   const long SIZE = 1000 + numProcs;
+   vector<int> v = writeInts(SIZE);
+   auto square = [](int x) { return x * x - 3; };
+   unsigned long blocks[] = { 7, 1, 1000000, 0 };
+   for (unsigned long blockItems : blocks) {
+      for (int ringSize = 2; ringSize <= 4; ++ringSize) {
+         for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+            ParallelReader<int> reader(IN_NAME, MPI_INT, id, numProcs);
+            ParallelWriter<int> writer(OUT_NAME, MPI_INT, id, numProcs);
+            transformFile(reader, writer, square, blockItems, numThreads,
+                           ringSize);
+            assert( writer.getFirstItemOffset() == reader.getFirstItemOffset() );
+            reader.close();
+            writer.close();
+            MPI_Barrier(MPI_COMM_WORLD);
+
+            ParallelReader<int> check(OUT_NAME, MPI_INT, id, numProcs);
+            vector<int> result = check.readChunk();
+            check.close();
+            assert( result.size() == v.size() );
+            for (unsigned long i = 0; i < v.size(); ++i) {
+               assert( result[i] == square(v[i]) );
+            }
+            MPI_Barrier(MPI_COMM_WORLD);
+         }
+      }
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* ints read as doubles, and halved doubles written as floats */
+void PipelineTester::runConversionTests() {
+   if (id == MASTER) cout << "- Running conversion tests..." << flush;
+
+   const long SIZE = 500 + numProcs;
+   vector<int> v = writeInts(SIZE);
+   ParallelReader<int, double> reader(IN_NAME, MPI_INT, id, numProcs);
+   ParallelWriter<float, double> writer(OUT_NAME, MPI_FLOAT, id, numProcs);
+   transformFile(reader, writer, [](double x) { return x * 0.5; }, 13);
+   reader.close();
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<float> check(OUT_NAME, MPI_FLOAT, id, numProcs);
+   vector<float> result = check.readChunk();
+   check.close();
+   assert( result.size() == v.size() );
+   for (unsigned long i = 0; i < v.size(); ++i) {
+      assert( result[i] == v[i] * 0.5f );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* checksums checked on the way in, and header, checksums and zone map
+ *  written on the way out
+ */
+void PipelineTester::runSidecarTests() {
+   if (id == MASTER) cout << "- Running sidecar tests..." << flush;
+
+   const long SIZE = 2000 + numProcs;
+   const long ZONE_ITEMS = 64;
+   vector<int> v = writeInts(SIZE, 100);
+   ParallelReader<int> reader(IN_NAME, MPI_INT, id, numProcs);
+   reader.setByteOrder( getForeignOrder() );
+   reader.verifyChecksums();
+   ParallelWriter<int> writer(OUT_NAME, MPI_INT, id, numProcs);
+   writer.setByteOrder( getForeignOrder() );
+   writer.enableHeader({(uint64_t) SIZE}, "negated");
+   writer.enableChecksums(256);
+   writer.enableZoneMap(ZONE_ITEMS);
+   transformFile(reader, writer, [](int x) { return -x; }, 37, 2);
+   assert( reader.getCorruptBlocks().empty() );
+   reader.close();
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int> check(OUT_NAME, MPI_INT, id, numProcs);
+   assert( check.hasHeader() && check.needsByteSwap() );
+   check.verifyChecksums();
+   vector<int> result = check.readChunk();
+   assert( check.getCorruptBlocks().empty() );
+   check.close();
+   assert( result.size() == v.size() );
+   for (unsigned long i = 0; i < v.size(); ++i) {
+      assert( result[i] == -v[i] );
+   }
+   RangeScanReader<int> zones(OUT_NAME, MPI_INT, id, numProcs);
+   assert( zones.getNumBlocks() == (SIZE + ZONE_ITEMS - 1) / ZONE_ITEMS );
+   assert( zones.getBlockMax(0) == 0 && zones.getBlockMin(0) == 1 - ZONE_ITEMS );
+   zones.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,222 @@
+/* ProfileTester.h declares the class that tests I/O tuning profiles
+ *   (parseProfile(), saveProfile(), getProfileFor(), the readers and
+ *   writers that use them, and autotune()).
+ *
+ * It sets OO_MPI_IO_PROFILES to a file in ./files while it runs,
+ *  so that the profiles in $HOME are neither used nor changed.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cstdlib>                 // setenv(), unsetenv()
+#include <fstream>                 // ifstream
+#include "../OO_MPI_IO.h"          // autotune(), ParallelWriter, ...
+using namespace std;
+
+class ProfileTester {
+public:
+  ProfileTester();
+  void runTests();
+  void runFormatTests();
+  void runSaveTests();
+  void runTunedIOTests();
+  void runAutotuneTests();
+
+private:
+   long countLines(const char* fileName) const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/profile.bin";
+   const char* SCRATCH_NAME = "./files/autotune.bin";
+   const char* PROFILES_NAME = "./files/profiles.txt";
+   int id;
+   int numProcs;
+};
+
+ProfileTester::ProfileTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void ProfileTester::runTests() {
+   if (id == MASTER) cout << "\nTesting I/O tuning profiles...\n" << flush;
+
+   setenv("OO_MPI_IO_PROFILES", PROFILES_NAME, 1);
+   clearProfiles();
+   runFormatTests();
+   runSaveTests();
+   runTunedIOTests();
+   runAutotuneTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   unsetenv("OO_MPI_IO_PROFILES");
+   clearProfiles();
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(PROFILES_NAME, MPI_INFO_NULL);
+      cout << "All I/O tuning profile tests passed!\n" << endl;
+   }
+}
+
+long ProfileTester::countLines(const char* fileName) const {
+   ifstream fin(fileName);
+   string line;
+   long count = 0;
+   while ( getline(fin, line) ) {
+      ++count;
+   }
+   return count;
+}
+
+/* lines, mount points and hints */
+void ProfileTester::runFormatTests() {
+   if (id == MASTER) cout << "- Running format tests..." << flush;
+
+   OO_MPI_IO_Profile profile = OO_MPI_IO_Profile(), parsed;
+   profile.collective = true;
+   profile.aggregators = 3;
+   profile.bufferBytes = 1L << 24;
+   profile.alignment = 1L << 20;
+   profile.windowBytes = 1L << 33;
+   string line = formatProfile("/scratch", profile), mountPoint;
+   assert( line == "/scratch collective=1 aggregators=3 bufferBytes=16777216"
+                   " alignment=1048576 windowBytes=8589934592\n" );
+   assert( parseProfile(line.c_str(), mountPoint, parsed) );
+   assert( mountPoint == "/scratch" && parsed == profile );
+   assert( parseProfile("  /data windowBytes=4096 colour=2 collective=0\n",
+                         mountPoint, parsed) );
+   assert( mountPoint == "/data" && parsed.windowBytes == 4096 );
+   assert( !parsed.collective && parsed.aggregators == 0 );
+   assert( !parseProfile("# a comment\n", mountPoint, parsed) );
+   assert( !parseProfile("   \n", mountPoint, parsed) );
+
+   string mount = getMountPoint(FILE_NAME);
+   assert( !mount.empty() && mount[0] == '/' );
+   assert( getMountPoint("/") == "/" );
+   assert( getMountPoint("/no/such/directory/file.bin") == "/" );
+
+   assert( makeProfileInfo(OO_MPI_IO_Profile()) == MPI_INFO_NULL );
+   MPI_Info info = makeProfileInfo(profile);
+   assert( info != MPI_INFO_NULL );
+   char value[32];
+   int found = 0;
+   MPI_Info_get(info, "cb_nodes", sizeof(value) - 1, value, &found);
+   assert( found && string(value) == "3" );
+   MPI_Info_get(info, "striping_unit", sizeof(value) - 1, value, &found);
+   assert( found && string(value) == "1048576" );
+   MPI_Info_free(&info);
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* saved profiles replace their mount point's line, and are loaded */
+void ProfileTester::runSaveTests() {
+   if (id == MASTER) cout << "- Running saveProfile() tests..." << flush;
+
+   string mount = getMountPoint(FILE_NAME);
+   OO_MPI_IO_Profile other = OO_MPI_IO_Profile(), first = other, second = other;
+   other.aggregators = 2;
+   first.windowBytes = 1L << 20;
+   second.collective = true;
+   second.windowBytes = 40;
+   if (id == MASTER) {
+      MPI_File_delete(PROFILES_NAME, MPI_INFO_NULL);
+      saveProfile("/no/such/mount", other);
+      saveProfile(mount, first);
+      saveProfile(mount, second);                            // replaces it
+      assert( countLines(PROFILES_NAME) == 3 );              // (+ a comment)
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( getProfileFor(FILE_NAME) == second );
+   setProfileFor(FILE_NAME, first);
+   assert( getProfileFor(FILE_NAME) == first );
+   clearProfiles();
+   assert( getProfileFor(FILE_NAME) == second );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* collective reads and writes, in small pieces and windows */
+void ProfileTester::runTunedIOTests() {
+   if (id == MASTER) cout << "- Running tuned I/O tests..." << flush;
+
+   OO_MPI_IO_Profile profile = OO_MPI_IO_Profile();
+   profile.collective = true;
+   profile.windowBytes = 40;                   // 10 ints per call
+   profile.aggregators = 1;
+   profile.bufferBytes = 1L << 20;
+   setProfileFor(FILE_NAME, profile);
+
+   const long SIZE = 1000 + numProcs;          // (uneven chunks)
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i);
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   assert( writer.getProfile() == profile );
+   writer.writeChunk(v);
+   writer.close();
+   if (OO_MPI_IO_STATS_ENABLED) {
+      long pieces = (v.size() + 9) / 10;
+      assert( (long) writer.getStats().ops[WRITE_OP].calls >= pieces );
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( reader.readChunk() == v );
+   vector<int> plus = reader.readChunkPlus(3);
+   assert( plus.size() == v.size() + (id < numProcs - 1 ? 3 : 0) );
+   assert( equal(v.begin(), v.end(), plus.begin()) );
+   reader.close();
+
+   // converted in 10-Item windows
+   ParallelReader<int, double> converter(FILE_NAME, MPI_INT, id, numProcs);
+   vector<double> doubles = converter.readChunk();
+   assert( doubles.size() == v.size() );
+   for (unsigned long i = 0; i < v.size(); ++i) {
+      assert( doubles[i] == v[i] );
+   }
+   converter.close();
+
+   // simulated PEs read independently
+   if (numProcs > 1) {
+      ParallelReader<int> whole(FILE_NAME, MPI_INT, 0, 1);
+      assert( !whole.isCollective() );
+      vector<int> all = whole.readChunk();
+      assert( (long) all.size() == SIZE && all[SIZE - 1] == SIZE - 1 );
+      whole.close();
+   }
+   clearProfiles();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* a (small) probe picks a profile for this file system */
+void ProfileTester::runAutotuneTests() {
+   if (id == MASTER) cout << "- Running autotune() tests..." << flush;
+
+   long linesBefore = countLines(PROFILES_NAME);
+   MPI_Barrier(MPI_COMM_WORLD);
+   OO_MPI_IO_Profile best = autotune(SCRATCH_NAME, 1L << 16, false);
+   assert( getProfileFor(SCRATCH_NAME) == best );
+   assert( !ifstream(SCRATCH_NAME).good() );                  // deleted
+   assert( countLines(PROFILES_NAME) == linesBefore );        // not saved
+   long bests[2] = { best.windowBytes, (long) best.collective }, maxes[2];
+   MPI_Allreduce(bests, maxes, 2, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+   assert( maxes[0] == bests[0] && maxes[1] == bests[1] );   // all agree
+
+   best = autotune(SCRATCH_NAME, 1L << 16);
+   clearProfiles();
+   assert( getProfileFor(SCRATCH_NAME) == best );            // saved
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,225 @@
+/* RecordTester.h declares the class that tests record files
+ *   (RecordWriter and RecordReader) using variable-length strings.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cstdio>                  // fopen()
+#include "../OO_MPI_IO.h"          // RecordWriter, RecordReader, ...
+using namespace std;
+
+class RecordTester {
+public:
+  RecordTester();
+  void runTests();
+  void runChunkTests();
+  void runSplitTests();
+  void runIndexTests();
+
+private:
+   string makeRecord(long i) const;
+   long writeRecords(long size, long syncInterval, bool index);
+   vector<string> gatherRecords(const vector<RecordView>& mine);
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/records.rec";
+   int id;
+   int numProcs;
+};
+
+RecordTester::RecordTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void RecordTester::runTests() {
+   if (id == MASTER) cout << "\nTesting record files...\n" << flush;
+
+   runChunkTests();
+   runSplitTests();
+   runIndexTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(getRecordIndexFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      cout << "All record file tests passed!\n" << endl;
+   }
+}
+
+/* record i: i's digits, padded to a length that varies from 0 to
+ *  a few hundred bytes (some with zero bytes), and a long one now and then
+ */
+string RecordTester::makeRecord(long i) const {
+   if (i % 10 == 7) return string();
+   string record = to_string(i);
+   record.resize( (i * 37) % 301 + (i % 97 == 0 ? 5000 : 0),
+                   (char)('a' + i % 26) );
+   if (i % 3 == 0 && record.size() > 10) record[5] = '\0';
+   return record;
+}
+
+/* write records 0 .. size-1, split unevenly among the PEs
+ *  (the last PE writes none)
+ * Return: the number of records this PE wrote.
+ */
+long RecordTester::writeRecords(long size, long syncInterval, bool index) {
+   long start = 0, stop = 0;
+   if (numProcs == 1 || id < numProcs - 1) {
+      getChunkStartStopValues(id, max(1, numProcs - 1), size, start, stop);
+      start = start * start / size;             // uneven shares
+      stop = stop * stop / size;
+   }
+   vector<string> records;
+   for (long i = start; i < stop; ++i) {
+      records.push_back( makeRecord(i) );
+   }
+   RecordWriter writer(FILE_NAME, id, numProcs, syncInterval);
+   if (index) writer.enableIndex();
+   writer.writeChunk(records);
+   assert( (long)writer.getNumRecords() == size );
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   return records.size();
+}
+
+/* concatenate every PE's records, in order of id
+ * Return: (on every PE) all the records.
+ */
+vector<string> RecordTester::gatherRecords(const vector<RecordView>& mine) {
+   string bytes;
+   vector<int> lengths;
+   for (unsigned long r = 0; r < mine.size(); ++r) {
+      bytes.append(mine[r].data, mine[r].length);
+      lengths.push_back(mine[r].length);
+   }
+   int counts[2] = { (int)lengths.size(), (int)bytes.size() };
+   vector<int> allCounts(2 * numProcs);
+   MPI_Allgather(counts, 2, MPI_INT, allCounts.data(), 2, MPI_INT,
+                 MPI_COMM_WORLD);
+   vector<int> lengthCounts(numProcs), byteCounts(numProcs);
+   vector<int> lengthDisps(numProcs, 0), byteDisps(numProcs, 0);
+   for (int pe = 0; pe < numProcs; ++pe) {
+      lengthCounts[pe] = allCounts[2*pe];
+      byteCounts[pe] = allCounts[2*pe + 1];
+      if (pe > 0) {
+         lengthDisps[pe] = lengthDisps[pe-1] + lengthCounts[pe-1];
+         byteDisps[pe] = byteDisps[pe-1] + byteCounts[pe-1];
+      }
+   }
+   vector<int> allLengths(lengthDisps.back() + lengthCounts.back());
+   string allBytes(byteDisps.back() + byteCounts.back(), ' ');
+   MPI_Allgatherv(lengths.data(), counts[0], MPI_INT, allLengths.data(),
+                  lengthCounts.data(), lengthDisps.data(), MPI_INT,
+                  MPI_COMM_WORLD);
+   MPI_Allgatherv(bytes.data(), counts[1], MPI_CHAR, &allBytes[0],
+                  byteCounts.data(), byteDisps.data(), MPI_CHAR,
+                  MPI_COMM_WORLD);
+   vector<string> all;
+   long position = 0;
+   for (unsigned long r = 0; r < allLengths.size(); ++r) {
+      all.push_back( allBytes.substr(position, allLengths[r]) );
+      position += allLengths[r];
+   }
+   return all;
+}
+
+void RecordTester::runChunkTests() {
+   if (id == MASTER) cout << "- Running readChunk() tests..." << flush;
+
+   const long SIZE = 3000 + numProcs;
+   writeRecords(SIZE, 1000, false);
+   RecordReader reader(FILE_NAME, id, numProcs);
+   assert( !reader.hasIndex() );
+   assert( (long)reader.getNumRecords() == SIZE );
+   assert( reader.getSyncInterval() == 1000 );
+   vector<RecordView> mine = reader.readChunk();
+   // the views point into one buffer
+   for (unsigned long r = 0; r < mine.size(); ++r) {
+      assert( mine[r].data >= reader.getBuffer().data() &&
+              mine[r].data + mine[r].length <=
+                reader.getBuffer().data() + reader.getBuffer().size() );
+   }
+   vector<string> all = gatherRecords(mine);
+   assert( (long)all.size() == SIZE );
+   for (long i = 0; i < SIZE; ++i) {
+      assert( all[i] == makeRecord(i) );
+   }
+   reader.close();
+
+   // an empty file
+   RecordWriter writer(FILE_NAME, id, numProcs);
+   writer.writeChunk(vector<string>());
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   RecordReader emptyReader(FILE_NAME, id, numProcs);
+   assert( emptyReader.getNumRecords() == 0 );
+   assert( emptyReader.readChunk().empty() );
+   emptyReader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* every split of the file, for 1..7 (simulated) PEs, with and without
+ *  an index, gives every record exactly once, in order
+ */
+void RecordTester::runSplitTests() {
+   if (id == MASTER) cout << "- Running split tests..." << flush;
+
+   const long SIZE = 500 + numProcs;
+   for (int index = 0; index < 2; ++index) {
+      writeRecords(SIZE, 64, index);
+      for (int pes = 1; pes <= 7; ++pes) {
+         if (pes == numProcs) continue;            // (would be collective)
+         vector<string> all;
+         for (int pe = 0; pe < pes; ++pe) {        // (every process)
+            RecordReader reader(FILE_NAME, pe, pes);
+            assert( reader.hasIndex() == (index == 1) );
+            vector<RecordView> views = reader.readChunk();
+            for (unsigned long r = 0; r < views.size(); ++r) {
+               all.push_back( views[r].toString() );
+            }
+            reader.close();
+         }
+         assert( (long)all.size() == SIZE );
+         for (long i = 0; i < SIZE; ++i) {
+            assert( all[i] == makeRecord(i) );
+         }
+      }
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void RecordTester::runIndexTests() {
+   if (id == MASTER) cout << "- Running index tests..." << flush;
+
+   const long SIZE = 2000 + numProcs;
+   writeRecords(SIZE, 4096, true);
+   RecordReader reader(FILE_NAME, id, numProcs);
+   assert( reader.hasIndex() );
+   vector<RecordView> views = reader.readRecords(97, 5);   // 97 is long
+   assert( views.size() == 5 );
+   for (long r = 0; r < 5; ++r) {
+      assert( views[r].toString() == makeRecord(97 + r) );
+   }
+   assert( reader.readRecords(SIZE - 1, 1)[0].toString() == makeRecord(SIZE - 1) );
+   assert( reader.readRecords(id, 0).empty() );
+   vector<string> all = gatherRecords( reader.readChunk() );
+   assert( (long)all.size() == SIZE && all[SIZE/2] == makeRecord(SIZE/2) );
+   reader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // a writer without an index removes the (stale) index
+   writeRecords(SIZE, 4096, false);
+   FILE* f = fopen(getRecordIndexFileName(FILE_NAME).c_str(), "rb");
+   assert( f == NULL );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,314 @@
+/* ReduceTester.h declares the class that tests streaming reductions
+ *   (the kernels, SumOp, MinOp, MaxOp, MomentsOp, HistogramOp,
+ *    makeAssociativeOp(), and ParallelReader::reduce()).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cmath>                   // fabs(), sqrt(), NAN
+#ifdef _OPENMP
+#include <omp.h>                   // omp_get_thread_num()
+#endif
+#include "../OO_MPI_IO.h"          // ParallelReader, SumOp, ...
+using namespace std;
+
+class ReduceTester {
+public:
+  ReduceTester();
+  void runTests();
+  void runKernelTests();
+  void runOpTests();
+  void runFileTests();
+  void runIntFileTests();
+  void runCombineTests();
+
+private:
+   bool isClose(double x, double y) const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/reduce.bin";
+   int id;
+   int numProcs;
+};
+
+ReduceTester::ReduceTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void ReduceTester::runTests() {
+   if (id == MASTER) cout << "\nTesting streaming reductions...\n" << flush;
+
+   runKernelTests();
+   runOpTests();
+   runFileTests();
+   runIntFileTests();
+   runCombineTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(getCrcFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      cout << "All streaming reduction tests passed!\n" << endl;
+   }
+}
+
+bool ReduceTester::isClose(double x, double y) const {
+   return fabs(x - y) <= 1e-9 * max(1.0, fabs(y));
+}
+
+/* the multi-lane kernels, with and without a remainder */
+void ReduceTester::runKernelTests() {
+   if (id == MASTER) cout << "- Running kernel tests..." << flush;
+
+   vector<int> ints(101);
+   for (int i = 0; i < 101; ++i) {
+      ints[i] = (i * 37) % 101 - 50;                    // -50..50, shuffled
+   }
+   for (unsigned long count : {0UL, 1UL, 7UL, 8UL, 13UL, 101UL}) {
+      long long sum = 0;
+      int least = INT_MAX, greatest = INT_MIN;
+      for (unsigned long i = 0; i < count; ++i) {
+         sum += ints[i];
+         least = min(least, ints[i]);
+         greatest = max(greatest, ints[i]);
+      }
+      assert( (sumItems<int, long long>(ints.data(), count)) == sum );
+      assert( minItems(ints.data(), count, INT_MAX) == least );
+      assert( maxItems(ints.data(), count, INT_MIN) == greatest );
+   }
+
+   // NaNs are ignored by min and max
+   double values[] = { NAN, 3.5, -2.0, NAN, 8.0, 1.0, NAN, 0.5, 7.0, NAN };
+   assert( minItems(values, 10, (double) INFINITY) == -2.0 );
+   assert( maxItems(values, 10, -(double) INFINITY) == 8.0 );
+   assert( minItems(values, 1, (double) INFINITY) == INFINITY );
+   assert( std::isnan(sumItems<double, double>(values, 10)) );
+   assert( (sumItems<double, double>(values + 1, 2)) == 1.5 );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* each op's identity, accumulate() and combine() */
+void ReduceTester::runOpTests() {
+   if (id == MASTER) cout << "- Running op tests..." << flush;
+
+   SumOp<int> intSum;
+   static_assert( is_same<SumOp<int>::Result, long long>::value, "" );
+   static_assert( is_same<SumOp<float>::Result, double>::value, "" );
+   int big[] = { INT_MAX, INT_MAX, INT_MAX };
+   long long total = intSum.identity();
+   intSum.accumulate(total, big, 3);
+   assert( total == 3LL * INT_MAX );                     // no overflow
+   assert( intSum.combine(total, 1) == total + 1 );
+
+   assert( MinOp<double>().identity() == INFINITY );
+   assert( MaxOp<double>().identity() == -INFINITY );
+   assert( MinOp<int>().identity() == INT_MAX );
+   assert( MaxOp<int>().identity() == INT_MIN );
+   assert( MinOp<int>().combine(3, -4) == -4 );
+   assert( MaxOp<int>().combine(3, -4) == 3 );
+
+   // moments of 1..10, whole and in two unequal parts
+   double values[10];
+   for (int i = 0; i < 10; ++i) {
+      values[i] = i + 1;
+   }
+   MomentsOp<double> moments;
+   OO_MPI_IO_Moments whole = moments.identity(), left = whole, right = whole;
+   assert( whole.count == 0 && whole.getVariance() == 0 );
+   moments.accumulate(whole, values, 10);
+   assert( whole.count == 10 && isClose(whole.mean, 5.5) );
+   assert( isClose(whole.getVariance(), 8.25) );
+   assert( isClose(whole.getSampleVariance(), 82.5 / 9) );
+   moments.accumulate(left, values, 3);
+   moments.accumulate(right, values + 3, 7);
+   OO_MPI_IO_Moments merged = moments.combine(left, right);
+   assert( merged.count == 10 && isClose(merged.mean, whole.mean) );
+   assert( isClose(merged.m2, whole.m2) );
+   merged = moments.combine(moments.identity(), whole);
+   assert( merged.count == 10 && merged.m2 == whole.m2 );
+
+   // 5 bins of width 2 from 0 to 10, plus under and over
+   HistogramOp<double> histogram(0.0, 10.0, 5);
+   assert( histogram.getNumBins() == 5 && histogram.identity().size() == 7 );
+   double samples[] = { -1.0, 0.0, 1.9, 2.0, 9.99, 10.0, 25.0, NAN };
+   vector<uint64_t> counts = histogram.identity();
+   histogram.accumulate(counts, samples, 8);
+   vector<uint64_t> expected = { 1, 2, 1, 0, 0, 1, 2 };      // (no NaN)
+   assert( counts == expected );
+   counts = histogram.combine(counts, counts);
+   assert( counts[0] == 2 && counts[6] == 4 );
+
+   auto product = makeAssociativeOp(1L, [](long a, long b) { return a * b; });
+   long factors[] = { 2, 3, 4, 5 };
+   long result = product.identity();
+   product.accumulate(result, factors, 4);
+   assert( result == 120 && product.combine(result, 2) == 240 );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* doubles 0.0, 0.5, 1.0, ..., in small and default windows */
+void ReduceTester::runFileTests() {
+   if (id == MASTER) cout << "- Running reduce() tests on doubles..." << flush;
+
+   const long SIZE = 10000 + numProcs;          // (uneven chunks)
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i * 0.5);
+   }
+   ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   double sum = 0.25 * SIZE * (SIZE - 1);        // (exact)
+   double mean = 0.25 * (SIZE - 1);
+   double variance = 0.25 * ((double) SIZE * SIZE - 1) / 12;
+   ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   for (unsigned long window : {7UL, 0UL}) {
+      assert( reader.reduce(SumOp<double>(), window) == sum );
+      assert( reader.reduce(MinOp<double>(), window) == 0.0 );
+      assert( reader.reduce(MaxOp<double>(), window) == (SIZE - 1) * 0.5 );
+      OO_MPI_IO_Moments moments = reader.reduce(MomentsOp<double>(), window);
+      assert( (long) moments.count == SIZE && isClose(moments.mean, mean) );
+      assert( isClose(moments.getVariance(), variance) );
+   }
+   assert( reader.getChunkSize() == stop - start );
+   assert( reader.getFirstItemOffset() == start );
+
+   HistogramOp<double> histogram(0.0, 0.5 * (SIZE - 100), 10);
+   vector<uint64_t> counts = reader.reduce(histogram, 7);
+   vector<uint64_t> expected = histogram.identity();
+   for (long i = 0; i < SIZE; ++i) {
+      double item = i * 0.5;
+      histogram.accumulate(expected, &item, 1);
+   }
+   assert( counts == expected && counts[0] == 0 && counts[11] == 100 );
+   reader.close();
+
+   // simulated PEs reduce just their own chunks
+   if (numProcs > 1) {
+      ParallelReader<double> whole(FILE_NAME, MPI_DOUBLE, 0, 1);
+      assert( whole.reduce(SumOp<double>(), 7) == sum );
+      whole.close();
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* ints, converted, byte-swapped and checksummed */
+void ReduceTester::runIntFileTests() {
+   if (id == MASTER) cout << "- Running reduce() tests on ints..." << flush;
+
+   const long SIZE = 5000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i * 7919 % 10007 - 5000);
+   }
+   long long sum = 0;
+   int bits = 0;
+   for (long i = 0; i < SIZE; ++i) {
+      int item = i * 7919 % 10007 - 5000;
+      sum += item;
+      bits ^= item;
+   }
+   ByteOrder other = (getHostByteOrder() == LITTLE_ENDIAN_ORDER)
+                      ? BIG_ENDIAN_ORDER : LITTLE_ENDIAN_ORDER;
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.setByteOrder(other);
+   writer.enableChecksums(1000);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   auto xorOp = makeAssociativeOp(0, [](int a, int b) { return a ^ b; });
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   reader.setByteOrder(other);
+   assert( reader.reduce(SumOp<int>(), 7) == sum );
+   assert( reader.reduce(xorOp, 7) == bits );
+   reader.verifyChecksums();
+   assert( reader.reduce(SumOp<int>(), 7) == sum );       // (250-int windows)
+   assert( reader.reduce(MinOp<int>()) == -5000 );
+   assert( reader.getCorruptBlocks().empty() );
+   reader.close();
+
+   ParallelReader<int, double> converter(FILE_NAME, MPI_INT, id, numProcs);
+   converter.setByteOrder(other);
+   OO_MPI_IO_Moments moments = converter.reduce(MomentsOp<double>(), 7);
+   assert( (long) moments.count == SIZE );
+   assert( isClose(moments.mean * SIZE, (double) sum) );
+   converter.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* results are combined over processes and threads, in order */
+void ReduceTester::runCombineTests() {
+   if (id == MASTER) cout << "- Running combine tests..." << flush;
+
+   SumOp<long> sumOp;
+   assert( combineOverProcesses(sumOp, (long long) id + 1)
+            == (long long) numProcs * (numProcs + 1) / 2 );
+   HistogramOp<int> histogram(0, numProcs, numProcs);
+   vector<uint64_t> mine = histogram.identity();
+   histogram.accumulate(mine, &id, 1);
+   vector<uint64_t> all = combineOverProcesses(histogram, mine);
+   assert( all.front() == 0 && all.back() == 0 );
+   for (int p = 0; p < numProcs; ++p) {
+      assert( all[p + 1] == 1 );
+   }
+   // (concatenating digits is associative but not commutative)
+   auto concat = makeAssociativeOp(0L, [](long a, long b) { 
+                                          long scale = 1;
+                                          while (scale <= b) scale *= 10;
+                                          return a * scale + b; 
+                                        });
+   long digits = combineOverProcesses(concat, (long) id + 1), expected = 0;
+   for (int p = 0; p < numProcs; ++p) {
+      expected = expected * 10 + p + 1;
+   }
+   assert( digits == expected );
+
+   vector<long long> threadSums(3, -1);
+   vector<long> threadDigits(3, -1);
+   long numThreads = 1;
+   #pragma omp parallel num_threads(3)
+   {
+      int thread = 0, team = 1;
+      #ifdef _OPENMP
+      thread = omp_get_thread_num();
+      team = omp_get_num_threads();
+      #endif
+      threadSums[thread] = combineOverThreads(sumOp, (long long) thread + 1,
+                                               thread, team);
+      threadDigits[thread] = combineOverThreads(concat, (long) thread + 1,
+                                                 thread, team);
+      if (thread == 0) {
+         numThreads = team;
+      }
+   }
+   expected = 0;
+   for (long t = 0; t < numThreads; ++t) {
+      expected = expected * 10 + t + 1;
+   }
+   for (long t = 0; t < numThreads; ++t) {
+      assert( threadSums[t] == numThreads * (numThreads + 1) / 2 );
+      assert( threadDigits[t] == expected );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,281 @@
+/* SortTester.h declares the class that tests sorting
+ *   (toSortKey(), radixSort(), chooseSplitters(), exchangeBuckets()
+ *    and parallelSort(), in memory and with run files).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cmath>                   // INFINITY
+#include <fstream>                 // ifstream
+#include <algorithm>               // sort(), is_sorted()
+#include "../OO_MPI_IO.h"          // parallelSort(), radixSort(), ...
+using namespace std;
+
+class SortTester {
+public:
+  SortTester();
+  void runTests();
+  void runKeyTests();
+  void runRadixTests();
+  void runExchangeTests();
+  void runSortTests();
+  void runExternalSortTests();
+
+private:
+   template <class ItemType>
+   void checkRadixSort(vector<ItemType> v, int numThreads);
+   template <class ItemType>
+   ItemType makeItem(long i) const;
+
+   const int MASTER = 0;
+   const char* IN_NAME = "./files/sortIn.bin";
+   const char* OUT_NAME = "./files/sortOut.bin";
+   int id;
+   int numProcs;
+};
+
+SortTester::SortTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void SortTester::runTests() {
+   if (id == MASTER) cout << "\nTesting parallel sorting...\n" << flush;
+
+   runKeyTests();
+   runRadixTests();
+   runExchangeTests();
+   runSortTests();
+   runExternalSortTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(IN_NAME, MPI_INFO_NULL);
+      MPI_File_delete(OUT_NAME, MPI_INFO_NULL);
+      cout << "All parallel sorting tests passed!\n" << endl;
+   }
+}
+
+/* a pseudo-random Item (with duplicates and negatives) */
+template <class ItemType>
+ItemType SortTester::makeItem(long i) const {
+   long x = (i * 7919 + 13) % 10007 - 5003;
+   return (ItemType) (x % 3 == 0 ? x : x / 8) / (ItemType) 2;
+}
+
+/* keys order numbers as < does */
+void SortTester::runKeyTests() {
+   if (id == MASTER) cout << "- Running sort key tests..." << flush;
+
+   int ints[] = { INT_MIN, -5, -1, 0, 1, 7, INT_MAX };
+   for (int i = 1; i < 7; ++i) {
+      assert( toSortKey(ints[i-1]) < toSortKey(ints[i]) );
+   }
+   unsigned long longs[] = { 0, 1, 1UL << 40, ULONG_MAX };
+   for (int i = 1; i < 4; ++i) {
+      assert( toSortKey(longs[i-1]) < toSortKey(longs[i]) );
+   }
+   double doubles[] = { -INFINITY, -1e300, -2.5, -1e-300, -0.0, 0.0,
+                        1e-300, 2.5, 1e300, INFINITY };
+   for (int i = 1; i < 10; ++i) {
+      assert( toSortKey(doubles[i-1]) < toSortKey(doubles[i]) );
+   }
+   float floats[] = { -INFINITY, -3.5f, 0.0f, 0.25f, INFINITY };
+   for (int i = 1; i < 5; ++i) {
+      assert( toSortKey(floats[i-1]) < toSortKey(floats[i]) );
+   }
+   assert( sortsBefore((short) -3, (short) 2) && !sortsBefore(2.0, 2.0) );
+   assert( toSortKey((char) 'a') < toSortKey((char) 'b') );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+template <class ItemType>
+void SortTester::checkRadixSort(vector<ItemType> v, int numThreads) {
+   vector<ItemType> expected(v);
+   sort(expected.begin(), expected.end());
+   radixSort(v.data(), v.size(), numThreads);
+   assert( v == expected );
+}
+
+/* several types, sizes and thread counts */
+void SortTester::runRadixTests() {
+   if (id == MASTER) cout << "- Running radixSort() tests..." << flush;
+
+   long sizes[] = { 0, 1, 2, 255, 1000, 20000 };
+   for (long size : sizes) {
+      vector<int> ints;
+      vector<long> longs;
+      vector<double> doubles;
+      vector<float> floats;
+      vector<unsigned char> bytes;
+      vector<short> shorts;
+      for (long i = 0; i < size; ++i) {
+         ints.push_back( makeItem<int>(i) * 40001 );
+         longs.push_back( (long) makeItem<int>(i) * (1L << 33) + i );
+         doubles.push_back( makeItem<double>(i) * 1e-3 );
+         floats.push_back( makeItem<float>(i) );
+         bytes.push_back( i * 31 % 256 );
+         shorts.push_back( makeItem<short>(i) );
+      }
+      for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+         checkRadixSort(ints, numThreads);
+         checkRadixSort(longs, numThreads);
+         checkRadixSort(doubles, numThreads);
+         checkRadixSort(floats, numThreads);
+         checkRadixSort(bytes, numThreads);
+         checkRadixSort(shorts, numThreads);
+      }
+   }
+   // small keys skip the high bytes' passes, all equal keys skip all
+   vector<long> small(1000, 7);
+   small[500] = 3;
+   checkRadixSort(small, 2);
+   checkRadixSort(vector<double>(100, -1.5), 1);
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* splitters are chosen alike, and buckets go to their processes */
+void SortTester::runExchangeTests() {
+   if (id == MASTER) cout << "- Running splitter and exchange tests..." << flush;
+
+   const long SIZE = 3000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( makeItem<int>(i) );
+   }
+   ParallelWriter<int> writer(IN_NAME, MPI_INT, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<int> reader(IN_NAME, MPI_INT, id, numProcs);
+   reader.beginChunk();
+   vector<int> splitters = chooseSplitters(reader);
+   reader.close();
+   assert( (int) splitters.size() == numProcs - 1 );
+   assert( is_sorted(splitters.begin(), splitters.end()) );
+   vector<int> first(splitters);
+   MPI_Bcast(first.data(), first.size(), MPI_INT, 0, MPI_COMM_WORLD);
+   assert( first == splitters );                      // all agree
+
+   radixSort(v.data(), v.size());
+   vector<int> bucket = exchangeBuckets(v, splitters, MPI_INT);
+   for (int item : bucket) {
+      assert( id == 0 || splitters[id-1] < item );
+      assert( id == numProcs - 1 || item <= splitters[id] );
+   }
+   long myCount = bucket.size(), count = 0;
+   MPI_Allreduce(&myCount, &count, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   assert( count == SIZE );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* in memory, with and without threads, and with a header: the output 
+ *  is sorted (across chunks too) and has the input's Items
+ */
+void SortTester::runSortTests() {
+   if (id == MASTER) cout << "- Running in-memory parallelSort() tests..." << flush;
+
+   const long SIZE = 5000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   long long sum = 0;
+   for (long i = 0; i < SIZE; ++i) {
+      if (i >= start && i < stop) {
+         v.push_back( makeItem<int>(i) );
+      }
+      sum += makeItem<int>(i);
+   }
+   ParallelWriter<int> writer(IN_NAME, MPI_INT, id, numProcs);
+   writer.enableHeader({(uint64_t) SIZE}, "unsorted");
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+      long mine = parallelSort<int>(IN_NAME, OUT_NAME, MPI_INT,
+                                     OO_MPI_IO_SORT_MEMORY, numThreads);
+      long total = 0;
+      MPI_Allreduce(&mine, &total, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+      assert( total == SIZE );
+      ParallelReader<int> reader(OUT_NAME, MPI_INT, id, numProcs);
+      assert( reader.hasHeader() && reader.getUserData() == "unsorted" );
+      assert( reader.getNumItemsInFile() == SIZE );
+      vector<int> chunk = reader.readChunkPlus(1);
+      assert( is_sorted(chunk.begin(), chunk.end()) );
+      assert( reader.reduce(SumOp<int>()) == sum );
+      reader.close();
+      MPI_Barrier(MPI_COMM_WORLD);
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* runs of a few hundred Items, merged from run files */
+void SortTester::runExternalSortTests() {
+   if (id == MASTER) cout << "- Running external parallelSort() tests..." << flush;
+
+   const long SIZE = 7000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   double sum = 0, least = 0;
+   for (long i = 0; i < SIZE; ++i) {
+      if (i >= start && i < stop) {
+         v.push_back( makeItem<double>(i) );
+      }
+      sum += makeItem<double>(i);              // (halves: exact)
+      least = min(least, makeItem<double>(i));
+   }
+   ParallelWriter<double> writer(IN_NAME, MPI_DOUBLE, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   long memoryBytes = 5 * 300 * sizeof(double);    // 300-Item runs
+   long mine = parallelSort<double>(IN_NAME, OUT_NAME, MPI_DOUBLE, memoryBytes, 2);
+   long total = 0;
+   MPI_Allreduce(&mine, &total, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   assert( total == SIZE );
+   string runFileName = string(OUT_NAME) + ".run" + to_string(id);
+   assert( !ifstream(runFileName.c_str()).good() );          // removed
+
+   ParallelReader<double> reader(OUT_NAME, MPI_DOUBLE, id, numProcs);
+   vector<double> chunk = reader.readChunkPlus(1);
+   assert( !reader.hasHeader() && reader.getNumItemsInFile() == SIZE );
+   assert( is_sorted(chunk.begin(), chunk.end()) );
+   assert( reader.reduce(SumOp<double>()) == sum );
+   double first = chunk.front();
+   MPI_Bcast(&first, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   assert( first == least );
+   reader.close();
+
+   // one Item, over and over
+   v.assign(stop - start, 4.5);
+   ParallelWriter<double> same(IN_NAME, MPI_DOUBLE, id, numProcs);
+   same.writeChunk(v);
+   same.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   parallelSort<double>(IN_NAME, OUT_NAME, MPI_DOUBLE, memoryBytes);
+   ParallelReader<double> sameReader(OUT_NAME, MPI_DOUBLE, id, numProcs);
+   assert( sameReader.reduce(MinOp<double>()) == 4.5 );
+   assert( sameReader.reduce(MaxOp<double>()) == 4.5 );
+   assert( sameReader.getNumItemsInFile() == SIZE );
+   sameReader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,156 @@
+/* SortedLookupTester.h declares the class that tests SortedLookup
+ *   (batched lower bound and exact-match lookups in sorted files).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <algorithm>               // lower_bound()
+#include "../OO_MPI_IO.h"          // ParallelWriter, SortedLookup, ...
+using namespace std;
+
+class SortedLookupTester {
+public:
+  SortedLookupTester();
+  void runTests();
+  void runFenceTests();
+  void runLookupTests();
+  void runForeignLookupTests();
+
+private:
+   long getKey(long i) const  { return 3 * (i / 2); }   // pairs of keys
+   void writeKeys(long size);
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/sortedLookup.bin";
+   int id;
+   int numProcs;
+};
+
+SortedLookupTester::SortedLookupTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void SortedLookupTester::runTests() {
+   if (id == MASTER) cout << "\nTesting SortedLookup...\n"
+                          << flush;
+
+   runFenceTests();
+   runLookupTests();
+   runForeignLookupTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+   if (id == MASTER) cout << "All SortedLookup tests passed!\n" << endl;
+}
+
+/* write keys 0, 0, 3, 3, 6, 6, ... (size of them) */
+void SortedLookupTester::writeKeys(long size) {
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, size, start, stop);
+   vector<long> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( getKey(i) );
+   }
+   ParallelWriter<long> writer(FILE_NAME, MPI_LONG, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void SortedLookupTester::runFenceTests() {
+   if (id == MASTER) cout << "- Running fence index tests..." << flush;
+
+   const long SIZE = 1000 + numProcs;
+   writeKeys(SIZE);
+   SortedLookup<long> lookup(FILE_NAME, MPI_LONG, id, numProcs, 64);
+   assert( lookup.getFenceInterval() == 64 );
+   const vector<long>& fences = lookup.getFences();
+   assert( (long)fences.size() == (SIZE + 63) / 64 );
+   for (unsigned long f = 0; f < fences.size(); ++f) {
+      assert( fences[f] == getKey(f * 64) );
+   }
+   lookup.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void SortedLookupTester::runLookupTests() {
+   if (id == MASTER) cout << "- Running lookup tests..." << flush;
+
+   // odd blocks, so that runs of equal keys straddle fences
+   const long SIZE = 10000 + numProcs, INTERVAL = 63;
+   writeKeys(SIZE);
+   vector<long> all(SIZE);
+   for (long i = 0; i < SIZE; ++i) {
+      all[i] = getKey(i);
+   }
+
+   // each PE asks about different keys (present, absent, out of range)
+   vector<long> keys = { -5, 0, getKey(SIZE-1), getKey(SIZE-1) + 1,
+                          getKey(INTERVAL), getKey(INTERVAL) + 1 };
+   for (long k = id; k < 3 * SIZE / 2; k += 7 * numProcs) {
+      keys.push_back(k);
+   }
+   SortedLookup<long> lookup(FILE_NAME, MPI_LONG, id, numProcs, INTERVAL);
+   vector<uint64_t> bounds = lookup.lowerBound(keys);
+   vector<int64_t> positions = lookup.find(keys);
+   assert( bounds.size() == keys.size() && positions.size() == keys.size() );
+   for (unsigned long i = 0; i < keys.size(); ++i) {
+      long expected = lower_bound(all.begin(), all.end(), keys[i])
+                       - all.begin();
+      assert( (long)bounds[i] == expected );
+      bool present = expected < SIZE && all[expected] == keys[i];
+      assert( positions[i] == (present ? expected : -1) );
+   }
+   // a key equal to a fence whose run begins in the previous block
+   assert( lookup.find({getKey(INTERVAL)})[0] == INTERVAL - 1 );
+
+   // a PE with no keys still takes part
+   vector<long> none;
+   if (id == MASTER) {
+      assert( lookup.lowerBound(none).empty() );
+   } else {
+      assert( lookup.lowerBound({3}) == vector<uint64_t>({2}) );
+   }
+   lookup.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* keys in the other byte order, after a header */
+void SortedLookupTester::runForeignLookupTests() {
+   if (id == MASTER) cout << "- Running converted lookup tests..." << flush;
+
+   const long SIZE = 2000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i * 0.5 - 100.0);
+   }
+   ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   writer.setByteOrder(BIG_ENDIAN_ORDER);
+   writer.enableHeader();
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   SortedLookup<double> lookup(FILE_NAME, MPI_DOUBLE, id, numProcs, 100);
+   vector<double> keys = { -100.0, -99.75, 0.0, 250.5, 1e9 };
+   vector<uint64_t> bounds = lookup.lowerBound(keys);
+   assert( bounds[0] == 0 && bounds[1] == 1 && bounds[2] == 200 );
+   assert( bounds[3] == 701 && (long)bounds[4] == SIZE );
+   vector<int64_t> positions = lookup.find(keys);
+   assert( positions[0] == 0 && positions[1] == -1 && positions[2] == 200 );
+   assert( positions[3] == 701 && positions[4] == -1 );
+   lookup.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -0,0 +1,165 @@
+/* StatsTester.h declares the class that tests the I/O statistics
+ *   of OO_MPI_IO_Base (getStats(), resetStats() and reduceStats()).
+ *
+ * When OO_MPI_IO_STATS is defined (as the Makefile does for
+ *  writerTester), it checks the counts; otherwise, that they are 0.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelWriter, OO_MPI_IO_Stats, ...
+using namespace std;
+
+class StatsTester {
+public:
+  StatsTester();
+  void runTests();
+  void runCountTests();
+  void runReduceTests();
+  void runSimulatedTests();
+
+private:
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/stats.bin";
+   const long SIZE = 10000;
+   int id;
+   int numProcs;
+};
+
+StatsTester::StatsTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void StatsTester::runTests() {
+   if (id == MASTER) cout << "\nTesting I/O statistics...\n" << flush;
+
+   runCountTests();
+   runReduceTests();
+   runSimulatedTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      cout << "All I/O statistics tests passed!\n" << endl;
+   }
+}
+
+/* the calls and bytes of a write and a read of a (headerless) file */
+void StatsTester::runCountTests() {
+   if (id == MASTER) cout << "- Running count tests..." << flush;
+
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i * 0.5);
+   }
+   uint64_t chunkBytes = v.size() * sizeof(double);
+
+   ParallelWriter<double> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   const OO_MPI_IO_Stats& written = writer.getStats();
+   if (OO_MPI_IO_STATS_ENABLED) {
+      assert( written.ops[OPEN_OP].calls == 1 );
+      assert( written.ops[TRUNCATE_OP].calls == 1 );
+      assert( written.ops[WRITE_OP].calls >= 1 );
+      assert( written.ops[WRITE_OP].bytes == chunkBytes );
+      assert( written.ops[WRITE_OP].seconds > 0 );
+      assert( written.ops[READ_OP].calls == 0 );
+      assert( written.ops[CLOSE_OP].calls == 1 );
+   } else {
+      assert( written.ops[OPEN_OP].calls == 0 );
+      assert( written.ops[WRITE_OP].bytes == 0 );
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( reader.readChunk() == v );
+   const OO_MPI_IO_Stats& read = reader.getStats();
+   if (OO_MPI_IO_STATS_ENABLED) {
+      // (process 0 also looked for a header)
+      uint64_t headerBytes = (id == MASTER) ? OO_MPI_IO_HEADER_SIZE : 0;
+      assert( read.ops[OPEN_OP].calls == 1 );
+      assert( read.ops[SIZE_OP].calls == 1 );
+      assert( read.ops[READ_OP].bytes == chunkBytes + headerBytes );
+      assert( read.ops[WRITE_OP].calls == 0 );
+      assert( read.ops[TRUNCATE_OP].calls == 0 );
+      assert( read.ops[CLOSE_OP].calls == 0 );
+   }
+   reader.resetStats();
+   for (int op = 0; op < OO_MPI_IO_NUM_OPERATIONS; ++op) {
+      assert( read.ops[op].calls == 0 && read.ops[op].bytes == 0 );
+      assert( read.ops[op].seconds == 0 );
+   }
+   reader.close();
+   if (OO_MPI_IO_STATS_ENABLED) {
+      assert( read.ops[CLOSE_OP].calls == 1 );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* the summaries of the PEs' counters */
+void StatsTester::runReduceTests() {
+   if (id == MASTER) cout << "- Running reduceStats() tests..." << flush;
+
+   ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   reader.resetStats();
+   vector<double> chunk = reader.readChunk();
+   vector<OO_MPI_IO_OpSummary> summaries = reader.reduceStats();
+   assert( summaries.size() == (unsigned) OO_MPI_IO_NUM_OPERATIONS );
+   const OO_MPI_IO_OpSummary& reads = summaries[READ_OP];
+   assert( reads.bandwidths.size() == (unsigned) numProcs );
+   if (OO_MPI_IO_STATS_ENABLED) {
+      // chunks differ by at most 1 Item
+      double least = (SIZE / numProcs) * sizeof(double);
+      double greatest = ((SIZE + numProcs - 1) / numProcs) * sizeof(double);
+      assert( reads.minBytes == least && reads.maxBytes == greatest );
+      assert( reads.meanBytes * numProcs == SIZE * sizeof(double) );
+      assert( reads.minCalls >= 1 && reads.maxCalls >= reads.minCalls );
+      assert( reads.minSeconds <= reads.meanSeconds );
+      assert( reads.meanSeconds <= reads.maxSeconds );
+      assert( reads.aggregateBandwidth > 0 );
+      double mine = chunk.size() * sizeof(double) /
+                     reader.getStats().ops[READ_OP].seconds;
+      assert( reads.bandwidths[id] == mine );
+      assert( summaries[WRITE_OP].maxCalls == 0 );
+      assert( summaries[WRITE_OP].aggregateBandwidth == 0 );
+   } else {
+      assert( reads.maxBytes == 0 && reads.maxSeconds == 0 );
+      assert( reads.bandwidths[id] == 0 );
+   }
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* PEs that are not MPI processes each summarize just their own counters */
+void StatsTester::runSimulatedTests() {
+   if (id == MASTER) cout << "- Running simulated-PE tests..." << flush;
+
+   if (numProcs > 1) {
+      ParallelReader<double> reader(FILE_NAME, MPI_DOUBLE, 0, 1);
+      assert( (long) reader.readChunk().size() == SIZE );
+      vector<OO_MPI_IO_OpSummary> summaries = reader.reduceStats();
+      const OO_MPI_IO_OpSummary& reads = summaries[READ_OP];
+      assert( reads.bandwidths.size() == 1 );
+      assert( reads.minBytes == reads.maxBytes );
+      assert( reads.meanBytes == reads.maxBytes );
+      if (OO_MPI_IO_STATS_ENABLED) {
+         assert( reads.maxBytes ==
+                  SIZE * sizeof(double) + OO_MPI_IO_HEADER_SIZE );
+      }
+      reader.close();
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
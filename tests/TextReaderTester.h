@@ -0,0 +1,335 @@
+/* TextReaderTester.h declares the class that tests ParallelTextReader
+ *   and ParallelTextWriter (parallel parsing and formatting of text 
+ *   files of one value per line).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <fstream>                 // ofstream
+#include <sstream>                 // ostringstream
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cmath>                   // fabs()
+#include <iomanip>                 // setprecision()
+#include "../OO_MPI_IO.h"          // ParallelTextReader, ParallelReader, ...
+using namespace std;
+
+class TextReaderTester {
+public:
+  TextReaderTester();
+  void runTests();
+  void runParseTests();
+  void runFileTests();
+  void runSplitTests();
+  void runCountLineTests();
+  void runWriterTests();
+
+private:
+   template <class ItemType>
+   vector<ItemType> gatherItems(const vector<ItemType>& mine, MPI_Datatype type);
+   template <class ItemType>
+   vector<ItemType> readBinary(const string& fileName, MPI_Datatype type);
+   void writeText(const string& text);
+   string readText();
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/textReader.txt";
+   int id;
+   int numProcs;
+};
+
+TextReaderTester::TextReaderTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void TextReaderTester::runTests() {
+   if (id == MASTER) cout << "\nTesting ParallelTextReader...\n" << flush;
+
+   runParseTests();
+   runFileTests();
+   runSplitTests();
+   runCountLineTests();
+   runWriterTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      cout << "All text reader tests passed!\n" << endl;
+   }
+}
+
+/* concatenate every PE's Items, in order of id
+ * Return: (on every PE) all the Items.
+ */
+template <class ItemType>
+vector<ItemType> TextReaderTester::gatherItems(const vector<ItemType>& mine,
+                                               MPI_Datatype type) {
+   int myCount = mine.size();
+   vector<int> counts(numProcs), displacements(numProcs, 0);
+   MPI_Allgather(&myCount, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                 MPI_COMM_WORLD);
+   for (int pe = 1; pe < numProcs; ++pe) {
+      displacements[pe] = displacements[pe-1] + counts[pe-1];
+   }
+   vector<ItemType> all(displacements.back() + counts.back());
+   MPI_Allgatherv(mine.data(), myCount, type, all.data(), counts.data(),
+                  displacements.data(), type, MPI_COMM_WORLD);
+   return all;
+}
+
+/* read all of a binary file (on every PE) */
+template <class ItemType>
+vector<ItemType> TextReaderTester::readBinary(const string& fileName,
+                                              MPI_Datatype type) {
+   ParallelReader<ItemType> reader(fileName, type, id, numProcs);
+   vector<ItemType> all = gatherItems(reader.readChunk(), type);
+   reader.close();
+   return all;
+}
+
+/* the master writes text to FILE_NAME */
+void TextReaderTester::writeText(const string& text) {
+   if (id == MASTER) {
+      ofstream fout(FILE_NAME, ios::binary);
+      fout << text;
+      fout.close();
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/* read all of FILE_NAME */
+string TextReaderTester::readText() {
+   ifstream fin(FILE_NAME, ios::binary);
+   ostringstream text;
+   text << fin.rdbuf();
+   return text.str();
+}
+
+void TextReaderTester::runParseTests() {
+   if (id == MASTER) cout << "- Running parse tests..." << flush;
+
+   const char* text = "42 -7 +3 2.5e3 x 300 18446744073709551615 -1 1e999";
+   int i = 0;
+   double d = 0;
+   char c = 0;
+   unsigned char uc = 0;
+   uint64_t u = 0;
+   assert( parseTextItem(text, text + 2, i) && i == 42 );
+   assert( parseTextItem(text + 3, text + 5, i) && i == -7 );
+   assert( parseTextItem(text + 6, text + 8, i) && i == 3 );
+   assert( parseTextItem(text + 9, text + 14, d) && d == 2500.0 );
+   assert( !parseTextItem(text + 9, text + 14, i) );        // not an int
+   assert( parseTextItem(text + 15, text + 16, c) && c == 'x' );
+   assert( !parseTextItem(text + 17, text + 20, c) );       // not one char
+   assert( !parseTextItem(text + 17, text + 20, uc) );      // out of range
+   assert( parseTextItem(text + 21, text + 41, u) && u == UINT64_MAX );
+   assert( !parseTextItem(text + 42, text + 44, u) );       // negative
+   assert( !parseTextItem(text + 45, text + 50, d) );       // out of range
+
+   // subnormals parse, but underflow to 0 and overflow (for the type) do not
+   const char* small = "4e-320 1e-400 1e-40 1e40";
+   float f = 0;
+   assert( parseTextItem(small, small + 6, d) && d > 0 && d < 1e-300 );
+   assert( !parseTextItem(small + 7, small + 13, d) );
+   assert( parseTextItem(small + 14, small + 19, f) && f > 0 && f < 1e-38f );
+   assert( !parseTextItem(small + 20, small + 24, f) );
+   assert( parseTextItem(small + 20, small + 24, d) && d == 1e40 );
+
+   // newlines are counted in every position
+   string lines(1000, 'x');
+   long expected = 0;
+   for (unsigned long k = 0; k < lines.size(); k += 1 + k % 5) {
+      lines[k] = '\n';
+      ++expected;
+   }
+   for (int offset = 0; offset < 40; ++offset) {
+      long count = 0;
+      for (unsigned long k = offset; k < lines.size(); ++k) {
+         count += (lines[k] == '\n');
+      }
+      assert( (long)countNewlines(lines.data() + offset,
+                                  lines.size() - offset) == count );
+   }
+   assert( (long)countNewlines(lines.data(), lines.size()) == expected );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* the text files in files/ hold the same values as the binary ones */
+void TextReaderTester::runFileTests() {
+   if (id == MASTER) cout << "- Running text file tests..." << flush;
+
+   ParallelTextReader<int> intReader("./files/12ints.txt", id, numProcs);
+   vector<int> ints = gatherItems(intReader.readChunk(), MPI_INT);
+   intReader.close();
+   assert( ints == readBinary<int>("./files/12ints.bin", MPI_INT) );
+
+   ParallelTextReader<char> charReader("./files/5chars.txt", id, numProcs);
+   vector<char> chars = gatherItems(charReader.readChunk(), MPI_CHAR);
+   charReader.close();
+   assert( chars == readBinary<char>("./files/5chars.bin", MPI_CHAR) );
+
+   ParallelTextReader<double> doubleReader("./files/5doubles.txt",
+                                           id, numProcs);
+   vector<double> doubles = gatherItems(doubleReader.readChunk(), MPI_DOUBLE);
+   doubleReader.close();
+   vector<double> binary = readBinary<double>("./files/5doubles.bin",
+                                              MPI_DOUBLE);
+   assert( doubles.size() == binary.size() );
+   for (unsigned long i = 0; i < doubles.size(); ++i) {
+      assert( fabs(doubles[i] - binary[i]) < 1e-15 );   // (15 places)
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* every split of a file gives every value once, in order,
+ *  with blank lines, spaces, '\r's and long lines
+ */
+void TextReaderTester::runSplitTests() {
+   if (id == MASTER) cout << "- Running split tests..." << flush;
+
+   const long SIZE = 3000 + numProcs;
+   ostringstream text;
+   vector<long> expected;
+   for (long i = 0; i < SIZE; ++i) {
+      long value = (i * 7919) % 100003 - 50000;
+      expected.push_back(value);
+      if (i % 11 == 0) text << "  ";
+      if (i % 500 == 7) text << string(OO_MPI_IO_TEXT_WINDOW + 10, ' ');
+      text << value;
+      if (i % 13 == 0) text << "\r";
+      if (i % 17 == 0) text << "\n";
+      if (i < SIZE - 1) text << "\n";              // none after the last
+   }
+   writeText(text.str());
+
+   for (int pes = 1; pes <= 7; ++pes) {
+      if (pes == numProcs) continue;            // (tested below)
+      vector<long> all;
+      for (int pe = 0; pe < pes; ++pe) {        // (every process)
+         ParallelTextReader<long> reader(FILE_NAME, pe, pes);
+         vector<long> chunk = reader.readChunk();
+         all.insert(all.end(), chunk.begin(), chunk.end());
+         reader.close();
+      }
+      assert( all == expected );
+   }
+   ParallelTextReader<long> reader(FILE_NAME, id, numProcs);
+   vector<long> chunk = reader.readChunk();
+   assert( reader.getFirstByteOffset() + reader.getChunkSize() <=
+           reader.getFileSize() );
+   reader.close();
+   assert( gatherItems(chunk, MPI_LONG) == expected );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* the generators' optional first line is the number of values */
+void TextReaderTester::runCountLineTests() {
+   if (id == MASTER) cout << "- Running count line tests..." << flush;
+
+   const long SIZE = 1000 + numProcs;
+   ostringstream text;
+   text << SIZE << "\n";
+   vector<float> expected;
+   for (long i = 0; i < SIZE; ++i) {
+      expected.push_back(i * 0.25f);
+      text << i * 0.25f << "\n";
+   }
+   writeText(text.str());
+
+   ParallelTextReader<float> reader(FILE_NAME, id, numProcs);
+   assert( !reader.hasCountLine() && reader.getDeclaredCount() == -1 );
+   reader.expectCountLine();
+   assert( reader.hasCountLine() && reader.getDeclaredCount() == SIZE );
+   assert( reader.getDataOffset() == (long)to_string(SIZE).size() + 1 );
+   vector<float> all = gatherItems(reader.readChunk(), MPI_FLOAT);
+   reader.close();
+   assert( all == expected );
+
+   // without expectCountLine(), the count is read as a value
+   ParallelTextReader<float> plainReader(FILE_NAME, id, numProcs);
+   all = gatherItems(plainReader.readChunk(), MPI_FLOAT);
+   plainReader.close();
+   assert( (long)all.size() == SIZE + 1 && all[0] == SIZE );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* the PEs' chunks (of different sizes) are written as one PE would */
+void TextReaderTester::runWriterTests() {
+   if (id == MASTER) cout << "- Running writer tests..." << flush;
+
+   // chunk sizes 1, 2, 3, ...
+   long start = id * (id + 1) / 2, stop = start + id + 1;
+   long size = numProcs * (numProcs + 1) / 2;
+   vector<double> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( (i % 2 ? -1 : 1) * i * 1234.5678901234567 );
+   }
+   ostringstream expected;
+   expected << size << "\n" << fixed << setprecision(15);
+   for (long i = 0; i < size; ++i) {
+      expected << (i % 2 ? -1 : 1) * i * 1234.5678901234567 << "\n";
+   }
+   ParallelTextWriter<double> writer(FILE_NAME, id, numProcs);
+   assert( writer.getPlaces() == 15 && !writer.hasCountLine() );
+   writer.enableCountLine();
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( readText() == expected.str() );
+
+   // so is ParallelWriter (in MPI mode), as textToBinary needs
+   ParallelWriter<double> binaryWriter(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   binaryWriter.writeChunk(v);
+   binaryWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( binaryWriter.getFirstItemOffset() == start );
+   vector<double> binary = readBinary<double>(FILE_NAME, MPI_DOUBLE);
+   assert( binary == gatherItems(v, MPI_DOUBLE) );
+
+   // with as few digits as read back the same
+   ParallelTextWriter<float> floatWriter(FILE_NAME, id, numProcs);
+   vector<float> floats;
+   for (long i = start; i < stop; ++i) {
+      floats.push_back(1.0f / (i + 3));
+   }
+   floatWriter.setPlaces(-1);
+   floatWriter.writeChunk(floats);
+   floatWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   ParallelTextReader<float> floatReader(FILE_NAME, id, numProcs);
+   vector<float> all = gatherItems(floatReader.readChunk(), MPI_FLOAT);
+   floatReader.close();
+   assert( all == gatherItems(floats, MPI_FLOAT) );
+
+   // chars are written as characters (with PE 0's chunk empty),
+   //  ints as integers
+   string expectedText;
+   for (int pe = 0; pe < numProcs; ++pe) {
+      for (int k = 0; k < pe; ++k) {
+         expectedText += string(1, 'a' + pe) + "\n";
+      }
+   }
+   ParallelTextWriter<char> charWriter(FILE_NAME, id, numProcs);
+   charWriter.writeChunk( vector<char>(id, 'a' + id) );
+   charWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( readText() == expectedText );
+   ParallelTextWriter<int> intWriter(FILE_NAME, id, numProcs);
+   intWriter.writeChunk( vector<int>(1, -id) );
+   intWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( readText().substr(0, 5) == "0\n-1\n" || numProcs == 1 );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
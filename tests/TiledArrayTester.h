@@ -0,0 +1,148 @@
+/* TiledArrayTester.h declares the class that tests TiledArray
+ *   using files/12ints.bin (as a 3x4 matrix) and a scratch file.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <fstream>                 // ifstream
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // TiledArray, ParallelReader
+using namespace std;
+
+class TiledArrayTester {
+public:
+  TiledArrayTester();
+  void runTests();
+  void runReadTests();
+  void runPrefetchTests();
+  void runWriteTests();
+private:
+   const int MASTER = 0;
+   int id;
+   int numProcs;
+};
+
+TiledArrayTester::TiledArrayTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void TiledArrayTester::runTests() {
+   if (id == MASTER) cout << "\nTesting TiledArray...\n" << flush;
+
+   runReadTests();
+   runPrefetchTests();
+   runWriteTests();
+
+   if (id == MASTER) cout << "All TiledArray tests passed!\n" << endl;
+}
+
+void TiledArrayTester::runReadTests() {
+   if (id == MASTER) cout << "- Running get() and LRU tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   vector<int> expected;
+   int iVal;
+   ifstream fin("files/12ints.txt");
+   assert( fin.is_open() );
+   for (int i = 0; i < 12; ++i) {
+      fin >> iVal;
+      expected.push_back(iVal);
+   }
+   fin.close();
+
+   // 3x4 matrix in 2x3 tiles => 2x2 tile grid, with partial edge tiles
+   TiledArray<int> matrix("./files/12ints.bin", MPI_INT, id, numProcs,
+                           3, 4, 2, 3, 2);
+   assert( matrix.getNumTileRows() == 2 );
+   assert( matrix.getNumTileCols() == 2 );
+
+   for (int r = 0; r < 3; ++r) {                // row-major sweep
+      for (int c = 0; c < 4; ++c) {
+         assert( matrix.get(r, c) == expected[r*4 + c] );
+      }
+   }
+   // tiles are visited 0,1,0,1,0,1,2,3,2,3,2,3; but with room for 2,
+   //  only the first touch of each tile misses
+   assert( matrix.getMisses() == 4 );
+   assert( matrix.getHits() == 8 );
+   assert( matrix.getEvictions() == 2 );
+   assert( matrix.getNumCachedTiles() == 2 );
+   assert( matrix.getBytesRead() == 12 * 4 );
+   assert( matrix.getWriteBacks() == 0 );
+
+   assert( matrix.get(0, 0) == expected[0] );  // tile 0 was evicted
+   assert( matrix.getMisses() == 5 );
+   assert( matrix.getEvictions() == 3 );
+   matrix.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void TiledArrayTester::runPrefetchTests() {
+   if (id == MASTER) cout << "- Running prefetch tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   TiledArray<int> matrix("./files/12ints.bin", MPI_INT, id, numProcs,
+                           3, 4, 1, 4, 2);     // one tile per row
+   matrix.setAutoPrefetch(true);
+   int* tile = matrix.getTile(0, 0);
+   assert( tile != NULL );
+   assert( matrix.getMisses() == 1 );
+   assert( matrix.getPrefetches() == 1 );        // row 1 is on its way
+   matrix.getTile(1, 0);
+   assert( matrix.getMisses() == 1 );
+   assert( matrix.getHits() == 1 );
+   assert( matrix.getPrefetches() == 2 );        // row 2 is on its way
+   assert( matrix.getEvictions() == 1 );         //  (row 0 was evicted)
+   matrix.getTile(2, 0);
+   assert( matrix.getMisses() == 1 );
+   assert( matrix.getReadBandwidth() >= 0.0 );
+   matrix.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+void TiledArrayTester::runWriteTests() {
+   if (id == MASTER) cout << "- Running set() and write-back tests..." << flush;
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   const char* fileName = "./files/tiled.bin";
+   const int ROWS = 5, COLS = 7;
+   {
+      // 5x7 matrix in 2x3 tiles => 3x3 tile grid; 
+      //  each PE fills the tiles t where t % numProcs == id
+      TiledArray<double> matrix(fileName, MPI_DOUBLE, id, numProcs,
+                                 ROWS, COLS, 2, 3, 2);
+      for (int r = 0; r < ROWS; ++r) {
+         for (int c = 0; c < COLS; ++c) {
+            long tile = (r/2) * matrix.getNumTileCols() + c/3;
+            if (tile % numProcs == id) {
+               matrix.set(r, c, r * 10.0 + c);
+            }
+         }
+      }
+      assert( matrix.getWriteBacks() > 0 || numProcs > 1 ); 
+      matrix.close();
+      assert( matrix.getBytesWritten() > 0 );
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelReader<double> reader(fileName, MPI_DOUBLE, id, numProcs);
+   vector<double> v = reader.readChunk();
+   reader.close();
+   assert( reader.getNumItemsInFile() == ROWS * COLS );
+   for (unsigned i = 0; i < v.size(); ++i) {
+      long item = reader.getFirstItemOffset() + i;
+      assert( v[i] == (item / COLS) * 10.0 + (item % COLS) );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(fileName, MPI_INFO_NULL);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
@@ -0,0 +1,185 @@
+/* TraceTester.h declares the class that tests event tracing
+ *   (OO_MPI_IO_TraceBuffer, OO_MPI_IO_TraceSpan, clearTrace() and saveTrace()).
+ *
+ * When OO_MPI_IO_TRACE is defined (as the Makefile does for
+ *  writerTester), it checks the traced I/O events as well.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <fstream>                 // ifstream
+#include <sstream>                 // stringstream
+#ifdef _OPENMP
+#include <omp.h>                   // omp_get_thread_num()
+#endif
+#include "../OO_MPI_IO.h"          // saveTrace(), ParallelWriter, ...
+using namespace std;
+
+class TraceTester {
+public:
+  TraceTester();
+  void runTests();
+  void runBufferTests();
+  void runThreadTests();
+  void runSaveTests();
+
+private:
+   string readTrace() const;
+   long countOf(const string& text, const string& part) const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/trace.bin";
+   const char* TRACE_NAME = "./files/trace.json";
+   int id;
+   int numProcs;
+};
+
+TraceTester::TraceTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void TraceTester::runTests() {
+   if (id == MASTER) cout << "\nTesting event tracing...\n" << flush;
+
+   runBufferTests();
+   runThreadTests();
+   runSaveTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(TRACE_NAME, MPI_INFO_NULL);
+      cout << "All event tracing tests passed!\n" << endl;
+   }
+}
+
+string TraceTester::readTrace() const {
+   ifstream fin(TRACE_NAME);
+   stringstream text;
+   text << fin.rdbuf();
+   return text.str();
+}
+
+long TraceTester::countOf(const string& text, const string& part) const {
+   long count = 0;
+   for (size_t at = text.find(part); at != string::npos;
+         at = text.find(part, at + 1)) {
+      ++count;
+   }
+   return count;
+}
+
+/* a ring keeps the latest events */
+void TraceTester::runBufferTests() {
+   if (id == MASTER) cout << "- Running trace buffer tests..." << flush;
+
+   OO_MPI_IO_TraceBuffer buffer(7, 4);
+   assert( buffer.getThread() == 7 && buffer.getCapacity() == 4 );
+   assert( buffer.getNumEvents() == 0 && buffer.getNumDropped() == 0 );
+   for (int i = 0; i < 6; ++i) {
+      buffer.add("read", "io", i, i + 0.5, 100 * i);
+   }
+   assert( buffer.getNumAdded() == 6 );
+   assert( buffer.getNumEvents() == 4 && buffer.getNumDropped() == 2 );
+   for (int i = 0; i < 4; ++i) {
+      assert( buffer.getEvent(i).start == i + 2 );
+      assert( buffer.getEvent(i).bytes == 100 * (uint64_t)(i + 2) );
+   }
+   buffer.clear();
+   assert( buffer.getNumEvents() == 0 && buffer.getNumDropped() == 0 );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* each thread has its own buffer */
+void TraceTester::runThreadTests() {
+   if (id == MASTER) cout << "- Running per-thread buffer tests..." << flush;
+
+   OO_MPI_IO_TraceBuffer* mine = getMyTraceBuffer();
+   assert( getMyTraceBuffer() == mine );
+   vector<OO_MPI_IO_TraceBuffer*> threadBuffers(3, (OO_MPI_IO_TraceBuffer*)NULL);
+   #pragma omp parallel num_threads(3)
+   {
+      OO_MPI_IO_TraceBuffer* buffer = getMyTraceBuffer();
+      double now = MPI_Wtime();
+      buffer->add("work", "phase", now, now, 0);
+      #ifdef _OPENMP
+      threadBuffers[omp_get_thread_num()] = buffer;
+      #else
+      threadBuffers[0] = buffer;
+      #endif
+   }
+   for (unsigned t = 0; t < threadBuffers.size(); ++t) {
+      if (threadBuffers[t] == NULL) continue;
+      for (unsigned u = 0; u < t; ++u) {
+         assert( threadBuffers[t] != threadBuffers[u] );
+      }
+   }
+   assert( threadBuffers[0] == mine );      // (the main thread is thread 0)
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* the merged trace of a write and a read */
+void TraceTester::runSaveTests() {
+   if (id == MASTER) cout << "- Running saveTrace() tests..." << flush;
+
+   const long SIZE = 1000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i);
+   }
+   clearTrace();                       // (the events of earlier tests)
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( reader.readChunk() == v );
+   reader.close();
+
+   saveTrace(TRACE_NAME);
+   assert( getMyTraceBuffer()->getNumEvents() == 0 );       // emptied
+   MPI_Barrier(MPI_COMM_WORLD);
+   string trace = readTrace();
+   assert( trace.find("{\"traceEvents\":[\n") == 0 );
+   assert( trace.substr(trace.size() - 2) == "}\n" );
+   assert( trace.find(",\n]") == string::npos );           // no extra ','
+   assert( countOf(trace, "{") == countOf(trace, "}") );
+   assert( countOf(trace, "\"process_name\"") == numProcs );
+   for (int pe = 0; pe < numProcs; ++pe) {
+      stringstream process;
+      process << "\"pid\":" << pe << ",\"args\":{\"name\":\"process " << pe;
+      assert( trace.find(process.str()) != string::npos );
+   }
+   if (OO_MPI_IO_TRACE_ENABLED) {
+      for (int pe = 0; pe < numProcs; ++pe) {
+         stringstream event;
+         event << "\"pid\":" << pe << ",\"tid\":0,";
+         long count = countOf(trace, event.str());
+         assert( count >= 6 );               // open, truncate, write, ...
+      }
+      assert( countOf(trace, "{\"name\":\"readChunk\",\"cat\":\"phase\"")
+               == numProcs );
+      assert( countOf(trace, "{\"name\":\"writePart\",\"cat\":\"phase\"")
+               == numProcs );
+      assert( countOf(trace, "{\"name\":\"open\",\"cat\":\"io\"")
+               == 2 * numProcs );
+      stringstream bytes;
+      bytes << "\"args\":{\"bytes\":" << (stop - start) * sizeof(int) << "}";
+      assert( trace.find(bytes.str()) != string::npos );
+   } else {
+      assert( countOf(trace, "\"cat\":\"io\"") == 0 );
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
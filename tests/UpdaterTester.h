@@ -0,0 +1,111 @@
+/* UpdaterTester.h declares the class that tests ParallelUpdater
+ *   using int values.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include "../OO_MPI_IO.h"          // ParallelUpdater, ParallelWriter, ...
+using namespace std;
+
+class UpdaterTester {
+public:
+  UpdaterTester();
+  void runTests();
+  void runWriteItemsTests(ConflictPolicy policy);
+private:
+   void makeFile();
+   vector<int> readFile();
+
+   const int MASTER = 0;
+   const int SIZE = 12;
+   const char* FILE_NAME = "./files/updater.bin";
+   int id;
+   int numProcs;
+};
+
+UpdaterTester::UpdaterTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void UpdaterTester::runTests() {
+   if (id == MASTER) cout << "\nTesting ParallelUpdater using ints...\n"
+                          << flush;
+
+   runWriteItemsTests(HIGHEST_ID_WINS);
+   runWriteItemsTests(LOWEST_ID_WINS);
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+   if (id == MASTER) cout << "All updater tests passed!\n" << endl;
+}
+
+/* write 0, 1, ..., SIZE-1 to the scratch file */
+void UpdaterTester::makeFile() {
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i);
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.writeChunk(v);
+   writer.close();
+}
+
+/* read the whole scratch file (on every PE) */
+vector<int> UpdaterTester::readFile() {
+   ParallelReader<int> reader(FILE_NAME, MPI_INT, 0, 1);
+   vector<int> v = reader.readChunk();
+   reader.close();
+   return v;
+}
+
+void UpdaterTester::runWriteItemsTests(ConflictPolicy policy) {
+   if (id == MASTER) cout << "- Running writeItems() tests ("
+                          << (policy == LOWEST_ID_WINS ? "lowest" : "highest")
+                          << " id wins)..." << flush;
+   makeFile();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParallelUpdater<int> updater(FILE_NAME, MPI_INT, id, numProcs, policy);
+   assert( updater.getConflictPolicy() == policy );
+   // every PE: its own item (twice: the last value counts),
+   //  two adjacent items of its own, and the contested item 5
+   vector<uint64_t> indices = {(uint64_t)id, 5, 
+                               (uint64_t)(SIZE-2*id-1), (uint64_t)(SIZE-2*id-2),
+                               (uint64_t)id};
+   vector<int> values = {-1, 100 + id, 200 + id, 300 + id, 1000 + id};
+   updater.writeItems(indices, values);
+   updater.close();
+   assert( updater.getFileSize() == SIZE * 4 );   // not truncated
+
+   long conflicts = updater.getNumConflicts();
+   long totalConflicts = 0;
+   MPI_Allreduce(&conflicts, &totalConflicts, 1, MPI_LONG, MPI_SUM,
+                  MPI_COMM_WORLD);
+   assert( totalConflicts == (numProcs > 1 ? 1 : 0) );
+
+   vector<int> v = readFile();
+   assert( (int)v.size() == SIZE );
+   int winner = (policy == LOWEST_ID_WINS) ? 0 : numProcs-1;
+   for (int i = 0; i < SIZE; ++i) {
+      if (i < numProcs) {
+         assert( v[i] == 1000 + i );
+      } else if (i == 5) {
+         assert( v[i] == 100 + winner );
+      } else if (i >= SIZE - 2*numProcs) {
+         int pe = (SIZE - 1 - i) / 2;
+         assert( v[i] == ((SIZE - 1 - i) % 2 == 0 ? 200 : 300) + pe );
+      } else {
+         assert( v[i] == i );                   // untouched
+      }
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
@@ -0,0 +1,315 @@
+/* ZoneMapTester.h declares the class that tests zone maps
+ *   (ParallelWriter::enableZoneMap(), buildZoneMap() and
+ *    RangeScanReader, and the removal of stale zone maps).
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ */
+
+#include <iostream>                // cout, ...
+#include <mpi.h>                   // MPI types
+#include <cassert>                 // assert()
+#include <cmath>                   // NAN
+#include <cstdio>                  // fopen()
+#include "../OO_MPI_IO.h"          // ParallelWriter, RangeScanReader, ...
+using namespace std;
+
+class ZoneMapTester {
+public:
+  ZoneMapTester();
+  void runTests();
+  void runAccumulatorTests();
+  void runScanTests();
+  void runForeignScanTests();
+  void runBuildTests();
+  void runRewriteTests();
+
+private:
+   template <class ItemType>
+   vector<ItemType> gatherScan(const vector<ItemType>& mine, MPI_Datatype type);
+   bool zoneMapExists() const;
+
+   const int MASTER = 0;
+   const char* FILE_NAME = "./files/zoneMap.bin";
+   int id;
+   int numProcs;
+};
+
+ZoneMapTester::ZoneMapTester() {
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+}
+
+void ZoneMapTester::runTests() {
+   if (id == MASTER) cout << "\nTesting zone maps and range scans...\n"
+                          << flush;
+
+   runAccumulatorTests();
+   runScanTests();
+   runForeignScanTests();
+   runBuildTests();
+   runRewriteTests();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(FILE_NAME, MPI_INFO_NULL);
+      MPI_File_delete(getZoneMapFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+      cout << "All zone map tests passed!\n" << endl;
+   }
+}
+
+/* concatenate every PE's share of a scan, in order of id
+ * Return: (on every PE) all the Items the scan found.
+ */
+template <class ItemType>
+vector<ItemType> ZoneMapTester::gatherScan(const vector<ItemType>& mine,
+                                           MPI_Datatype type) {
+   int myCount = mine.size();
+   vector<int> counts(numProcs), displacements(numProcs, 0);
+   MPI_Allgather(&myCount, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                 MPI_COMM_WORLD);
+   for (int pe = 1; pe < numProcs; ++pe) {
+      displacements[pe] = displacements[pe-1] + counts[pe-1];
+   }
+   vector<ItemType> all(displacements.back() + counts.back());
+   MPI_Allgatherv(mine.data(), myCount, type, all.data(), counts.data(),
+                  displacements.data(), type, MPI_COMM_WORLD);
+   return all;
+}
+
+bool ZoneMapTester::zoneMapExists() const {
+   FILE* f = fopen(getZoneMapFileName(FILE_NAME).c_str(), "rb");
+   if (f != NULL) fclose(f);
+   return f != NULL;
+}
+
+void ZoneMapTester::runAccumulatorTests() {
+   if (id == MASTER) cout << "- Running zone accumulator tests..." << flush;
+
+   // Items 250..549 in blocks of 100, added in two parts
+   vector<double> values(300);
+   for (unsigned i = 0; i < values.size(); ++i) {
+      values[i] = (i % 2 == 0) ? i : -(double)i;
+   }
+   values[10] = NAN;
+   for (unsigned i = 250; i < 300; ++i) {       // all of block 5
+      values[i] = NAN;
+   }
+   OO_MPI_IO_ZoneAccumulator<double> zones;
+   zones.begin(250, 100);
+   zones.add(values.data(), 120);
+   zones.add(values.data() + 120, 180);
+   assert( zones.getNumPieces() == 4 );               // blocks 2..5
+   const vector<uint64_t>& pieces = zones.getPieces();
+   double least, greatest;
+   assert( pieces[0] == 2 && pieces[3] == 49 );       // 50 Items, 1 NaN
+   memcpy(&least, &pieces[1], 8);
+   memcpy(&greatest, &pieces[2], 8);
+   assert( least == -49 && greatest == 48 );
+   assert( pieces[4] == 3 && pieces[7] == 100 );      // split over 2 adds
+   memcpy(&least, &pieces[5], 8);
+   memcpy(&greatest, &pieces[6], 8);
+   assert( least == -149 && greatest == 148 );
+   assert( pieces[12] == 5 && pieces[15] == 0 );      // no ordered Items
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* a slowly-rising series: a narrow range matches few blocks */
+void ZoneMapTester::runScanTests() {
+   if (id == MASTER) cout << "- Running range scan tests..." << flush;
+
+   const long SIZE = 10000 + numProcs, BLOCK_ITEMS = 100;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i / 2 + (i % 7));               // rising, with noise
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.enableZoneMap(BLOCK_ITEMS);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( zoneMapExists() );
+
+   RangeScanReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   assert( reader.getNumBlocks() == (SIZE + BLOCK_ITEMS - 1) / BLOCK_ITEMS );
+   assert( reader.getBlockItems() == BLOCK_ITEMS );
+   int least = 0, greatest = 0;                   // Item 0 is 0
+   for (long i = 0; i < BLOCK_ITEMS; ++i) {
+      least = min(least, int(i / 2 + (i % 7)));
+      greatest = max(greatest, int(i / 2 + (i % 7)));
+   }
+   assert( reader.getBlockMin(0) == least && reader.getBlockMax(0) == greatest );
+   assert( reader.getBlockCount(0) == BLOCK_ITEMS );
+
+   const int LOW = 2000, HIGH = 2400;
+   vector<int> all = gatherScan(reader.scanRange(LOW, HIGH), MPI_INT);
+   vector<int> expected;
+   for (long i = 0; i < SIZE; ++i) {
+      int x = i / 2 + (i % 7);
+      if (LOW <= x && x <= HIGH) expected.push_back(x);
+   }
+   assert( all == expected );
+   // only the ~10 blocks around Items 4000..4800 were read, evenly
+   assert( reader.getNumBlocksMatched() <= 11 );
+   long myRead = reader.getNumBlocksRead(), leastRead = 0, mostRead = 0;
+   MPI_Allreduce(&myRead, &leastRead, 1, MPI_LONG, MPI_MIN, MPI_COMM_WORLD);
+   MPI_Allreduce(&myRead, &mostRead, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+   assert( mostRead - leastRead <= 1 );
+
+   // ranges that match nothing, or everything
+   assert( reader.scanRange(-10, -1).empty() );
+   assert( reader.getNumBlocksMatched() == 0 );
+   all = gatherScan(reader.scanRange(0, SIZE), MPI_INT);
+   assert( (long)all.size() == SIZE );
+   assert( reader.getNumBlocksMatched() == reader.getNumBlocks() );
+   reader.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   // a writer without a zone map removes the (stale) zone map
+   ParallelWriter<int> plainWriter(FILE_NAME, MPI_INT, id, numProcs);
+   plainWriter.writeChunk(v);
+   plainWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !zoneMapExists() );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* zones are of the values, not of the bytes stored:
+ *  check doubles converted from floats, big-endian, with a header
+ */
+void ZoneMapTester::runForeignScanTests() {
+   if (id == MASTER) cout << "- Running converted range scan tests..."
+                          << flush;
+
+   const long SIZE = 1000 + numProcs;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<float> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( (i % 10 == 3) ? NAN : i * 0.25f );
+   }
+   ParallelWriter<double, float> writer(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   writer.setByteOrder(BIG_ENDIAN_ORDER);
+   writer.enableHeader({(uint64_t)SIZE});
+   writer.enableZoneMap(64);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   RangeScanReader<double> reader(FILE_NAME, MPI_DOUBLE, id, numProcs);
+   assert( reader.getBlockMin(1) == 64 * 0.25 );
+   assert( reader.getBlockMax(1) == 127 * 0.25 );
+   assert( reader.getBlockCount(1) == 64 - 6 );           // 6 NaNs
+   vector<double> all = gatherScan(reader.scanRange(100.0, 110.0), MPI_DOUBLE);
+   assert( all.size() == 41 - 4 );                         // 400..440
+   for (unsigned i = 0; i < all.size(); ++i) {
+      assert( all[i] >= 100.0 && all[i] <= 110.0 );
+   }
+   assert( reader.getNumBlocksMatched() == 1 );            // block 6
+   reader.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* buildZoneMap() gives the same zone map as enableZoneMap() */
+void ZoneMapTester::runBuildTests() {
+   if (id == MASTER) cout << "- Running buildZoneMap() tests..." << flush;
+
+   const long SIZE = 777 + numProcs, BLOCK_ITEMS = 50;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<long> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back( (i * 7919) % 1000 - 500 );
+   }
+   ParallelWriter<long> writer(FILE_NAME, MPI_LONG, id, numProcs);
+   writer.enableZoneMap(BLOCK_ITEMS);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   RangeScanReader<long> written(FILE_NAME, MPI_LONG, id, numProcs);
+   vector<long> writtenScan = written.scanRange(-100, 100);
+   written.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) {
+      MPI_File_delete(getZoneMapFileName(FILE_NAME).c_str(), MPI_INFO_NULL);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   buildZoneMap<long>(FILE_NAME, MPI_LONG, id, numProcs, BLOCK_ITEMS);
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( zoneMapExists() );
+   RangeScanReader<long> built(FILE_NAME, MPI_LONG, id, numProcs);
+   assert( built.getNumBlocks() == (SIZE + BLOCK_ITEMS - 1) / BLOCK_ITEMS );
+   for (long b = 0; b < built.getNumBlocks(); ++b) {
+      long least = 1000, greatest = -1000;
+      for (long i = b * BLOCK_ITEMS; i < min(SIZE, (b+1) * BLOCK_ITEMS); ++i) {
+         long x = (i * 7919) % 1000 - 500;
+         least = min(least, x);
+         greatest = max(greatest, x);
+      }
+      assert( built.getBlockMin(b) == least );
+      assert( built.getBlockMax(b) == greatest );
+   }
+   assert( built.scanRange(-100, 100) == writtenScan );
+   built.close();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
+
+/* rewriting a file's Items (by array or by tile) removes its zone map,
+ *  so a scan of a fresh map finds the new Items
+ */
+void ZoneMapTester::runRewriteTests() {
+   if (id == MASTER) cout << "- Running stale zone map tests..." << flush;
+
+   const long SIZE = 100;
+   long start = -1, stop = -1;
+   getChunkStartStopValues(id, numProcs, SIZE, start, stop);
+   vector<int> v;
+   for (long i = start; i < stop; ++i) {
+      v.push_back(i);
+   }
+   ParallelWriter<int> writer(FILE_NAME, MPI_INT, id, numProcs);
+   writer.enableZoneMap(10);
+   writer.writeChunk(v);
+   writer.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( zoneMapExists() );
+
+   ParallelArrayWriter<int> arrayWriter(FILE_NAME, MPI_INT, id, numProcs,
+                                        {SIZE}, {numProcs});
+   arrayWriter.writeBlock( vector<int>(arrayWriter.getBlockSize(), 1000) );
+   arrayWriter.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !zoneMapExists() );
+   buildZoneMap<int>(FILE_NAME, MPI_INT, id, numProcs, 10);
+   MPI_Barrier(MPI_COMM_WORLD);
+   RangeScanReader<int> reader(FILE_NAME, MPI_INT, id, numProcs);
+   long myCount = reader.scanRange(900, 1100).size(), count = 0;
+   reader.close();
+   MPI_Allreduce(&myCount, &count, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   assert( count == SIZE );
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( zoneMapExists() );
+
+   // the last PE changes one Item through its tile cache
+   TiledArray<int> matrix(FILE_NAME, MPI_INT, id, numProcs, 10, 10, 5, 5, 2);
+   if (id == numProcs - 1) {
+      matrix.set(9, 9, 7);
+   }
+   matrix.close();
+   MPI_Barrier(MPI_COMM_WORLD);
+   assert( !zoneMapExists() );
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (id == MASTER) cout << " Passed! " << endl;
+}
@@ -9,6 +9,9 @@
 #include "DoubleReaderTester.h"
 #include "IntReaderTester.h"
 #include "CharReaderTester.h"
+#include "ArrayReaderTester.h"
+#include "EpochReaderTester.h"
+#include "TextReaderTester.h"
 
 int main(int argc, char** argv) {
    MPI_Init(&argc, &argv);
@@ -22,6 +25,15 @@ int main(int argc, char** argv) {
    CharReaderTester crt;
    crt.runTests();
 
+   ArrayReaderTester art;
+   art.runTests();
+
+   EpochReaderTester ert;
+   ert.runTests();
+
+   TextReaderTester trt;
+   trt.runTests();
+
    MPI_Finalize();
 }
 
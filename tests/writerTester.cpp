@@ -7,6 +7,25 @@
 #include "DoubleWriterTester.h"
 // #include "IntReaderTester.h"
 #include "CharWriterTester.h"
+#include "ArrayWriterTester.h"
+#include "TiledArrayTester.h"
+#include "UpdaterTester.h"
+#include "HeaderTester.h"
+#include "ByteOrderTester.h"
+#include "ConversionTester.h"
+#include "CompressedTester.h"
+#include "ChecksumTester.h"
+#include "ZoneMapTester.h"
+#include "SortedLookupTester.h"
+#include "BloomFilterTester.h"
+#include "RecordTester.h"
+#include "GeneratorTester.h"
+#include "StatsTester.h"
+#include "TraceTester.h"
+#include "ProfileTester.h"
+#include "ReduceTester.h"
+#include "PipelineTester.h"
+#include "SortTester.h"
 
 int main(int argc, char** argv) {
    MPI_Init(&argc, &argv);
@@ -20,6 +39,63 @@ int main(int argc, char** argv) {
    CharWriterTester cwt;
    cwt.runTests();
 
+   ArrayWriterTester awt;
+   awt.runTests();
+
+   TiledArrayTester tat;
+   tat.runTests();
+
+   UpdaterTester ut;
+   ut.runTests();
+
+   HeaderTester ht;
+   ht.runTests();
+
+   ByteOrderTester bot;
+   bot.runTests();
+
+   ConversionTester ct;
+   ct.runTests();
+
+   CompressedTester cpt;
+   cpt.runTests();
+
+   ChecksumTester cst;
+   cst.runTests();
+
+   ZoneMapTester zmt;
+   zmt.runTests();
+
+   SortedLookupTester slt;
+   slt.runTests();
+
+   BloomFilterTester bft;
+   bft.runTests();
+
+   RecordTester rt;
+   rt.runTests();
+
+   GeneratorTester gt;
+   gt.runTests();
+
+   StatsTester st;
+   st.runTests();
+
+   TraceTester trt;
+   trt.runTests();
+
+   ProfileTester pt;
+   pt.runTests();
+
+   ReduceTester redt;
+   redt.runTests();
+
+   PipelineTester plt;
+   plt.runTests();
+
+   SortTester sot;
+   sot.runTests();
+
    MPI_Finalize();
 }
 
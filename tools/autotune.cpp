@@ -0,0 +1,51 @@
+/* autotune.cpp probes a file system and saves the I/O tuning profile
+ *  with which a probe file was written and read back the fastest,
+ *  so that later programs' readers and writers on it use the profile.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./autotune <scratchFileName> [<probeMB>]
+ *
+ *  where <scratchFileName> is a file (which will be overwritten and
+ *  deleted) on the file system to be tuned, and <probeMB> (default 64)
+ *  is the size of the probe file, in MB.
+ *  The profile is saved in the file named by OO_MPI_IO_PROFILES
+ *  (by default, $HOME/.oo_mpi_io_profiles), under the file system's
+ *  mount point. Run it with as many processes as the programs that
+ *  will use the file system usually have.
+ */
+
+#include "../OO_MPI_IO.h"   // autotune(), ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+using namespace std;
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long probeMB = (argc > 2) ? atol(argv[2]) : OO_MPI_IO_PROBE_BYTES >> 20;
+   if (argc < 2 || argc > 3 || probeMB <= 0) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./autotune"
+                         " <scratchFileName> [<probeMB>]\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* fileName = argv[1];
+
+   double start = MPI_Wtime();
+   OO_MPI_IO_Profile profile = autotune(fileName, probeMB << 20);
+   double time = MPI_Wtime() - start;
+   if (id == 0) {
+      printf("\nThe best profile (found in %.3f secs) is:\n  %s"
+             "saved in '%s'\n\n", time,
+              formatProfile(getMountPoint(fileName), profile).c_str(),
+              getProfilesFileName().c_str());
+   }
+
+   MPI_Finalize();
+   return 0;
+}
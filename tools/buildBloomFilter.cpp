@@ -0,0 +1,63 @@
+/* buildBloomFilter.cpp builds the Bloom filter of an existing binary file,
+ *  so that BloomFilter can rule out most absent keys without reading it.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./buildBloomFilter <type> <fileName> [<bitsPerKey>]
+ *
+ *  where <type> is one of char, int, long, float or double,
+ *  and <bitsPerKey> (default 10) is the filter's size, in bits per Item.
+ *  The filter is written to <fileName>.bloom.
+ */
+
+#include "../OO_MPI_IO.h"   // buildBloomFilter(), ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atof()
+#include <cstring>          // strcmp()
+using namespace std;
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   if (argc < 3 || argc > 4) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./buildBloomFilter"
+                         " <type> <fileName> [<bitsPerKey>]\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* type = argv[1];
+   const char* fileName = argv[2];
+   double bitsPerKey = (argc > 3) ? atof(argv[3]) 
+                                  : OO_MPI_IO_BLOOM_BITS_PER_KEY;
+
+   double start = MPI_Wtime();
+   if (strcmp(type, "char") == 0) {
+      buildBloomFilter<char>(fileName, MPI_CHAR, id, numProcs, bitsPerKey);
+   } else if (strcmp(type, "int") == 0) {
+      buildBloomFilter<int>(fileName, MPI_INT, id, numProcs, bitsPerKey);
+   } else if (strcmp(type, "long") == 0) {
+      buildBloomFilter<long>(fileName, MPI_LONG, id, numProcs, bitsPerKey);
+   } else if (strcmp(type, "float") == 0) {
+      buildBloomFilter<float>(fileName, MPI_FLOAT, id, numProcs, bitsPerKey);
+   } else if (strcmp(type, "double") == 0) {
+      buildBloomFilter<double>(fileName, MPI_DOUBLE, id, numProcs, bitsPerKey);
+   } else {
+      if (id == 0) {
+         fprintf(stderr, "\nbuildBloomFilter: unknown type '%s'\n\n", type);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   double time = MPI_Wtime() - start;
+   if (id == 0) {
+      printf("\nWrote %s in %.3f secs\n\n", 
+              getBloomFileName(fileName).c_str(), time);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,63 @@
+/* buildZoneMap.cpp builds the zone map of an existing binary file,
+ *  so that RangeScanReader can skip the blocks that cannot hold
+ *  values in the range it is looking for.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./buildZoneMap <type> <fileName> [<blockItems>]
+ *
+ *  where <type> is one of char, int, long, float or double,
+ *  and <blockItems> (default 65536) is the number of Items per block.
+ *  The zone map is written to <fileName>.zmap.
+ */
+
+#include "../OO_MPI_IO.h"   // buildZoneMap(), ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol()
+#include <cstring>          // strcmp()
+using namespace std;
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   if (argc < 3 || argc > 4) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./buildZoneMap"
+                         " <type> <fileName> [<blockItems>]\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* type = argv[1];
+   const char* fileName = argv[2];
+   long blockItems = (argc > 3) ? atol(argv[3]) : OO_MPI_IO_ZONE_ITEMS;
+
+   double start = MPI_Wtime();
+   if (strcmp(type, "char") == 0) {
+      buildZoneMap<char>(fileName, MPI_CHAR, id, numProcs, blockItems);
+   } else if (strcmp(type, "int") == 0) {
+      buildZoneMap<int>(fileName, MPI_INT, id, numProcs, blockItems);
+   } else if (strcmp(type, "long") == 0) {
+      buildZoneMap<long>(fileName, MPI_LONG, id, numProcs, blockItems);
+   } else if (strcmp(type, "float") == 0) {
+      buildZoneMap<float>(fileName, MPI_FLOAT, id, numProcs, blockItems);
+   } else if (strcmp(type, "double") == 0) {
+      buildZoneMap<double>(fileName, MPI_DOUBLE, id, numProcs, blockItems);
+   } else {
+      if (id == 0) {
+         fprintf(stderr, "\nbuildZoneMap: unknown type '%s'\n\n", type);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   double time = MPI_Wtime() - start;
+   if (id == 0) {
+      printf("\nWrote %s in %.3f secs\n\n", 
+              getZoneMapFileName(fileName).c_str(), time);
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -0,0 +1,76 @@
+/* sortFile.cpp sorts a binary file of numbers into another file,
+ *  in parallel, with runs and a merge if it does not fit in memory.
+ *
+ * @author: Joel C. Adams, Calvin University, Fall 2026
+ *
+ * Usage: mpirun -np <P> ./sortFile <type> <inFileName> <outFileName> 
+ *                                  [<memoryMB>] [<numThreads>]
+ *
+ *  where <type> is one of char, int, long, float or double,
+ *  <memoryMB> (default 1024) is the most memory each process may
+ *  use for Items, in MB, and <numThreads> (default 1) is the number
+ *  of threads each process sorts with.
+ *  The run files (if any) are written next to <outFileName>.
+ */
+
+#include "../OO_MPI_IO.h"   // parallelSort(), ...
+#include <cstdio>           // printf()
+#include <cstdlib>          // atol(), atoi()
+#include <cstring>          // strcmp()
+using namespace std;
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   int id = -1, numProcs = -1;
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+   long memoryMB = (argc > 4) ? atol(argv[4]) : OO_MPI_IO_SORT_MEMORY >> 20;
+   int numThreads = (argc > 5) ? atoi(argv[5]) : 1;
+   if (argc < 4 || argc > 6 || memoryMB <= 0 || numThreads <= 0) {
+      if (id == 0) {
+         fprintf(stderr, "\nUsage: mpirun -np <P> ./sortFile <type> <inFileName>"
+                         " <outFileName> [<memoryMB>] [<numThreads>]\n\n");
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   const char* type = argv[1];
+   const char* inFileName = argv[2];
+   const char* outFileName = argv[3];
+   long memoryBytes = memoryMB << 20;
+
+   double start = MPI_Wtime();
+   long numItems = 0;
+   if (strcmp(type, "char") == 0) {
+      numItems = parallelSort<char>(inFileName, outFileName, MPI_CHAR,
+                                     memoryBytes, numThreads);
+   } else if (strcmp(type, "int") == 0) {
+      numItems = parallelSort<int>(inFileName, outFileName, MPI_INT,
+                                    memoryBytes, numThreads);
+   } else if (strcmp(type, "long") == 0) {
+      numItems = parallelSort<long>(inFileName, outFileName, MPI_LONG,
+                                     memoryBytes, numThreads);
+   } else if (strcmp(type, "float") == 0) {
+      numItems = parallelSort<float>(inFileName, outFileName, MPI_FLOAT,
+                                      memoryBytes, numThreads);
+   } else if (strcmp(type, "double") == 0) {
+      numItems = parallelSort<double>(inFileName, outFileName, MPI_DOUBLE,
+                                       memoryBytes, numThreads);
+   } else {
+      if (id == 0) {
+         fprintf(stderr, "\nsortFile: unknown type '%s'\n\n", type);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+   double time = MPI_Wtime() - start;
+   long totalItems = 0;
+   MPI_Reduce(&numItems, &totalItems, 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+   if (id == 0) {
+      printf("\nSorted %ld Items into %s in %.3f secs\n\n", 
+              totalItems, outFileName, time);
+   }
+
+   MPI_Finalize();
+   return 0;
+}